@@ -25,6 +25,7 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "boolean.h"
 #include "assert.h"
 #include "log.h"
 
@@ -53,6 +54,15 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("EventProfiling",
+                   "Profile the number and the wall-clock time of the events "
+                   "invoking each function, and the size of the event queue. "
+                   "The profile is reported when the simulator is destroyed, "
+                   "as configured by the attributes of ns3::EventProfiler.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::SetEventProfiling,
+                                        &DefaultSimulatorImpl::GetEventProfiling),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -93,6 +103,7 @@ DefaultSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+  m_profiler = 0;
   SimulatorImpl::DoDispose ();
 }
 void
@@ -109,6 +120,10 @@ DefaultSimulatorImpl::Destroy ()
           ev->Invoke ();
         }
     }
+  if (m_profiler != 0)
+    {
+      m_profiler->Report ();
+    }
 }
 
 void
@@ -128,6 +143,32 @@ DefaultSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
   m_events = scheduler;
 }
 
+void
+DefaultSimulatorImpl::SetEventProfiling (bool enable)
+{
+  NS_LOG_FUNCTION (this << enable);
+  if (!enable)
+    {
+      m_profiler = 0;
+    }
+  else if (m_profiler == 0)
+    {
+      m_profiler = CreateObject<EventProfiler> ();
+    }
+}
+
+bool
+DefaultSimulatorImpl::GetEventProfiling (void) const
+{
+  return m_profiler != 0;
+}
+
+Ptr<EventProfiler>
+DefaultSimulatorImpl::GetEventProfiler (void) const
+{
+  return m_profiler;
+}
+
 // System ID for non-distributed simulation is always zero
 uint32_t
 DefaultSimulatorImpl::GetSystemId (void) const
@@ -148,7 +189,14 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  if (m_profiler != 0)
+    {
+      m_profiler->Invoke (next.impl, TimeStep (m_currentTs), m_unscheduledEvents);
+    }
+  else
+    {
+      next.impl->Invoke ();
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
@@ -24,6 +24,7 @@
 #include "simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 #include "system-thread.h"
 #include "system-mutex.h"
 
@@ -79,9 +80,25 @@ public:
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
 
+  /**
+   * \returns the profile of the events processed so far, or 0 if the
+   * EventProfiling attribute is false
+   */
+  Ptr<EventProfiler> GetEventProfiler (void) const;
+
 private:
   virtual void DoDispose (void);
 
+  /**
+   * Enable or disable the profiling of the events.
+   * \param [in] enable \c true to profile the events
+   */
+  void SetEventProfiling (bool enable);
+  /**
+   * \returns \c true if the events are profiled
+   */
+  bool GetEventProfiling (void) const;
+
   /** Process the next event. */
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
@@ -136,6 +153,9 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+  /** The profile of the events, if enabled. */
+  Ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
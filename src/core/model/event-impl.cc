@@ -31,6 +31,103 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+namespace {
+
+/** Granularity of the sizes of the recycled events, in bytes. */
+const std::size_t EVENT_SIZE_STEP = 16;
+/** Number of sizes of the recycled events. */
+const std::size_t EVENT_SIZES = 8;
+/** Maximum number of free events of each size kept by a thread. */
+const std::size_t MAX_FREE_EVENTS = 4096;
+
+/**
+ * \ingroup events
+ * Free lists of the events of a thread.
+ *
+ * This is trivially destructible, so that events released while the
+ * thread exits, after EventFreeListsCleanup, do not use a destroyed object.
+ */
+struct EventFreeLists
+{
+  void *head[EVENT_SIZES];          //!< First free event of each size, linked through their first word
+  std::size_t length[EVENT_SIZES];  //!< Number of free events of each size
+  bool initialized;                 //!< True once the cleanup is registered
+  bool destroyed;                   //!< True once the thread is exiting
+};
+
+/**
+ * \ingroup events
+ * Release the free events when the thread exits.
+ */
+struct EventFreeListsCleanup
+{
+  /** Destructor. */
+  ~EventFreeListsCleanup ();
+};
+
+/** Free lists of the events of this thread. */
+thread_local EventFreeLists g_eventFreeLists;
+/** Cleanup of the free lists of this thread. */
+thread_local EventFreeListsCleanup g_eventFreeListsCleanup;
+
+EventFreeListsCleanup::~EventFreeListsCleanup ()
+{
+  for (std::size_t i = 0; i < EVENT_SIZES; i++)
+    {
+      while (g_eventFreeLists.head[i] != 0)
+        {
+          void *p = g_eventFreeLists.head[i];
+          g_eventFreeLists.head[i] = *static_cast<void **> (p);
+          ::operator delete (p);
+        }
+      g_eventFreeLists.length[i] = 0;
+    }
+  g_eventFreeLists.destroyed = true;
+}
+
+} // unnamed namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  std::size_t i = (size - 1) / EVENT_SIZE_STEP;
+  if (i >= EVENT_SIZES)
+    {
+      return ::operator new (size);
+    }
+  if (!g_eventFreeLists.initialized && !g_eventFreeLists.destroyed)
+    {
+      // construct the cleanup of this thread
+      (void) &g_eventFreeListsCleanup;
+      g_eventFreeLists.initialized = true;
+    }
+  void *p = g_eventFreeLists.head[i];
+  if (p == 0)
+    {
+      // the block may be recycled for any event of the same size class
+      return ::operator new ((i + 1) * EVENT_SIZE_STEP);
+    }
+  g_eventFreeLists.head[i] = *static_cast<void **> (p);
+  g_eventFreeLists.length[i]--;
+  return p;
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  std::size_t i = (size - 1) / EVENT_SIZE_STEP;
+  if (i >= EVENT_SIZES || g_eventFreeLists.destroyed
+      || !g_eventFreeLists.initialized
+      || g_eventFreeLists.length[i] >= MAX_FREE_EVENTS)
+    {
+      ::operator delete (p);
+      return;
+    }
+  *static_cast<void **> (p) = g_eventFreeLists.head[i];
+  g_eventFreeLists.head[i] = p;
+  g_eventFreeLists.length[i]++;
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -66,4 +163,10 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+const void *
+EventImpl::GetFunction (void) const
+{
+  return 0;
+}
+
 } // namespace ns3
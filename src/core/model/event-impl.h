@@ -20,6 +20,7 @@
 #ifndef EVENT_IMPL_H
 #define EVENT_IMPL_H
 
+#include <cstddef>
 #include <stdint.h>
 #include "simple-ref-count.h"
 
@@ -48,6 +49,24 @@ public:
   EventImpl ();
   /** Destructor. */
   virtual ~EventImpl () = 0;
+  /**
+   * Allocate the memory of an event.
+   *
+   * Events are small and short-lived, so their memory is recycled through
+   * per-thread free lists, one for each multiple of 16 bytes up to 128
+   * bytes. Larger events use the global allocator.
+   *
+   * \param [in] size The size of the event.
+   * \returns The memory of the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release the memory of an event to the free list of its size.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
   /**
    * Called by the simulation engine to notify the event that it is time
    * to execute.
@@ -65,6 +84,13 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * \returns the address of the function or method invoked by the event,
+   * or 0 if it is not known.
+   *
+   * Used by the EventProfiler to group the events by the code they run.
+   */
+  virtual const void * GetFunction (void) const;
 
 protected:
   /**
@@ -0,0 +1,313 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "log.h"
+#include "string.h"
+#include "ns3/core-config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#ifdef HAVE_DLADDR
+#include <dlfcn.h>
+#endif
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+NS_OBJECT_ENSURE_REGISTERED (EventProfiler);
+
+namespace {
+
+/**
+ * \ingroup events
+ * \param mangled a mangled C++ name
+ * \return the demangled name, or the mangled one if it can't be demangled
+ */
+std::string
+Demangle (const char *mangled)
+{
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled, NULL, NULL, &status);
+  std::string ret = (status == 0) ? demangled : mangled;
+  std::free (demangled);
+  return ret;
+}
+
+/**
+ * \ingroup events
+ * \param entry an entry of the profile
+ * \param other another entry of the profile
+ * \return true if the first entry took longer
+ */
+bool
+CompareTotalTime (const EventProfiler::Entry &entry, const EventProfiler::Entry &other)
+{
+  return entry.time > other.time;
+}
+
+} // unnamed namespace
+
+TypeId
+EventProfiler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::EventProfiler")
+    .SetParent<Object> ()
+    .SetGroupName ("Core")
+    .AddConstructor<EventProfiler> ()
+    .AddAttribute ("QueueSizeSamplingInterval",
+                   "Interval of simulation time between two samples of the size "
+                   "of the event queue. If zero, the size is sampled at every event.",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&EventProfiler::m_samplingInterval),
+                   MakeTimeChecker (Time (0)))
+    .AddAttribute ("OutputFilename",
+                   "Name of the file where the profile is written when the "
+                   "simulator is destroyed. If empty, the profile is printed "
+                   "to the standard output.",
+                   StringValue (""),
+                   MakeStringAccessor (&EventProfiler::m_outputFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("QueueSizeFilename",
+                   "Name of the file where the samples of the size of the event "
+                   "queue are written when the simulator is destroyed. If empty, "
+                   "the samples are not written.",
+                   StringValue (""),
+                   MakeStringAccessor (&EventProfiler::m_queueSizeFilename),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+EventProfiler::EventProfiler ()
+  : m_cancelled (0),
+    m_maxQueueSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+EventProfiler::~EventProfiler ()
+{
+}
+
+void
+EventProfiler::Invoke (EventImpl *event, const Time &now, uint32_t queueSize)
+{
+  if (now >= m_nextSample)
+    {
+      QueueSizeSample sample;
+      sample.time = now;
+      sample.size = queueSize;
+      m_queueSizeSamples.push_back (sample);
+      m_nextSample = now + m_samplingInterval;
+    }
+  m_maxQueueSize = std::max (m_maxQueueSize, queueSize);
+
+  if (event->IsCancelled ())
+    {
+      m_cancelled++;
+      return;
+    }
+
+  // identify the event before invoking it, as it may destroy its object;
+  // events without a known function are grouped by their type
+  const void *function = event->GetFunction ();
+  const std::type_info *type = &typeid (*event);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  event->Invoke ();
+  uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds> (
+      std::chrono::steady_clock::now () - start).count ();
+
+  Stats &stats = m_stats[function != 0 ? function : type];
+  if (stats.count == 0)
+    {
+      stats.type = type;
+    }
+  stats.count++;
+  stats.nanoseconds += nanoseconds;
+  stats.maxNanoseconds = std::max (stats.maxNanoseconds, nanoseconds);
+  uint32_t bucket = 0;
+  while (nanoseconds > 0)
+    {
+      nanoseconds >>= 1;
+      bucket++;
+    }
+  if (stats.histogram.size () <= bucket)
+    {
+      stats.histogram.resize (bucket + 1, 0);
+    }
+  stats.histogram[bucket]++;
+}
+
+std::string
+EventProfiler::GetName (const void *function, const Stats &stats)
+{
+#ifdef HAVE_DLADDR
+  Dl_info info;
+  if (function != stats.type && dladdr (function, &info) != 0 && info.dli_sname != 0
+      && info.dli_saddr == function)
+    {
+      return Demangle (info.dli_sname);
+    }
+#endif
+  // the function has no symbol, e.g., it is not exported by the executable
+  return Demangle (stats.type->name ());
+}
+
+std::vector<EventProfiler::Entry>
+EventProfiler::GetEntries (void) const
+{
+  std::vector<Entry> entries;
+  for (std::map<const void *, Stats>::const_iterator it = m_stats.begin (); it != m_stats.end (); ++it)
+    {
+      Entry entry;
+      entry.name = GetName (it->first, it->second);
+      entry.count = it->second.count;
+      entry.time = it->second.nanoseconds * 1e-9;
+      entry.maxTime = it->second.maxNanoseconds * 1e-9;
+      entry.histogram = it->second.histogram;
+      entries.push_back (entry);
+    }
+  std::stable_sort (entries.begin (), entries.end (), CompareTotalTime);
+  return entries;
+}
+
+uint64_t
+EventProfiler::GetCancelledCount (void) const
+{
+  return m_cancelled;
+}
+
+const std::vector<EventProfiler::QueueSizeSample> &
+EventProfiler::GetQueueSizeSamples (void) const
+{
+  return m_queueSizeSamples;
+}
+
+uint32_t
+EventProfiler::GetMaxQueueSize (void) const
+{
+  return m_maxQueueSize;
+}
+
+void
+EventProfiler::Print (std::ostream &os) const
+{
+  std::vector<Entry> entries = GetEntries ();
+  uint64_t count = 0;
+  double time = 0;
+  for (std::vector<Entry>::const_iterator it = entries.begin (); it != entries.end (); ++it)
+    {
+      count += it->count;
+      time += it->time;
+    }
+  double meanQueueSize = 0;
+  for (std::vector<QueueSizeSample>::const_iterator it = m_queueSizeSamples.begin ();
+       it != m_queueSizeSamples.end (); ++it)
+    {
+      meanQueueSize += it->size;
+    }
+  if (!m_queueSizeSamples.empty ())
+    {
+      meanQueueSize /= m_queueSizeSamples.size ();
+    }
+
+  std::ios_base::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+  os << std::fixed << std::setprecision (3)
+     << "Events: " << count << " invoked in " << time << " s, "
+     << m_cancelled << " cancelled" << std::endl
+     << "Queue size: max " << m_maxQueueSize << ", mean " << meanQueueSize
+     << " over " << m_queueSizeSamples.size () << " samples" << std::endl
+     << std::right << std::setw (12) << "count" << std::setw (12) << "total [s]"
+     << std::setw (8) << "%" << std::setw (12) << "mean [us]" << std::setw (12) << "max [us]"
+     << "  function" << std::endl;
+  for (std::vector<Entry>::const_iterator it = entries.begin (); it != entries.end (); ++it)
+    {
+      os << std::setw (12) << it->count << std::setw (12) << it->time
+         << std::setw (8) << std::setprecision (1) << (time > 0 ? it->time / time * 100 : 0)
+         << std::setprecision (3) << std::setw (12) << it->time / it->count * 1e6
+         << std::setw (12) << it->maxTime * 1e6 << "  " << it->name << std::endl;
+    }
+  os.flags (flags);
+  os.precision (precision);
+}
+
+void
+EventProfiler::Report (void) const
+{
+  NS_LOG_FUNCTION (this);
+  if (m_outputFilename.empty ())
+    {
+      Print (std::cout);
+    }
+  else
+    {
+      std::ofstream os (m_outputFilename.c_str ());
+      if (!os.is_open ())
+        {
+          NS_LOG_ERROR ("Can't open file " << m_outputFilename);
+        }
+      else
+        {
+          Print (os);
+        }
+    }
+
+  if (!m_queueSizeFilename.empty ())
+    {
+      std::ofstream os (m_queueSizeFilename.c_str ());
+      if (!os.is_open ())
+        {
+          NS_LOG_ERROR ("Can't open file " << m_queueSizeFilename);
+          return;
+        }
+      for (std::vector<QueueSizeSample>::const_iterator it = m_queueSizeSamples.begin ();
+           it != m_queueSizeSamples.end (); ++it)
+        {
+          os << it->time.GetSeconds () << "\t" << it->size << std::endl;
+        }
+    }
+}
+
+void
+EventProfiler::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stats.clear ();
+  m_cancelled = 0;
+  m_queueSizeSamples.clear ();
+  m_maxQueueSize = 0;
+  m_nextSample = Time (0);
+}
+
+} // namespace ns3
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "object.h"
+#include "nstime.h"
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup events
+ *
+ * Profile of the events processed by the simulator.
+ *
+ * The events are grouped by the function or method they invoke, as
+ * returned by EventImpl::GetFunction. For each function, the profiler
+ * counts the events and measures the wall-clock time spent in them, with
+ * a histogram of the durations in power-of-two buckets of nanoseconds.
+ * The size of the event queue is sampled every QueueSizeSamplingInterval
+ * of simulation time.
+ *
+ * The profiler is created by DefaultSimulatorImpl when its EventProfiling
+ * attribute is true. The profile is available through
+ * DefaultSimulatorImpl::GetEventProfiler until the simulator is destroyed,
+ * when it is reported.
+ */
+class EventProfiler : public Object
+{
+public:
+  /**
+   * Profile of the events invoking the same function
+   */
+  struct Entry
+  {
+    std::string name;                 //!< name of the function
+    uint64_t count;                   //!< number of events
+    double time;                      //!< total wall-clock time, in seconds
+    double maxTime;                   //!< longest event, in seconds
+    std::vector<uint64_t> histogram;  //!< number of events lasting [2^(i-1), 2^i) ns
+  };
+
+  /**
+   * Size of the event queue at a given simulation time
+   */
+  struct QueueSizeSample
+  {
+    Time time;     //!< simulation time
+    uint32_t size; //!< number of events in the queue
+  };
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  EventProfiler ();
+  virtual ~EventProfiler ();
+
+  /**
+   * \brief Invoke an event and add it to the profile
+   * \param event the event
+   * \param now the current simulation time
+   * \param queueSize the number of events left in the queue
+   */
+  void Invoke (EventImpl *event, const Time &now, uint32_t queueSize);
+
+  /**
+   * \return the profile of the invoked functions, sorted by decreasing total time
+   */
+  std::vector<Entry> GetEntries (void) const;
+  /**
+   * \return the number of cancelled events, which are not invoked
+   */
+  uint64_t GetCancelledCount (void) const;
+  /**
+   * \return the samples of the size of the event queue
+   */
+  const std::vector<QueueSizeSample> & GetQueueSizeSamples (void) const;
+  /**
+   * \return the largest size of the event queue
+   */
+  uint32_t GetMaxQueueSize (void) const;
+
+  /**
+   * \brief Print the profile
+   * \param os the output stream
+   */
+  void Print (std::ostream &os) const;
+  /**
+   * \brief Print the profile to the file set by the OutputFilename attribute,
+   * and the queue size samples to the file set by QueueSizeFilename
+   */
+  void Report (void) const;
+  /**
+   * \brief Discard the profile
+   */
+  void Clear (void);
+
+private:
+  /**
+   * Profile of the events invoking the same function, as it is collected
+   */
+  struct Stats
+  {
+    const std::type_info *type;       //!< type of the first event, to name the function if it has no symbol
+    uint64_t count;                   //!< number of events
+    uint64_t nanoseconds;             //!< total duration
+    uint64_t maxNanoseconds;          //!< longest duration
+    std::vector<uint64_t> histogram;  //!< durations, in power-of-two buckets
+  };
+
+  /**
+   * \param function the address of a function, or 0
+   * \param stats the profile of the function
+   * \return the name of the function
+   */
+  static std::string GetName (const void *function, const Stats &stats);
+
+  std::map<const void *, Stats> m_stats;               //!< profile, by address of the function
+  uint64_t m_cancelled;                                //!< number of cancelled events
+  std::vector<QueueSizeSample> m_queueSizeSamples;     //!< samples of the size of the event queue
+  uint32_t m_maxQueueSize;                             //!< largest size of the event queue
+  Time m_nextSample;                                   //!< time of the next queue size sample
+  Time m_samplingInterval;                             //!< interval between the queue size samples
+  std::string m_outputFilename;                        //!< file of the report, standard output if empty
+  std::string m_queueSizeFilename;                     //!< file of the queue size samples, not written if empty
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "four-ary-heap-scheduler.h"
+#include "event-impl.h"
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdlib.h>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::FourAryHeapScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FourAryHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (FourAryHeapScheduler);
+
+namespace {
+
+/** Size of a cache line, in bytes. */
+const std::size_t CACHE_LINE_SIZE = 64;
+/** Initial capacity of the heap, in nodes. */
+const std::size_t INITIAL_CAPACITY = 64;
+
+} // unnamed namespace
+
+const std::size_t FourAryHeapScheduler::ROOT;
+
+TypeId
+FourAryHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FourAryHeapScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<FourAryHeapScheduler> ()
+  ;
+  return tid;
+}
+
+FourAryHeapScheduler::FourAryHeapScheduler ()
+  : m_heap (0),
+    m_end (ROOT),
+    m_capacity (0)
+{
+  NS_LOG_FUNCTION (this);
+  Grow ();
+}
+
+FourAryHeapScheduler::~FourAryHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  free (m_heap);
+}
+
+bool
+FourAryHeapScheduler::IsLess (const Node &a, const Node &b)
+{
+  return (a.ts < b.ts) | ((a.ts == b.ts) & (a.uid < b.uid));
+}
+
+void
+FourAryHeapScheduler::Grow (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::size_t capacity = m_capacity == 0 ? INITIAL_CAPACITY : 2 * m_capacity;
+  void *heap = 0;
+  int error = posix_memalign (&heap, CACHE_LINE_SIZE, capacity * sizeof (Node));
+  NS_ABORT_MSG_IF (error != 0, "Can't allocate a heap of " << capacity << " events");
+  if (m_heap != 0)
+    {
+      std::memcpy (heap, m_heap, m_end * sizeof (Node));
+      free (m_heap);
+    }
+  m_heap = static_cast<Node *> (heap);
+  m_capacity = capacity;
+}
+
+Scheduler::Event
+FourAryHeapScheduler::GetEvent (const Node &node)
+{
+  Scheduler::Event ev;
+  ev.impl = node.impl;
+  ev.key.m_ts = node.ts;
+  ev.key.m_uid = node.uid;
+  ev.key.m_context = node.context;
+  return ev;
+}
+
+void
+FourAryHeapScheduler::BottomUp (std::size_t index, Node node)
+{
+  while (index > ROOT)
+    {
+      std::size_t parent = index / 4 + 2;
+      if (!IsLess (node, m_heap[parent]))
+        {
+          break;
+        }
+      m_heap[index] = m_heap[parent];
+      index = parent;
+    }
+  m_heap[index] = node;
+}
+
+void
+FourAryHeapScheduler::TopDown (std::size_t index, Node node)
+{
+  // move the hole down to a leaf, along the smallest children, and then
+  // the node up from there: the node usually comes from the bottom of the
+  // heap, so this saves comparing it with the children at each level
+  while (true)
+    {
+      std::size_t child = 4 * index - 8;
+      std::size_t smallest = child;
+      if (child + 4 <= m_end)
+        {
+          std::size_t other = IsLess (m_heap[child + 1], m_heap[child]) ? child + 1 : child;
+          smallest = IsLess (m_heap[child + 3], m_heap[child + 2]) ? child + 3 : child + 2;
+          smallest = IsLess (m_heap[other], m_heap[smallest]) ? other : smallest;
+        }
+      else if (child < m_end)
+        {
+          for (++child; child < m_end; ++child)
+            {
+              if (IsLess (m_heap[child], m_heap[smallest]))
+                {
+                  smallest = child;
+                }
+            }
+        }
+      else
+        {
+          break;
+        }
+      m_heap[index] = m_heap[smallest];
+      index = smallest;
+    }
+  BottomUp (index, node);
+}
+
+void
+FourAryHeapScheduler::Insert (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  if (m_end == m_capacity)
+    {
+      Grow ();
+    }
+
+  Node node;
+  node.ts = ev.key.m_ts;
+  node.impl = ev.impl;
+  node.uid = ev.key.m_uid;
+  node.context = ev.key.m_context;
+  BottomUp (m_end++, node);
+}
+
+bool
+FourAryHeapScheduler::IsEmpty (void) const
+{
+  return m_end == ROOT;
+}
+
+Scheduler::Event
+FourAryHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return GetEvent (m_heap[ROOT]);
+}
+
+Scheduler::Event
+FourAryHeapScheduler::RemoveAt (std::size_t index)
+{
+  Scheduler::Event ev = GetEvent (m_heap[index]);
+
+  m_end--;
+  if (index != m_end)
+    {
+      Node last = m_heap[m_end];
+      if (index > ROOT && IsLess (last, m_heap[index / 4 + 2]))
+        {
+          BottomUp (index, last);
+        }
+      else
+        {
+          TopDown (index, last);
+        }
+    }
+  return ev;
+}
+
+Scheduler::Event
+FourAryHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return RemoveAt (ROOT);
+}
+
+void
+FourAryHeapScheduler::Remove (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  std::size_t index = ROOT;
+  while (index < m_end && m_heap[index].uid != ev.key.m_uid)
+    {
+      index++;
+    }
+  NS_ASSERT (index < m_end);
+  RemoveAt (index);
+}
+
+} // namespace ns3
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FOUR_ARY_HEAP_SCHEDULER_H
+#define FOUR_ARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::FourAryHeapScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a cache-aligned 4-ary heap event scheduler
+ *
+ * The events are held by value in a single array aligned to a cache line,
+ * with the root at index 3, so that the children of the node at index \c i
+ * are at indexes `4 i - 8` to `4 i - 5`: the four children of a node are
+ * contiguous, and each node is 24 bytes, so that the children span at most
+ * two cache lines.
+ *
+ * Compared to the binary HeapScheduler, the heap is half as deep, and
+ * reading the children of a node while percolating down costs at most
+ * two cache misses. When the root is removed, the hole is moved down to a
+ * leaf along the smallest children, and the last event is moved up from
+ * there, which saves most of the comparisons with the last event, as it
+ * usually belongs near the bottom of the heap.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Logarithmic     | Heapify
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Heap kept sorted
+ * Remove()     | Linear          | Search, heapify
+ * RemoveNext() | Logarithmic     | Heapify
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 72 bytes + 3 x `sizeof (*)`      | Nodes before the root, array
+ * Per Event | 24 bytes                         | Heap node
+ */
+class FourAryHeapScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  FourAryHeapScheduler ();
+  /** Destructor. */
+  virtual ~FourAryHeapScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Node of the heap, ordered by time stamp and unique id. */
+  struct Node
+  {
+    uint64_t ts;       /**< Event time stamp. */
+    EventImpl *impl;   /**< Pointer to the event implementation. */
+    uint32_t uid;      /**< Event unique id. */
+    uint32_t context;  /**< Event context. */
+  };
+
+  /** Index of the root of the heap. */
+  static const std::size_t ROOT = 3;
+
+  /**
+   * Compare (less than) two nodes.
+   *
+   * \param [in] a The first node.
+   * \param [in] b The second node.
+   * \returns \c true if \c a < \c b
+   */
+  static inline bool IsLess (const Node &a, const Node &b);
+  /**
+   * Rebuild the event held by a node.
+   *
+   * \param [in] node The node.
+   * \returns The event.
+   */
+  static Scheduler::Event GetEvent (const Node &node);
+  /**
+   * Remove a node from the heap.
+   *
+   * \param [in] index The index of the node.
+   * \returns The event held by the node.
+   */
+  Scheduler::Event RemoveAt (std::size_t index);
+  /**
+   * Percolate a node up the heap.
+   *
+   * \param [in] index The index of the node.
+   * \param [in] node The node.
+   */
+  void BottomUp (std::size_t index, Node node);
+  /**
+   * Percolate a node down the heap, from a node which is not smaller
+   * than the parent of \c index.
+   *
+   * \param [in] index The index of the node.
+   * \param [in] node The node.
+   */
+  void TopDown (std::size_t index, Node node);
+  /** Double the capacity of the heap. */
+  void Grow (void);
+
+  /** The heap, aligned to a cache line. */
+  Node *m_heap;
+  /** Index after the last node of the heap. */
+  std::size_t m_end;
+  /** Number of nodes the heap can hold, including the unused ones before the root. */
+  std::size_t m_capacity;
+};
+
+} // namespace ns3
+
+#endif /* FOUR_ARY_HEAP_SCHEDULER_H */
@@ -236,7 +236,17 @@ HeapScheduler::Remove (const Event &ev)
           NS_ASSERT (m_heap[i].impl == ev.impl);
           Exch (i, Last ());
           m_heap.pop_back ();
-          TopDown (i);
+          if (i < m_heap.size ())
+            {
+              // the event moved in place of the removed one may be
+              // smaller than its new parent
+              while (!IsRoot (i) && IsLessStrictly (i, Parent (i)))
+                {
+                  Exch (i, Parent (i));
+                  i = Parent (i);
+                }
+              TopDown (i);
+            }
           return;
         }
     }
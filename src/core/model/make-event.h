@@ -317,6 +317,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
 #include "event-impl.h"
 #include "type-traits.h"
 
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
 namespace ns3 {
 
 /**
@@ -355,6 +359,49 @@ struct EventMemberImplObjTraits<T *>
   }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Get the address of the code run by a class method when it is invoked on
+ * an object, resolving virtual methods through the object's vtable.
+ *
+ * The member function pointer is decoded according to the Itanium C++ ABI
+ * on x86; on other platforms the address is not known.
+ *
+ * \tparam C \deduced The class of the method.
+ * \tparam F \deduced The method signature.
+ * \tparam T \deduced The class of the object.
+ * \param [in] mem_ptr Class method member function pointer
+ * \param [in] obj Class instance.
+ * \returns The address of the code, or 0 if it is not known.
+ */
+template <typename C, typename F, typename T>
+const void * GetEventMemberFunction (F C::*mem_ptr, const T &obj)
+{
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+  struct
+  {
+    uintptr_t ptr;
+    ptrdiff_t adj;
+  } pmf;
+  if (sizeof (mem_ptr) != sizeof (pmf))
+    {
+      return 0;
+    }
+  std::memcpy (&pmf, &mem_ptr, sizeof (pmf));
+  if (pmf.ptr & 1)
+    {
+      // virtual method: ptr - 1 is the offset of the method in the vtable
+      const C *base = &obj;
+      const char *self = reinterpret_cast<const char *> (base) + pmf.adj;
+      const char *vtable = *reinterpret_cast<const char * const *> (self);
+      return *reinterpret_cast<const void * const *> (vtable + pmf.ptr - 1);
+    }
+  return reinterpret_cast<const void *> (pmf.ptr);
+#else
+  return 0;
+#endif
+}
+
 template <typename MEM, typename OBJ>
 EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
 {
@@ -374,6 +421,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)();
     }
+    virtual const void * GetFunction (void) const
+    {
+      return GetEventMemberFunction (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
   } *ev = new EventMemberImpl0 (obj, mem_ptr);
@@ -404,6 +455,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return GetEventMemberFunction (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -435,6 +490,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return GetEventMemberFunction (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -468,6 +527,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return GetEventMemberFunction (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -503,6 +566,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return GetEventMemberFunction (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -541,6 +608,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return GetEventMemberFunction (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -581,6 +652,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return GetEventMemberFunction (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -616,6 +691,10 @@ EventImpl * MakeEvent (void (*f)(U1), T1 a1)
     {
       (*m_function)(m_a1);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventFunctionImpl1 (f, a1);
@@ -646,6 +725,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2), T1 a1, T2 a2)
     {
       (*m_function)(m_a1, m_a2);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -679,6 +762,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3), T1 a1, T2 a2, T3 a3)
     {
       (*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -714,6 +801,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4), T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -751,6 +842,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -790,6 +885,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -0,0 +1,379 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "perf-counters.h"
+#include "abort.h"
+#include "enum.h"
+#include "log.h"
+#include "simulator.h"
+#include "string.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup perf-counters
+ * ns3::PerfCounter and ns3::PerfCounters implementations.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PerfCounters");
+
+NS_OBJECT_ENSURE_REGISTERED (PerfCounters);
+
+bool PerfCounters::m_useTsc = false;
+bool PerfCounters::m_armed = false;
+
+PerfCounter::PerfCounter (std::string module, std::string name)
+  : m_module (module),
+    m_name (name),
+    m_enabled (true),
+    m_count (0),
+    m_ticks (0),
+    m_maxTicks (0)
+{
+}
+
+TypeId
+PerfCounters::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::PerfCounters")
+    .SetParent<Object> ()
+    .SetGroupName ("Core")
+    .AddConstructor<PerfCounters> ()
+    .AddAttribute ("Modules",
+                   "Comma-separated list of the modules whose counters are enabled, "
+                   "\"all\" or \"none\". A module prefixed by '-' is disabled, e.g., "
+                   "\"all,-spectrum\".",
+                   StringValue ("all"),
+                   MakeStringAccessor (&PerfCounters::SetModules,
+                                       &PerfCounters::GetModules),
+                   MakeStringChecker ())
+    .AddAttribute ("Format",
+                   "Format of the report printed when the simulator is destroyed.",
+                   EnumValue (PerfCounters::TABLE),
+                   MakeEnumAccessor (&PerfCounters::m_format),
+                   MakeEnumChecker (PerfCounters::TABLE, "Table",
+                                    PerfCounters::JSON, "Json"))
+    .AddAttribute ("OutputFilename",
+                   "Name of the file where the report is written. If empty, the "
+                   "report is printed to the standard output.",
+                   StringValue (""),
+                   MakeStringAccessor (&PerfCounters::m_outputFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("Clock",
+                   "Clock used by the timers. The time-stamp counter is cheaper to "
+                   "read, but it is only available on x86 processors.",
+                   EnumValue (PerfCounters::STEADY_CLOCK),
+                   MakeEnumAccessor (&PerfCounters::SetClock,
+                                     &PerfCounters::GetClock),
+                   MakeEnumChecker (PerfCounters::STEADY_CLOCK, "SteadyClock",
+                                    PerfCounters::TSC, "Tsc"))
+  ;
+  return tid;
+}
+
+PerfCounters::PerfCounters ()
+  : m_allModules (true),
+    m_format (TABLE),
+    m_calibrationTime (std::chrono::steady_clock::now ()),
+    m_calibrationTicks (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PerfCounters::~PerfCounters ()
+{
+}
+
+void
+PerfCounters::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Object::DoDispose ();
+}
+
+Ptr<PerfCounters>
+PerfCounters::Get (void)
+{
+  static Ptr<PerfCounters> instance = CreateObject<PerfCounters> ();
+  return instance;
+}
+
+PerfCounter *
+PerfCounters::Register (std::string module, std::string name)
+{
+  NS_LOG_FUNCTION (this << module << name);
+  std::pair<std::string, std::string> key (module, name);
+  std::map<std::pair<std::string, std::string>, PerfCounter>::iterator it = m_counters.find (key);
+  if (it == m_counters.end ())
+    {
+      it = m_counters.insert (std::make_pair (key, PerfCounter (module, name))).first;
+      it->second.m_enabled = IsModuleEnabled (module);
+    }
+  return &it->second;
+}
+
+void
+PerfCounters::SetModuleEnabled (std::string module, bool enabled)
+{
+  NS_LOG_FUNCTION (this << module << enabled);
+  if (enabled != m_allModules)
+    {
+      m_modules.insert (module);
+    }
+  else
+    {
+      m_modules.erase (module);
+    }
+
+  for (std::map<std::pair<std::string, std::string>, PerfCounter>::iterator it = m_counters.begin ();
+       it != m_counters.end (); ++it)
+    {
+      if (it->second.m_module == module)
+        {
+          it->second.m_enabled = enabled;
+        }
+    }
+}
+
+bool
+PerfCounters::IsModuleEnabled (std::string module) const
+{
+  bool listed = m_modules.find (module) != m_modules.end ();
+  return m_allModules ? !listed : listed;
+}
+
+void
+PerfCounters::SetModules (std::string modules)
+{
+  NS_LOG_FUNCTION (this << modules);
+  m_allModules = false;
+  m_modules.clear ();
+
+  std::istringstream ss (modules);
+  std::string module;
+  while (std::getline (ss, module, ','))
+    {
+      if (module.empty ())
+        {
+          continue;
+        }
+      if (module == "all" || module == "none")
+        {
+          m_allModules = (module == "all");
+          m_modules.clear ();
+        }
+      else if (module[0] == '-')
+        {
+          SetModuleEnabled (module.substr (1), false);
+        }
+      else
+        {
+          SetModuleEnabled (module, true);
+        }
+    }
+
+  for (std::map<std::pair<std::string, std::string>, PerfCounter>::iterator it = m_counters.begin ();
+       it != m_counters.end (); ++it)
+    {
+      it->second.m_enabled = IsModuleEnabled (it->second.m_module);
+    }
+}
+
+std::string
+PerfCounters::GetModules (void) const
+{
+  std::ostringstream os;
+  os << (m_allModules ? "all" : "none");
+  for (std::set<std::string>::const_iterator it = m_modules.begin (); it != m_modules.end (); ++it)
+    {
+      os << "," << (m_allModules ? "-" : "") << *it;
+    }
+  return os.str ();
+}
+
+void
+PerfCounters::SetClock (Clock clock)
+{
+  NS_LOG_FUNCTION (this << clock);
+#ifdef NS3_PERF_COUNTERS_HAVE_TSC
+  m_useTsc = (clock == TSC);
+  if (m_useTsc)
+    {
+      m_calibrationTime = std::chrono::steady_clock::now ();
+      m_calibrationTicks = __rdtsc ();
+    }
+#else
+  NS_ABORT_MSG_IF (clock == TSC, "The time-stamp counter is not available on this platform");
+#endif
+}
+
+PerfCounters::Clock
+PerfCounters::GetClock (void) const
+{
+  return m_useTsc ? TSC : STEADY_CLOCK;
+}
+
+double
+PerfCounters::GetSecondsPerTick (void) const
+{
+#ifdef NS3_PERF_COUNTERS_HAVE_TSC
+  if (m_useTsc)
+    {
+      // calibrate the TSC on the time elapsed since the clock was selected
+      uint64_t ticks = __rdtsc () - m_calibrationTicks;
+      double seconds = std::chrono::duration<double> (std::chrono::steady_clock::now ()
+                                                      - m_calibrationTime).count ();
+      return ticks > 0 ? seconds / ticks : 0;
+    }
+#endif
+  return 1e-9;
+}
+
+void
+PerfCounters::DoArmReport (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_armed = true;
+  Simulator::ScheduleDestroy (&PerfCounters::Report, this);
+}
+
+void
+PerfCounters::Print (std::ostream &os, Format format) const
+{
+  double secondsPerTick = GetSecondsPerTick ();
+
+  std::ios_base::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+  if (format == TABLE)
+    {
+      os << std::left << std::setw (12) << "module" << std::right
+         << std::setw (14) << "count" << std::setw (14) << "total [ms]"
+         << std::setw (12) << "mean [us]" << std::setw (12) << "max [us]" << "  counter\n";
+    }
+  else
+    {
+      os << "{\n  \"counters\" : [";
+    }
+
+  bool first = true;
+  os << std::fixed;
+  for (std::map<std::pair<std::string, std::string>, PerfCounter>::const_iterator it = m_counters.begin ();
+       it != m_counters.end (); ++it)
+    {
+      const PerfCounter &counter = it->second;
+      if (counter.m_count == 0)
+        {
+          continue;
+        }
+      double total = counter.m_ticks * secondsPerTick;
+      double mean = total / counter.m_count;
+      double max = counter.m_maxTicks * secondsPerTick;
+      if (format == TABLE)
+        {
+          os << std::left << std::setw (12) << counter.m_module
+             << std::right << std::setw (14) << counter.m_count
+             << std::setprecision (3) << std::setw (14) << total * 1e3
+             << std::setw (12) << mean * 1e6 << std::setw (12) << max * 1e6
+             << "  " << counter.m_name << "\n";
+        }
+      else
+        {
+          os << (first ? "\n" : ",\n") << std::setprecision (9)
+             << "    { \"module\" : \"" << counter.m_module << "\", \"name\" : \"" << counter.m_name
+             << "\", \"count\" : " << counter.m_count << ", \"total\" : " << total
+             << ", \"max\" : " << max << " }";
+        }
+      first = false;
+    }
+
+  if (format == JSON)
+    {
+      os << "\n  ]\n}\n";
+    }
+  os.flags (flags);
+  os.precision (precision);
+}
+
+void
+PerfCounters::Report (void)
+{
+  NS_LOG_FUNCTION (this);
+  bool empty = true;
+  for (std::map<std::pair<std::string, std::string>, PerfCounter>::const_iterator it = m_counters.begin ();
+       it != m_counters.end (); ++it)
+    {
+      empty &= (it->second.m_count == 0);
+    }
+  if (empty)
+    {
+      NS_LOG_LOGIC ("Nothing to report");
+    }
+  else if (m_outputFilename.empty ())
+    {
+      Print (std::cout, m_format);
+    }
+  else
+    {
+      std::ofstream os (m_outputFilename.c_str (), std::ios_base::app);
+      if (!os.is_open ())
+        {
+          NS_LOG_ERROR ("Can't open file " << m_outputFilename);
+        }
+      else
+        {
+          Print (os, m_format);
+        }
+    }
+  Reset ();
+  m_armed = false;
+}
+
+void
+PerfCounters::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::map<std::pair<std::string, std::string>, PerfCounter>::iterator it = m_counters.begin ();
+       it != m_counters.end (); ++it)
+    {
+      it->second.m_count = 0;
+      it->second.m_ticks = 0;
+      it->second.m_maxTicks = 0;
+    }
+}
+
+uint64_t
+PerfCounters::GetCount (std::string module, std::string name) const
+{
+  std::map<std::pair<std::string, std::string>, PerfCounter>::const_iterator it =
+    m_counters.find (std::make_pair (module, name));
+  return it != m_counters.end () ? it->second.m_count : 0;
+}
+
+double
+PerfCounters::GetTotalTime (std::string module, std::string name) const
+{
+  std::map<std::pair<std::string, std::string>, PerfCounter>::const_iterator it =
+    m_counters.find (std::make_pair (module, name));
+  return it != m_counters.end () ? it->second.m_ticks * GetSecondsPerTick () : 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,369 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include "object.h"
+#include "ptr.h"
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+
+#if defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h>
+#define NS3_PERF_COUNTERS_HAVE_TSC
+#endif
+
+/**
+ * \file
+ * \ingroup perf-counters
+ * ns3::PerfCounter, ns3::PerfScopedTimer and ns3::PerfCounters declarations,
+ * and the instrumentation macros.
+ */
+
+/**
+ * \ingroup core
+ * \defgroup perf-counters Performance counters
+ *
+ * Lightweight instrumentation of the hot paths of the models.
+ *
+ * Instrumented code uses NS_PERF_TIMER to measure the time spent in a scope,
+ * and NS_PERF_COUNT to count occurrences, under a counter identified by a
+ * module and a name. The macros are compiled only if ns-3 is configured
+ * with \c --enable-perf-counters, otherwise they expand to nothing.
+ *
+ * The counters of each module can be enabled or disabled at runtime with
+ * the Modules attribute of ns3::PerfCounters. The counters are printed,
+ * either as a table or in JSON, and reset when the simulator is destroyed.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup perf-counters
+ *
+ * Number of calls and time spent in an instrumented scope
+ */
+class PerfCounter
+{
+public:
+  /**
+   * Constructor
+   * \param module the module of the counter
+   * \param name the name of the counter
+   */
+  PerfCounter (std::string module, std::string name);
+
+  /**
+   * \return true if the module of the counter is enabled
+   */
+  bool IsEnabled (void) const
+  {
+    return m_enabled;
+  }
+  /**
+   * \brief Count occurrences, without timing them
+   * \param n the number of occurrences
+   */
+  void Increment (uint64_t n = 1)
+  {
+    m_count += n;
+  }
+  /**
+   * \brief Count one occurrence, with its duration
+   * \param ticks the duration, in ticks of PerfCounters::GetTicks
+   */
+  void AddSample (uint64_t ticks)
+  {
+    m_count++;
+    m_ticks += ticks;
+    if (ticks > m_maxTicks)
+      {
+        m_maxTicks = ticks;
+      }
+  }
+
+  std::string m_module; //!< module of the counter
+  std::string m_name;   //!< name of the counter
+  bool m_enabled;       //!< true if the module of the counter is enabled
+  uint64_t m_count;     //!< number of occurrences
+  uint64_t m_ticks;     //!< total duration of the timed occurrences
+  uint64_t m_maxTicks;  //!< longest duration of a timed occurrence
+};
+
+/**
+ * \ingroup perf-counters
+ *
+ * Registry and report of the performance counters
+ *
+ * A single instance exists, created with the default values of the
+ * attributes the first time a counter is registered or the instance is
+ * requested.
+ */
+class PerfCounters : public Object
+{
+public:
+  /**
+   * Format of the report
+   */
+  enum Format
+  {
+    TABLE, //!< aligned text table
+    JSON   //!< JSON object
+  };
+
+  /**
+   * Clock used by the scoped timers
+   */
+  enum Clock
+  {
+    STEADY_CLOCK, //!< std::chrono::steady_clock
+    TSC           //!< time-stamp counter of x86 processors, calibrated on the steady clock
+  };
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  PerfCounters ();
+  virtual ~PerfCounters ();
+
+  /**
+   * \return the registry of the counters
+   */
+  static Ptr<PerfCounters> Get (void);
+
+  /**
+   * \brief Get a counter, creating it if needed
+   *
+   * The returned pointer remains valid for the lifetime of the process.
+   *
+   * \param module the module of the counter
+   * \param name the name of the counter
+   * \return the counter
+   */
+  PerfCounter * Register (std::string module, std::string name);
+
+  /**
+   * \brief Enable or disable the counters of a module
+   * \param module the module
+   * \param enabled true to enable the counters
+   */
+  void SetModuleEnabled (std::string module, bool enabled);
+  /**
+   * \param module the module
+   * \return true if the counters of the module are enabled
+   */
+  bool IsModuleEnabled (std::string module) const;
+
+  /**
+   * \brief Print the counters with at least one occurrence
+   * \param os the output stream
+   * \param format the format of the report
+   */
+  void Print (std::ostream &os, Format format) const;
+  /**
+   * \brief Print the counters in the format and to the file set by the
+   * attributes, then reset them
+   */
+  void Report (void);
+  /**
+   * \brief Set the counters to zero
+   */
+  void Reset (void);
+
+  /**
+   * \param module the module of the counter
+   * \param name the name of the counter
+   * \return the number of occurrences of the counter, 0 if it does not exist
+   */
+  uint64_t GetCount (std::string module, std::string name) const;
+  /**
+   * \param module the module of the counter
+   * \param name the name of the counter
+   * \return the time spent in the counter, in seconds
+   */
+  double GetTotalTime (std::string module, std::string name) const;
+
+  /**
+   * \return the current time, in ticks of the clock in use
+   */
+  static uint64_t GetTicks (void)
+  {
+#ifdef NS3_PERF_COUNTERS_HAVE_TSC
+    if (m_useTsc)
+      {
+        return __rdtsc ();
+      }
+#endif
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (
+             std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+  }
+
+  /**
+   * \brief Make sure that the counters are reported when the current
+   * simulation is destroyed
+   */
+  static void ArmReport (void)
+  {
+    if (!m_armed)
+      {
+        Get ()->DoArmReport ();
+      }
+  }
+
+private:
+  virtual void DoDispose (void);
+
+  /**
+   * \brief Schedule the report at the destruction of the simulator
+   */
+  void DoArmReport (void);
+  /**
+   * \brief Set the modules to be enabled
+   * \param modules comma-separated list of modules, "all" or "none"
+   */
+  void SetModules (std::string modules);
+  /**
+   * \return the modules to be enabled
+   */
+  std::string GetModules (void) const;
+  /**
+   * \brief Set the clock used by the timers
+   * \param clock the clock
+   */
+  void SetClock (Clock clock);
+  /**
+   * \return the clock used by the timers
+   */
+  Clock GetClock (void) const;
+  /**
+   * \return the duration of a tick, in seconds
+   */
+  double GetSecondsPerTick (void) const;
+
+  std::map<std::pair<std::string, std::string>, PerfCounter> m_counters; //!< counters, by module and name
+  bool m_allModules;                  //!< true if the modules not in m_modules are enabled
+  std::set<std::string> m_modules;    //!< modules enabled, or disabled if m_allModules is true
+  Format m_format;                    //!< format of the report
+  std::string m_outputFilename;       //!< file where the report is written, standard output if empty
+  std::chrono::steady_clock::time_point m_calibrationTime; //!< steady clock time at the start of the TSC calibration
+  uint64_t m_calibrationTicks;        //!< TSC value at the start of the TSC calibration
+
+  static bool m_useTsc; //!< true if the timers use the TSC
+  static bool m_armed;  //!< true if the report is scheduled for the current simulation
+};
+
+/**
+ * \ingroup perf-counters
+ *
+ * Adds the time spent in a scope to a counter
+ */
+class PerfScopedTimer
+{
+public:
+  /**
+   * Start the timer, if the counter is enabled
+   * \param counter the counter
+   */
+  PerfScopedTimer (PerfCounter *counter)
+    : m_counter (counter),
+      m_start (0)
+  {
+    if (m_counter->IsEnabled ())
+      {
+        PerfCounters::ArmReport ();
+        m_start = PerfCounters::GetTicks ();
+      }
+  }
+
+  /**
+   * Stop the timer and update the counter
+   */
+  ~PerfScopedTimer ()
+  {
+    if (m_counter->IsEnabled ())
+      {
+        m_counter->AddSample (PerfCounters::GetTicks () - m_start);
+      }
+  }
+
+private:
+  PerfCounter *m_counter; //!< the counter
+  uint64_t m_start;       //!< ticks at the start of the scope
+};
+
+} // namespace ns3
+
+/**
+ * \ingroup perf-counters
+ * Concatenate two tokens after expanding them
+ */
+#define NS_PERF_CONCAT_IMPL(a, b) a ## b
+/**
+ * \ingroup perf-counters
+ * Concatenate two tokens after expanding them
+ */
+#define NS_PERF_CONCAT(a, b) NS_PERF_CONCAT_IMPL (a, b)
+
+#ifdef NS3_PERF_COUNTERS_ENABLE
+
+/**
+ * \ingroup perf-counters
+ * \brief Add the time spent from this point to the end of the enclosing
+ * scope to a counter
+ * \param module the module of the counter
+ * \param name the name of the counter
+ */
+#define NS_PERF_TIMER(module, name)                                        \
+  static ns3::PerfCounter * NS_PERF_CONCAT (ns3PerfCounter, __LINE__) =    \
+    ns3::PerfCounters::Get ()->Register (module, name);                    \
+  ns3::PerfScopedTimer NS_PERF_CONCAT (ns3PerfTimer, __LINE__) (           \
+    NS_PERF_CONCAT (ns3PerfCounter, __LINE__))
+
+/**
+ * \ingroup perf-counters
+ * \brief Count an occurrence, without timing it
+ * \param module the module of the counter
+ * \param name the name of the counter
+ */
+#define NS_PERF_COUNT(module, name)                                        \
+  do                                                                       \
+    {                                                                      \
+      static ns3::PerfCounter *ns3PerfCounter =                            \
+        ns3::PerfCounters::Get ()->Register (module, name);                \
+      if (ns3PerfCounter->IsEnabled ())                                    \
+        {                                                                  \
+          ns3::PerfCounters::ArmReport ();                                 \
+          ns3PerfCounter->Increment ();                                    \
+        }                                                                  \
+    }                                                                      \
+  while (false)
+
+#else /* NS3_PERF_COUNTERS_ENABLE */
+
+#define NS_PERF_TIMER(module, name)
+#define NS_PERF_COUNT(module, name)
+
+#endif /* NS3_PERF_COUNTERS_ENABLE */
+
+#endif /* PERF_COUNTERS_H */
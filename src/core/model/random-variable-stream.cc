@@ -37,6 +37,7 @@
 #include <cmath>
 #include <iostream>
 #include <algorithm>    // upper_bound
+#include <set>
 
 /**
  * \file
@@ -50,6 +51,26 @@ NS_LOG_COMPONENT_DEFINE ("RandomVariableStream");
 
 NS_OBJECT_ENSURE_REGISTERED (RandomVariableStream);
 
+namespace {
+
+/**
+ * \ingroup randomvariable
+ * Get the set of the existing random variables, for ReseedAll.
+ *
+ * The set is never deleted, so that the variables destroyed during the
+ * destruction of the static objects can still remove themselves.
+ *
+ * \returns The set of the existing random variables.
+ */
+std::set<RandomVariableStream *> &
+GetStreams (void)
+{
+  static std::set<RandomVariableStream *> *streams = new std::set<RandomVariableStream *> ();
+  return *streams;
+}
+
+} // unnamed namespace
+
 TypeId
 RandomVariableStream::GetTypeId (void)
 {
@@ -74,13 +95,16 @@ RandomVariableStream::GetTypeId (void)
 }
 
 RandomVariableStream::RandomVariableStream ()
-  : m_rng (0)
+  : m_rng (0),
+    m_streamIndex (0)
 {
   NS_LOG_FUNCTION (this);
+  GetStreams ().insert (this);
 }
 RandomVariableStream::~RandomVariableStream ()
 {
   NS_LOG_FUNCTION (this);
+  GetStreams ().erase (this);
   delete m_rng;
 }
 
@@ -109,22 +133,39 @@ RandomVariableStream::SetStream (int64_t stream)
       // number assignment.
       uint64_t nextStream = RngSeedManager::GetNextStreamIndex ();
       NS_ASSERT (nextStream <= ((1ULL) << 63));
-      m_rng = new RngStream (RngSeedManager::GetSeed (),
-                             nextStream,
-                             RngSeedManager::GetRun ());
+      m_streamIndex = nextStream;
     }
   else
     {
       // The last 2^63 streams are reserved for deterministic stream
       // number assignment.
       uint64_t base = ((1ULL) << 63);
-      uint64_t target = base + stream;
-      m_rng = new RngStream (RngSeedManager::GetSeed (),
-                             target,
-                             RngSeedManager::GetRun ());
+      m_streamIndex = base + stream;
     }
+  m_rng = new RngStream (RngSeedManager::GetSeed (),
+                         m_streamIndex,
+                         RngSeedManager::GetRun ());
   m_stream = stream;
 }
+void
+RandomVariableStream::ReseedAll (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::set<RandomVariableStream *> &streams = GetStreams ();
+  for (std::set<RandomVariableStream *>::iterator it = streams.begin (); it != streams.end (); ++it)
+    {
+      RandomVariableStream *stream = *it;
+      if (stream->m_rng == 0)
+        {
+          // the stream is not set yet
+          continue;
+        }
+      delete stream->m_rng;
+      stream->m_rng = new RngStream (RngSeedManager::GetSeed (),
+                                     stream->m_streamIndex,
+                                     RngSeedManager::GetRun ());
+    }
+}
 int64_t
 RandomVariableStream::GetStream (void) const
 {
@@ -125,6 +125,17 @@ public:
    */
   int64_t GetStream (void) const;
 
+  /**
+   * \brief Recreate the RngStream of all the existing random variables,
+   * in the substream of the current run.
+   *
+   * Each variable keeps its stream number, and starts drawing from the
+   * beginning of the substream set by RngSeedManager::SetRun. This is used
+   * after forking a simulation, see WarmStart, so that the processes
+   * continue with different random numbers.
+   */
+  static void ReseedAll (void);
+
   /**
    * \brief Specify whether antithetic values should be generated.
    * \param [in] isAntithetic If \c true antithetic value will be generated.
@@ -187,6 +198,9 @@ private:
   /** The stream number for the RngStream. */
   int64_t m_stream;
 
+  /** The index of the RngStream, including the automatically allocated ones. */
+  uint64_t m_streamIndex;
+
 };  // class RandomVariableStream
 
 
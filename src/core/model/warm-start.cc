@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "warm-start.h"
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+#include "random-variable-stream.h"
+#include "rng-seed-manager.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup warm-start
+ * ns3::WarmStart implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WarmStart");
+
+namespace {
+
+/** Write end of the pipe to the parent, in a child, or -1 in the parent. */
+int g_childFd = -1;
+/** Outcome of the children of the last Fork. */
+std::vector<WarmStart::Result> g_results;
+
+/** A running child, seen from the parent. */
+struct RunningChild
+{
+  pid_t pid;                  //!< Process id.
+  int fd;                     //!< Read end of the pipe from the child.
+  WarmStart::Result result;   //!< Outcome of the child.
+};
+
+/** Flush the standard streams, before forking or exiting. */
+void
+FlushStreams (void)
+{
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::clog.flush ();
+  std::fflush (0);
+}
+
+/**
+ * Read the data available from a child.
+ *
+ * \param [in,out] child The child.
+ * \returns \c true once the child closed the pipe.
+ */
+bool
+ReadFromChild (RunningChild &child)
+{
+  char buffer[65536];
+  ssize_t n = read (child.fd, buffer, sizeof (buffer));
+  if (n < 0)
+    {
+      NS_ABORT_MSG_IF (errno != EINTR && errno != EAGAIN,
+                       "Can't read from child " << child.result.child << ": " << std::strerror (errno));
+      return false;
+    }
+  if (n == 0)
+    {
+      return true;
+    }
+  child.result.output.append (buffer, n);
+  return false;
+}
+
+} // unnamed namespace
+
+int32_t
+WarmStart::Fork (uint32_t nChildren, uint32_t maxChildren)
+{
+  NS_LOG_FUNCTION (nChildren << maxChildren);
+  NS_ABORT_MSG_IF (IsChild (), "Fork called in a child");
+  if (maxChildren == 0)
+    {
+      long processors = sysconf (_SC_NPROCESSORS_ONLN);
+      maxChildren = processors > 0 ? processors : 1;
+    }
+
+  g_results.clear ();
+  std::vector<RunningChild> running;
+  uint32_t next = 0;
+  while (next < nChildren || !running.empty ())
+    {
+      while (next < nChildren && running.size () < maxChildren)
+        {
+          int fds[2];
+          NS_ABORT_MSG_IF (pipe (fds) != 0, "Can't create a pipe: " << std::strerror (errno));
+          FlushStreams ();
+          pid_t pid = fork ();
+          NS_ABORT_MSG_IF (pid < 0, "Can't fork: " << std::strerror (errno));
+          if (pid == 0)
+            {
+              // the child does not read the pipes of its siblings
+              close (fds[0]);
+              for (std::vector<RunningChild>::const_iterator it = running.begin (); it != running.end (); ++it)
+                {
+                  close (it->fd);
+                }
+              g_childFd = fds[1];
+              NS_LOG_LOGIC ("child " << next << " forked");
+              return next;
+            }
+          close (fds[1]);
+          RunningChild child;
+          child.pid = pid;
+          child.fd = fds[0];
+          child.result.child = next;
+          child.result.status = 0;
+          running.push_back (child);
+          next++;
+        }
+
+      // read what the children report, so that they do not block on a full
+      // pipe, until one of them exits
+      std::vector<struct pollfd> fds (running.size ());
+      for (std::size_t i = 0; i < running.size (); i++)
+        {
+          fds[i].fd = running[i].fd;
+          fds[i].events = POLLIN;
+          fds[i].revents = 0;
+        }
+      if (poll (fds.data (), fds.size (), -1) < 0)
+        {
+          NS_ABORT_MSG_IF (errno != EINTR, "Can't poll the children: " << std::strerror (errno));
+          continue;
+        }
+      for (std::size_t i = running.size (); i-- > 0; )
+        {
+          if (fds[i].revents == 0 || !ReadFromChild (running[i]))
+            {
+              continue;
+            }
+          close (running[i].fd);
+          while (waitpid (running[i].pid, &running[i].result.status, 0) < 0)
+            {
+              NS_ABORT_MSG_IF (errno != EINTR, "Can't wait for child " << running[i].result.child
+                                                                        << ": " << std::strerror (errno));
+            }
+          NS_LOG_LOGIC ("child " << running[i].result.child << " exited with status " << running[i].result.status);
+          g_results.push_back (running[i].result);
+          running.erase (running.begin () + i);
+        }
+    }
+
+  std::sort (g_results.begin (), g_results.end (),
+             [] (const Result &a, const Result &b) { return a.child < b.child; });
+  return -1;
+}
+
+bool
+WarmStart::IsChild (void)
+{
+  return g_childFd >= 0;
+}
+
+void
+WarmStart::SetRun (uint64_t run)
+{
+  NS_LOG_FUNCTION (run);
+  RngSeedManager::SetRun (run);
+  RandomVariableStream::ReseedAll ();
+}
+
+void
+WarmStart::Report (const std::string &data)
+{
+  NS_LOG_FUNCTION (data.size ());
+  NS_ABORT_MSG_IF (!IsChild (), "Report called outside a child");
+  std::size_t written = 0;
+  while (written < data.size ())
+    {
+      ssize_t n = write (g_childFd, data.data () + written, data.size () - written);
+      if (n < 0)
+        {
+          NS_ABORT_MSG_IF (errno != EINTR, "Can't report to the parent: " << std::strerror (errno));
+          continue;
+        }
+      written += n;
+    }
+}
+
+void
+WarmStart::Exit (int status)
+{
+  NS_LOG_FUNCTION (status);
+  NS_ABORT_MSG_IF (!IsChild (), "Exit called outside a child");
+  FlushStreams ();
+  close (g_childFd);
+  g_childFd = -1;
+  std::exit (status);
+}
+
+std::vector<WarmStart::Result>
+WarmStart::GetResults (void)
+{
+  return g_results;
+}
+
+} // namespace ns3
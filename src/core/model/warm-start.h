@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup warm-start
+ * ns3::WarmStart declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \defgroup warm-start Warm start of parameter sweeps
+ *
+ * Fork a simulation, once it has been warmed up, into processes which
+ * continue it with different parameters.
+ */
+
+/**
+ * \ingroup warm-start
+ * \brief Fork a warmed-up simulation into children which continue it with
+ * different parameters.
+ *
+ * The points of a parameter sweep often share an expensive startup, e.g.,
+ * the installation of the devices, the attachment of the UEs, the
+ * activation of the bearers and the first channel realizations, and
+ * differ only in parameters which matter afterwards. With WarmStart the
+ * startup is simulated once: the simulation is run up to a warm time, and
+ * then the process is forked into one child per point, which inherits the
+ * state of the simulation, applies its own parameters, e.g., with
+ * Config::Set, and its own run number, and continues the simulation.
+ * The children report their results to the parent through a pipe:
+ *
+ * \code
+ *   // configure and install the scenario
+ *   Simulator::Stop (Seconds (1));
+ *   Simulator::Run ();
+ *
+ *   int32_t child = WarmStart::Fork (thresholds.size ());
+ *   if (child >= 0)
+ *     {
+ *       Config::Set (thresholdPath, DoubleValue (thresholds[child]));
+ *       WarmStart::SetRun (child + 1);
+ *       Simulator::Stop (Seconds (9));
+ *       Simulator::Run ();
+ *       std::ostringstream os;
+ *       os << thresholds[child] << "\t" << sink->GetTotalRx () << std::endl;
+ *       WarmStart::Report (os.str ());
+ *       Simulator::Destroy ();
+ *       WarmStart::Exit ();
+ *     }
+ *   for (const WarmStart::Result &result : WarmStart::GetResults ())
+ *     {
+ *       std::cout << result.output;
+ *     }
+ *   Simulator::Destroy ();
+ * \endcode
+ *
+ * The children share the files opened before the fork, and should write
+ * their traces in different files. The events of a realtime simulation,
+ * or of a simulation which interacts with other processes, cannot be
+ * forked. This is available only on POSIX systems.
+ */
+class WarmStart
+{
+public:
+  /** Outcome of a child. */
+  struct Result
+  {
+    uint32_t child;     //!< Index of the child.
+    int status;         //!< Exit status of the child, as reported by waitpid.
+    std::string output; //!< Data reported by the child.
+  };
+
+  /**
+   * Fork the process into children which continue the simulation from
+   * its current state, and wait for them to exit.
+   *
+   * The children are forked as soon as fewer than \p maxChildren are
+   * running, so that the parent stays at the warm state. The output of the
+   * process should be flushed before, or it would be printed by each child:
+   * the standard streams are flushed here.
+   *
+   * \param [in] nChildren The number of children.
+   * \param [in] maxChildren The maximum number of children running at the
+   *             same time, or 0 for the number of online processors.
+   * \returns The index of the child, from 0 to \p nChildren - 1, in the
+   *          children, and -1 in the parent, once all the children exited.
+   */
+  static int32_t Fork (uint32_t nChildren, uint32_t maxChildren = 0);
+  /**
+   * \returns \c true in a child forked by Fork.
+   */
+  static bool IsChild (void);
+  /**
+   * Set the run number in a child, and recreate the generators of all the
+   * existing random variables in the substream of that run, so that the
+   * children draw different numbers after the fork.
+   *
+   * \param [in] run The run number.
+   */
+  static void SetRun (uint64_t run);
+  /**
+   * Send data to the parent, in a child. The data of successive calls is
+   * concatenated.
+   *
+   * \param [in] data The data.
+   */
+  static void Report (const std::string &data);
+  /**
+   * Terminate a child, after flushing the standard streams and closing the
+   * pipe to the parent.
+   *
+   * \param [in] status The exit status.
+   */
+  static void Exit (int status = 0);
+  /**
+   * \returns The outcome of the children of the last Fork, ordered by the
+   *          index of the child.
+   */
+  static std::vector<Result> GetResults (void);
+};
+
+} // namespace ns3
+
+#endif /* WARM_START_H */
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-profiler.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup events
+ * EventProfiler test suite.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+/**
+ * \ingroup core-tests
+ * Base class of the profiled handlers, to check that virtual methods are
+ * resolved to the overriding method
+ */
+class EventProfilerHandlerBase
+{
+public:
+  virtual ~EventProfilerHandlerBase ()
+  {}
+  /** Handler overridden by the derived class */
+  virtual void Handle (void) = 0;
+};
+
+/**
+ * \ingroup core-tests
+ * Profiled handlers
+ */
+class EventProfilerHandler : public EventProfilerHandlerBase
+{
+public:
+  virtual void Handle (void);
+  /**
+   * Handler with an argument
+   * \param n unused argument
+   */
+  void HandleArgument (uint32_t n);
+};
+
+void
+EventProfilerHandler::Handle (void)
+{
+}
+
+void
+EventProfilerHandler::HandleArgument (uint32_t n)
+{
+}
+
+/**
+ * \ingroup core-tests
+ * Check the events counted for each function and the queue size samples
+ */
+class EventProfilerTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerTestCase::EventProfilerTestCase ()
+  : TestCase ("Check the events counted for each function and the queue size samples")
+{}
+
+void
+EventProfilerTestCase::DoRun (void)
+{
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "The test needs the default simulator");
+  NS_TEST_ASSERT_MSG_EQ (impl->GetEventProfiler (), 0, "Events profiled by default");
+  impl->SetAttribute ("EventProfiling", BooleanValue (true));
+  Ptr<EventProfiler> profiler = impl->GetEventProfiler ();
+  NS_TEST_ASSERT_MSG_NE (profiler, 0, "Events not profiled");
+  profiler->SetAttribute ("QueueSizeSamplingInterval", TimeValue (Seconds (1)));
+
+  EventProfilerHandler handler;
+  EventProfilerHandlerBase *base = &handler;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::Schedule (Seconds (i), &EventProfilerHandlerBase::Handle, base);
+    }
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Simulator::Schedule (Seconds (i), &EventProfilerHandler::HandleArgument, &handler, i);
+    }
+  EventId cancelled = Simulator::Schedule (Seconds (1), &EventProfilerHandler::Handle, &handler);
+  cancelled.Cancel ();
+  Simulator::Run ();
+
+  std::vector<EventProfiler::Entry> entries = profiler->GetEntries ();
+  NS_TEST_ASSERT_MSG_EQ (entries.size (), 2, "Wrong number of functions");
+  std::map<std::string, uint64_t> counts;
+  for (std::vector<EventProfiler::Entry>::const_iterator it = entries.begin (); it != entries.end (); ++it)
+    {
+      counts[it->name] = it->count;
+      uint64_t histogramCount = 0;
+      for (uint32_t i = 0; i < it->histogram.size (); i++)
+        {
+          histogramCount += it->histogram[i];
+        }
+      NS_TEST_ASSERT_MSG_EQ (histogramCount, it->count, "Wrong histogram of " << it->name);
+    }
+  NS_TEST_ASSERT_MSG_EQ (counts["ns3::tests::EventProfilerHandler::Handle()"], 3,
+                         "Wrong count of the virtual method");
+  NS_TEST_ASSERT_MSG_EQ (counts["ns3::tests::EventProfilerHandler::HandleArgument(unsigned int)"], 2,
+                         "Wrong count of the method with an argument");
+  NS_TEST_ASSERT_MSG_EQ (profiler->GetCancelledCount (), 1, "Wrong count of cancelled events");
+
+  // the queue is sampled once per second, before the first event of the second
+  const std::vector<EventProfiler::QueueSizeSample> &samples = profiler->GetQueueSizeSamples ();
+  NS_TEST_ASSERT_MSG_EQ (samples.size (), 3, "Wrong number of queue size samples");
+  NS_TEST_ASSERT_MSG_EQ (samples[0].size, 5, "Wrong queue size at 0 s");
+  NS_TEST_ASSERT_MSG_EQ (samples[1].time, Seconds (1), "Wrong time of the second sample");
+  NS_TEST_ASSERT_MSG_EQ (samples[1].size, 3, "Wrong queue size at 1 s");
+  NS_TEST_ASSERT_MSG_EQ (profiler->GetMaxQueueSize (), 5, "Wrong maximum queue size");
+
+  std::ostringstream os;
+  profiler->Print (os);
+  NS_TEST_ASSERT_MSG_NE (os.str ().find ("Events: 5 invoked"), std::string::npos,
+                         "Wrong report " << os.str ());
+
+  // do not report the profile of the test
+  impl->SetAttribute ("EventProfiling", BooleanValue (false));
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup core-tests
+ * EventProfiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  EventProfilerTestSuite ();
+};
+
+EventProfilerTestSuite::EventProfilerTestSuite ()
+  : TestSuite ("event-profiler", UNIT)
+{
+  AddTestCase (new EventProfilerTestCase ());
+}
+
+/**
+ * \ingroup core-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+
+}  // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/perf-counters.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup perf-counters
+ * PerfCounters test suite.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+/**
+ * \ingroup core-tests
+ * Check the counters, the modules selection and the report
+ */
+class PerfCountersTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PerfCountersTestCase ();
+  virtual void DoRun (void);
+};
+
+PerfCountersTestCase::PerfCountersTestCase ()
+  : TestCase ("Check the counters, the modules selection and the report")
+{}
+
+void
+PerfCountersTestCase::DoRun (void)
+{
+  Ptr<PerfCounters> counters = CreateObject<PerfCounters> ();
+  counters->SetAttribute ("Modules", StringValue ("all,-spectrum"));
+
+  PerfCounter *timed = counters->Register ("mmwave", "Timed");
+  PerfCounter *counted = counters->Register ("mmwave", "Counted");
+  PerfCounter *disabled = counters->Register ("spectrum", "Disabled");
+  NS_TEST_ASSERT_MSG_EQ (counters->Register ("mmwave", "Timed"), timed, "A counter was registered twice");
+  NS_TEST_ASSERT_MSG_EQ (timed->IsEnabled (), true, "Counter of an enabled module is disabled");
+  NS_TEST_ASSERT_MSG_EQ (disabled->IsEnabled (), false, "Counter of a disabled module is enabled");
+
+  timed->AddSample (3000);
+  timed->AddSample (1000);
+  counted->Increment (5);
+  NS_TEST_ASSERT_MSG_EQ (counters->GetCount ("mmwave", "Timed"), 2, "Wrong count");
+  NS_TEST_ASSERT_MSG_EQ (counters->GetCount ("mmwave", "Counted"), 5, "Wrong count");
+  NS_TEST_ASSERT_MSG_EQ (counters->GetCount ("mmwave", "Unknown"), 0, "Wrong count of an unknown counter");
+  NS_TEST_ASSERT_MSG_EQ_TOL (counters->GetTotalTime ("mmwave", "Timed"), 4e-6, 1e-12, "Wrong total time");
+
+  {
+    PerfScopedTimer timer (timed);
+  }
+  NS_TEST_ASSERT_MSG_EQ (counters->GetCount ("mmwave", "Timed"), 3, "The scoped timer was not counted");
+  {
+    PerfScopedTimer timer (disabled);
+  }
+  NS_TEST_ASSERT_MSG_EQ (counters->GetCount ("spectrum", "Disabled"), 0, "A disabled counter was updated");
+
+  // only the counters with occurrences are reported
+  std::ostringstream json;
+  counters->Print (json, PerfCounters::JSON);
+  NS_TEST_ASSERT_MSG_NE (json.str ().find ("\"name\" : \"Timed\", \"count\" : 3"), std::string::npos,
+                         "Missing counter in " << json.str ());
+  NS_TEST_ASSERT_MSG_EQ (json.str ().find ("Disabled"), std::string::npos,
+                         "Unexpected counter in " << json.str ());
+
+  counters->SetModuleEnabled ("spectrum", true);
+  counters->SetModuleEnabled ("mmwave", false);
+  NS_TEST_ASSERT_MSG_EQ (disabled->IsEnabled (), true, "Module not enabled");
+  NS_TEST_ASSERT_MSG_EQ (timed->IsEnabled (), false, "Module not disabled");
+  StringValue modules;
+  counters->GetAttribute ("Modules", modules);
+  NS_TEST_ASSERT_MSG_EQ (modules.Get (), "all,-mmwave", "Wrong modules");
+
+  counters->SetAttribute ("Modules", StringValue ("none,mmwave"));
+  NS_TEST_ASSERT_MSG_EQ (disabled->IsEnabled (), false, "Module not disabled");
+  NS_TEST_ASSERT_MSG_EQ (timed->IsEnabled (), true, "Module not enabled");
+
+  counters->Reset ();
+  NS_TEST_ASSERT_MSG_EQ (counters->GetCount ("mmwave", "Timed"), 0, "Counter not reset");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup core-tests
+ * PerfCounters test suite.
+ */
+class PerfCountersTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  PerfCountersTestSuite ();
+};
+
+PerfCountersTestSuite::PerfCountersTestSuite ()
+  : TestSuite ("perf-counters", UNIT)
+{
+  AddTestCase (new PerfCountersTestCase ());
+}
+
+/**
+ * \ingroup core-tests
+ * PerfCountersTestSuite instance variable.
+ */
+static PerfCountersTestSuite g_perfCountersTestSuite;
+
+
+}  // namespace tests
+
+}  // namespace ns3
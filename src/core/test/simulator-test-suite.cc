@@ -24,6 +24,8 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/four-ary-heap-scheduler.h"
+#include <set>
 
 using namespace ns3;
 
@@ -465,6 +467,76 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  ObjectFactory m_schedulerFactory;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that events are removed in order with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  // insert and remove events directly in the scheduler, with many equal
+  // time stamps, and compare the order with the one of a std::set
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  std::set<std::pair<uint64_t, uint32_t> > expected;
+  uint32_t random = 12345;
+  uint32_t uid = 0;
+  uint64_t now = 0;
+  for (uint32_t i = 0; i < 3000; i++)
+    {
+      random = random * 1103515245 + 12345;
+      uint32_t operation = (random >> 16) % 8;
+      if (operation < 5 || scheduler->IsEmpty ())
+        {
+          Scheduler::Event ev;
+          ev.impl = 0;
+          ev.key.m_ts = now + (random >> 8) % 50;
+          ev.key.m_uid = uid++;
+          ev.key.m_context = ev.key.m_uid % 7;
+          scheduler->Insert (ev);
+          expected.insert (std::make_pair (ev.key.m_ts, ev.key.m_uid));
+        }
+      else if (operation < 7)
+        {
+          Scheduler::Event next = scheduler->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (next.key.m_ts, expected.begin ()->first, "Wrong time stamp");
+          NS_TEST_ASSERT_MSG_EQ (next.key.m_uid, expected.begin ()->second, "Wrong uid");
+          NS_TEST_ASSERT_MSG_EQ (next.key.m_context, next.key.m_uid % 7, "Wrong context");
+          expected.erase (expected.begin ());
+          now = next.key.m_ts;
+        }
+      else
+        {
+          // remove an event in the middle of the queue
+          std::set<std::pair<uint64_t, uint32_t> >::iterator it = expected.begin ();
+          std::advance (it, (random >> 4) % expected.size ());
+          Scheduler::Event ev;
+          ev.impl = 0;
+          ev.key.m_ts = it->first;
+          ev.key.m_uid = it->second;
+          ev.key.m_context = it->second % 7;
+          scheduler->Remove (ev);
+          expected.erase (it);
+        }
+    }
+  while (!scheduler->IsEmpty ())
+    {
+      Scheduler::Event next = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (next.key.m_uid, expected.begin ()->second, "Wrong uid");
+      expected.erase (expected.begin ());
+    }
+  NS_TEST_ASSERT_MSG_EQ (expected.empty (), true, "Events lost by the scheduler");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +555,18 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (FourAryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    const std::string schedulers[] = {
+      "ns3::ListScheduler", "ns3::MapScheduler", "ns3::HeapScheduler",
+      "ns3::CalendarScheduler", "ns3::PriorityQueueScheduler",
+      "ns3::FourAryHeapScheduler"
+    };
+    for (uint32_t i = 0; i < sizeof (schedulers) / sizeof (schedulers[0]); i++)
+      {
+        factory.SetTypeId (schedulers[i]);
+        AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+      }
   }
 } g_simulatorTestSuite;
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/warm-start.h"
+
+#include <set>
+#include <sstream>
+#include <sys/wait.h>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup warm-start
+ * WarmStart test suite.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+/**
+ * \ingroup core-tests
+ * Fork a simulation and check that the children continue it from the
+ * warm state, with different random numbers, and report to the parent
+ */
+class WarmStartTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  WarmStartTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /** Count an event. */
+  void Count (void);
+
+  uint32_t m_count; //!< number of events executed
+};
+
+WarmStartTestCase::WarmStartTestCase ()
+  : TestCase ("Check that the children continue the simulation from the warm state"),
+    m_count (0)
+{}
+
+void
+WarmStartTestCase::Count (void)
+{
+  m_count++;
+}
+
+void
+WarmStartTestCase::DoRun (void)
+{
+  uint64_t run = RngSeedManager::GetRun ();
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 1; i <= 10; i++)
+    {
+      Simulator::Schedule (Seconds (i), &WarmStartTestCase::Count, this);
+    }
+  Simulator::Stop (Seconds (5.5));
+  Simulator::Run ();
+
+  const uint32_t nChildren = 5;
+  int32_t child = WarmStart::Fork (nChildren, 2);
+  if (child >= 0)
+    {
+      // continue the simulation with a different random number
+      WarmStart::SetRun (child + 1);
+      Simulator::Run ();
+      std::ostringstream os;
+      os << child << " " << m_count << " " << rv->GetInteger (0, 1000000000);
+      WarmStart::Report (os.str ());
+      Simulator::Destroy ();
+      WarmStart::Exit (child);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (WarmStart::IsChild (), false, "The parent is a child");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 5, "The parent continued the simulation");
+  std::vector<WarmStart::Result> results = WarmStart::GetResults ();
+  NS_TEST_ASSERT_MSG_EQ (results.size (), nChildren, "Wrong number of results");
+  std::set<uint32_t> numbers;
+  for (uint32_t i = 0; i < results.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (results[i].child, i, "Results not ordered by child");
+      NS_TEST_ASSERT_MSG_EQ ((WIFEXITED (results[i].status) != 0), true, "Child " << i << " did not exit");
+      NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (WEXITSTATUS (results[i].status)), i, "Wrong exit status of child " << i);
+      std::istringstream is (results[i].output);
+      uint32_t index = 0;
+      uint32_t count = 0;
+      uint32_t number = 0;
+      is >> index >> count >> number;
+      NS_TEST_ASSERT_MSG_EQ (index, i, "Wrong report of child " << i);
+      NS_TEST_ASSERT_MSG_EQ (count, 10, "Child " << i << " did not continue the simulation");
+      numbers.insert (number);
+    }
+  NS_TEST_ASSERT_MSG_EQ (numbers.size (), nChildren, "The children drew the same random numbers");
+
+  RngSeedManager::SetRun (run);
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup core-tests
+ * WarmStart test suite.
+ */
+class WarmStartTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  WarmStartTestSuite ();
+};
+
+WarmStartTestSuite::WarmStartTestSuite ()
+  : TestSuite ("warm-start", UNIT)
+{
+  AddTestCase (new WarmStartTestCase ());
+}
+
+/**
+ * \ingroup core-tests
+ * WarmStartTestSuite instance variable.
+ */
+static WarmStartTestSuite g_warmStartTestSuite;
+
+
+}  // namespace tests
+
+}  // namespace ns3
@@ -216,6 +216,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
   FlowStats &stats = GetStatsForFlow (flowId);
   stats.delaySum += delay;
   stats.delayHistogram.AddValue (delay.GetSeconds ());
+  stats.delayLogLinearHistogram.AddValue (delay.GetNanoSeconds ());
   if (stats.rxPackets > 0 )
     {
       Time jitter = stats.lastDelay - delay;
@@ -468,6 +469,17 @@ FlowMonitor::SerializeToXmlStream (std::ostream &os, uint16_t indent, bool enabl
           flowI->second.jitterHistogram.SerializeToXmlStream (os, indent, "jitterHistogram");
           flowI->second.packetSizeHistogram.SerializeToXmlStream (os, indent, "packetSizeHistogram");
           flowI->second.flowInterruptionsHistogram.SerializeToXmlStream (os, indent, "flowInterruptionsHistogram");
+
+          const LogLinearHistogram &delays = flowI->second.delayLogLinearHistogram;
+          os << std::string ( indent, ' ' );
+          os << "<delayQuantiles"
+          << " p50=\"" << NanoSeconds (delays.GetQuantile (0.5)) << "\""
+          << " p95=\"" << NanoSeconds (delays.GetQuantile (0.95)) << "\""
+          << " p99=\"" << NanoSeconds (delays.GetQuantile (0.99)) << "\""
+          << " p999=\"" << NanoSeconds (delays.GetQuantile (0.999)) << "\""
+          << " histogram=\"";
+          delays.Serialize (os);
+          os << "\" />\n";
         }
       indent -= 2;
 
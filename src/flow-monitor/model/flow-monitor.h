@@ -29,6 +29,7 @@
 #include "ns3/flow-probe.h"
 #include "ns3/flow-classifier.h"
 #include "ns3/histogram.h"
+#include "ns3/log-linear-histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 
@@ -116,6 +117,10 @@ public:
     Histogram jitterHistogram;
     /// Histogram of the packet sizes
     Histogram packetSizeHistogram;
+    /// Log-linear histogram of the packet delays, in nanoseconds. Unlike
+    /// delayHistogram, it does not need a bin width, and it bounds the
+    /// relative error of the delay quantiles
+    LogLinearHistogram delayLogLinearHistogram;
 
     /// This attribute also tracks the number of lost packets and
     /// bytes, but discriminates the losses by a _reason code_.  This
@@ -39,6 +39,7 @@ NS_OBJECT_ENSURE_REGISTERED (LteRlcUm);
 LteRlcUm::LteRlcUm ()
   : m_maxTxBufferSize (10 * 1024),
     m_txBufferSize (0),
+    m_txHeadOffset (0),
     m_sequenceNumber (0),
     m_vrUr (0),
     m_vrUx (0),
@@ -174,96 +175,38 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   uint32_t dataFieldAddedSize = 0;
   std::vector < Ptr<Packet> > dataField;
 
-  // Remove the first packet from the transmission buffer.
-  // If only a segment of the packet is taken, then the remaining is given back later
+  // Take data from the SDU at the head of the transmission buffer.
+  // If only a segment of the SDU is taken, the remaining bytes stay in the buffer
   if ( m_txBuffer.size () == 0 )
     {
       NS_LOG_LOGIC ("No data pending");
       return;
     }
 
-  NS_LOG_LOGIC ("SDUs in TxBuffer  = " << m_txBuffer.size ());
-  NS_LOG_LOGIC ("First SDU buffer  = " << *(m_txBuffer.begin()));
-  NS_LOG_LOGIC ("First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
-  NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
-  NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Ptr<Packet> firstSegment = (*(m_txBuffer.begin ()))->Copy ();
-  m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
-  NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
-  m_txBuffer.erase (m_txBuffer.begin ());
-
-  while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
+  bool headTaken = false;
+  while ( !headTaken && (nextSegmentSize > 0) )
     {
-      NS_LOG_LOGIC ("WHILE ( firstSegment && firstSegment->GetSize > 0 && nextSegmentSize > 0 )");
-      NS_LOG_LOGIC ("    firstSegment size = " << firstSegment->GetSize ());
+      uint32_t headSize = m_txBuffer.front ()->GetSize () - m_txHeadOffset;
+      NS_LOG_LOGIC ("WHILE ( head SDU not taken && nextSegmentSize > 0 )");
+      NS_LOG_LOGIC ("    SDUs in TxBuffer  = " << m_txBuffer.size ());
+      NS_LOG_LOGIC ("    head SDU size     = " << headSize << " (offset " << m_txHeadOffset << ")");
       NS_LOG_LOGIC ("    nextSegmentSize   = " << nextSegmentSize);
-      if ( (firstSegment->GetSize () > nextSegmentSize) ||
+      if ( (headSize > nextSegmentSize) ||
            // Segment larger than 2047 octets can only be mapped to the end of the Data field
-           (firstSegment->GetSize () > 2047)
+           (headSize > 2047)
          )
         {
           // Take the minimum size, due to the 2047-bytes 3GPP exception
           // This exception is due to the length of the LI field (just 11 bits)
-          uint32_t currSegmentSize = std::min (firstSegment->GetSize (), nextSegmentSize);
+          uint32_t currSegmentSize = std::min (headSize, nextSegmentSize);
 
-          NS_LOG_LOGIC ("    IF ( firstSegment > nextSegmentSize ||");
-          NS_LOG_LOGIC ("         firstSegment > 2047 )");
+          NS_LOG_LOGIC ("    IF ( headSize > nextSegmentSize ||");
+          NS_LOG_LOGIC ("         headSize > 2047 )");
 
-          // Segment txBuffer.FirstBuffer and
-          // Give back the remaining segment to the transmission buffer
-          Ptr<Packet> newSegment = firstSegment->CreateFragment (0, currSegmentSize);
+          // Segment the head SDU, the remaining segment stays in the transmission buffer
+          Ptr<Packet> newSegment = TakeTxHeadSegment (currSegmentSize);
           NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
-
-          // Status tag of the new and remaining segments
-          // Note: This is the only place where a PDU is segmented and
-          // therefore its status can change
-          LteRlcSduStatusTag oldTag, newTag;
-          firstSegment->RemovePacketTag (oldTag);
-          newSegment->RemovePacketTag (newTag);
-          if (oldTag.GetStatus () == LteRlcSduStatusTag::FULL_SDU)
-            {
-              newTag.SetStatus (LteRlcSduStatusTag::FIRST_SEGMENT);
-              oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-            }
-          else if (oldTag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT)
-            {
-              newTag.SetStatus (LteRlcSduStatusTag::MIDDLE_SEGMENT);
-              //oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-            }
-
-          // Give back the remaining segment to the transmission buffer
-          firstSegment->RemoveAtStart (currSegmentSize);
-          NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
-          if (firstSegment->GetSize () > 0)
-            {
-              firstSegment->AddPacketTag (oldTag);
-
-              m_txBuffer.insert (m_txBuffer.begin (), firstSegment);
-              m_txBufferSize += (*(m_txBuffer.begin()))->GetSize ();
-
-              NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
-              NS_LOG_LOGIC ("    TX buffers = " << m_txBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << (*(m_txBuffer.begin()))->GetSize ());
-              NS_LOG_LOGIC ("    txBufferSize = " << m_txBufferSize );
-            }
-          else
-            {
-              // Whole segment was taken, so adjust tag
-              if (newTag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
-                {
-                  newTag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
-                }
-              else if (newTag.GetStatus () == LteRlcSduStatusTag::MIDDLE_SEGMENT)
-                {
-                  newTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-                }
-            }
-          // Segment is completely taken or
-          // the remaining segment is given back to the transmission buffer
-          firstSegment = 0;
-
-          // Put status tag once it has been adjusted
-          newSegment->AddPacketTag (newTag);
+          headTaken = true;
 
           // Add Segment to Data field
           dataFieldAddedSize = newSegment->GetSize ();
@@ -284,14 +227,15 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           // (NO more segments) → exit
           // break;
         }
-      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txBuffer.size () == 0) )
+      else if ( (nextSegmentSize - headSize <= 2) || (m_txBuffer.size () == 1) )
         {
-          NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txBuffer.size == 0");
-          // Add txBuffer.FirstBuffer to DataField
-          dataFieldAddedSize = firstSegment->GetSize ();
+          NS_LOG_LOGIC ("    IF nextSegmentSize - headSize <= 2 || head is the last SDU");
+          // Add the head SDU to DataField
+          Ptr<Packet> segment = TakeTxHeadSegment (headSize);
+          headTaken = true;
+          dataFieldAddedSize = segment->GetSize ();
           dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
-          firstSegment = 0;
+          dataField.push_back (segment);
 
           // ExtensionBit (Next_Segment - 1) = 0
           rlcHeader.PushExtensionBit (LteRlcHeader::DATA_FIELD_FOLLOWS);
@@ -302,11 +246,6 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           nextSegmentId++;
 
           NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
-          if (m_txBuffer.size () > 0)
-            {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
-            }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
 
           // nextSegmentSize <= 2 (only if txBuffer is not empty)
@@ -314,37 +253,28 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           // (NO more segments) → exit
           // break;
         }
-      else // (firstSegment->GetSize () < m_nextSegmentSize) && (m_txBuffer.size () > 0)
+      else // (headSize < m_nextSegmentSize) && (more SDUs in the buffer)
         {
-          NS_LOG_LOGIC ("    IF firstSegment < NextSegmentSize && txBuffer.size > 0");
-          // Add txBuffer.FirstBuffer to DataField
-          dataFieldAddedSize = firstSegment->GetSize ();
+          NS_LOG_LOGIC ("    IF headSize < NextSegmentSize && more SDUs in the buffer");
+          // Add the head SDU to DataField
+          Ptr<Packet> segment = TakeTxHeadSegment (headSize);
+          dataFieldAddedSize = segment->GetSize ();
           dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
+          dataField.push_back (segment);
 
           // ExtensionBit (Next_Segment - 1) = 1
           rlcHeader.PushExtensionBit (LteRlcHeader::E_LI_FIELDS_FOLLOWS);
 
           // LengthIndicator (Next_Segment)  = txBuffer.FirstBuffer.length()
-          rlcHeader.PushLengthIndicator (firstSegment->GetSize ());
+          rlcHeader.PushLengthIndicator (dataFieldAddedSize);
 
           nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + dataFieldAddedSize;
           nextSegmentId++;
 
           NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
-          if (m_txBuffer.size () > 0)
-            {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
-            }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
-          NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = (*(m_txBuffer.begin ()))->Copy ();
-          m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
-          m_txBuffer.erase (m_txBuffer.begin ());
-          NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
         }
 
     }
@@ -435,10 +365,69 @@ LteRlcUm::DoNotifyHarqDeliveryFailure ()
   NS_LOG_FUNCTION (this);
 }
 
+Ptr<Packet>
+LteRlcUm::TakeTxHeadSegment (uint32_t bytes)
+{
+  Ptr<Packet> head = m_txBuffer.front ();
+  uint32_t headSize = head->GetSize () - m_txHeadOffset;
+  NS_ASSERT (bytes > 0 && bytes <= headSize);
+
+  bool first = (m_txHeadOffset == 0);
+  bool last = (bytes == headSize);
+  Ptr<Packet> segment;
+  if (first && last)
+    {
+      segment = head->Copy ();
+    }
+  else
+    {
+      segment = head->CreateFragment (m_txHeadOffset, bytes);
+    }
+
+  // Status tag of the segment
+  // Note: This is the only place where a PDU is segmented and
+  // therefore its status can change
+  LteRlcSduStatusTag tag;
+  segment->RemovePacketTag (tag);
+  if (first)
+    {
+      tag.SetStatus (last ? LteRlcSduStatusTag::FULL_SDU : LteRlcSduStatusTag::FIRST_SEGMENT);
+    }
+  else
+    {
+      tag.SetStatus (last ? LteRlcSduStatusTag::LAST_SEGMENT : LteRlcSduStatusTag::MIDDLE_SEGMENT);
+    }
+  segment->AddPacketTag (tag);
+
+  m_txBufferSize -= bytes;
+  if (last)
+    {
+      m_txBuffer.pop_front ();
+      m_txHeadOffset = 0;
+    }
+  else
+    {
+      m_txHeadOffset += bytes;
+    }
+  NS_LOG_LOGIC ("txBufferSize = " << m_txBufferSize << " head offset = " << m_txHeadOffset);
+  return segment;
+}
+
 std::vector < Ptr<Packet> >
 LteRlcUm::GetTxBuffer()
 {
-  return m_txBuffer;
+  std::vector < Ptr<Packet> > txBuffer (m_txBuffer.begin (), m_txBuffer.end ());
+  if (m_txHeadOffset > 0)
+    {
+      // the head SDU has been partially transmitted, return the remaining segment
+      Ptr<Packet> remaining = txBuffer.front ()->CreateFragment (m_txHeadOffset, txBuffer.front ()->GetSize () - m_txHeadOffset);
+      LteRlcSduStatusTag tag;
+      remaining->RemovePacketTag (tag);
+      tag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
+      remaining->AddPacketTag (tag);
+      txBuffer.front () = remaining;
+    }
+  return txBuffer;
 }
 
 void
@@ -30,6 +30,7 @@
 #include <ns3/epc-x2-sap.h>
 
 #include <ns3/event-id.h>
+#include <deque>
 #include <map>
 
 namespace ns3 {
@@ -113,10 +114,22 @@ private:
   /// Report buffer status
   void DoReportBufferStatus ();
 
+  /**
+   * Remove the first bytes of the SDU at the head of the transmission buffer.
+   * The SDU is removed from the buffer only when its last byte is taken,
+   * otherwise the head offset is advanced, so that the remaining segment
+   * is neither copied nor inserted again in the buffer.
+   *
+   * \param bytes the size of the segment, at most the size of the head SDU minus the head offset
+   * \returns the segment, with the LteRlcSduStatusTag updated
+   */
+  Ptr<Packet> TakeTxHeadSegment (uint32_t bytes);
+
 private:
   uint32_t m_maxTxBufferSize; ///< maximum transmit buffer status
-  uint32_t m_txBufferSize; ///< transmit buffer size
-  std::vector < Ptr<Packet> > m_txBuffer;       ///< Transmission buffer
+  uint32_t m_txBufferSize; ///< transmit buffer size (not including the bytes of the head SDU already transmitted)
+  uint32_t m_txHeadOffset; ///< number of bytes of the head SDU already transmitted
+  std::deque < Ptr<Packet> > m_txBuffer;       ///< Transmission buffer
   std::map <uint16_t, Ptr<Packet> > m_rxBuffer; ///< Reception buffer
   std::vector < Ptr<Packet> > m_reasBuffer;     ///< Reassembling buffer
 
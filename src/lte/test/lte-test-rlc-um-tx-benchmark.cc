@@ -0,0 +1,171 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+#include "ns3/test.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/lte-mac-sap.h"
+#include "ns3/lte-rlc-um.h"
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * \file lte-test-rlc-um-tx-benchmark.cc
+ * \ingroup lte-test
+ *
+ * \brief Microbenchmark of the transmitter of LteRlcUm.
+ * The transmission buffer is kept at a constant number of SDUs while the
+ * RLC is granted transmission opportunities smaller than an SDU, so that
+ * every PDU carries a segment. The average wall-clock time needed to serve
+ * a transmission opportunity is printed on the standard output, for
+ * growing buffer depths. The suite is not part of the default test.py run, use
+ * ./waf --run "test-runner --suite=lte-rlc-um-tx-benchmark"
+ */
+
+/**
+ * MAC SAP provider which counts and discards the PDUs
+ */
+class LteRlcUmBenchmarkMacSapProvider : public LteMacSapProvider
+{
+public:
+  LteRlcUmBenchmarkMacSapProvider ();
+
+  // inherited from LteMacSapProvider
+  virtual void TransmitPdu (TransmitPduParameters params);
+  virtual void ReportBufferStatus (ReportBufferStatusParameters params);
+
+  uint64_t m_txBytes; //!< bytes of the transmitted PDUs
+  uint32_t m_numPdus; //!< number of transmitted PDUs
+};
+
+LteRlcUmBenchmarkMacSapProvider::LteRlcUmBenchmarkMacSapProvider ()
+  : m_txBytes (0),
+    m_numPdus (0)
+{
+}
+
+void
+LteRlcUmBenchmarkMacSapProvider::TransmitPdu (TransmitPduParameters params)
+{
+  m_txBytes += params.pdu->GetSize ();
+  m_numPdus++;
+}
+
+void
+LteRlcUmBenchmarkMacSapProvider::ReportBufferStatus (ReportBufferStatusParameters params)
+{
+}
+
+class LteRlcUmTxBenchmarkTestCase : public TestCase
+{
+public:
+  LteRlcUmTxBenchmarkTestCase (uint32_t numSdus, uint32_t sduSize, uint32_t txOpSize, uint32_t numTxOps);
+  virtual ~LteRlcUmTxBenchmarkTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_numSdus; //!< number of SDUs in the transmission buffer
+  uint32_t m_sduSize; //!< size of the SDUs
+  uint32_t m_txOpSize; //!< size of the transmission opportunities
+  uint32_t m_numTxOps; //!< number of transmission opportunities
+};
+
+LteRlcUmTxBenchmarkTestCase::LteRlcUmTxBenchmarkTestCase (uint32_t numSdus, uint32_t sduSize, uint32_t txOpSize, uint32_t numTxOps)
+  : TestCase (std::to_string (numSdus) + " SDUs of " + std::to_string (sduSize) + " bytes, TX opportunities of "
+              + std::to_string (txOpSize) + " bytes"),
+    m_numSdus (numSdus),
+    m_sduSize (sduSize),
+    m_txOpSize (txOpSize),
+    m_numTxOps (numTxOps)
+{
+}
+
+LteRlcUmTxBenchmarkTestCase::~LteRlcUmTxBenchmarkTestCase ()
+{
+}
+
+void
+LteRlcUmTxBenchmarkTestCase::DoRun (void)
+{
+  LteRlcUmBenchmarkMacSapProvider macSapProvider;
+  Ptr<LteRlcUm> rlc = CreateObject<LteRlcUm> ();
+  rlc->SetAttribute ("MaxTxBufferSize", UintegerValue ((m_numSdus + 1) * m_sduSize));
+  rlc->SetRnti (1);
+  rlc->SetLcId (3);
+  rlc->SetLteMacSapProvider (&macSapProvider);
+
+  uint32_t depthBytes = m_numSdus * m_sduSize;
+  while (rlc->GetTxBufferSize () < depthBytes)
+    {
+      rlc->DoTransmitPdcpPdu (Create<Packet> (m_sduSize));
+    }
+
+  LteMacSapUser::TxOpportunityParameters txOpParams;
+  txOpParams.bytes = m_txOpSize;
+  txOpParams.layer = 0;
+  txOpParams.harqId = 0;
+  txOpParams.componentCarrierId = 0;
+  txOpParams.rnti = 1;
+  txOpParams.lcid = 3;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < m_numTxOps; i++)
+    {
+      rlc->GetLteMacSapUser ()->NotifyTxOpportunity (txOpParams);
+      // top up the buffer, to keep its depth constant
+      while (rlc->GetTxBufferSize () + m_sduSize <= depthBytes)
+        {
+          rlc->DoTransmitPdcpPdu (Create<Packet> (m_sduSize));
+        }
+    }
+  int64_t elapsedMs = clock.End ();
+
+  NS_TEST_ASSERT_MSG_EQ (macSapProvider.m_numPdus, m_numTxOps, "Not all the TX opportunities have been used");
+
+  std::cout << std::setw (7) << m_numSdus << " SDUs "
+            << std::setw (10) << std::fixed << std::setprecision (3)
+            << (elapsedMs * 1000.0 / m_numTxOps) << " us/TX opportunity "
+            << std::setw (12) << macSapProvider.m_txBytes << " bytes" << std::endl;
+
+  rlc->Dispose ();
+  Simulator::Destroy ();
+}
+
+class LteRlcUmTxBenchmarkTestSuite : public TestSuite
+{
+public:
+  LteRlcUmTxBenchmarkTestSuite ();
+};
+
+LteRlcUmTxBenchmarkTestSuite::LteRlcUmTxBenchmarkTestSuite ()
+  : TestSuite ("lte-rlc-um-tx-benchmark", PERFORMANCE)
+{
+  uint32_t numSdus[5] = {10, 100, 1000, 5000, 20000};
+  for (uint32_t n = 0; n < 5; n++)
+    {
+      AddTestCase (new LteRlcUmTxBenchmarkTestCase (numSdus[n], 1400, 500, 100000), TestCase::QUICK);
+    }
+}
+
+static LteRlcUmTxBenchmarkTestSuite lteRlcUmTxBenchmarkTestSuite; //!< the benchmark suite
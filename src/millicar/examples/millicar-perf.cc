@@ -0,0 +1,435 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-sidelink-spectrum-phy.h"
+#include "ns3/mmwave-vehicular-net-device.h"
+#include "ns3/mmwave-vehicular-helper.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/core-module.h"
+#include "ns3/bursty-helper.h"
+#include "ns3/burst-sink-helper.h"
+#include "ns3/bursty-application.h"
+#include "ns3/burst-sink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <sys/resource.h>
+
+NS_LOG_COMPONENT_DEFINE ("MillicarPerf");
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+  Performance benchmark of the contention-based sidelink.
+
+  The scenario generalizes the ones of the vehicular-threeTransmitters
+  programs: [numPlatoons] platoons of [numVehicles] vehicles travel in
+  parallel lanes, [interPlatoonDistance] m apart, keeping a distance of
+  [intraPlatoonDistance] m between consecutive vehicles. In each platoon the
+  front vehicle receives the bursts generated by all the others, e.g., point
+  clouds of [burstSize] B every [framePeriod] ms. All the platoons share the
+  same channel, so that the transmissions of different platoons interfere.
+
+  The benchmark reports the wall-clock time of each phase of the simulation
+  (configuration, installation, run, destruction), the number of events
+  executed, the simulated seconds per wall-clock second and the peak
+  resident set size of the process, together with the traffic delivered.
+  It also reports how many buffers of SpectrumValue were allocated from
+  the heap, how many times their values were copied, and how many copies
+  shared the values instead.
+
+  With --baseline=<file> the results are appended to a tab-separated file,
+  one line per run, identified by the scenario parameters. With
+  --compare=<file> the results are compared with the last line of a
+  previous baseline file having the same scenario, e.g., a baseline saved
+  before a change:
+
+  ./waf --run "millicar-perf --numPlatoons=2 --baseline=before.tsv"
+  ... change and rebuild ...
+  ./waf --run "millicar-perf --numPlatoons=2 --compare=before.tsv"
+
+  With --profile the wall-clock time spent in each event handler is
+  reported when the simulator is destroyed (see ns3::EventProfiler). The
+  profiling adds some overhead, so the results of a profiled run should not
+  be compared with the ones of a run without profiling.
+
+  Each run simulates one scenario: peak RSS is a property of the process.
+*/
+
+namespace {
+
+/**
+ * Wall-clock time of the phases of the simulation
+ */
+class PhaseTimer
+{
+public:
+  PhaseTimer ()
+    : m_start (std::chrono::steady_clock::now ())
+  {
+  }
+
+  /**
+   * Close the current phase
+   * \param name the name of the phase
+   */
+  void EndPhase (std::string name)
+  {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ();
+    m_phases.push_back (std::make_pair (name, std::chrono::duration<double> (now - m_start).count ()));
+    m_start = now;
+  }
+
+  /**
+   * \return the name and the duration [s] of each phase, in order
+   */
+  const std::vector<std::pair<std::string, double> > & GetPhases (void) const
+  {
+    return m_phases;
+  }
+
+  /**
+   * \param name the name of a phase
+   * \return the duration of the phase [s]
+   */
+  double GetPhase (std::string name) const
+  {
+    for (std::vector<std::pair<std::string, double> >::const_iterator it = m_phases.begin (); it != m_phases.end (); ++it)
+      {
+        if (it->first == name)
+          {
+            return it->second;
+          }
+      }
+    return 0;
+  }
+
+private:
+  std::chrono::steady_clock::time_point m_start; //!< start of the current phase
+  std::vector<std::pair<std::string, double> > m_phases; //!< name and duration of the closed phases
+};
+
+/**
+ * \return the peak resident set size of the process [kB]
+ */
+long
+GetPeakRss (void)
+{
+  struct rusage usage;
+  if (getrusage (RUSAGE_SELF, &usage) != 0)
+    {
+      return 0;
+    }
+  return usage.ru_maxrss; // kB on Linux
+}
+
+/**
+ * \param value a value
+ * \return the value as a string, with 6 significant digits
+ */
+template <typename T>
+std::string
+ToString (T value)
+{
+  std::stringstream ss;
+  ss << std::setprecision (6) << value;
+  return ss.str ();
+}
+
+/**
+ * Split a tab-separated line
+ * \param line the line
+ * \return the fields of the line
+ */
+std::vector<std::string>
+SplitFields (const std::string &line)
+{
+  std::vector<std::string> fields;
+  std::istringstream ss (line);
+  std::string field;
+  while (std::getline (ss, field, '\t'))
+    {
+      fields.push_back (field);
+    }
+  return fields;
+}
+
+} // unnamed namespace
+
+int main (int argc, char *argv[])
+{
+  uint32_t numPlatoons = 2; // number of platoons
+  uint32_t numVehicles = 4; // vehicles per platoon, including the receiver
+  uint32_t numAntennaElements = 4; // number of antenna elements
+  bool csma = true; // use the contention-based access
+  uint32_t backOffBound = 5; // upper bound of the random backoff [slots]
+  double intThreshold = 0.0; // interference threshold to declare the channel idle
+  uint32_t mcs = 28; // modulation and coding scheme
+  double intraPlatoonDistance = 20.0; // distance between vehicles of the same platoon [m]
+  double interPlatoonDistance = 5.0; // distance between platoons [m]
+  double speed = 20; // speed of the vehicles [m/s]
+  uint32_t burstSize = 125000; // size of the bursts [B]
+  uint32_t framePeriod = 50; // period of the bursts [ms]
+  double simTime = 2.0; // simulated time [s]
+  std::string baseline = ""; // file where the results are appended
+  std::string compare = ""; // baseline file the results are compared with
+  bool profile = false; // report the time spent in each event handler
+
+  CommandLine cmd;
+  cmd.AddValue ("numPlatoons", "number of platoons", numPlatoons);
+  cmd.AddValue ("numVehicles", "number of vehicles per platoon, including the receiver", numVehicles);
+  cmd.AddValue ("numAntennaElements", "number of antenna elements", numAntennaElements);
+  cmd.AddValue ("CSMA", "usage of csma", csma);
+  cmd.AddValue ("backOffBound", "upper bound of the random backoff, in slots", backOffBound);
+  cmd.AddValue ("threshold", "interference threshold to declare channel idle", intThreshold);
+  cmd.AddValue ("mcs", "modulation and coding scheme", mcs);
+  cmd.AddValue ("intraPlatoonDistance", "distance between vehicles of the same platoon in meters", intraPlatoonDistance);
+  cmd.AddValue ("interPlatoonDistance", "distance between platoons in meters", interPlatoonDistance);
+  cmd.AddValue ("speed", "the speed of the vehicles in m/s", speed);
+  cmd.AddValue ("burstSize", "size of the bursts in bytes", burstSize);
+  cmd.AddValue ("framePeriod", "period of the bursts in milliseconds", framePeriod);
+  cmd.AddValue ("simTime", "simulated time in seconds", simTime);
+  cmd.AddValue ("baseline", "file where the results are appended", baseline);
+  cmd.AddValue ("compare", "baseline file the results are compared with", compare);
+  cmd.AddValue ("profile", "report the time spent in each event handler", profile);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (numPlatoons < 1 || numVehicles < 2, "At least one platoon of two vehicles is needed");
+
+  PhaseTimer timer;
+
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::EventProfiling", BooleanValue (profile));
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::UseAmc", BooleanValue (false));
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::UseCSMA", BooleanValue (csma));
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::backOffBound", UintegerValue (backOffBound));
+  Config::SetDefault ("ns3::MmWaveSidelinkSpectrumPhy::InterferenceThreshold", DoubleValue (intThreshold));
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::Mcs", UintegerValue (mcs));
+  Config::SetDefault ("ns3::MmWavePhyMacCommon::CenterFreq", DoubleValue (28.0e9));
+  Config::SetDefault ("ns3::MmWaveVehicularPropagationLossModel::ChannelCondition", StringValue ("l"));
+  Config::SetDefault ("ns3::MmWaveVehicularNetDevice::RlcType", StringValue ("LteRlcUm"));
+  Config::SetDefault ("ns3::MmWaveVehicularHelper::SchedulingPatternOption", EnumValue (2));
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (500 * 1024));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::AntennaElements", UintegerValue (numAntennaElements));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::AntennaElementPattern", StringValue ("3GPP-V2V"));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::IsotropicAntennaElements", BooleanValue (true));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::NumSectors", UintegerValue (2));
+
+  timer.EndPhase ("configure");
+
+  // create the helper, shared by all the platoons so that they share the channel
+  Ptr<MmWaveVehicularHelper> helper = CreateObject<MmWaveVehicularHelper> ();
+  helper->SetNumerology (3);
+  helper->SetPropagationLossModelType ("ns3::MmWaveVehicularPropagationLossModel");
+  helper->SetSpectrumPropagationLossModelType ("ns3::MmWaveVehicularSpectrumPropagationLossModel");
+
+  InternetStackHelper internet;
+  Ipv4AddressHelper ipv4;
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+
+  ApplicationContainer clientApps;
+  ApplicationContainer serverApps;
+  uint16_t port = 50000;
+
+  for (uint32_t p = 0; p < numPlatoons; p++)
+    {
+      NodeContainer platoon;
+      platoon.Create (numVehicles);
+      mobility.Install (platoon);
+      for (uint32_t v = 0; v < numVehicles; v++)
+        {
+          platoon.Get (v)->GetObject<MobilityModel> ()->SetPosition (Vector (v * intraPlatoonDistance, p * interPlatoonDistance, 0));
+          platoon.Get (v)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (speed, 0, 0));
+        }
+
+      NetDeviceContainer devs = helper->InstallMmWaveVehicularNetDevices (platoon);
+      internet.Install (platoon);
+
+      std::stringstream base;
+      base << "10." << 1 + p / 250 << "." << 1 + p % 250 << ".0";
+      ipv4.SetBase (Ipv4Address (base.str ().c_str ()), "255.255.255.0");
+      Ipv4InterfaceContainer interfaces = ipv4.Assign (devs);
+
+      helper->PairDevices (devs);
+
+      // the front vehicle receives the bursts of all the others
+      Ipv4Address serverAddress = interfaces.GetAddress (numVehicles - 1);
+      for (uint32_t v = 0; v < numVehicles - 1; v++)
+        {
+          BurstyHelper burstyHelper ("ns3::UdpSocketFactory", InetSocketAddress (serverAddress, port + v));
+          burstyHelper.SetAttribute ("FragmentSize", UintegerValue (1200));
+          std::stringstream burstSizeRv;
+          burstSizeRv << "ns3::ConstantRandomVariable[Constant=" << burstSize << "]";
+          std::stringstream periodRv;
+          periodRv << "ns3::ConstantRandomVariable[Constant=" << framePeriod / 1e3 << "]";
+          burstyHelper.SetBurstGenerator ("ns3::SimpleBurstGenerator",
+                                          "BurstSizeRv", StringValue (burstSizeRv.str ()),
+                                          "PeriodRv", StringValue (periodRv.str ()));
+          clientApps.Add (burstyHelper.Install (platoon.Get (v)));
+
+          BurstSinkHelper burstSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port + v));
+          serverApps.Add (burstSinkHelper.Install (platoon.Get (numVehicles - 1)));
+        }
+    }
+
+  Ptr<UniformRandomVariable> rv = CreateObjectWithAttributes<UniformRandomVariable> (
+      "Min", DoubleValue (0), "Max", DoubleValue (0.1));
+  clientApps.StartWithJitter (Seconds (0.1), rv);
+  clientApps.Stop (Seconds (simTime));
+  Simulator::Stop (Seconds (simTime));
+
+  timer.EndPhase ("install");
+
+  Simulator::Run ();
+  uint64_t events = Simulator::GetEventCount ();
+
+  timer.EndPhase ("run");
+
+  uint64_t txBytes = 0;
+  uint64_t rxBytes = 0;
+  uint64_t txBursts = 0;
+  uint64_t rxBursts = 0;
+  for (uint32_t i = 0; i < clientApps.GetN (); i++)
+    {
+      Ptr<BurstyApplication> burstyApp = clientApps.Get (i)->GetObject<BurstyApplication> ();
+      Ptr<BurstSink> burstSink = serverApps.Get (i)->GetObject<BurstSink> ();
+      txBytes += burstyApp->GetTotalTxBytes ();
+      txBursts += burstyApp->GetTotalTxBursts ();
+      rxBytes += burstSink->GetTotalRxBytes ();
+      rxBursts += burstSink->GetTotalRxBursts ();
+    }
+
+  Simulator::Destroy ();
+
+  timer.EndPhase ("destroy");
+
+  // results, in the order of the baseline columns
+  std::stringstream scenario;
+  scenario << "p" << numPlatoons << "-v" << numVehicles << "-a" << numAntennaElements
+           << "-csma" << csma << "-bo" << backOffBound << "-thr" << intThreshold
+           << "-b" << burstSize << "-f" << framePeriod << "-t" << simTime;
+  double runTime = timer.GetPhase ("run");
+  double simSecondsPerSecond = runTime > 0 ? simTime / runTime : 0;
+  double eventsPerSecond = runTime > 0 ? events / runTime : 0;
+  long peakRss = GetPeakRss ();
+
+  std::vector<std::pair<std::string, std::string> > results;
+  results.push_back (std::make_pair ("scenario", scenario.str ()));
+  for (std::vector<std::pair<std::string, double> >::const_iterator it = timer.GetPhases ().begin ();
+       it != timer.GetPhases ().end (); ++it)
+    {
+      results.push_back (std::make_pair (it->first + "Wall", ToString (it->second)));
+    }
+  results.push_back (std::make_pair ("events", ToString (events)));
+  results.push_back (std::make_pair ("eventsPerWallSecond", ToString (eventsPerSecond)));
+  results.push_back (std::make_pair ("simSecondsPerWallSecond", ToString (simSecondsPerSecond)));
+  results.push_back (std::make_pair ("peakRssKb", ToString (peakRss)));
+  results.push_back (std::make_pair ("psdAllocations", ToString (SpectrumValue::GetAllocationCount ())));
+  results.push_back (std::make_pair ("psdDeepCopies", ToString (SpectrumValue::GetDeepCopyCount ())));
+  results.push_back (std::make_pair ("psdSharedCopies", ToString (SpectrumValue::GetSharedCopyCount ())));
+  results.push_back (std::make_pair ("txBursts", ToString (txBursts)));
+  results.push_back (std::make_pair ("rxBursts", ToString (rxBursts)));
+  results.push_back (std::make_pair ("txBytes", ToString (txBytes)));
+  results.push_back (std::make_pair ("rxBytes", ToString (rxBytes)));
+
+  for (std::vector<std::pair<std::string, std::string> >::const_iterator it = results.begin (); it != results.end (); ++it)
+    {
+      std::cout << std::left << std::setw (26) << it->first << it->second << std::endl;
+    }
+
+  if (!compare.empty ())
+    {
+      std::ifstream in (compare.c_str ());
+      NS_ABORT_MSG_IF (!in.is_open (), "Can't open file " << compare);
+      std::string line;
+      std::vector<std::string> header;
+      std::vector<std::string> previous;
+      while (std::getline (in, line))
+        {
+          std::vector<std::string> fields = SplitFields (line);
+          if (header.empty ())
+            {
+              header = fields;
+            }
+          else if (!fields.empty () && fields[0] == scenario.str ())
+            {
+              previous = fields;
+            }
+        }
+
+      if (previous.empty ())
+        {
+          std::cout << "No result for scenario " << scenario.str () << " in " << compare << std::endl;
+        }
+      else
+        {
+          std::cout << std::endl << "Change with respect to " << compare << ":" << std::endl;
+          for (std::vector<std::pair<std::string, std::string> >::const_iterator it = results.begin () + 1; it != results.end (); ++it)
+            {
+              std::vector<std::string>::const_iterator column = std::find (header.begin (), header.end (), it->first);
+              if (column == header.end () || uint32_t (column - header.begin ()) >= previous.size ())
+                {
+                  continue;
+                }
+              double before = std::atof (previous[column - header.begin ()].c_str ());
+              double after = std::atof (it->second.c_str ());
+              std::cout << std::left << std::setw (26) << it->first << previous[column - header.begin ()]
+                        << " -> " << it->second;
+              if (before != 0)
+                {
+                  std::cout << " (" << std::showpos << std::setprecision (3) << 100 * (after - before) / before
+                            << std::noshowpos << "%)";
+                }
+              std::cout << std::endl;
+            }
+        }
+    }
+
+  if (!baseline.empty ())
+    {
+      std::ifstream existing (baseline.c_str ());
+      bool writeHeader = !existing.is_open () || existing.peek () == std::ifstream::traits_type::eof ();
+      existing.close ();
+
+      std::ofstream out (baseline.c_str (), std::ios_base::app);
+      NS_ABORT_MSG_IF (!out.is_open (), "Can't open file " << baseline);
+      if (writeHeader)
+        {
+          for (uint32_t i = 0; i < results.size (); i++)
+            {
+              out << (i > 0 ? "\t" : "") << results[i].first;
+            }
+          out << "\n";
+        }
+      for (uint32_t i = 0; i < results.size (); i++)
+        {
+          out << (i > 0 ? "\t" : "") << results[i].second;
+        }
+      out << "\n";
+    }
+
+  return 0;
+}
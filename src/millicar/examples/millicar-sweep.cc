@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-vehicular-net-device.h"
+#include "ns3/mmwave-vehicular-helper.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/core-module.h"
+#include "ns3/sweep-runner.h"
+#include "ns3/bursty-helper.h"
+#include "ns3/burst-sink-helper.h"
+#include "ns3/burst-sink.h"
+
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("MillicarSweep");
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+  Parameter sweep of the contention-based sidelink, run in parallel.
+
+  The scenario is the one of vehicular-threeTransmitters_2plat_sem: two
+  platoons of [numVehicles] vehicles share the channel, and in each platoon
+  the front vehicle receives the bursts generated by the others. The sweep
+  varies the upper bound of the backoff and the interference threshold,
+  which are set as attribute defaults by the SweepRunner, and repeats each
+  combination for [numRuns] runs. The points are simulated in worker
+  processes forked from this program, at most one per online processor,
+  and the bursts and bytes received by each point are written in a single
+  tab-separated file:
+
+  ./waf --run "millicar-sweep --numRuns=4 --output=sweep.tsv"
+*/
+
+/// Parameters of the scenario which are not swept
+struct Scenario
+{
+  uint32_t numVehicles;   //!< vehicles per platoon, including the receiver
+  uint32_t burstSize;     //!< size of the bursts [B]
+  double simTime;         //!< simulated time [s]
+};
+
+/**
+ * Simulate a point of the sweep
+ * \param scenario the parameters which are not swept
+ * \param point the point, whose parameters are already set as defaults
+ * \return the traffic received in the point
+ */
+static SweepRunner::Summary
+RunPoint (const Scenario *scenario, const SweepRunner::Point &point)
+{
+  Ptr<MmWaveVehicularHelper> helper = CreateObject<MmWaveVehicularHelper> ();
+  helper->SetNumerology (3);
+  helper->SetPropagationLossModelType ("ns3::MmWaveVehicularPropagationLossModel");
+  helper->SetSpectrumPropagationLossModelType ("ns3::MmWaveVehicularSpectrumPropagationLossModel");
+
+  InternetStackHelper internet;
+  Ipv4AddressHelper ipv4;
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+
+  ApplicationContainer clientApps;
+  ApplicationContainer serverApps;
+  uint16_t port = 50000;
+  for (uint32_t p = 0; p < 2; p++)
+    {
+      NodeContainer platoon;
+      platoon.Create (scenario->numVehicles);
+      mobility.Install (platoon);
+      for (uint32_t v = 0; v < scenario->numVehicles; v++)
+        {
+          platoon.Get (v)->GetObject<MobilityModel> ()->SetPosition (Vector (v * 20.0, p * 5.0, 0));
+          platoon.Get (v)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (20, 0, 0));
+        }
+
+      NetDeviceContainer devs = helper->InstallMmWaveVehicularNetDevices (platoon);
+      internet.Install (platoon);
+      std::stringstream base;
+      base << "10.1." << 1 + p << ".0";
+      ipv4.SetBase (Ipv4Address (base.str ().c_str ()), "255.255.255.0");
+      Ipv4InterfaceContainer interfaces = ipv4.Assign (devs);
+      helper->PairDevices (devs);
+
+      Ipv4Address serverAddress = interfaces.GetAddress (scenario->numVehicles - 1);
+      for (uint32_t v = 0; v < scenario->numVehicles - 1; v++)
+        {
+          BurstyHelper burstyHelper ("ns3::UdpSocketFactory", InetSocketAddress (serverAddress, port + v));
+          burstyHelper.SetAttribute ("FragmentSize", UintegerValue (1200));
+          std::stringstream burstSizeRv;
+          burstSizeRv << "ns3::ConstantRandomVariable[Constant=" << scenario->burstSize << "]";
+          burstyHelper.SetBurstGenerator ("ns3::SimpleBurstGenerator",
+                                          "BurstSizeRv", StringValue (burstSizeRv.str ()),
+                                          "PeriodRv", StringValue ("ns3::ConstantRandomVariable[Constant=0.05]"));
+          clientApps.Add (burstyHelper.Install (platoon.Get (v)));
+
+          BurstSinkHelper burstSinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port + v));
+          serverApps.Add (burstSinkHelper.Install (platoon.Get (scenario->numVehicles - 1)));
+        }
+    }
+
+  Ptr<UniformRandomVariable> rv = CreateObjectWithAttributes<UniformRandomVariable> (
+      "Min", DoubleValue (0), "Max", DoubleValue (0.1));
+  clientApps.StartWithJitter (Seconds (0.1), rv);
+  clientApps.Stop (Seconds (scenario->simTime));
+  Simulator::Stop (Seconds (scenario->simTime));
+  Simulator::Run ();
+
+  uint64_t rxBursts = 0;
+  uint64_t rxBytes = 0;
+  for (uint32_t i = 0; i < serverApps.GetN (); i++)
+    {
+      Ptr<BurstSink> burstSink = serverApps.Get (i)->GetObject<BurstSink> ();
+      rxBursts += burstSink->GetTotalRxBursts ();
+      rxBytes += burstSink->GetTotalRxBytes ();
+    }
+  Simulator::Destroy ();
+
+  SweepRunner::Summary summary;
+  std::ostringstream os;
+  os << rxBursts;
+  summary.push_back (std::make_pair ("rxBursts", os.str ()));
+  os.str ("");
+  os << rxBytes * 8 / (scenario->simTime - 0.1) / 1e6;
+  summary.push_back (std::make_pair ("throughputMbps", os.str ()));
+  return summary;
+}
+
+int main (int argc, char *argv[])
+{
+  Scenario scenario;
+  scenario.numVehicles = 4;
+  scenario.burstSize = 125000;
+  scenario.simTime = 1.0;
+  uint32_t numRuns = 2; // runs of each combination of the parameters
+  uint32_t maxWorkers = 0; // maximum number of worker processes, 0 for one per processor
+  std::string output = "millicar-sweep.tsv"; // result file
+
+  CommandLine cmd;
+  cmd.AddValue ("numVehicles", "number of vehicles per platoon, including the receiver", scenario.numVehicles);
+  cmd.AddValue ("burstSize", "size of the bursts in bytes", scenario.burstSize);
+  cmd.AddValue ("simTime", "simulated time in seconds", scenario.simTime);
+  cmd.AddValue ("numRuns", "runs of each combination of the parameters", numRuns);
+  cmd.AddValue ("maxWorkers", "maximum number of worker processes, 0 for one per processor", maxWorkers);
+  cmd.AddValue ("output", "result file", output);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (scenario.numVehicles < 2, "At least two vehicles per platoon are needed");
+
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::UseAmc", BooleanValue (false));
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::UseCSMA", BooleanValue (true));
+  Config::SetDefault ("ns3::MmWavePhyMacCommon::CenterFreq", DoubleValue (28.0e9));
+  Config::SetDefault ("ns3::MmWaveVehicularPropagationLossModel::ChannelCondition", StringValue ("l"));
+  Config::SetDefault ("ns3::MmWaveVehicularNetDevice::RlcType", StringValue ("LteRlcUm"));
+  Config::SetDefault ("ns3::MmWaveVehicularHelper::SchedulingPatternOption", EnumValue (2));
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (500 * 1024));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::AntennaElements", UintegerValue (4));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::AntennaElementPattern", StringValue ("3GPP-V2V"));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::IsotropicAntennaElements", BooleanValue (true));
+  Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::NumSectors", UintegerValue (2));
+
+  SweepRunner sweep;
+  sweep.AddParameter ("ns3::MmWaveSidelinkMac::backOffBound", {"1", "5", "20"});
+  sweep.AddParameter ("ns3::MmWaveSidelinkSpectrumPhy::InterferenceThreshold", {"0", "1e-12"});
+  sweep.SetRuns (numRuns);
+  sweep.SetMaxWorkers (maxWorkers);
+  uint32_t failed = sweep.Run (MakeBoundCallback (&RunPoint, &scenario), output);
+
+  std::cout << sweep.GetNPoints () << " points written in " << output;
+  if (failed > 0)
+    {
+      std::cout << ", " << failed << " failed";
+    }
+  std::cout << std::endl;
+  return failed > 0 ? 1 : 0;
+}
@@ -28,6 +28,11 @@
 #include "ns3/pointer.h"
 #include "ns3/config.h"
 
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#include "ns3/mmwave-vehicular-distributed-spectrum-channel.h"
+#endif
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("MmWaveVehicularHelper"); // TODO check if this has to be defined here
@@ -116,8 +121,20 @@ MmWaveVehicularHelper::DoInitialize ()
                                                                              "Bandwidth", DoubleValue (m_bandwidth));
   }
 
-  // create the channel
+  // create the channel, which is shared by the processes of a distributed
+  // simulation
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled () && MpiInterface::GetSize () > 1)
+  {
+    m_channel = CreateObject<MmWaveVehicularDistributedSpectrumChannel> ();
+  }
+  else
+  {
+    m_channel = CreateObject<SingleModelSpectrumChannel> ();
+  }
+#else
   m_channel = CreateObject<SingleModelSpectrumChannel> ();
+#endif
   if (!m_propagationLossModelType.empty ())
   {
     ObjectFactory factory (m_propagationLossModelType);
@@ -212,9 +229,6 @@ MmWaveVehicularHelper::InstallSingleMmWaveVehicularNetDevice (Ptr<Node> node, ui
   NS_ASSERT_MSG (m_channel, "First create the channel");
   ssp->SetChannel (m_channel);
 
-  // add the spectrum phy to the spectrum channel
-  m_channel->AddRx (ssp);
-
   // create and configure the chunk processor
   Ptr<mmwave::mmWaveChunkProcessor> pData = Create<mmwave::mmWaveChunkProcessor> ();
   pData->AddCallback (MakeCallback (&MmWaveSidelinkSpectrumPhy::UpdateSinrPerceived, ssp));
@@ -249,6 +263,10 @@ MmWaveVehicularHelper::InstallSingleMmWaveVehicularNetDevice (Ptr<Node> node, ui
   device->SetNode (node);
   ssp->SetDevice (device);
 
+  // add the spectrum phy to the spectrum channel, once it is attached to the
+  // device
+  m_channel->AddRx (ssp);
+
   // connect the rx callback of the mac object to the rx method of the NetDevice
   mac->SetForwardUpCallback(MakeCallback(&MmWaveVehicularNetDevice::Receive, device));
 
@@ -20,6 +20,7 @@
 #include "mmwave-vehicular-traces-helper.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/enum.h"
 
 namespace ns3 {
 
@@ -29,19 +30,26 @@ namespace millicar {
 
 NS_OBJECT_ENSURE_REGISTERED (MmWaveVehicularTracesHelper);
 
+TypeId
+MmWaveVehicularTracesHelper::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveVehicularTracesHelper")
+    .SetParent<Object> ()
+    .AddAttribute ("TraceFormat",
+                   "Format of the SINR and MCS trace",
+                   EnumValue (mmwave::MmWaveTraceSink::TEXT),
+                   MakeEnumAccessor (&MmWaveVehicularTracesHelper::m_format),
+                   MakeEnumChecker (mmwave::MmWaveTraceSink::TEXT, "Text",
+                                    mmwave::MmWaveTraceSink::BINARY, "Binary"))
+  ;
+  return tid;
+}
+
 MmWaveVehicularTracesHelper::MmWaveVehicularTracesHelper (std::string filename)
-: m_filename(filename)
+: m_filename(filename),
+  m_format (mmwave::MmWaveTraceSink::TEXT)
 {
   NS_LOG_FUNCTION (this);
-
-  if(!m_outputFile.is_open())
-  {
-    m_outputFile.open(m_filename.c_str());
-    if (!m_outputFile.is_open ())
-    {
-      NS_FATAL_ERROR ("Could not open tracefile");
-    }
-  }
 }
 
 MmWaveVehicularTracesHelper::~MmWaveVehicularTracesHelper ()
@@ -49,11 +57,36 @@ MmWaveVehicularTracesHelper::~MmWaveVehicularTracesHelper ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+MmWaveVehicularTracesHelper::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  // flush and close the file
+  m_outputSink = 0;
+  Object::DoDispose ();
+}
+
 void
 MmWaveVehicularTracesHelper::McsSinrCallback(const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize, uint8_t mcs)
 {
+  if (!m_outputSink)
+  {
+    // the file is opened with the first record, so that the format can be set
+    // through the attribute after the helper is created
+    mmwave::MmWaveTraceSchema schema;
+    schema.AddColumn ("time", mmwave::MmWaveTraceSchema::DOUBLE)
+    .AddColumn ("rnti", mmwave::MmWaveTraceSchema::UINT16)
+    .AddColumn ("sinr", mmwave::MmWaveTraceSchema::DOUBLE)
+    .AddColumn ("numSym", mmwave::MmWaveTraceSchema::UINT8)
+    .AddColumn ("tbSize", mmwave::MmWaveTraceSchema::UINT32)
+    .AddColumn ("mcs", mmwave::MmWaveTraceSchema::UINT8)
+    .SetTextHeader (false);
+    m_outputSink = Create<mmwave::MmWaveTraceSink> (m_filename, schema, m_format);
+    Simulator::ScheduleDestroy (&mmwave::MmWaveTraceSink::Flush, m_outputSink);
+  }
+
   double sinrAvg = Sum (sinr) / (sinr.GetSpectrumModel ()->GetNumBands ());
-  m_outputFile << Simulator::Now().GetSeconds() << "\t" << rnti << "\t" << 10 * std::log10 (sinrAvg) << "\t" << (uint32_t)numSym << "\t" << tbSize << "\t" << (uint32_t)mcs << std::endl;
+  m_outputSink->Append () << Simulator::Now().GetSeconds() << rnti << 10 * std::log10 (sinrAvg) << numSym << tbSize << mcs;
 }
 
 }
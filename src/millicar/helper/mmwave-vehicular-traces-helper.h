@@ -24,6 +24,7 @@
 #include <string>
 #include <ns3/object.h>
 #include <ns3/spectrum-value.h>
+#include <ns3/mmwave-trace-sink.h>
 
 namespace ns3 {
 
@@ -47,6 +48,12 @@ public:
    */
   virtual ~MmWaveVehicularTracesHelper();
 
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
   /**
    * Method to be attached to the callback in the MmWaveSidelinkSpectrumPhy
    * \param sinr pointer to the SpectrumValue instance representing the SINR
@@ -59,9 +66,14 @@ public:
    */
   void McsSinrCallback(const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize, uint8_t mcs);
 
+protected:
+  // inherited from Object
+  virtual void DoDispose (void);
+
 private:
   std::string m_filename; //!< filename for the output
-  std::ofstream m_outputFile; //!< output file
+  mmwave::MmWaveTraceSink::Format m_format; //!< format of the output file
+  Ptr<mmwave::MmWaveTraceSink> m_outputSink; //!< output sink, opened with the first record
 
 };
 
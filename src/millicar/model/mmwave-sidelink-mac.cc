@@ -28,6 +28,7 @@
 #include "ns3/random-variable-stream.h"
 
 #include <ns3/seq-ts-header.h>
+#include <ns3/perf-counters.h>
 
 namespace ns3 {
 
@@ -204,10 +205,7 @@ MmWaveSidelinkMac::DoSlotIndication (mmwave::SfnSf timingInfo)
               continue;
             }
             // otherwise, forward the packet to the PHY
-            Ptr<PacketBurst> pb = CreateObject<PacketBurst> ();
-            pb->AddPacket (txBuffer->second.front ().pdu);
-            
-            m_phySapProvider->AddTransportBlock (pb, *it);
+            m_phySapProvider->AddTransportBlock (mmwave::TransportBlock (txBuffer->second.front ().pdu), *it);
             txBuffer->second.pop_front ();
               
           }
@@ -250,10 +248,7 @@ MmWaveSidelinkMac::DoSlotIndication (mmwave::SfnSf timingInfo)
           continue;
         }
         // otherwise, forward the packet to the PHY
-        Ptr<PacketBurst> pb = CreateObject<PacketBurst> ();
-        pb->AddPacket (txBuffer->second.front ().pdu);
-        
-        m_phySapProvider->AddTransportBlock (pb, *it);
+        m_phySapProvider->AddTransportBlock (mmwave::TransportBlock (txBuffer->second.front ().pdu), *it);
         txBuffer->second.pop_front ();
       }
     }
@@ -273,6 +268,7 @@ MmWaveSidelinkMac::DoSlotIndication (mmwave::SfnSf timingInfo)
 mmwave::SlotAllocInfo
 MmWaveSidelinkMac::ScheduleResources (mmwave::SfnSf timingInfo)
 {
+  NS_PERF_TIMER ("millicar", "MmWaveSidelinkMac::ScheduleResources");
   mmwave::SlotAllocInfo allocationInfo; // stores all the allocation decisions
   allocationInfo.m_sfnSf = timingInfo;
   allocationInfo.m_numSymAlloc = 0;
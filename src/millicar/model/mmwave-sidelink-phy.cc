@@ -36,9 +36,9 @@ MacSidelinkMemberPhySapProvider::MacSidelinkMemberPhySapProvider (Ptr<MmWaveSide
 }
 
 void
-MacSidelinkMemberPhySapProvider::AddTransportBlock (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info)
+MacSidelinkMemberPhySapProvider::AddTransportBlock (mmwave::TransportBlock tb, mmwave::TtiAllocInfo info)
 {
-  m_phy->DoAddTransportBlock (pb, info);
+  m_phy->DoAddTransportBlock (std::move (tb), info);
 }
 
 bool
@@ -182,13 +182,10 @@ MmWaveSidelinkPhy::SetPhySapUser (MmWaveSidelinkPhySapUser* sap)
 }
 
 void
-MmWaveSidelinkPhy::DoAddTransportBlock (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info)
+MmWaveSidelinkPhy::DoAddTransportBlock (mmwave::TransportBlock tb, mmwave::TtiAllocInfo info)
 {
-  // create a new entry for the PHY buffer
-  PhyBufferEntry e = std::make_pair (pb, info);
-
-  // add the new entry to the buffer
-  m_phyBuffer.push_back (e);
+  // add a new entry to the buffer
+  m_phyBuffer.push_back (std::make_pair (std::move (tb), info));
 }
 
 void
@@ -196,6 +193,15 @@ MmWaveSidelinkPhy::StartSlot (mmwave::SfnSf timingInfo)
 {
    NS_LOG_FUNCTION (this << " frame " << timingInfo.m_frameNum << " subframe " << timingInfo.m_sfNum << " slot " << timingInfo.m_slotNum);
 
+  // in a distributed simulation, the vehicles of the other processes are
+  // only copies which receive their signals, and do not run the slots
+  Ptr<NetDevice> device = m_sidelinkSpectrumPhy->GetDevice ();
+  if (device && device->GetNode ()->GetSystemId () != Simulator::GetSystemId ())
+  {
+    NS_LOG_DEBUG ("Node " << device->GetNode ()->GetId () << " is simulated by process " << device->GetNode ()->GetSystemId ());
+    return;
+  }
+
   // trigger the MAC
   m_phySapUser->SlotIndication (timingInfo);
 
@@ -204,14 +210,13 @@ MmWaveSidelinkPhy::StartSlot (mmwave::SfnSf timingInfo)
     uint8_t usedSymbols = 0; // the symbol index
 
     // retrieve the first element in the list
-    Ptr<PacketBurst> pktBurst;
-    mmwave::TtiAllocInfo info;
-    std::tie (pktBurst, info) = m_phyBuffer.front ();
+    const mmwave::TransportBlock &tb = m_phyBuffer.front ().first;
+    const mmwave::TtiAllocInfo &info = m_phyBuffer.front ().second;
 
     // send the transport block
     if (info.m_ttiType == mmwave::TtiAllocInfo::DATA)
     {
-      usedSymbols += SlData (pktBurst, info);
+      usedSymbols += SlData (tb, info);
     }
     else if (info.m_ttiType == mmwave::TtiAllocInfo::CTRL)
     {
@@ -235,7 +240,7 @@ MmWaveSidelinkPhy::StartSlot (mmwave::SfnSf timingInfo)
 }
 
 uint8_t
-MmWaveSidelinkPhy::SlData (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info)
+MmWaveSidelinkPhy::SlData (const mmwave::TransportBlock &tb, mmwave::TtiAllocInfo info)
 {
   NS_LOG_FUNCTION (this);
 
@@ -254,7 +259,7 @@ MmWaveSidelinkPhy::SlData (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info)
 
   // send the transport block
   Simulator::Schedule (startTime, &MmWaveSidelinkPhy::SendDataChannels, this,
-                       pb,
+                       tb,
                        duration,
                        info,
                        subChannelsForTx);
@@ -263,7 +268,7 @@ MmWaveSidelinkPhy::SlData (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info)
 }
 
 void
-MmWaveSidelinkPhy::SendDataChannels (Ptr<PacketBurst> pb,
+MmWaveSidelinkPhy::SendDataChannels (mmwave::TransportBlock tb,
   Time duration,
   mmwave::TtiAllocInfo info,
   std::vector<int> rbBitmap)
@@ -274,7 +279,7 @@ MmWaveSidelinkPhy::SendDataChannels (Ptr<PacketBurst> pb,
   NS_ASSERT_MSG (m_deviceMap.find (info.m_rnti) != m_deviceMap.end (), "Device not found");
   m_sidelinkSpectrumPhy->ConfigureBeamforming (m_deviceMap.at (info.m_rnti));
 
-  m_sidelinkSpectrumPhy->StartTxDataFrames (pb, duration, info.m_dci.m_mcs, info.m_dci.m_tbSize, info.m_dci.m_numSym, info.m_dci.m_rnti, info.m_rnti, rbBitmap);
+  m_sidelinkSpectrumPhy->StartTxDataFrames (std::move (tb), duration, info.m_dci.m_mcs, info.m_dci.m_tbSize, info.m_dci.m_numSym, info.m_dci.m_rnti, info.m_rnti, rbBitmap);
 }
 
 std::vector<int>
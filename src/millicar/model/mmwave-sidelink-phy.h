@@ -119,10 +119,10 @@ public:
   /**
    * Add a transport block to the transmission buffer, which will be sent in the
    * current slot.
-   * \param pb the packet burst containing the packets to be sent
+   * \param tb the transport block containing the packets to be sent
    * \param info the mmwave::TtiAllocInfo instance containg the transmission information
    */
-  void DoAddTransportBlock (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info);
+  void DoAddTransportBlock (mmwave::TransportBlock tb, mmwave::TtiAllocInfo info);
 
   /**
    * Prepare for the reception from another device by properly configuring
@@ -160,11 +160,11 @@ private:
 
   /**
    * Transmit a transport block
-   * \param pb the packet burst containing the packets to be sent
+   * \param tb the transport block containing the packets to be sent
    * \param info the mmwave::TtiAllocInfo instance containg the transmission information
    * \return the number of symbols used to send this TB
    */
-  uint8_t SlData (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info);
+  uint8_t SlData (const mmwave::TransportBlock &tb, mmwave::TtiAllocInfo info);
 
   /**
    * Set the transmission mask and creates the power spectral density for the
@@ -174,14 +174,14 @@ private:
   std::vector<int> SetSubChannelsForTransmission ();
 
   /**
-   * Send the packet burts
-   * \param pb the packet burst
+   * Send the transport block
+   * \param tb the transport block
    * \param duration the duration of the transmissin
    * \param info the mmwave::TtiAllocInfo instance containg the transmission information
    * \param rbBitmap the mask indicating the suchannels to be used for the
             transmission
    */
-  void SendDataChannels (Ptr<PacketBurst> pb, Time duration, mmwave::TtiAllocInfo info, std::vector<int> rbBitmap);
+  void SendDataChannels (mmwave::TransportBlock tb, Time duration, mmwave::TtiAllocInfo info, std::vector<int> rbBitmap);
 
   /**
    * TODO: this can be done by overloading the operator ++ of the mmwave::SfnSf struct
@@ -201,7 +201,7 @@ private:
   double m_noiseFigure; //!< the noise figure in dB
   Ptr<MmWaveSidelinkSpectrumPhy> m_sidelinkSpectrumPhy; //!< the SpectrumPhy instance associated with this PHY
   Ptr<mmwave::MmWavePhyMacCommon> m_phyMacConfig; //!< the configuration parameters
-  typedef std::pair<Ptr<PacketBurst>, mmwave::TtiAllocInfo> PhyBufferEntry; //!< type of the phy buffer entries
+  typedef std::pair<mmwave::TransportBlock, mmwave::TtiAllocInfo> PhyBufferEntry; //!< type of the phy buffer entries
   std::list<PhyBufferEntry> m_phyBuffer; //!< buffer of transport blocks to send in the current slot
   std::map<uint64_t, Ptr<NetDevice>> m_deviceMap; //!< map containing the <rnti, device> pairs of the nodes we want to communicate with
 };
@@ -212,7 +212,7 @@ class MacSidelinkMemberPhySapProvider : public MmWaveSidelinkPhySapProvider
 public:
   MacSidelinkMemberPhySapProvider (Ptr<MmWaveSidelinkPhy> phy);
 
-  void AddTransportBlock (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info) override;
+  void AddTransportBlock (mmwave::TransportBlock tb, mmwave::TtiAllocInfo info) override;
 
   void PrepareForReception (uint16_t rnti) override;
 
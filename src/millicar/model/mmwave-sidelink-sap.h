@@ -20,7 +20,7 @@
 #ifndef SRC_MMWAVE_MODEL_MMWAVE_SAP_H_
 #define SRC_MMWAVE_MODEL_MMWAVE_SAP_H_
 
-#include <ns3/packet-burst.h>
+#include <ns3/mmwave-transport-block.h>
 #include <ns3/lte-mac-sap.h>
 #include <ns3/lte-rlc-am.h>
 #include <ns3/spectrum-value.h>
@@ -39,10 +39,10 @@ public:
 
   /**
    * \brief Called by the upper layers to fill PHY's buffer
-   * \param pb burst of packets to be forwarded to the PHY layer
+   * \param tb transport block to be forwarded to the PHY layer
    * \param info information about slot allocation necessary to determine the transmission parameters
    */
-  virtual void AddTransportBlock (Ptr<PacketBurst> pb, mmwave::TtiAllocInfo info) = 0;
+  virtual void AddTransportBlock (mmwave::TransportBlock tb, mmwave::TtiAllocInfo info) = 0;
 
   /**
    * \brief Called by the upper layer to prepare the PHY for the reception from
@@ -36,6 +36,7 @@
 #include <ns3/mmwave-vehicular-antenna-array-model.h>
 
 #include <ns3/seq-ts-header.h>
+#include <ns3/perf-counters.h>
 
 using namespace ns3;
 using namespace mmwave;
@@ -336,9 +337,9 @@ MmWaveSidelinkSpectrumPhy::StartRxData (Ptr<MmWaveSidelinkSpectrumSignalParamete
             }
 
           ChangeState (RX_DATA);
-          if (params->packetBurst && !params->packetBurst->GetPackets ().empty ())
+          if (!params->transportBlock.IsEmpty ())
             {
-              TbInfo_t tbInfo = {params->packetBurst, params->size, params->mcs, params->numSym, params->senderRnti, params->rbBitmap};
+              TbInfo_t tbInfo = {params->transportBlock, params->size, params->mcs, params->numSym, params->senderRnti, params->rbBitmap};
               m_rxTransportBlock.push_back (tbInfo);
             }
         }
@@ -398,6 +399,7 @@ void
 MmWaveSidelinkSpectrumPhy::EndRxData ()
 {
   NS_LOG_FUNCTION (this);
+  NS_PERF_TIMER ("millicar", "MmWaveSidelinkSpectrumPhy::EndRxData");
   m_interferenceData->EndRx ();
 
   double sinrAvg = Sum (m_sinrPerceived) / (m_sinrPerceived.GetSpectrumModel ()->GetNumBands ());
@@ -434,8 +436,8 @@ MmWaveSidelinkSpectrumPhy::EndRxData ()
        bool corrupt = m_random->GetValue () > tbStats->m_tbler ? false : true;
        if(!corrupt)
        {
-         Ptr<PacketBurst> burst = (*i).packetBurst;
-         for (std::list<Ptr<Packet> >::const_iterator j = (*burst).Begin (); j != (*burst).End (); ++j)
+         const mmwave::TransportBlock &tb = (*i).transportBlock;
+         for (mmwave::TransportBlock::Iterator j = tb.Begin (); j != tb.End (); ++j)
          {
            if ((*j)->GetSize () == 0)
            {
@@ -445,7 +447,8 @@ MmWaveSidelinkSpectrumPhy::EndRxData ()
 
            // Do we need the LteRadioBearerTag also here to check the rnti? I don't think so.
            NS_ASSERT_MSG (!m_phyRxDataEndOkCallback.IsNull (), "First set the rx callback");
-           m_phyRxDataEndOkCallback (*j);
+           // the packet is shared with the other receivers of the TB
+           m_phyRxDataEndOkCallback ((*j)->Copy ());
          }
        }
        else
@@ -487,7 +490,7 @@ MmWaveSidelinkSpectrumPhy::EndRxData ()
 // }
 
 bool
-MmWaveSidelinkSpectrumPhy::StartTxDataFrames (Ptr<PacketBurst> pb,
+MmWaveSidelinkSpectrumPhy::StartTxDataFrames (mmwave::TransportBlock tb,
   Time duration,
   uint8_t mcs,
   uint32_t size,
@@ -518,7 +521,7 @@ MmWaveSidelinkSpectrumPhy::StartTxDataFrames (Ptr<PacketBurst> pb,
         txParams->duration = duration;
         txParams->txPhy = this->GetObject<SpectrumPhy> ();
         txParams->psd = m_txPsd;
-        txParams->packetBurst = pb;
+        txParams->transportBlock = std::move (tb);
         //txParams->ctrlMsgList = ctrlMsgList;
         txParams->txAntenna = m_antenna;
         txParams->mcs = mcs;
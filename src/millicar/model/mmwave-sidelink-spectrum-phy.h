@@ -35,7 +35,7 @@
 #include <ns3/spectrum-interference.h>
 #include <ns3/data-rate.h>
 #include <ns3/generic-phy.h>
-#include <ns3/packet-burst.h>
+#include <ns3/mmwave-transport-block.h>
 #include "mmwave-sidelink-spectrum-signal-parameters.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/mmwave-interference.h"
@@ -48,7 +48,7 @@ namespace millicar {
 
 struct TbInfo_t
 {
-  Ptr<PacketBurst> packetBurst; ///< Packet burst associated to the transport block
+  mmwave::TransportBlock transportBlock; ///< Packets of the transport block
   uint32_t size; ///< Transport block size
   uint8_t mcs; ///< MCS
   uint8_t numSym; ///< number of symbols used to transmit this TB
@@ -202,7 +202,7 @@ public:
   /**
   * Start a transmission of data frame in sidelink
   *
-  * @param pb the burst of packets to be transmitted
+  * @param tb the transport block to be transmitted
   * @param duration the duration of the data frame
   * @param mcs MCS to use for the transmission of the data frame
   * @param size size of the transport block
@@ -213,7 +213,7 @@ public:
   * @return true if an error occurred and the transmission was not
   * started, false otherwise.
   */
-  bool StartTxDataFrames (Ptr<PacketBurst> pb, Time duration, uint8_t mcs, uint32_t size, uint8_t numSym, uint16_t senderRnti, uint16_t destinationRnti, std::vector<int> rbBitmap);
+  bool StartTxDataFrames (mmwave::TransportBlock tb, Time duration, uint8_t mcs, uint32_t size, uint8_t numSym, uint16_t senderRnti, uint16_t destinationRnti, std::vector<int> rbBitmap);
 
   //bool StartTxControlFrames (std::list<Ptr<MmWaveControlMessage> > ctrlMsgList, Time duration);       // control frames from enb to ue
 
@@ -21,7 +21,6 @@
 */
 
 #include <ns3/log.h>
-#include <ns3/packet-burst.h>
 #include <ns3/ptr.h>
 #include "mmwave-sidelink-spectrum-signal-parameters.h"
 
@@ -40,10 +39,7 @@ MmWaveSidelinkSpectrumSignalParameters::MmWaveSidelinkSpectrumSignalParameters (
   : SpectrumSignalParameters (p)
 {
   NS_LOG_FUNCTION (this << &p);
-  if (p.packetBurst)
-    {
-      packetBurst = p.packetBurst->Copy ();
-    }
+  transportBlock = p.transportBlock;
   //ctrlMsgList = p.ctrlMsgList;
   mcs = p.mcs;
   size = p.size;
@@ -24,11 +24,10 @@
 #define MMWAVE_SIDELINK_SPECTRUM_SIGNAL_PARAMETERS_H
 
 #include <ns3/spectrum-signal-parameters.h>
+#include <ns3/mmwave-transport-block.h>
 
 namespace ns3 {
 
-class PacketBurst;
-
 namespace millicar {
 
 class MmWaveSidelinkControlMessage;
@@ -49,7 +48,11 @@ struct MmWaveSidelinkSpectrumSignalParameters : public SpectrumSignalParameters
   */
   MmWaveSidelinkSpectrumSignalParameters (const MmWaveSidelinkSpectrumSignalParameters& p);
 
-  Ptr<PacketBurst> packetBurst;
+  /**
+   * the transmitted transport block; its packets are shared by the copies
+   * of the parameters delivered to each receiver, and must not be modified
+   */
+  mmwave::TransportBlock transportBlock;
 
   //std::list<Ptr<MmWaveSidelinkControlMessage>> ctrlMsgList;
 
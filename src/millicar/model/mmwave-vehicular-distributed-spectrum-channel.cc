@@ -0,0 +1,183 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "mmwave-vehicular-distributed-spectrum-channel.h"
+#include "mmwave-vehicular-signal-descriptor.h"
+#include "mmwave-sidelink-spectrum-phy.h"
+#include "mmwave-vehicular-antenna-array-model.h"
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/mobility-model.h>
+#include <ns3/node.h>
+#include <ns3/simulator.h>
+#include <ns3/mpi-interface.h>
+#include <ns3/mpi-receiver.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveVehicularDistributedSpectrumChannel");
+
+namespace millicar {
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveVehicularDistributedSpectrumChannel);
+
+TypeId
+MmWaveVehicularDistributedSpectrumChannel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveVehicularDistributedSpectrumChannel")
+    .SetParent<SingleModelSpectrumChannel> ()
+    .SetGroupName ("millicar")
+    .AddConstructor<MmWaveVehicularDistributedSpectrumChannel> ()
+    .AddAttribute ("LookAhead",
+                   "The delay after which the signals are received by the "
+                   "other processes, which must not exceed the propagation "
+                   "delay between two vehicles simulated by different processes",
+                   TimeValue (NanoSeconds (100)),
+                   MakeTimeAccessor (&MmWaveVehicularDistributedSpectrumChannel::m_lookAhead),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+MmWaveVehicularDistributedSpectrumChannel::MmWaveVehicularDistributedSpectrumChannel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveVehicularDistributedSpectrumChannel::~MmWaveVehicularDistributedSpectrumChannel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MmWaveVehicularDistributedSpectrumChannel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_remotePhys.clear ();
+  m_endpoints.clear ();
+  SingleModelSpectrumChannel::DoDispose ();
+}
+
+void
+MmWaveVehicularDistributedSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  Ptr<NetDevice> device = phy->GetDevice ();
+  NS_ABORT_MSG_IF (device == 0, "The SpectrumPhy must be attached to its device before it is added to the channel");
+  Ptr<Node> node = device->GetNode ();
+  uint32_t systemId = node->GetSystemId ();
+
+  // the first device of each process receives the signals forwarded to it
+  if (m_endpoints.find (systemId) == m_endpoints.end ())
+    {
+      m_endpoints[systemId] = DeviceId (node->GetId (), device->GetIfIndex ());
+      if (systemId == MpiInterface::GetSystemId ())
+        {
+          Ptr<MpiReceiver> receiver = CreateObject<MpiReceiver> ();
+          receiver->SetReceiveCallback (MakeCallback (&MmWaveVehicularDistributedSpectrumChannel::ReceiveSignal, this));
+          device->AggregateObject (receiver);
+        }
+      else
+        {
+          MpiInterface::AddRemoteChannel (this, systemId, m_lookAhead);
+        }
+    }
+
+  if (systemId == MpiInterface::GetSystemId ())
+    {
+      SingleModelSpectrumChannel::AddRx (phy);
+    }
+  else
+    {
+      Ptr<MmWaveSidelinkSpectrumPhy> sidelinkPhy = DynamicCast<MmWaveSidelinkSpectrumPhy> (phy);
+      NS_ABORT_MSG_IF (sidelinkPhy == 0, "The vehicles of the other processes must use a MmWaveSidelinkSpectrumPhy");
+      m_remotePhys[DeviceId (node->GetId (), device->GetIfIndex ())] = sidelinkPhy;
+    }
+}
+
+void
+MmWaveVehicularDistributedSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> params)
+{
+  NS_LOG_FUNCTION (this << params);
+  Ptr<NetDevice> device = params->txPhy->GetDevice ();
+  NS_ASSERT_MSG (device, "The transmitter is not attached to a device");
+  if (device->GetNode ()->GetSystemId () != MpiInterface::GetSystemId ())
+    {
+      // the copies of the vehicles of the other processes do not transmit
+      NS_LOG_WARN ("Signal of node " << device->GetNode ()->GetId () << ", which is simulated by another process, dropped");
+      return;
+    }
+
+  SingleModelSpectrumChannel::StartTx (params);
+
+  if (m_endpoints.size () < 2)
+    {
+      return;
+    }
+  Ptr<MmWaveSidelinkSpectrumSignalParameters> sidelinkParams = DynamicCast<MmWaveSidelinkSpectrumSignalParameters> (params);
+  NS_ABORT_MSG_IF (sidelinkParams == 0, "Only sidelink signals can be forwarded to the other processes");
+  MmWaveVehicularSignalDescriptor descriptor (sidelinkParams);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (descriptor);
+
+  // the packet is serialized when it is sent, hence it can be sent to all the processes
+  Time rxTime = Simulator::Now () + m_lookAhead;
+  for (std::map<uint32_t, DeviceId>::const_iterator it = m_endpoints.begin (); it != m_endpoints.end (); ++it)
+    {
+      if (it->first != MpiInterface::GetSystemId ())
+        {
+          NS_LOG_LOGIC ("Forward " << descriptor << " to process " << it->first);
+          MpiInterface::SendPacket (packet, rxTime, it->second.first, it->second.second);
+        }
+    }
+}
+
+void
+MmWaveVehicularDistributedSpectrumChannel::ReceiveSignal (Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+  MmWaveVehicularSignalDescriptor descriptor;
+  packet->RemoveHeader (descriptor);
+  NS_LOG_LOGIC ("Received " << descriptor);
+
+  std::map<DeviceId, Ptr<MmWaveSidelinkSpectrumPhy> >::const_iterator it
+    = m_remotePhys.find (DeviceId (descriptor.GetTxNodeId (), descriptor.GetTxIfIndex ()));
+  NS_ABORT_MSG_IF (it == m_remotePhys.end (), "Signal of node " << descriptor.GetTxNodeId () << ", which is not attached to the channel");
+  Ptr<MmWaveSidelinkSpectrumPhy> txPhy = it->second;
+
+  // move the copy of the transmitter and point it at the same device
+  txPhy->GetMobility ()->SetPosition (descriptor.GetTxPosition ());
+  Ptr<MmWaveVehicularAntennaArrayModel> antenna = DynamicCast<MmWaveVehicularAntennaArrayModel> (txPhy->GetRxAntenna ());
+  if (antenna && descriptor.IsOmni ())
+    {
+      antenna->ChangeToOmniTx ();
+    }
+  else if (descriptor.GetBeamDevice ())
+    {
+      txPhy->ConfigureBeamforming (descriptor.GetBeamDevice ());
+    }
+
+  Ptr<MmWaveSidelinkSpectrumSignalParameters> params = descriptor.CreateSignalParameters (txPhy, txPhy->GetRxSpectrumModel ());
+  DeliverToReceivers (params, m_lookAhead);
+}
+
+} // namespace millicar
+
+} // namespace ns3
@@ -0,0 +1,98 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#ifndef MMWAVE_VEHICULAR_DISTRIBUTED_SPECTRUM_CHANNEL_H_
+#define MMWAVE_VEHICULAR_DISTRIBUTED_SPECTRUM_CHANNEL_H_
+
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/nstime.h>
+#include <map>
+#include <utility>
+
+namespace ns3 {
+
+class Packet;
+
+namespace millicar {
+
+class MmWaveSidelinkSpectrumPhy;
+
+/**
+ * \ingroup millicar
+ * SpectrumChannel for the sidelink of vehicles simulated by several MPI
+ * processes.
+ *
+ * As usual in the distributed simulations of ns-3, every process creates
+ * all the vehicles, and simulates only the nodes whose system ID is its
+ * rank; the vehicles of the other processes are copies which do not
+ * transmit. The signals transmitted by the local vehicles are received by
+ * the local ones as in a SingleModelSpectrumChannel, and are forwarded to
+ * the other processes as MmWaveVehicularSignalDescriptor, where the copy of
+ * the transmitter is moved to its actual position and pointed at the same
+ * device, and the signal is delivered to the vehicles of that process.
+ *
+ * The descriptors are received after the LookAhead, which must not exceed
+ * the propagation delay between any two vehicles simulated by different
+ * processes, so a PropagationDelayModel is needed. The LookAhead is
+ * declared with MpiInterface::AddRemoteChannel, and the larger it is, the
+ * less often the processes have to synchronize.
+ *
+ * The SpectrumPhy instances must be attached to their device before they
+ * are added to the channel.
+ */
+class MmWaveVehicularDistributedSpectrumChannel : public SingleModelSpectrumChannel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  MmWaveVehicularDistributedSpectrumChannel ();
+  virtual ~MmWaveVehicularDistributedSpectrumChannel ();
+
+  // inherited from SpectrumChannel
+  virtual void AddRx (Ptr<SpectrumPhy> phy);
+  virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+
+protected:
+  virtual void DoDispose ();
+
+private:
+  /**
+   * Deliver a signal forwarded by another process to the local vehicles
+   * \param packet the packet with the MmWaveVehicularSignalDescriptor
+   */
+  void ReceiveSignal (Ptr<Packet> packet);
+
+  /// Node ID and device index of a device
+  typedef std::pair<uint32_t, uint32_t> DeviceId;
+
+  Time m_lookAhead; //!< the minimum delay of the signals forwarded to the other processes
+  std::map<DeviceId, Ptr<MmWaveSidelinkSpectrumPhy> > m_remotePhys; //!< copies of the vehicles of the other processes
+  std::map<uint32_t, DeviceId> m_endpoints; //!< device receiving the signals forwarded to each process
+};
+
+} // namespace millicar
+
+} // namespace ns3
+
+#endif /* MMWAVE_VEHICULAR_DISTRIBUTED_SPECTRUM_CHANNEL_H_ */
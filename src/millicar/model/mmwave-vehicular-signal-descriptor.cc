@@ -0,0 +1,309 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "mmwave-vehicular-signal-descriptor.h"
+#include "mmwave-sidelink-spectrum-phy.h"
+#include "mmwave-vehicular-antenna-array-model.h"
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/mobility-model.h>
+#include <ns3/node.h>
+#include <ns3/node-list.h>
+#include <ns3/spectrum-value.h>
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveVehicularSignalDescriptor");
+
+namespace millicar {
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveVehicularSignalDescriptor);
+
+namespace {
+
+void
+WriteDouble (Buffer::Iterator &i, double value)
+{
+  uint64_t bits;
+  std::memcpy (&bits, &value, sizeof (bits));
+  i.WriteHtonU64 (bits);
+}
+
+double
+ReadDouble (Buffer::Iterator &i)
+{
+  uint64_t bits = i.ReadNtohU64 ();
+  double value;
+  std::memcpy (&value, &bits, sizeof (value));
+  return value;
+}
+
+} // unnamed namespace
+
+TypeId
+MmWaveVehicularSignalDescriptor::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveVehicularSignalDescriptor")
+    .SetParent<Header> ()
+    .SetGroupName ("millicar")
+    .AddConstructor<MmWaveVehicularSignalDescriptor> ()
+  ;
+  return tid;
+}
+
+TypeId
+MmWaveVehicularSignalDescriptor::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+MmWaveVehicularSignalDescriptor::MmWaveVehicularSignalDescriptor ()
+  : m_txNodeId (0),
+    m_txIfIndex (0),
+    m_omni (true),
+    m_beamNodeId (NO_BEAM),
+    m_beamIfIndex (0),
+    m_mcs (0),
+    m_numSym (0),
+    m_senderRnti (0),
+    m_destinationRnti (0),
+    m_size (0),
+    m_pss (false)
+{
+}
+
+MmWaveVehicularSignalDescriptor::MmWaveVehicularSignalDescriptor (Ptr<const MmWaveSidelinkSpectrumSignalParameters> params)
+  : m_omni (true),
+    m_beamNodeId (NO_BEAM),
+    m_beamIfIndex (0),
+    m_duration (params->duration),
+    m_psd (params->psd->ConstValuesBegin (), params->psd->ConstValuesEnd ()),
+    m_mcs (params->mcs),
+    m_numSym (params->numSym),
+    m_senderRnti (params->senderRnti),
+    m_destinationRnti (params->destinationRnti),
+    m_size (params->size),
+    m_rbBitmap (params->rbBitmap),
+    m_pss (params->pss),
+    m_packets (params->transportBlock.Begin (), params->transportBlock.End ())
+{
+  NS_LOG_FUNCTION (this << params);
+  Ptr<NetDevice> device = params->txPhy->GetDevice ();
+  NS_ABORT_MSG_IF (device == 0 || params->txPhy->GetMobility () == 0,
+                   "The transmitter must be attached to a node and have a mobility model");
+  m_txNodeId = device->GetNode ()->GetId ();
+  m_txIfIndex = device->GetIfIndex ();
+  m_txPosition = params->txPhy->GetMobility ()->GetPosition ();
+
+  Ptr<MmWaveVehicularAntennaArrayModel> antenna = DynamicCast<MmWaveVehicularAntennaArrayModel> (params->txAntenna);
+  if (antenna)
+    {
+      m_omni = antenna->IsOmniTx ();
+      Ptr<NetDevice> beamDevice = antenna->GetCurrentDevice ();
+      if (!m_omni && beamDevice)
+        {
+          m_beamNodeId = beamDevice->GetNode ()->GetId ();
+          m_beamIfIndex = beamDevice->GetIfIndex ();
+        }
+    }
+}
+
+uint32_t
+MmWaveVehicularSignalDescriptor::GetTxNodeId (void) const
+{
+  return m_txNodeId;
+}
+
+uint32_t
+MmWaveVehicularSignalDescriptor::GetTxIfIndex (void) const
+{
+  return m_txIfIndex;
+}
+
+Vector
+MmWaveVehicularSignalDescriptor::GetTxPosition (void) const
+{
+  return m_txPosition;
+}
+
+bool
+MmWaveVehicularSignalDescriptor::IsOmni (void) const
+{
+  return m_omni;
+}
+
+Ptr<NetDevice>
+MmWaveVehicularSignalDescriptor::GetBeamDevice (void) const
+{
+  if (m_beamNodeId == NO_BEAM)
+    {
+      return 0;
+    }
+  return NodeList::GetNode (m_beamNodeId)->GetDevice (m_beamIfIndex);
+}
+
+Ptr<MmWaveSidelinkSpectrumSignalParameters>
+MmWaveVehicularSignalDescriptor::CreateSignalParameters (Ptr<MmWaveSidelinkSpectrumPhy> txPhy,
+                                                         Ptr<const SpectrumModel> model) const
+{
+  NS_LOG_FUNCTION (this << txPhy << model);
+  NS_ABORT_MSG_IF (model->GetNumBands () != m_psd.size (), "The PSD does not match the spectrum model");
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (model);
+  std::copy (m_psd.begin (), m_psd.end (), psd->ValuesBegin ());
+
+  Ptr<MmWaveSidelinkSpectrumSignalParameters> params = Create<MmWaveSidelinkSpectrumSignalParameters> ();
+  params->duration = m_duration;
+  params->psd = psd;
+  params->txPhy = txPhy;
+  params->txAntenna = txPhy->GetRxAntenna ();
+  params->mcs = m_mcs;
+  params->numSym = m_numSym;
+  params->senderRnti = m_senderRnti;
+  params->destinationRnti = m_destinationRnti;
+  params->size = m_size;
+  params->rbBitmap = m_rbBitmap;
+  params->pss = m_pss;
+  for (std::vector<Ptr<Packet> >::const_iterator it = m_packets.begin (); it != m_packets.end (); ++it)
+    {
+      params->transportBlock.AddPacket (*it);
+    }
+  return params;
+}
+
+uint32_t
+MmWaveVehicularSignalDescriptor::GetSerializedSize (void) const
+{
+  uint32_t size = 4 + 4 + 3 * 8 + 1 + 4 + 4 + 8; // device, position, beam and duration
+  size += 4 + m_psd.size () * 8;
+  size += 1 + 1 + 2 + 2 + 4 + 1; // fields of the transport block
+  size += 4 + m_rbBitmap.size () * 4;
+  size += 4;
+  for (std::vector<Ptr<Packet> >::const_iterator it = m_packets.begin (); it != m_packets.end (); ++it)
+    {
+      size += 4 + (*it)->GetSerializedSize ();
+    }
+  return size;
+}
+
+void
+MmWaveVehicularSignalDescriptor::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  i.WriteHtonU32 (m_txNodeId);
+  i.WriteHtonU32 (m_txIfIndex);
+  WriteDouble (i, m_txPosition.x);
+  WriteDouble (i, m_txPosition.y);
+  WriteDouble (i, m_txPosition.z);
+  i.WriteU8 (m_omni);
+  i.WriteHtonU32 (m_beamNodeId);
+  i.WriteHtonU32 (m_beamIfIndex);
+  i.WriteHtonU64 (m_duration.GetTimeStep ());
+
+  i.WriteHtonU32 (m_psd.size ());
+  for (std::vector<double>::const_iterator it = m_psd.begin (); it != m_psd.end (); ++it)
+    {
+      WriteDouble (i, *it);
+    }
+
+  i.WriteU8 (m_mcs);
+  i.WriteU8 (m_numSym);
+  i.WriteHtonU16 (m_senderRnti);
+  i.WriteHtonU16 (m_destinationRnti);
+  i.WriteHtonU32 (m_size);
+  i.WriteU8 (m_pss);
+  i.WriteHtonU32 (m_rbBitmap.size ());
+  for (std::vector<int>::const_iterator it = m_rbBitmap.begin (); it != m_rbBitmap.end (); ++it)
+    {
+      i.WriteHtonU32 (*it);
+    }
+
+  i.WriteHtonU32 (m_packets.size ());
+  std::vector<uint8_t> buffer;
+  for (std::vector<Ptr<Packet> >::const_iterator it = m_packets.begin (); it != m_packets.end (); ++it)
+    {
+      uint32_t size = (*it)->GetSerializedSize ();
+      buffer.resize (size);
+      (*it)->Serialize (buffer.data (), size);
+      i.WriteHtonU32 (size);
+      i.Write (buffer.data (), size);
+    }
+}
+
+uint32_t
+MmWaveVehicularSignalDescriptor::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  m_txNodeId = i.ReadNtohU32 ();
+  m_txIfIndex = i.ReadNtohU32 ();
+  m_txPosition.x = ReadDouble (i);
+  m_txPosition.y = ReadDouble (i);
+  m_txPosition.z = ReadDouble (i);
+  m_omni = i.ReadU8 ();
+  m_beamNodeId = i.ReadNtohU32 ();
+  m_beamIfIndex = i.ReadNtohU32 ();
+  m_duration = TimeStep (i.ReadNtohU64 ());
+
+  m_psd.resize (i.ReadNtohU32 ());
+  for (std::vector<double>::iterator it = m_psd.begin (); it != m_psd.end (); ++it)
+    {
+      *it = ReadDouble (i);
+    }
+
+  m_mcs = i.ReadU8 ();
+  m_numSym = i.ReadU8 ();
+  m_senderRnti = i.ReadNtohU16 ();
+  m_destinationRnti = i.ReadNtohU16 ();
+  m_size = i.ReadNtohU32 ();
+  m_pss = i.ReadU8 ();
+  m_rbBitmap.resize (i.ReadNtohU32 ());
+  for (std::vector<int>::iterator it = m_rbBitmap.begin (); it != m_rbBitmap.end (); ++it)
+    {
+      *it = static_cast<int32_t> (i.ReadNtohU32 ());
+    }
+
+  m_packets.resize (i.ReadNtohU32 ());
+  std::vector<uint8_t> buffer;
+  for (std::vector<Ptr<Packet> >::iterator it = m_packets.begin (); it != m_packets.end (); ++it)
+    {
+      uint32_t size = i.ReadNtohU32 ();
+      buffer.resize (size);
+      i.Read (buffer.data (), size);
+      *it = Create<Packet> (buffer.data (), size, true);
+    }
+  return i.GetDistanceFrom (start);
+}
+
+void
+MmWaveVehicularSignalDescriptor::Print (std::ostream &os) const
+{
+  os << "node=" << m_txNodeId
+     << " device=" << m_txIfIndex
+     << " position=" << m_txPosition
+     << " omni=" << m_omni
+     << " duration=" << m_duration
+     << " rnti=" << m_senderRnti << "->" << m_destinationRnti
+     << " size=" << m_size
+     << " packets=" << m_packets.size ();
+}
+
+} // namespace millicar
+
+} // namespace ns3
@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#ifndef MMWAVE_VEHICULAR_SIGNAL_DESCRIPTOR_H_
+#define MMWAVE_VEHICULAR_SIGNAL_DESCRIPTOR_H_
+
+#include <ns3/header.h>
+#include <ns3/vector.h>
+#include <ns3/nstime.h>
+#include <ns3/spectrum-model.h>
+#include "mmwave-sidelink-spectrum-signal-parameters.h"
+
+namespace ns3 {
+
+namespace millicar {
+
+class MmWaveSidelinkSpectrumPhy;
+
+/**
+ * \ingroup millicar
+ * Compact description of a sidelink signal, which is forwarded to the
+ * processes which simulate the receivers of other vehicles, see
+ * MmWaveVehicularDistributedSpectrumChannel.
+ *
+ * Every process holds a copy of all the vehicles, and the descriptor
+ * only carries the state of the transmitter which is not known by the
+ * other processes: the values of the transmitted PSD, the position of the
+ * transmitter, the device its beam is pointed at (the beamforming vector
+ * is recomputed from the positions), the fields of the sidelink signal
+ * and the packets of the transport block.
+ */
+class MmWaveVehicularSignalDescriptor : public Header
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+  /**
+   * Create an empty descriptor
+   */
+  MmWaveVehicularSignalDescriptor ();
+  /**
+   * Describe a signal
+   * \param params the parameters of the signal, whose transmitter is
+   *        attached to a node and has a mobility model
+   */
+  MmWaveVehicularSignalDescriptor (Ptr<const MmWaveSidelinkSpectrumSignalParameters> params);
+
+  /**
+   * \return the ID of the node of the transmitter
+   */
+  uint32_t GetTxNodeId (void) const;
+  /**
+   * \return the index of the device of the transmitter in its node
+   */
+  uint32_t GetTxIfIndex (void) const;
+  /**
+   * \return the position of the transmitter
+   */
+  Vector GetTxPosition (void) const;
+  /**
+   * \return true if the transmitter used an omnidirectional pattern
+   */
+  bool IsOmni (void) const;
+  /**
+   * \return the device the beam of the transmitter is pointed at, or 0
+   */
+  Ptr<NetDevice> GetBeamDevice (void) const;
+
+  /**
+   * Rebuild the parameters of the signal
+   * \param txPhy the phy of the transmitter in this process
+   * \param model the spectrum model of the PSD
+   * \return the parameters of the signal
+   */
+  Ptr<MmWaveSidelinkSpectrumSignalParameters> CreateSignalParameters (Ptr<MmWaveSidelinkSpectrumPhy> txPhy,
+                                                                      Ptr<const SpectrumModel> model) const;
+
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Print (std::ostream &os) const;
+
+private:
+  /// value of m_beamNodeId when the beam is not pointed at a device
+  static const uint32_t NO_BEAM = 0xffffffff;
+
+  uint32_t m_txNodeId; //!< the ID of the node of the transmitter
+  uint32_t m_txIfIndex; //!< the index of the device of the transmitter
+  Vector m_txPosition; //!< the position of the transmitter
+  bool m_omni; //!< whether the transmitter used an omnidirectional pattern
+  uint32_t m_beamNodeId; //!< the node of the device the beam is pointed at, or NO_BEAM
+  uint32_t m_beamIfIndex; //!< the index of the device the beam is pointed at
+  Time m_duration; //!< the duration of the signal
+  std::vector<double> m_psd; //!< the values of the transmitted PSD
+  uint8_t m_mcs; //!< the MCS of the transport block
+  uint8_t m_numSym; //!< the number of symbols of the transport block
+  uint16_t m_senderRnti; //!< the RNTI of the transmitter
+  uint16_t m_destinationRnti; //!< the RNTI of the destination
+  uint32_t m_size; //!< the size of the transport block
+  std::vector<int> m_rbBitmap; //!< the resource blocks bitmap
+  bool m_pss; //!< the pss flag of the signal
+  std::vector<Ptr<Packet> > m_packets; //!< the packets of the transport block
+};
+
+} // namespace millicar
+
+} // namespace ns3
+
+#endif /* MMWAVE_VEHICULAR_SIGNAL_DESCRIPTOR_H_ */
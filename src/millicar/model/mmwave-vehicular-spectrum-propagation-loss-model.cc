@@ -30,6 +30,7 @@
 #include <random>       // std::default_random_engine
 #include <ns3/boolean.h>
 #include <ns3/integer.h>
+#include <ns3/perf-counters.h>
 
 namespace ns3 {
 
@@ -180,6 +181,7 @@ MmWaveVehicularSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<c
                                                  Ptr<const MobilityModel> b) const
 {
   NS_LOG_FUNCTION (this);
+  NS_PERF_TIMER ("millicar", "MmWaveVehicularSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity");
 
   // check if the frequency is correctly set
   NS_ASSERT_MSG (m_frequency != 0.0, "Set the operating frequency first!");
@@ -367,10 +369,9 @@ MmWaveVehicularSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<c
 
   Ptr<SpectrumValue> bfPsd = CalBeamformingGain (rxPsd, channelParams, longTerm, rxSpeed, txSpeed);
 
-  SpectrumValue bfGain = (*bfPsd) / (*rxPsd);
-  uint8_t nbands = bfGain.GetSpectrumModel ()->GetNumBands ();
-
-  NS_LOG_DEBUG ("****** BF gain == " << Sum (bfGain) / nbands << " RX PSD " << Sum (*rxPsd) / nbands
+  // the gain is computed only if it is logged
+  NS_LOG_DEBUG ("****** BF gain == " << Sum ((*bfPsd) / (*rxPsd)) / rxPsd->GetValuesN ()
+                                        << " RX PSD " << Sum (*rxPsd) / rxPsd->GetValuesN ()
                                         << " a pos " << a->GetPosition ()
                                         << " a antenna ID " << txAntennaArray->GetPlanesId ()
                                         << " b pos " << b->GetPosition ()
@@ -793,6 +794,7 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
                                   uint16_t *txAntennaNum, uint16_t *rxAntennaNum,  Angles &rxAngle, Angles &txAngle,
                                   Vector speed, double dis2D, double dis3D) const
 {
+  NS_PERF_TIMER ("millicar", "MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel");
   uint8_t numOfCluster = table3gpp->m_numOfCluster;
   uint8_t raysPerCluster = table3gpp->m_raysPerCluster;
   Ptr<Params3gpp> channelParams = Create<Params3gpp> ();
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-vehicular-signal-descriptor.h"
+#include "ns3/mmwave-vehicular-helper.h"
+#include "ns3/mmwave-vehicular-net-device.h"
+#include "ns3/mmwave-sidelink-spectrum-phy.h"
+#include "ns3/mmwave-vehicular-antenna-array-model.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveVehicularSignalDescriptorTestSuite");
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+ * This is a test to check that a sidelink signal is rebuilt from its
+ * MmWaveVehicularSignalDescriptor, after the descriptor is serialized in a
+ * packet, as when it is forwarded to another process.
+ */
+class MmWaveVehicularSignalDescriptorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param omni whether the transmitter uses an omnidirectional pattern
+   */
+  MmWaveVehicularSignalDescriptorTestCase (bool omni);
+
+private:
+  /**
+   * This method run the test
+   */
+  virtual void DoRun (void);
+
+  bool m_omni; //!< whether the transmitter uses an omnidirectional pattern
+};
+
+MmWaveVehicularSignalDescriptorTestCase::MmWaveVehicularSignalDescriptorTestCase (bool omni)
+  : TestCase (omni ? "Signal descriptor of an omnidirectional transmitter"
+                   : "Signal descriptor of a beamformed transmitter"),
+    m_omni (omni)
+{
+}
+
+void
+MmWaveVehicularSignalDescriptorTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+  nodes.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (1.5, -2.0, 0.25));
+  nodes.Get (1)->GetObject<MobilityModel> ()->SetPosition (Vector (20.0, 0.0, 0.0));
+
+  Ptr<MmWaveVehicularHelper> helper = CreateObject<MmWaveVehicularHelper> ();
+  NetDeviceContainer devices = helper->InstallMmWaveVehicularNetDevices (nodes);
+  Ptr<MmWaveSidelinkSpectrumPhy> txPhy = DynamicCast<MmWaveVehicularNetDevice> (devices.Get (0))->GetPhy ()->GetSpectrumPhy ();
+  if (m_omni)
+    {
+      DynamicCast<MmWaveVehicularAntennaArrayModel> (txPhy->GetRxAntenna ())->ChangeToOmniTx ();
+    }
+  else
+    {
+      txPhy->ConfigureBeamforming (devices.Get (1));
+    }
+
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (txPhy->GetRxSpectrumModel ());
+  for (uint32_t i = 0; i < psd->GetValuesN (); i++)
+    {
+      (*psd)[i] = 1e-9 * (i + 1) / 3;
+    }
+  Ptr<MmWaveSidelinkSpectrumSignalParameters> params = Create<MmWaveSidelinkSpectrumSignalParameters> ();
+  params->duration = NanoSeconds (8920);
+  params->psd = psd;
+  params->txPhy = txPhy;
+  params->txAntenna = txPhy->GetRxAntenna ();
+  params->mcs = 12;
+  params->numSym = 3;
+  params->senderRnti = 1;
+  params->destinationRnti = 2;
+  params->size = 300;
+  params->rbBitmap = std::vector<int> (psd->GetValuesN (), 1);
+  params->rbBitmap[1] = 0;
+  params->pss = true;
+  uint8_t payload[200];
+  for (uint32_t i = 0; i < sizeof (payload); i++)
+    {
+      payload[i] = i;
+    }
+  params->transportBlock.AddPacket (Create<Packet> (payload, 100));
+  params->transportBlock.AddPacket (Create<Packet> (payload, 200));
+
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (MmWaveVehicularSignalDescriptor (params));
+  MmWaveVehicularSignalDescriptor descriptor;
+  packet->RemoveHeader (descriptor);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "Descriptor not entirely read");
+
+  NS_TEST_ASSERT_MSG_EQ (descriptor.GetTxNodeId (), nodes.Get (0)->GetId (), "Wrong transmitter");
+  NS_TEST_ASSERT_MSG_EQ (descriptor.GetTxIfIndex (), devices.Get (0)->GetIfIndex (), "Wrong transmitter");
+  NS_TEST_ASSERT_MSG_EQ (descriptor.GetTxPosition (), Vector (1.5, -2.0, 0.25), "Wrong position");
+  NS_TEST_ASSERT_MSG_EQ (descriptor.IsOmni (), m_omni, "Wrong pattern");
+  NS_TEST_ASSERT_MSG_EQ (descriptor.GetBeamDevice (), (m_omni ? Ptr<NetDevice> () : devices.Get (1)), "Wrong beam");
+
+  Ptr<MmWaveSidelinkSpectrumSignalParameters> rebuilt = descriptor.CreateSignalParameters (txPhy, txPhy->GetRxSpectrumModel ());
+  NS_TEST_ASSERT_MSG_EQ (rebuilt->duration, params->duration, "Wrong duration");
+  NS_TEST_ASSERT_MSG_EQ ((rebuilt->txPhy == txPhy), true, "Wrong transmitter");
+  NS_TEST_ASSERT_MSG_EQ ((rebuilt->psd->GetSpectrumModel () == psd->GetSpectrumModel ()), true, "Wrong spectrum model");
+  for (uint32_t i = 0; i < psd->GetValuesN (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*rebuilt->psd)[i], (*psd)[i], "Wrong PSD");
+    }
+  NS_TEST_ASSERT_MSG_EQ (uint32_t (rebuilt->mcs), 12, "Wrong MCS");
+  NS_TEST_ASSERT_MSG_EQ (uint32_t (rebuilt->numSym), 3, "Wrong number of symbols");
+  NS_TEST_ASSERT_MSG_EQ (rebuilt->senderRnti, 1, "Wrong sender");
+  NS_TEST_ASSERT_MSG_EQ (rebuilt->destinationRnti, 2, "Wrong destination");
+  NS_TEST_ASSERT_MSG_EQ (rebuilt->size, 300, "Wrong size");
+  NS_TEST_ASSERT_MSG_EQ ((rebuilt->rbBitmap == params->rbBitmap), true, "Wrong bitmap");
+  NS_TEST_ASSERT_MSG_EQ (rebuilt->pss, true, "Wrong pss");
+
+  NS_TEST_ASSERT_MSG_EQ (rebuilt->transportBlock.GetNPackets (), 2, "Wrong number of packets");
+  uint32_t i = 0;
+  for (mmwave::TransportBlock::Iterator it = rebuilt->transportBlock.Begin (); it != rebuilt->transportBlock.End (); ++it, ++i)
+    {
+      uint32_t size = (i + 1) * 100;
+      NS_TEST_ASSERT_MSG_EQ ((*it)->GetSize (), size, "Wrong packet size");
+      NS_TEST_ASSERT_MSG_EQ ((*it)->GetUid (), (*(params->transportBlock.Begin () + i))->GetUid (), "Wrong packet");
+      uint8_t data[200];
+      (*it)->CopyData (data, size);
+      NS_TEST_ASSERT_MSG_EQ (std::equal (data, data + size, payload), true, "Wrong payload");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test suite for the MmWaveVehicularSignalDescriptor
+ */
+class MmWaveVehicularSignalDescriptorTestSuite : public TestSuite
+{
+public:
+  MmWaveVehicularSignalDescriptorTestSuite ();
+};
+
+MmWaveVehicularSignalDescriptorTestSuite::MmWaveVehicularSignalDescriptorTestSuite ()
+  : TestSuite ("mmwave-vehicular-signal-descriptor", UNIT)
+{
+  AddTestCase (new MmWaveVehicularSignalDescriptorTestCase (true), TestCase::QUICK);
+  AddTestCase (new MmWaveVehicularSignalDescriptorTestCase (false), TestCase::QUICK);
+}
+
+static MmWaveVehicularSignalDescriptorTestSuite MmWaveVehicularSignalDescriptorTestSuite;
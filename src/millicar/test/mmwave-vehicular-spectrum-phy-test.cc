@@ -198,17 +198,16 @@ MmWaveVehicularSpectrumPhyTestCase1::StartTest (double dist)
   device->SetNode(nc.Get(0));
   nc.Get(0)->AddDevice(device);
 
-  // send an empty packet burst
+  // send a transport block with a single packet
   Ptr<Packet> p = Create<Packet> (20);
-  Ptr<PacketBurst> pb = CreateObject<PacketBurst> ();
-  pb->AddPacket (p);
+  mmwave::TransportBlock tb (p);
   Time duration = MilliSeconds (1); // packet duration
   uint8_t mcs = 0; // MCS
   uint8_t numSym = 14; // number of symbols dedicated to the transport block
   uint8_t size = 20; // size of the transport block
 
   // send the transport block through the spectrum channel
-  tx_ssp->StartTxDataFrames (pb, duration, mcs, size, numSym, 0, rxRnti, subChannelsForTx);
+  tx_ssp->StartTxDataFrames (tb, duration, mcs, size, numSym, 0, rxRnti, subChannelsForTx);
 
   // compute the expected SINR
   m_expectedSinr = txp + 20 * log10 (3e8 / (4 * M_PI * distance * pmc->GetCenterFrequency ())) + 114 - noiseFigure - 10 * log10 (pmc->GetBandwidth () / 1e6);
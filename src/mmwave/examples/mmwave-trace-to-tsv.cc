@@ -0,0 +1,69 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020, University of Padova, Dep. of Information Engineering, SIGNET lab
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/core-module.h"
+#include "ns3/mmwave-trace-sink.h"
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * Convert a binary trace written by MmWaveTraceSink, e.g., with
+ * ns3::MmWavePhyTrace::TraceFormat set to Binary, to the tab-separated
+ * text layout of the same trace.
+ *
+ * ./waf --run "mmwave-trace-to-tsv --input=RxPacketTrace.bin --output=RxPacketTrace.txt"
+ */
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "The binary trace", input);
+  cmd.AddValue ("output", "The text trace, the standard output if empty", output);
+  cmd.Parse (argc, argv);
+
+  MmWaveTraceReader reader;
+  if (!reader.Open (input))
+    {
+      std::cerr << "Could not read the binary trace " << input << std::endl;
+      return 1;
+    }
+
+  uint64_t nRecords;
+  if (output.empty ())
+    {
+      nRecords = reader.ConvertToText (std::cout);
+    }
+  else
+    {
+      std::ofstream os (output.c_str ());
+      if (!os.is_open ())
+        {
+          std::cerr << "Could not open " << output << std::endl;
+          return 1;
+        }
+      nRecords = reader.ConvertToText (os);
+      std::clog << nRecords << " records written to " << output << std::endl;
+    }
+  return 0;
+}
@@ -34,6 +34,7 @@
 #include "ns3/string.h"
 #include "ns3/nstime.h"
 #include <ns3/boolean.h>
+#include <ns3/enum.h>
 #include <ns3/log.h>
 #include <vector>
 #include <algorithm>
@@ -50,7 +51,8 @@ MmWaveBearerStatsCalculator::MmWaveBearerStatsCalculator ()
   : m_firstWrite (true),
     m_pendingOutput (false),
     m_aggregatedStats (true),
-    m_protocolType ("RLC")
+    m_protocolType ("RLC"),
+    m_outputFormat (TEXT)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -58,7 +60,8 @@ MmWaveBearerStatsCalculator::MmWaveBearerStatsCalculator ()
 MmWaveBearerStatsCalculator::MmWaveBearerStatsCalculator (std::string protocolType)
   : m_firstWrite (true),
     m_pendingOutput (false),
-    m_aggregatedStats (true)
+    m_aggregatedStats (true),
+    m_outputFormat (TEXT)
 {
   NS_LOG_FUNCTION (this);
   m_protocolType = protocolType;
@@ -111,6 +114,13 @@ MmWaveBearerStatsCalculator::GetTypeId (void)
                    StringValue ("UlPdcpStats.txt"),
                    MakeStringAccessor (&MmWaveBearerStatsCalculator::SetUlPdcpOutputFilename),
                    MakeStringChecker ())
+    .AddAttribute ("OutputFormat",
+                   "Format of the output files of the aggregated statistics. Columnar files "
+                   "are written with ColumnarFileWriter and can be read with ColumnarFileReader.",
+                   EnumValue (MmWaveBearerStatsCalculator::TEXT),
+                   MakeEnumAccessor (&MmWaveBearerStatsCalculator::m_outputFormat),
+                   MakeEnumChecker (MmWaveBearerStatsCalculator::TEXT, "Text",
+                                    MmWaveBearerStatsCalculator::COLUMNAR, "Columnar"))
   ;
   return tid;
 }
@@ -123,6 +133,17 @@ MmWaveBearerStatsCalculator::DoDispose ()
     {
       ShowResults ();
     }
+  // write the footers, without them the files can not be read
+  if (m_ulColumnarWriter)
+    {
+      m_ulColumnarWriter->Close ();
+      m_ulColumnarWriter = 0;
+    }
+  if (m_dlColumnarWriter)
+    {
+      m_dlColumnarWriter->Close ();
+      m_dlColumnarWriter = 0;
+    }
 }
 
 void
@@ -178,11 +199,11 @@ MmWaveBearerStatsCalculator::UlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t r
     if (!m_ulOutFile.is_open ())
       {
         m_ulOutFile.open (GetUlOutputFilename ().c_str ());
-        m_ulOutFile << "TYPE\tTIME\tCellId\tIMSI\tRNTI\tLCID\tSIZE\tDELAY\t" << std::endl;
+        m_ulOutFile << "TYPE\tTIME\tCellId\tIMSI\tRNTI\tLCID\tSIZE\tDELAY\t" << '\n';
       }
     m_ulOutFile << "Tx\t" << Simulator::Now ().GetNanoSeconds () / 1.0e9 << "\t" 
     << cellId << "\t" << imsi << "\t" << rnti << "\t" << (uint32_t) lcid << "\t" 
-    << packetSize << "\t" << 0 << "\t" << std::endl;
+    << packetSize << "\t" << 0 << "\t" << '\n';
   }
 }
 
@@ -207,11 +228,11 @@ MmWaveBearerStatsCalculator::DlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t r
     if (!m_dlOutFile.is_open ())
       {
         m_dlOutFile.open (GetDlOutputFilename ().c_str ());
-        m_dlOutFile << "TYPE\tTIME\tCellId\tIMSI\tRNTI\tLCID\tSIZE\tDELAY\t" << std::endl;
+        m_dlOutFile << "TYPE\tTIME\tCellId\tIMSI\tRNTI\tLCID\tSIZE\tDELAY\t" << '\n';
       }
     m_dlOutFile << "Tx\t" << Simulator::Now ().GetNanoSeconds () / 1.0e9 << "\t" 
     << cellId << "\t" << imsi << "\t" << rnti << "\t" << (uint32_t) lcid << "\t" 
-    << packetSize << "\t" << 0 << "\t" << std::endl;
+    << packetSize << "\t" << 0 << "\t" << '\n';
   }
 }
 
@@ -246,11 +267,11 @@ MmWaveBearerStatsCalculator::UlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t r
     if (!m_ulOutFile.is_open ())
       {
         m_ulOutFile.open (GetUlOutputFilename ().c_str ());
-        m_ulOutFile << "TYPE\tTIME\tCellId\tIMSI\tRNTI\tLCID\tSIZE\tDELAY\t" << std::endl;
+        m_ulOutFile << "TYPE\tTIME\tCellId\tIMSI\tRNTI\tLCID\tSIZE\tDELAY\t" << '\n';
       }
     m_ulOutFile << "Rx\t" << Simulator::Now ().GetNanoSeconds () / 1.0e9 << "\t" 
     << cellId << "\t" << imsi << "\t" << rnti << "\t" << (uint32_t) lcid << "\t" 
-    << packetSize << "\t" << delay << "\t" << std::endl;
+    << packetSize << "\t" << delay << "\t" << '\n';
   }
 }
 
@@ -284,11 +305,11 @@ MmWaveBearerStatsCalculator::DlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t r
     if (!m_dlOutFile.is_open ())
     {
       m_dlOutFile.open (GetDlOutputFilename ().c_str ());
-      m_dlOutFile << "TYPE\tTIME\tCellId\tIMSI\tRNTI\tLCID\tSIZE\tDELAY\t" << std::endl;
+      m_dlOutFile << "TYPE\tTIME\tCellId\tIMSI\tRNTI\tLCID\tSIZE\tDELAY\t" << '\n';
     }
     m_dlOutFile << "Rx\t" << Simulator::Now ().GetNanoSeconds () / 1.0e9 << "\t" 
     << cellId << "\t" << imsi << "\t" << rnti << "\t" << (uint32_t) lcid << "\t" 
-    << packetSize << "\t" << delay << "\t" << std::endl;
+    << packetSize << "\t" << delay << "\t" << '\n';
   }
 }
 
@@ -299,6 +320,14 @@ MmWaveBearerStatsCalculator::ShowResults (void)
   NS_LOG_FUNCTION (this << GetUlOutputFilename ().c_str () << GetDlOutputFilename ().c_str ());
   NS_LOG_INFO ("Write stats in " << GetUlOutputFilename ().c_str () << " and in " << GetDlOutputFilename ().c_str ());
 
+  if (m_outputFormat == COLUMNAR)
+    {
+      WriteColumnarResults (m_ulColumnarWriter, GetUlOutputFilename (), true);
+      WriteColumnarResults (m_dlColumnarWriter, GetDlOutputFilename (), false);
+      m_pendingOutput = false;
+      return;
+    }
+
   std::ofstream ulOutFile;
   std::ofstream dlOutFile;
 
@@ -321,11 +350,11 @@ MmWaveBearerStatsCalculator::ShowResults (void)
       ulOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
       ulOutFile << "delay\tstdDev\tmin\tmax\t";
       ulOutFile << "PduSize\tstdDev\tmin\tmax";
-      ulOutFile << std::endl;
+      ulOutFile << '\n';
       dlOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
       dlOutFile << "delay\tstdDev\tmin\tmax\t";
       dlOutFile << "PduSize\tstdDev\tmin\tmax";
-      dlOutFile << std::endl;
+      dlOutFile << '\n';
     }
   else
     {
@@ -390,7 +419,7 @@ MmWaveBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
         {
           outFile << (*it) << "\t";
         }
-      outFile << std::endl;
+      outFile << '\n';
     }
 
   outFile.close ();
@@ -435,12 +464,102 @@ MmWaveBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
         {
           outFile << (*it) << "\t";
         }
-      outFile << std::endl;
+      outFile << '\n';
     }
 
   outFile.close ();
 }
 
+void
+MmWaveBearerStatsCalculator::WriteColumnarResults (Ptr<ColumnarFileWriter> &writer, std::string filename, bool uplink)
+{
+  NS_LOG_FUNCTION (this << filename << uplink);
+
+  // same columns as the text output
+  enum
+  {
+    START, END, CELL_ID, IMSI, RNTI, LCID, TX_PDUS, TX_BYTES, RX_PDUS, RX_BYTES,
+    DELAY, DELAY_STD_DEV, DELAY_MIN, DELAY_MAX,
+    PDU_SIZE, PDU_SIZE_STD_DEV, PDU_SIZE_MIN, PDU_SIZE_MAX
+  };
+
+  if (!writer)
+    {
+      writer = Create<ColumnarFileWriter> ();
+      writer->AddColumn ("start", ColumnarFile::DOUBLE);
+      writer->AddColumn ("end", ColumnarFile::DOUBLE);
+      writer->AddColumn ("CellId", ColumnarFile::DICTIONARY);
+      writer->AddColumn ("IMSI", ColumnarFile::DICTIONARY);
+      writer->AddColumn ("RNTI", ColumnarFile::DICTIONARY);
+      writer->AddColumn ("LCID", ColumnarFile::DICTIONARY);
+      writer->AddColumn ("nTxPDUs", ColumnarFile::UINT64);
+      writer->AddColumn ("TxBytes", ColumnarFile::UINT64);
+      writer->AddColumn ("nRxPDUs", ColumnarFile::UINT64);
+      writer->AddColumn ("RxBytes", ColumnarFile::UINT64);
+      writer->AddColumn ("delay", ColumnarFile::DOUBLE);
+      writer->AddColumn ("delayStdDev", ColumnarFile::DOUBLE);
+      writer->AddColumn ("delayMin", ColumnarFile::DOUBLE);
+      writer->AddColumn ("delayMax", ColumnarFile::DOUBLE);
+      writer->AddColumn ("PduSize", ColumnarFile::DOUBLE);
+      writer->AddColumn ("PduSizeStdDev", ColumnarFile::DOUBLE);
+      writer->AddColumn ("PduSizeMin", ColumnarFile::DOUBLE);
+      writer->AddColumn ("PduSizeMax", ColumnarFile::DOUBLE);
+      if (!writer->Open (filename))
+        {
+          NS_LOG_ERROR ("Can't open file " << filename.c_str ());
+          writer = 0;
+          return;
+        }
+    }
+
+  // the keys of the map are unique (IMSI, LCID) pairs
+  Uint32Map &txPackets = uplink ? m_ulTxPackets : m_dlTxPackets;
+  Time endTime = m_startTime + m_epochDuration;
+  for (Uint32Map::iterator it = txPackets.begin (); it != txPackets.end (); ++it)
+    {
+      ImsiLcidPair_t p = it->first;
+      writer->SetDouble (START, m_startTime.GetNanoSeconds () / 1.0e9);
+      writer->SetDouble (END, endTime.GetNanoSeconds () / 1.0e9);
+      writer->SetUint (IMSI, p.m_imsi);
+      writer->SetUint (RNTI, m_flowId[p].m_rnti);
+      writer->SetUint (LCID, m_flowId[p].m_lcId);
+
+      std::vector<double> delayStats;
+      std::vector<double> pduSizeStats;
+      if (uplink)
+        {
+          writer->SetUint (CELL_ID, GetUlCellId (p.m_imsi, p.m_lcId));
+          writer->SetUint (TX_PDUS, GetUlTxPackets (p.m_imsi, p.m_lcId));
+          writer->SetUint (TX_BYTES, GetUlTxData (p.m_imsi, p.m_lcId));
+          writer->SetUint (RX_PDUS, GetUlRxPackets (p.m_imsi, p.m_lcId));
+          writer->SetUint (RX_BYTES, GetUlRxData (p.m_imsi, p.m_lcId));
+          delayStats = GetUlDelayStats (p.m_imsi, p.m_lcId);
+          pduSizeStats = GetUlPduSizeStats (p.m_imsi, p.m_lcId);
+        }
+      else
+        {
+          writer->SetUint (CELL_ID, GetDlCellId (p.m_imsi, p.m_lcId));
+          writer->SetUint (TX_PDUS, GetDlTxPackets (p.m_imsi, p.m_lcId));
+          writer->SetUint (TX_BYTES, GetDlTxData (p.m_imsi, p.m_lcId));
+          writer->SetUint (RX_PDUS, GetDlRxPackets (p.m_imsi, p.m_lcId));
+          writer->SetUint (RX_BYTES, GetDlRxData (p.m_imsi, p.m_lcId));
+          delayStats = GetDlDelayStats (p.m_imsi, p.m_lcId);
+          pduSizeStats = GetDlPduSizeStats (p.m_imsi, p.m_lcId);
+        }
+
+      // delays in seconds, as in the text output
+      for (uint32_t i = 0; i < delayStats.size (); ++i)
+        {
+          writer->SetDouble (DELAY + i, delayStats[i] * 1e-9);
+        }
+      for (uint32_t i = 0; i < pduSizeStats.size (); ++i)
+        {
+          writer->SetDouble (PDU_SIZE + i, pduSizeStats[i]);
+        }
+      writer->EndRow ();
+    }
+}
+
 void
 MmWaveBearerStatsCalculator::ResetResults (void)
 {
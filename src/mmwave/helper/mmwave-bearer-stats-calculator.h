@@ -35,6 +35,7 @@
 #include "ns3/object.h"
 #include "ns3/basic-data-calculators.h"
 #include "ns3/lte-common.h"
+#include "ns3/columnar-file-writer.h"
 #include <string>
 #include <map>
 #include <fstream>
@@ -382,6 +383,16 @@ private:
   void
   WriteDlResults (std::ofstream& outFile);
 
+  /**
+   * Writes collected statistics to a columnar output file,
+   * which is created during the first call.
+   * @param writer the writer of the file
+   * @param filename the name of the file
+   * @param uplink true for the UL statistics, false for the DL ones
+   */
+  void
+  WriteColumnarResults (Ptr<ColumnarFileWriter> &writer, std::string filename, bool uplink);
+
   /**
    * Erases collected statistics
    */
@@ -463,6 +474,20 @@ private:
 
   std::ofstream m_dlOutFile;
   std::ofstream m_ulOutFile;
+
+  /**
+   * Format of the output files of the aggregated statistics
+   */
+  enum OutputFormat
+  {
+    TEXT = 0,    //!< tab-separated text
+    COLUMNAR = 1 //!< columnar binary file, see ColumnarFileWriter
+  };
+
+  OutputFormat m_outputFormat; //!< format of the output files
+
+  Ptr<ColumnarFileWriter> m_dlColumnarWriter; //!< writer of the DL columnar output file
+  Ptr<ColumnarFileWriter> m_ulColumnarWriter; //!< writer of the UL columnar output file
 };
 
 } // namespace mmwave
@@ -415,7 +415,7 @@ MmWaveBearerStatsConnector::PrintMmWaveSinr (uint64_t imsi, uint16_t cellId, lon
     {
       m_mmWaveSinrOutFile.open (GetMmWaveSinrOutputFilename ().c_str ());
     }
-  m_mmWaveSinrOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << cellId << " " << 10 * std::log10 (sinr) << std::endl;
+  m_mmWaveSinrOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << cellId << " " << 10 * std::log10 (sinr) << '\n';
 }
 
 void
@@ -432,7 +432,7 @@ MmWaveBearerStatsConnector::PrintLteSinr (uint16_t rnti, uint16_t cellId, double
     {
       m_lteSinrOutFile.open (GetLteSinrOutputFilename ().c_str ());
     }
-  m_lteSinrOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << rnti << " " << cellId << " " << sinr << std::endl;
+  m_lteSinrOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << rnti << " " << cellId << " " << sinr << '\n';
 }
 
 std::string
@@ -525,7 +525,7 @@ MmWaveBearerStatsConnector::PrintEnbStartHandover (uint64_t imsi, uint16_t sourc
     {
       m_enbHandoverStartOutFile.open (GetEnbHandoverStartOutputFilename ().c_str ());
     }
-  m_enbHandoverStartOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << sourceCellid << " " << targetCellId << std::endl;
+  m_enbHandoverStartOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << sourceCellid << " " << targetCellId << '\n';
 }
 
 void
@@ -536,7 +536,7 @@ MmWaveBearerStatsConnector::PrintEnbEndHandover (uint64_t imsi, uint16_t targetC
     {
       m_enbHandoverEndOutFile.open (GetEnbHandoverEndOutputFilename ().c_str ());
     }
-  m_enbHandoverEndOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << targetCellId << std::endl;
+  m_enbHandoverEndOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << targetCellId << '\n';
 }
 
 void
@@ -547,7 +547,7 @@ MmWaveBearerStatsConnector::PrintUeStartHandover (uint64_t imsi, uint16_t source
     {
       m_ueHandoverStartOutFile.open (GetUeHandoverStartOutputFilename ().c_str ());
     }
-  m_ueHandoverStartOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << sourceCellid << " " << targetCellId << std::endl;
+  m_ueHandoverStartOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << sourceCellid << " " << targetCellId << '\n';
 }
 
 void
@@ -558,13 +558,13 @@ MmWaveBearerStatsConnector::PrintUeEndHandover (uint64_t imsi, uint16_t targetCe
     {
       m_ueHandoverEndOutFile.open (GetUeHandoverEndOutputFilename ().c_str ());
     }
-  m_ueHandoverEndOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << targetCellId << std::endl;
+  m_ueHandoverEndOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << targetCellId << '\n';
 
   if (!m_cellIdInTimeHandoverOutFile.is_open ())
     {
       m_cellIdInTimeHandoverOutFile.open (GetCellIdStatsOutputFilename ().c_str ());
     }
-  m_cellIdInTimeHandoverOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << targetCellId << std::endl;
+  m_cellIdInTimeHandoverOutFile << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << imsi << " " << rnti << " " << targetCellId << '\n';
 }
 
 void
@@ -20,6 +20,9 @@
 
 #include <ns3/log.h>
 #include "mmwave-mac-trace.h"
+#include <ns3/simulator.h>
+#include <ns3/enum.h>
+#include <ns3/boolean.h>
 
 namespace ns3 {
 
@@ -29,8 +32,10 @@ namespace mmwave {
 
 NS_OBJECT_ENSURE_REGISTERED (MmWaveMacTrace);
 
-std::ofstream MmWaveMacTrace::m_schedAllocTraceFile {};
+Ptr<MmWaveTraceSink> MmWaveMacTrace::m_schedAllocTraceSink {};
 std::string MmWaveMacTrace::m_schedAllocTraceFilename {};
+MmWaveTraceSink::Format MmWaveMacTrace::m_traceFormat = MmWaveTraceSink::TEXT;
+bool MmWaveMacTrace::m_writerThread = false;
 
 MmWaveMacTrace::MmWaveMacTrace ()
 {
@@ -38,10 +43,8 @@ MmWaveMacTrace::MmWaveMacTrace ()
 
 MmWaveMacTrace::~MmWaveMacTrace ()
 {
-  if (m_schedAllocTraceFile.is_open ())
-    {
-      m_schedAllocTraceFile.close ();
-    }
+  // close the file
+  m_schedAllocTraceSink = 0;
 }
 
 TypeId
@@ -55,6 +58,19 @@ MmWaveMacTrace::GetTypeId (void)
                    StringValue ("EnbSchedAllocTraces.txt"),
                    MakeStringAccessor (&MmWaveMacTrace::SetOutputFilename),
                    MakeStringChecker ())
+    .AddAttribute ("TraceFormat",
+                   "Format of the MAC-related traces. Binary traces can be converted to text "
+                   "with the mmwave-trace-to-tsv program.",
+                   EnumValue (MmWaveTraceSink::TEXT),
+                   MakeEnumAccessor (&MmWaveMacTrace::SetTraceFormat),
+                   MakeEnumChecker (MmWaveTraceSink::TEXT, "Text",
+                                    MmWaveTraceSink::BINARY, "Binary"))
+    .AddAttribute ("WriterThread",
+                   "If true, the MAC-related traces are formatted and written to the file "
+                   "by a background thread, instead of the simulation thread.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveMacTrace::SetWriterThread),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -63,28 +79,42 @@ void
 MmWaveMacTrace::ReportEnbSchedulingInfo (Ptr<MmWaveMacTrace> enbStats, MmWaveEnbMac::MmWaveSchedTraceInfo schedParams)
 {
     // Open the output file if it is not open yet
-    if (!m_schedAllocTraceFile.is_open ())
+    if (!m_schedAllocTraceSink)
     {
-      m_schedAllocTraceFile.open (m_schedAllocTraceFilename.c_str ());
-      if (!m_schedAllocTraceFile.is_open ())
+      MmWaveTraceSchema schema;
+      schema.AddColumn ("frame", MmWaveTraceSchema::UINT16)
+      .AddColumn ("subF", MmWaveTraceSchema::UINT8)
+      .AddColumn ("slot", MmWaveTraceSchema::UINT8)
+      .AddColumn ("rnti", MmWaveTraceSchema::UINT16)
+      .AddColumn ("firstSym", MmWaveTraceSchema::UINT8)
+      .AddColumn ("numSym", MmWaveTraceSchema::UINT8)
+      .AddColumn ("type", MmWaveTraceSchema::UINT8)
+      .AddColumn ("tddMode", MmWaveTraceSchema::UINT8)
+      .AddColumn ("retxNum", MmWaveTraceSchema::UINT8)
+      .AddColumn ("ccId", MmWaveTraceSchema::UINT8);
+      if (m_writerThread)
         {
-          NS_FATAL_ERROR ("Could not open tracefile");
+          m_schedAllocTraceSink = Create<MmWaveThreadedTraceSink> (m_schedAllocTraceFilename, schema, m_traceFormat);
         }
-      m_schedAllocTraceFile << "frame\tsubF\tslot\trnti\tfirstSym\tnumSym\ttype\ttddMode\tretxNum\tccId" << std::endl;
+      else
+        {
+          m_schedAllocTraceSink = Create<MmWaveTraceSink> (m_schedAllocTraceFilename, schema, m_traceFormat);
+        }
+      // make the trace complete when the simulation ends
+      Simulator::ScheduleDestroy (&MmWaveMacTrace::Flush);
     }
-    
 
     SlotAllocInfo allocInfo = schedParams.m_indParam.m_slotAllocInfo;
     SfnSf dlSfn = schedParams.m_indParam.m_sfnSf;   // Holds the intended slot, subframe and frame info
 
-    for (auto iTti : allocInfo.m_ttiAllocInfo)
+    for (const auto &iTti : allocInfo.m_ttiAllocInfo)
     {
       // Trace the incoming alloc info
-      m_schedAllocTraceFile << +dlSfn.m_frameNum << "\t" << +dlSfn.m_sfNum << "\t"
-                            << +dlSfn.m_slotNum << "\t" << +iTti.m_dci.m_rnti << "\t" 
-                            << +iTti.m_dci.m_symStart << "\t" << +iTti.m_dci.m_numSym << "\t" 
-                            << iTti.m_ttiType << "\t" << iTti.m_tddMode << "\t" 
-                            << +iTti.m_dci.m_rv << "\t" << +schedParams.m_ccId << std::endl;
+      m_schedAllocTraceSink->Append () << dlSfn.m_frameNum << dlSfn.m_sfNum
+                                       << dlSfn.m_slotNum << iTti.m_dci.m_rnti
+                                       << iTti.m_dci.m_symStart << iTti.m_dci.m_numSym
+                                       << iTti.m_ttiType << iTti.m_tddMode
+                                       << iTti.m_dci.m_rv << schedParams.m_ccId;
     }   
 }
 
@@ -95,6 +125,29 @@ MmWaveMacTrace::SetOutputFilename (std::string fileName)
   m_schedAllocTraceFilename = fileName;
 }
 
+void
+MmWaveMacTrace::SetTraceFormat (MmWaveTraceSink::Format format)
+{
+  NS_LOG_INFO ("Format: " << format);
+  m_traceFormat = format;
+}
+
+void
+MmWaveMacTrace::SetWriterThread (bool writerThread)
+{
+  NS_LOG_INFO ("Writer thread: " << writerThread);
+  m_writerThread = writerThread;
+}
+
+void
+MmWaveMacTrace::Flush (void)
+{
+  if (m_schedAllocTraceSink)
+    {
+      m_schedAllocTraceSink->Flush ();
+    }
+}
+
 } // namespace mmwave
 
 } /* namespace ns3 */
@@ -24,6 +24,8 @@
 #include <ns3/object.h>
 #include <ns3/mmwave-phy-mac-common.h>
 #include <ns3/mmwave-enb-mac.h>
+#include <ns3/mmwave-trace-sink.h>
+#include <ns3/mmwave-threaded-trace-sink.h>
 #include <fstream>
 
 namespace ns3 {
@@ -51,6 +53,25 @@ public:
   */
   void SetOutputFilename (std::string fileName);
 
+ /**
+  * Sets the format of the MAC-related traces
+  * 
+  * \param format the format
+  */
+  void SetTraceFormat (MmWaveTraceSink::Format format);
+
+ /**
+  * Sets whether the MAC-related traces are written by a background thread
+  * 
+  * \param writerThread true to use a MmWaveThreadedTraceSink
+  */
+  void SetWriterThread (bool writerThread);
+
+ /**
+  * Write the buffered records of the MAC-related traces to the file
+  */
+  static void Flush (void);
+
  /**
   * Callback used to trace the reception of a scheduling decision by the eNB and from the scheduler itself.
   * 
@@ -60,8 +81,10 @@ public:
   static void ReportEnbSchedulingInfo (Ptr<MmWaveMacTrace> enbStats, MmWaveEnbMac::MmWaveSchedTraceInfo schedParams);
 
 private:
-  static std::ofstream m_schedAllocTraceFile;  //!< Output stream for the scheduling allocations trace
+  static Ptr<MmWaveTraceSink> m_schedAllocTraceSink;  //!< Output sink for the scheduling allocations trace
   static std::string m_schedAllocTraceFilename;   //!< Output filename for the scheduling allocations trace
+  static MmWaveTraceSink::Format m_traceFormat;   //!< Format of the scheduling allocations trace
+  static bool m_writerThread;   //!< True if the scheduling allocations trace is written by a background thread
 };
 
 } // namespace mmwave
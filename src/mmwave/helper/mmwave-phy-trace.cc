@@ -36,6 +36,8 @@
 #include <ns3/log.h>
 #include "mmwave-phy-trace.h"
 #include <ns3/simulator.h>
+#include <ns3/enum.h>
+#include <ns3/boolean.h>
 #include <stdio.h>
 
 namespace ns3 {
@@ -46,25 +48,74 @@ namespace mmwave {
 
 NS_OBJECT_ENSURE_REGISTERED (MmWavePhyTrace);
 
-std::ofstream MmWavePhyTrace::m_rxPacketTraceFile;
+Ptr<MmWaveTraceSink> MmWavePhyTrace::m_rxPacketTraceSink;
 std::string MmWavePhyTrace::m_rxPacketTraceFilename;
 
-std::ofstream MmWavePhyTrace::m_ulPhyTraceFile {};
+Ptr<MmWaveTraceSink> MmWavePhyTrace::m_ulPhyTraceSink {};
 std::string MmWavePhyTrace::m_ulPhyTraceFilename {};
 
-std::ofstream MmWavePhyTrace::m_dlPhyTraceFile {};
+Ptr<MmWaveTraceSink> MmWavePhyTrace::m_dlPhyTraceSink {};
 std::string MmWavePhyTrace::m_dlPhyTraceFilename {};
 
+MmWaveTraceSink::Format MmWavePhyTrace::m_traceFormat = MmWaveTraceSink::TEXT;
+bool MmWavePhyTrace::m_writerThread = false;
+
+/**
+ * \return the schema of the PHY reception trace
+ */
+static MmWaveTraceSchema
+GetRxPacketTraceSchema (void)
+{
+  MmWaveTraceSchema schema;
+  schema.AddColumn ("DL/UL", MmWaveTraceSchema::LABEL)
+  .AddColumn ("time", MmWaveTraceSchema::DOUBLE)
+  .AddColumn ("frame", MmWaveTraceSchema::UINT16)
+  .AddColumn ("subF", MmWaveTraceSchema::UINT8)
+  .AddColumn ("slot", MmWaveTraceSchema::UINT8)
+  .AddColumn ("1stSym", MmWaveTraceSchema::UINT8)
+  .AddColumn ("symbol#", MmWaveTraceSchema::UINT8)
+  .AddColumn ("cellId", MmWaveTraceSchema::UINT64)
+  .AddColumn ("rnti", MmWaveTraceSchema::UINT16)
+  .AddColumn ("ccId", MmWaveTraceSchema::UINT8)
+  .AddColumn ("tbSize", MmWaveTraceSchema::UINT32)
+  .AddColumn ("mcs", MmWaveTraceSchema::UINT8)
+  .AddColumn ("rv", MmWaveTraceSchema::UINT8)
+  .AddColumn ("SINR(dB)", MmWaveTraceSchema::DOUBLE)
+  .AddColumn ("corrupt", MmWaveTraceSchema::UINT8)
+  .AddColumn ("TBler", MmWaveTraceSchema::DOUBLE)
+  .AddLabel ("DL")
+  .AddLabel ("UL");
+  return schema;
+}
+
+/**
+ * \return the schema of the UL and DL PHY transmission traces
+ */
+static MmWaveTraceSchema
+GetPhyTransmissionTraceSchema (void)
+{
+  MmWaveTraceSchema schema;
+  schema.AddColumn ("frame", MmWaveTraceSchema::UINT16)
+  .AddColumn ("subF", MmWaveTraceSchema::UINT8)
+  .AddColumn ("slot", MmWaveTraceSchema::UINT8)
+  .AddColumn ("rnti", MmWaveTraceSchema::UINT16)
+  .AddColumn ("firstSym", MmWaveTraceSchema::UINT8)
+  .AddColumn ("numSym", MmWaveTraceSchema::UINT8)
+  .AddColumn ("type", MmWaveTraceSchema::UINT8)
+  .AddColumn ("tddMode", MmWaveTraceSchema::UINT8)
+  .AddColumn ("retxNum", MmWaveTraceSchema::UINT8)
+  .AddColumn ("ccId", MmWaveTraceSchema::UINT8);
+  return schema;
+}
+
 MmWavePhyTrace::MmWavePhyTrace ()
 {
 }
 
 MmWavePhyTrace::~MmWavePhyTrace ()
 {
-  if (m_rxPacketTraceFile.is_open ())
-    {
-      m_rxPacketTraceFile.close ();
-    }
+  // close the file
+  m_rxPacketTraceSink = 0;
 }
 
 TypeId
@@ -88,7 +139,19 @@ MmWavePhyTrace::GetTypeId (void)
                    StringValue ("DlPhyTransmissionTrace.txt"),
                    MakeStringAccessor (&MmWavePhyTrace::SetDlPhyTxOutputFilename),
                    MakeStringChecker ())
-          
+    .AddAttribute ("TraceFormat",
+                   "Format of the PHY traces. Binary traces can be converted to text "
+                   "with the mmwave-trace-to-tsv program.",
+                   EnumValue (MmWaveTraceSink::TEXT),
+                   MakeEnumAccessor (&MmWavePhyTrace::SetTraceFormat),
+                   MakeEnumChecker (MmWaveTraceSink::TEXT, "Text",
+                                    MmWaveTraceSink::BINARY, "Binary"))
+    .AddAttribute ("WriterThread",
+                   "If true, the PHY traces are formatted and written to the files "
+                   "by a background thread, instead of the simulation thread.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWavePhyTrace::SetWriterThread),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -114,6 +177,55 @@ MmWavePhyTrace::SetDlPhyTxOutputFilename (std::string fileName)
   m_dlPhyTraceFilename = fileName;
 }
 
+void
+MmWavePhyTrace::SetTraceFormat (MmWaveTraceSink::Format format)
+{
+  NS_LOG_INFO ("PHY trace format: " << format);
+  m_traceFormat = format;
+}
+
+void
+MmWavePhyTrace::SetWriterThread (bool writerThread)
+{
+  NS_LOG_INFO ("PHY trace writer thread: " << writerThread);
+  m_writerThread = writerThread;
+}
+
+void
+MmWavePhyTrace::Flush (void)
+{
+  if (m_rxPacketTraceSink)
+    {
+      m_rxPacketTraceSink->Flush ();
+    }
+  if (m_ulPhyTraceSink)
+    {
+      m_ulPhyTraceSink->Flush ();
+    }
+  if (m_dlPhyTraceSink)
+    {
+      m_dlPhyTraceSink->Flush ();
+    }
+}
+
+void
+MmWavePhyTrace::OpenSink (Ptr<MmWaveTraceSink> &sink, const std::string &fileName, const MmWaveTraceSchema &schema)
+{
+  if (!sink)
+    {
+      if (m_writerThread)
+        {
+          sink = Create<MmWaveThreadedTraceSink> (fileName, schema, m_traceFormat);
+        }
+      else
+        {
+          sink = Create<MmWaveTraceSink> (fileName, schema, m_traceFormat);
+        }
+      // make the traces complete when the simulation ends
+      Simulator::ScheduleDestroy (&MmWavePhyTrace::Flush);
+    }
+}
+
 void
 MmWavePhyTrace::ReportCurrentCellRsrpSinrCallback (Ptr<MmWavePhyTrace> phyStats, std::string path,
                                                      uint64_t imsi, SpectrumValue& sinr, SpectrumValue& power)
@@ -191,65 +303,41 @@ MmWavePhyTrace::ReportDLTbSize (uint64_t imsi, uint64_t tbSize)
 void 
 MmWavePhyTrace::ReportUlPhyTransmissionCallback (Ptr<MmWavePhyTrace> phyStats, PhyTransmissionTraceParams param)
 {
-  if (!m_ulPhyTraceFile.is_open ())
-    {
-      m_ulPhyTraceFile.open (m_ulPhyTraceFilename.c_str ());
-      if (!m_ulPhyTraceFile.is_open ())
-        {
-          NS_FATAL_ERROR ("Could not open tracefile");
-        }
-      m_ulPhyTraceFile << "frame\tsubF\tslot\trnti\tfirstSym\tnumSym\ttype\ttddMode\tretxNum\tccId" << std::endl;
-    }
+  OpenSink (m_ulPhyTraceSink, m_ulPhyTraceFilename, GetPhyTransmissionTraceSchema ());
 
   // Trace the UL PHY transmission info
-  m_ulPhyTraceFile << +param.m_frameNum << "\t" << +param.m_sfNum << "\t"
-                   << +param.m_slotNum << "\t" << +param.m_rnti << "\t" 
-                   << +param.m_symStart << "\t" << +param.m_numSym << "\t" 
-                   << +param.m_ttiType << "\t" << +param.m_tddMode << "\t" 
-                   << +param.m_rv << "\t" << +param.m_ccId << std::endl;
+  m_ulPhyTraceSink->Append () << param.m_frameNum << param.m_sfNum
+                             << param.m_slotNum << param.m_rnti
+                             << param.m_symStart << param.m_numSym
+                             << param.m_ttiType << param.m_tddMode
+                             << param.m_rv << param.m_ccId;
 }
 
 void 
 MmWavePhyTrace::ReportDlPhyTransmissionCallback (Ptr<MmWavePhyTrace> phyStats, PhyTransmissionTraceParams param)
 {
-  if (!m_dlPhyTraceFile.is_open ())
-    {
-      m_dlPhyTraceFile.open (m_dlPhyTraceFilename.c_str ());
-      if (!m_dlPhyTraceFile.is_open ())
-        {
-          NS_FATAL_ERROR ("Could not open tracefile");
-        }
-      m_dlPhyTraceFile << "frame\tsubF\tslot\trnti\tfirstSym\tnumSym\ttype\ttddMode\tretxNum\tccId" << std::endl;
-    }
+  OpenSink (m_dlPhyTraceSink, m_dlPhyTraceFilename, GetPhyTransmissionTraceSchema ());
 
   // Trace the DL PHY transmission info
-  m_dlPhyTraceFile << +param.m_frameNum << "\t" << +param.m_sfNum << "\t"
-                   << +param.m_slotNum << "\t" << +param.m_rnti << "\t" 
-                   << +param.m_symStart << "\t" << +param.m_numSym << "\t" 
-                   << +param.m_ttiType << "\t" << +param.m_tddMode << "\t" 
-                   << +param.m_rv << "\t" << +param.m_ccId << std::endl;
+  m_dlPhyTraceSink->Append () << param.m_frameNum << param.m_sfNum
+                             << param.m_slotNum << param.m_rnti
+                             << param.m_symStart << param.m_numSym
+                             << param.m_ttiType << param.m_tddMode
+                             << param.m_rv << param.m_ccId;
 }
 
 void
 MmWavePhyTrace::RxPacketTraceUeCallback (Ptr<MmWavePhyTrace> phyStats, std::string path, RxPacketTraceParams params)
 {
-  if (!m_rxPacketTraceFile.is_open ())
-    {
-      m_rxPacketTraceFile.open (m_rxPacketTraceFilename.c_str ());
-      m_rxPacketTraceFile << "DL/UL\ttime\tframe\tsubF\tslot\t1stSym\tsymbol#\tcellId\trnti\tccId\ttbSize\tmcs\trv\tSINR(dB)\tcorrupt\tTBler" << std::endl;
-      if (!m_rxPacketTraceFile.is_open ())
-        {
-          NS_FATAL_ERROR ("Could not open tracefile");
-        }
-    }
-  m_rxPacketTraceFile << "DL\t" << Simulator::Now ().GetSeconds () << "\t" 
-                      << params.m_frameNum << "\t" << +params.m_sfNum << "\t" 
-                      << +params.m_slotNum << "\t" << +params.m_symStart << "\t" 
-                      << +params.m_numSym << "\t" << params.m_cellId << "\t" 
-                      << params.m_rnti << "\t" << +params.m_ccId << "\t" 
-                      << params.m_tbSize << "\t" << +params.m_mcs << "\t" 
-                      << +params.m_rv << "\t" << 10 * std::log10 (params.m_sinr) << "\t" 
-                      << params.m_corrupt << "\t" <<  params.m_tbler << std::endl;
+  OpenSink (m_rxPacketTraceSink, m_rxPacketTraceFilename, GetRxPacketTraceSchema ());
+  m_rxPacketTraceSink->Append () << 0 /* DL */ << Simulator::Now ().GetSeconds ()
+                                 << params.m_frameNum << params.m_sfNum
+                                 << params.m_slotNum << params.m_symStart
+                                 << params.m_numSym << params.m_cellId
+                                 << params.m_rnti << params.m_ccId
+                                 << params.m_tbSize << params.m_mcs
+                                 << params.m_rv << 10 * std::log10 (params.m_sinr)
+                                 << params.m_corrupt << params.m_tbler;
 
   if (params.m_corrupt)
     {
@@ -265,23 +353,15 @@ MmWavePhyTrace::RxPacketTraceUeCallback (Ptr<MmWavePhyTrace> phyStats, std::stri
 void
 MmWavePhyTrace::RxPacketTraceEnbCallback (Ptr<MmWavePhyTrace> phyStats, std::string path, RxPacketTraceParams params)
 {
-  if (!m_rxPacketTraceFile.is_open ())
-    {
-      m_rxPacketTraceFile.open (m_rxPacketTraceFilename.c_str ());
-      m_rxPacketTraceFile << "DL/UL\ttime\tframe\tsubF\tslot\t1stSym\tsymbol#\tcellId\trnti\tccId\ttbSize\tmcs\trv\tSINR(dB)\tcorrupt\tTBler" << std::endl;
-      if (!m_rxPacketTraceFile.is_open ())
-        {
-          NS_FATAL_ERROR ("Could not open tracefile");
-        }
-    }
-  m_rxPacketTraceFile << "UL\t" << Simulator::Now ().GetSeconds () << "\t" 
-                      << params.m_frameNum << "\t" << +params.m_sfNum << "\t" 
-                      << +params.m_slotNum << "\t" << +params.m_symStart << "\t" 
-                      << +params.m_numSym << "\t" << params.m_cellId << "\t" 
-                      << params.m_rnti << "\t" << +params.m_ccId << "\t" 
-                      << params.m_tbSize << "\t" << +params.m_mcs << "\t" 
-                      << +params.m_rv << "\t" << 10 * std::log10 (params.m_sinr) << " \t" 
-                      << params.m_corrupt << "\t" << params.m_tbler << std::endl;
+  OpenSink (m_rxPacketTraceSink, m_rxPacketTraceFilename, GetRxPacketTraceSchema ());
+  m_rxPacketTraceSink->Append () << 1 /* UL */ << Simulator::Now ().GetSeconds ()
+                                 << params.m_frameNum << params.m_sfNum
+                                 << params.m_slotNum << params.m_symStart
+                                 << params.m_numSym << params.m_cellId
+                                 << params.m_rnti << params.m_ccId
+                                 << params.m_tbSize << params.m_mcs
+                                 << params.m_rv << 10 * std::log10 (params.m_sinr)
+                                 << params.m_corrupt << params.m_tbler;
 
   if (params.m_corrupt)
     {
@@ -36,6 +36,8 @@
 #include <ns3/object.h>
 #include <ns3/spectrum-value.h>
 #include <ns3/mmwave-phy-mac-common.h>
+#include <ns3/mmwave-trace-sink.h>
+#include <ns3/mmwave-threaded-trace-sink.h>
 #include <fstream>
 #include <iostream>
 
@@ -84,17 +86,45 @@ public:
   */
   void SetDlPhyTxOutputFilename (std::string fileName);
 
+ /**
+  * Sets the format of the PHY traces
+  * \param format the format
+  */
+  void SetTraceFormat (MmWaveTraceSink::Format format);
+
+ /**
+  * Sets whether the PHY traces are written by a background thread
+  * \param writerThread true to use a MmWaveThreadedTraceSink
+  */
+  void SetWriterThread (bool writerThread);
+
+ /**
+  * Write the buffered records of the PHY traces to the files
+  */
+  static void Flush (void);
+
 private:
+  /**
+   * Open the sink of a trace, if it is not open yet
+   * \param sink the sink
+   * \param fileName the name of the file
+   * \param schema the schema of the trace
+   */
+  static void OpenSink (Ptr<MmWaveTraceSink> &sink, const std::string &fileName, const MmWaveTraceSchema &schema);
+
   //void ReportInterferenceTrace (uint64_t imsi, SpectrumValue& sinr);
   //void ReportDLTbSize (uint64_t imsi, uint64_t tbSize);
-  static std::ofstream m_rxPacketTraceFile;   //!< Output stream for the PHY reception trace
+  static Ptr<MmWaveTraceSink> m_rxPacketTraceSink;   //!< Output sink for the PHY reception trace
   static std::string m_rxPacketTraceFilename;   //!< Output filename for the PHY reception trace
 
-  static std::ofstream m_ulPhyTraceFile;    //!< Output stream for the UL PHY transmission trace
+  static Ptr<MmWaveTraceSink> m_ulPhyTraceSink;    //!< Output sink for the UL PHY transmission trace
   static std::string m_ulPhyTraceFilename;    //!< Output filename for the UL PHY transmission trace
   
-  static std::ofstream m_dlPhyTraceFile;    //!< Output stream for the DL PHY transmission trace
+  static Ptr<MmWaveTraceSink> m_dlPhyTraceSink;    //!< Output sink for the DL PHY transmission trace
   static std::string m_dlPhyTraceFilename;    //!< Output filename for the DL PHY transmission trace
+
+  static MmWaveTraceSink::Format m_traceFormat;    //!< Format of the PHY traces
+  static bool m_writerThread;    //!< True if the PHY traces are written by a background thread
   
 };
 
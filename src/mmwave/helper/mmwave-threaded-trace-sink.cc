@@ -0,0 +1,190 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020, University of Padova, Dep. of Information Engineering, SIGNET lab
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-threaded-trace-sink.h"
+#include <ns3/log.h>
+#include <ns3/callback.h>
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveThreadedTraceSink");
+
+namespace mmwave {
+
+/// Time the threads sleep when they have nothing to do, in nanoseconds
+static const uint64_t g_idleWaitNs = 1000000;
+
+MmWaveThreadedTraceSink::MmWaveThreadedTraceSink (const std::string &fileName, const MmWaveTraceSchema &schema,
+                                                  Format format, uint32_t ringSize, uint32_t bufferSize)
+  : MmWaveTraceSink (fileName, schema, format, bufferSize),
+    m_recordSize (schema.GetRecordSize ()),
+    m_ringSize (ringSize),
+    m_head (0),
+    m_tail (0),
+    m_stop (false),
+    m_flush (false),
+    m_nStalls (0)
+{
+  NS_LOG_FUNCTION (this << fileName << format << ringSize << bufferSize);
+  NS_ASSERT (m_ringSize > 0);
+  m_ring.resize (m_ringSize * m_recordSize);
+
+  // write the text header before the writer thread starts
+  MmWaveTraceSink::Flush ();
+
+  m_thread = Create<SystemThread> (MakeCallback (&MmWaveThreadedTraceSink::Run, this));
+  m_thread->Start ();
+}
+
+MmWaveThreadedTraceSink::~MmWaveThreadedTraceSink ()
+{
+  NS_LOG_FUNCTION (this);
+  m_stop.store (true);
+  m_wakeWriter.SetCondition (true);
+  m_wakeWriter.Signal ();
+  m_thread->Join ();
+  NS_LOG_INFO ("Trace writer stopped, " << m_nStalls << " stalls");
+}
+
+void
+MmWaveThreadedTraceSink::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_flush.store (true);
+  m_wakeWriter.SetCondition (true);
+  m_wakeWriter.Signal ();
+  while (true)
+    {
+      // reset the condition before checking, so that a signal sent after
+      // the check is not lost
+      m_wakeProducer.SetCondition (false);
+      if (!m_flush.load ())
+        {
+          break;
+        }
+      m_wakeProducer.TimedWait (g_idleWaitNs);
+    }
+}
+
+uint64_t
+MmWaveThreadedTraceSink::GetNStalls (void) const
+{
+  return m_nStalls;
+}
+
+void
+MmWaveThreadedTraceSink::DoCommit (const uint8_t *record)
+{
+  uint64_t head = m_head.load (std::memory_order_relaxed);
+  if (head - m_tail.load (std::memory_order_acquire) >= m_ringSize)
+    {
+      // the ring is full, wait for the writer thread to free a slot
+      m_nStalls++;
+      while (true)
+        {
+          m_wakeProducer.SetCondition (false);
+          if (head - m_tail.load (std::memory_order_acquire) < m_ringSize)
+            {
+              break;
+            }
+          m_wakeWriter.SetCondition (true);
+          m_wakeWriter.Signal ();
+          m_wakeProducer.TimedWait (g_idleWaitNs);
+        }
+    }
+
+  std::memcpy (&m_ring[(head % m_ringSize) * m_recordSize], record, m_recordSize);
+  m_head.store (head + 1, std::memory_order_release);
+}
+
+uint64_t
+MmWaveThreadedTraceSink::Drain (std::string &output)
+{
+  uint64_t tail = m_tail.load (std::memory_order_relaxed);
+  uint64_t head = m_head.load (std::memory_order_acquire);
+  uint64_t popped = head - tail;
+  for (; tail < head; tail++)
+    {
+      const uint8_t *record = &m_ring[(tail % m_ringSize) * m_recordSize];
+      if (m_format == BINARY)
+        {
+          output.append (reinterpret_cast<const char*> (record), m_recordSize);
+        }
+      else
+        {
+          m_schema.FormatRecord (record, output);
+        }
+      m_tail.store (tail + 1, std::memory_order_release);
+
+      if (output.size () >= m_bufferSize)
+        {
+          Write (output.data (), output.size ());
+          output.clear ();
+        }
+    }
+
+  if (popped > 0)
+    {
+      m_wakeProducer.SetCondition (true);
+      m_wakeProducer.Signal ();
+    }
+  return popped;
+}
+
+void
+MmWaveThreadedTraceSink::Run (void)
+{
+  std::string output;
+  output.reserve (m_bufferSize + 1024);
+
+  while (true)
+    {
+      m_wakeWriter.SetCondition (false);
+      // read the requests before draining, so that all the records
+      // appended before the requests are written
+      bool stop = m_stop.load ();
+      bool flush = m_flush.load ();
+      uint64_t popped = Drain (output);
+
+      if (flush || stop)
+        {
+          Write (output.data (), output.size ());
+          output.clear ();
+          MmWaveTraceSink::Flush ();
+          if (flush)
+            {
+              m_flush.store (false);
+              m_wakeProducer.SetCondition (true);
+              m_wakeProducer.Signal ();
+            }
+          if (stop)
+            {
+              return;
+            }
+        }
+      else if (popped == 0)
+        {
+          m_wakeWriter.TimedWait (g_idleWaitNs);
+        }
+    }
+}
+
+} // namespace mmwave
+
+} // namespace ns3
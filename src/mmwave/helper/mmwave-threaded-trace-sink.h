@@ -0,0 +1,104 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020, University of Padova, Dep. of Information Engineering, SIGNET lab
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SRC_MMWAVE_HELPER_MMWAVE_THREADED_TRACE_SINK_H_
+#define SRC_MMWAVE_HELPER_MMWAVE_THREADED_TRACE_SINK_H_
+
+#include <ns3/mmwave-trace-sink.h>
+#include <ns3/system-thread.h>
+#include <ns3/system-condition.h>
+#include <atomic>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * Trace sink which formats and writes the records in a background thread.
+ * The simulation thread copies each binary record in a lock-free single
+ * producer, single consumer ring, and a writer thread drains the ring,
+ * formats the records and writes them to the file, so that the trace
+ * callbacks never wait for the disk. The ring has a fixed capacity: when
+ * it is full, the simulation thread waits for the writer to free a slot,
+ * so that the memory used by the sink is bounded.
+ */
+class MmWaveThreadedTraceSink : public MmWaveTraceSink
+{
+public:
+  /**
+   * Constructor, which starts the writer thread
+   * \param fileName the name of the output file
+   * \param schema the schema of the records
+   * \param format the format of the output file
+   * \param ringSize the capacity of the ring, in records
+   * \param bufferSize the size of the output buffer of the writer thread, in bytes
+   */
+  MmWaveThreadedTraceSink (const std::string &fileName, const MmWaveTraceSchema &schema,
+                           Format format, uint32_t ringSize = 1 << 16, uint32_t bufferSize = 1 << 20);
+
+  /**
+   * Destructor, which writes the remaining records and stops the writer thread
+   */
+  virtual ~MmWaveThreadedTraceSink ();
+
+  /**
+   * Wait for the writer thread to write all the records appended so far
+   */
+  virtual void Flush (void);
+
+  /**
+   * \return the number of times the simulation thread waited for a free slot in the ring
+   */
+  uint64_t GetNStalls (void) const;
+
+protected:
+  // inherited from MmWaveTraceSink
+  virtual void DoCommit (const uint8_t *record);
+
+private:
+  /**
+   * Body of the writer thread
+   */
+  void Run (void);
+
+  /**
+   * Pop and format the records in the ring, and write them when the output buffer is full
+   * \param output the output buffer
+   * \return the number of records popped
+   */
+  uint64_t Drain (std::string &output);
+
+  std::vector<uint8_t> m_ring; //!< the storage of the ring
+  uint32_t m_recordSize; //!< the size of a record
+  uint64_t m_ringSize; //!< the capacity of the ring, in records
+  std::atomic<uint64_t> m_head; //!< the number of records pushed, written by the simulation thread only
+  std::atomic<uint64_t> m_tail; //!< the number of records popped, written by the writer thread only
+  std::atomic<bool> m_stop; //!< true when the writer thread has to exit
+  std::atomic<bool> m_flush; //!< true when the writer thread has to write its output buffer
+  SystemCondition m_wakeWriter; //!< wakes the writer thread up
+  SystemCondition m_wakeProducer; //!< wakes the simulation thread up
+  Ptr<SystemThread> m_thread; //!< the writer thread
+  uint64_t m_nStalls; //!< the number of times the simulation thread waited for the writer
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_HELPER_MMWAVE_THREADED_TRACE_SINK_H_ */
@@ -0,0 +1,502 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020, University of Padova, Dep. of Information Engineering, SIGNET lab
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-trace-sink.h"
+#include <ns3/log.h>
+#include <ns3/fatal-error.h>
+#include <cstdio>
+#include <inttypes.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveTraceSink");
+
+namespace mmwave {
+
+/// Magic string at the beginning of a binary trace
+static const char g_traceMagic[8] = {'M', 'M', 'W', 'T', 'R', 'A', 'C', 'E'};
+/// Version of the binary trace format
+static const uint32_t g_traceVersion = 1;
+
+/**
+ * Write an integer to a binary stream
+ * \param os the output stream
+ * \param value the value
+ */
+static void
+WriteU32 (std::ostream &os, uint32_t value)
+{
+  os.write (reinterpret_cast<const char*> (&value), sizeof (value));
+}
+
+/**
+ * Read an integer from a binary stream
+ * \param is the input stream
+ * \param value the value
+ * \return true if the value has been read
+ */
+static bool
+ReadU32 (std::istream &is, uint32_t &value)
+{
+  is.read (reinterpret_cast<char*> (&value), sizeof (value));
+  return is.good ();
+}
+
+/**
+ * Write a string to a binary stream
+ * \param os the output stream
+ * \param str the string
+ */
+static void
+WriteString (std::ostream &os, const std::string &str)
+{
+  WriteU32 (os, str.size ());
+  os.write (str.data (), str.size ());
+}
+
+/**
+ * Read a string from a binary stream
+ * \param is the input stream
+ * \param str the string
+ * \return true if the string has been read
+ */
+static bool
+ReadString (std::istream &is, std::string &str)
+{
+  uint32_t size;
+  if (!ReadU32 (is, size) || size > 4096)
+    {
+      return false;
+    }
+  str.resize (size);
+  if (size > 0)
+    {
+      is.read (&str[0], size);
+    }
+  return is.good ();
+}
+
+MmWaveTraceSchema::MmWaveTraceSchema ()
+  : m_recordSize (0),
+    m_textHeader (true)
+{
+}
+
+MmWaveTraceSchema&
+MmWaveTraceSchema::AddColumn (const std::string &name, ColumnType type)
+{
+  Column c;
+  c.m_name = name;
+  c.m_type = type;
+  c.m_offset = m_recordSize;
+  m_columns.push_back (c);
+  m_recordSize += GetTypeSize (type);
+  return *this;
+}
+
+MmWaveTraceSchema&
+MmWaveTraceSchema::AddLabel (const std::string &label)
+{
+  NS_ASSERT_MSG (m_labels.size () < 256, "Too many labels");
+  m_labels.push_back (label);
+  return *this;
+}
+
+MmWaveTraceSchema&
+MmWaveTraceSchema::SetTextHeader (bool header)
+{
+  m_textHeader = header;
+  return *this;
+}
+
+bool
+MmWaveTraceSchema::HasTextHeader (void) const
+{
+  return m_textHeader;
+}
+
+uint32_t
+MmWaveTraceSchema::GetNColumns (void) const
+{
+  return m_columns.size ();
+}
+
+const MmWaveTraceSchema::Column&
+MmWaveTraceSchema::GetColumn (uint32_t i) const
+{
+  return m_columns.at (i);
+}
+
+uint32_t
+MmWaveTraceSchema::GetRecordSize (void) const
+{
+  return m_recordSize;
+}
+
+uint32_t
+MmWaveTraceSchema::GetNLabels (void) const
+{
+  return m_labels.size ();
+}
+
+const std::string&
+MmWaveTraceSchema::GetLabel (uint32_t i) const
+{
+  return m_labels.at (i);
+}
+
+uint32_t
+MmWaveTraceSchema::GetTypeSize (ColumnType type)
+{
+  switch (type)
+    {
+    case UINT8:
+    case LABEL:
+      return 1;
+    case UINT16:
+      return 2;
+    case UINT32:
+      return 4;
+    case UINT64:
+    case INT64:
+    case DOUBLE:
+      return 8;
+    }
+  NS_FATAL_ERROR ("Unknown column type " << type);
+  return 0;
+}
+
+void
+MmWaveTraceSchema::FormatRecord (const uint8_t *record, std::string &out) const
+{
+  char field[32];
+  for (uint32_t i = 0; i < m_columns.size (); i++)
+    {
+      const Column &c = m_columns[i];
+      const uint8_t *src = record + c.m_offset;
+      int len = 0;
+      switch (c.m_type)
+        {
+        case UINT8:
+          len = std::snprintf (field, sizeof (field), "%u", (unsigned) *src);
+          break;
+        case LABEL:
+          out.append (*src < m_labels.size () ? m_labels[*src] : std::string ("?"));
+          break;
+        case UINT16:
+          {
+            uint16_t v;
+            std::memcpy (&v, src, sizeof (v));
+            len = std::snprintf (field, sizeof (field), "%u", (unsigned) v);
+            break;
+          }
+        case UINT32:
+          {
+            uint32_t v;
+            std::memcpy (&v, src, sizeof (v));
+            len = std::snprintf (field, sizeof (field), "%" PRIu32, v);
+            break;
+          }
+        case UINT64:
+          {
+            uint64_t v;
+            std::memcpy (&v, src, sizeof (v));
+            len = std::snprintf (field, sizeof (field), "%" PRIu64, v);
+            break;
+          }
+        case INT64:
+          {
+            int64_t v;
+            std::memcpy (&v, src, sizeof (v));
+            len = std::snprintf (field, sizeof (field), "%" PRId64, v);
+            break;
+          }
+        case DOUBLE:
+          {
+            // same as the default formatting of std::ostream
+            double v;
+            std::memcpy (&v, src, sizeof (v));
+            len = std::snprintf (field, sizeof (field), "%g", v);
+            break;
+          }
+        }
+      out.append (field, len);
+      out.push_back (i + 1 < m_columns.size () ? '\t' : '\n');
+    }
+}
+
+void
+MmWaveTraceSchema::FormatHeader (std::string &out) const
+{
+  for (uint32_t i = 0; i < m_columns.size (); i++)
+    {
+      out.append (m_columns[i].m_name);
+      out.push_back (i + 1 < m_columns.size () ? '\t' : '\n');
+    }
+}
+
+void
+MmWaveTraceSchema::Serialize (std::ostream &os) const
+{
+  os.write (g_traceMagic, sizeof (g_traceMagic));
+  WriteU32 (os, g_traceVersion);
+  WriteU32 (os, m_textHeader ? 1 : 0);
+  WriteU32 (os, m_columns.size ());
+  for (std::vector<Column>::const_iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      WriteU32 (os, it->m_type);
+      WriteString (os, it->m_name);
+    }
+  WriteU32 (os, m_labels.size ());
+  for (std::vector<std::string>::const_iterator it = m_labels.begin (); it != m_labels.end (); ++it)
+    {
+      WriteString (os, *it);
+    }
+}
+
+bool
+MmWaveTraceSchema::Deserialize (std::istream &is)
+{
+  char magic[sizeof (g_traceMagic)];
+  is.read (magic, sizeof (magic));
+  if (!is.good () || std::memcmp (magic, g_traceMagic, sizeof (magic)) != 0)
+    {
+      return false;
+    }
+  uint32_t version, textHeader, nColumns, nLabels;
+  if (!ReadU32 (is, version) || version != g_traceVersion
+      || !ReadU32 (is, textHeader) || !ReadU32 (is, nColumns))
+    {
+      return false;
+    }
+
+  *this = MmWaveTraceSchema ();
+  m_textHeader = (textHeader != 0);
+  for (uint32_t i = 0; i < nColumns; i++)
+    {
+      uint32_t type;
+      std::string name;
+      if (!ReadU32 (is, type) || type > LABEL || !ReadString (is, name))
+        {
+          return false;
+        }
+      AddColumn (name, static_cast<ColumnType> (type));
+    }
+  if (!ReadU32 (is, nLabels) || nLabels > 256)
+    {
+      return false;
+    }
+  for (uint32_t i = 0; i < nLabels; i++)
+    {
+      std::string label;
+      if (!ReadString (is, label))
+        {
+          return false;
+        }
+      AddLabel (label);
+    }
+  return true;
+}
+
+MmWaveTraceSink::Record::Record (MmWaveTraceSink *sink)
+  : m_sink (sink),
+    m_column (0)
+{
+}
+
+MmWaveTraceSink::Record::Record (const Record &other)
+  : m_sink (other.m_sink),
+    m_column (other.m_column)
+{
+  other.m_sink = 0;
+}
+
+MmWaveTraceSink::Record::~Record ()
+{
+  if (m_sink != 0)
+    {
+      m_sink->Commit (m_column);
+    }
+}
+
+MmWaveTraceSink::MmWaveTraceSink (const std::string &fileName, const MmWaveTraceSchema &schema,
+                                  Format format, uint32_t bufferSize)
+  : m_schema (schema),
+    m_format (format),
+    m_bufferSize (bufferSize),
+    m_record (schema.GetRecordSize (), 0),
+    m_nRecords (0)
+{
+  NS_LOG_FUNCTION (this << fileName << format << bufferSize);
+  m_file.open (fileName.c_str (), std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!m_file.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open tracefile " << fileName);
+    }
+  m_buffer.reserve (m_bufferSize + 1024);
+
+  if (m_format == BINARY)
+    {
+      m_schema.Serialize (m_file);
+    }
+  else if (m_schema.HasTextHeader ())
+    {
+      m_schema.FormatHeader (m_buffer);
+    }
+}
+
+MmWaveTraceSink::~MmWaveTraceSink ()
+{
+  if (!m_buffer.empty ())
+    {
+      Write (m_buffer.data (), m_buffer.size ());
+      m_buffer.clear ();
+    }
+  m_file.close ();
+}
+
+MmWaveTraceSink::Record
+MmWaveTraceSink::Append (void)
+{
+  return Record (this);
+}
+
+void
+MmWaveTraceSink::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_buffer.empty ())
+    {
+      Write (m_buffer.data (), m_buffer.size ());
+      m_buffer.clear ();
+    }
+  m_file.flush ();
+}
+
+MmWaveTraceSink::Format
+MmWaveTraceSink::GetFormat (void) const
+{
+  return m_format;
+}
+
+const MmWaveTraceSchema&
+MmWaveTraceSink::GetSchema (void) const
+{
+  return m_schema;
+}
+
+uint64_t
+MmWaveTraceSink::GetNRecords (void) const
+{
+  return m_nRecords;
+}
+
+void
+MmWaveTraceSink::Commit (uint32_t numColumns)
+{
+  NS_ASSERT_MSG (numColumns == m_schema.GetNColumns (), "Incomplete trace record");
+  m_nRecords++;
+  DoCommit (m_record.data ());
+}
+
+void
+MmWaveTraceSink::DoCommit (const uint8_t *record)
+{
+  if (m_format == BINARY)
+    {
+      m_buffer.append (reinterpret_cast<const char*> (record), m_schema.GetRecordSize ());
+    }
+  else
+    {
+      m_schema.FormatRecord (record, m_buffer);
+    }
+
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Write (m_buffer.data (), m_buffer.size ());
+      m_buffer.clear ();
+    }
+}
+
+void
+MmWaveTraceSink::Write (const char *data, uint32_t size)
+{
+  m_file.write (data, size);
+  if (!m_file.good ())
+    {
+      NS_FATAL_ERROR ("Error while writing the tracefile");
+    }
+}
+
+MmWaveTraceReader::MmWaveTraceReader ()
+{
+}
+
+bool
+MmWaveTraceReader::Open (const std::string &fileName)
+{
+  m_file.open (fileName.c_str (), std::ios::in | std::ios::binary);
+  if (!m_file.is_open ())
+    {
+      return false;
+    }
+  return m_schema.Deserialize (m_file);
+}
+
+const MmWaveTraceSchema&
+MmWaveTraceReader::GetSchema (void) const
+{
+  return m_schema;
+}
+
+bool
+MmWaveTraceReader::Read (std::vector<uint8_t> &record)
+{
+  record.resize (m_schema.GetRecordSize ());
+  m_file.read (reinterpret_cast<char*> (record.data ()), record.size ());
+  return m_file.gcount () == static_cast<std::streamsize> (record.size ());
+}
+
+uint64_t
+MmWaveTraceReader::ConvertToText (std::ostream &os)
+{
+  std::string text;
+  if (m_schema.HasTextHeader ())
+    {
+      m_schema.FormatHeader (text);
+    }
+
+  uint64_t nRecords = 0;
+  std::vector<uint8_t> record;
+  while (Read (record))
+    {
+      m_schema.FormatRecord (record.data (), text);
+      nRecords++;
+      if (text.size () >= (1 << 20))
+        {
+          os.write (text.data (), text.size ());
+          text.clear ();
+        }
+    }
+  os.write (text.data (), text.size ());
+  return nRecords;
+}
+
+} // namespace mmwave
+
+} // namespace ns3
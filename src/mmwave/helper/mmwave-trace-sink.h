@@ -0,0 +1,417 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020, University of Padova, Dep. of Information Engineering, SIGNET lab
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SRC_MMWAVE_HELPER_MMWAVE_TRACE_SINK_H_
+#define SRC_MMWAVE_HELPER_MMWAVE_TRACE_SINK_H_
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/ptr.h>
+#include <ns3/assert.h>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * Fixed layout of the records of a trace.
+ * A record is a sequence of columns, each one with a name and a type. In
+ * binary form the columns are packed in the order they are added, with no
+ * padding, so that every record has the same size. LABEL columns store the
+ * index of a string from the label table of the schema, e.g., "DL" or "UL".
+ */
+class MmWaveTraceSchema
+{
+public:
+  /**
+   * Type of a column
+   */
+  enum ColumnType
+  {
+    UINT8 = 0,
+    UINT16 = 1,
+    UINT32 = 2,
+    UINT64 = 3,
+    INT64 = 4,
+    DOUBLE = 5,
+    LABEL = 6
+  };
+
+  /**
+   * A column of the trace
+   */
+  struct Column
+  {
+    std::string m_name; //!< the name of the column, used in the text header
+    ColumnType m_type; //!< the type of the column
+    uint32_t m_offset; //!< the offset of the column in the binary record
+  };
+
+  /**
+   * Constructor
+   */
+  MmWaveTraceSchema ();
+
+  /**
+   * Append a column to the records
+   * \param name the name of the column
+   * \param type the type of the column
+   * \return a reference to the schema, to chain the calls
+   */
+  MmWaveTraceSchema& AddColumn (const std::string &name, ColumnType type);
+
+  /**
+   * Add a string to the label table
+   * \param label the string
+   * \return a reference to the schema, to chain the calls
+   */
+  MmWaveTraceSchema& AddLabel (const std::string &label);
+
+  /**
+   * \param header true if the text form of the trace starts with a line with the column names
+   * \return a reference to the schema, to chain the calls
+   */
+  MmWaveTraceSchema& SetTextHeader (bool header);
+
+  /**
+   * \return true if the text form of the trace starts with a line with the column names
+   */
+  bool HasTextHeader (void) const;
+
+  /**
+   * \return the number of columns
+   */
+  uint32_t GetNColumns (void) const;
+
+  /**
+   * \param i the index of the column
+   * \return the column
+   */
+  const Column& GetColumn (uint32_t i) const;
+
+  /**
+   * \return the size of a binary record, in bytes
+   */
+  uint32_t GetRecordSize (void) const;
+
+  /**
+   * \return the number of labels
+   */
+  uint32_t GetNLabels (void) const;
+
+  /**
+   * \param i the index of the label
+   * \return the label
+   */
+  const std::string& GetLabel (uint32_t i) const;
+
+  /**
+   * \param type the type of a column
+   * \return the size of the column in a binary record, in bytes
+   */
+  static uint32_t GetTypeSize (ColumnType type);
+
+  /**
+   * Append the text form of a binary record to a string.
+   * The columns are separated by a tab and the line is terminated by a newline,
+   * floating point values are formatted as std::ostream does by default.
+   * \param record the binary record
+   * \param out the string the text is appended to
+   */
+  void FormatRecord (const uint8_t *record, std::string &out) const;
+
+  /**
+   * Append the line with the column names to a string
+   * \param out the string the text is appended to
+   */
+  void FormatHeader (std::string &out) const;
+
+  /**
+   * Write the schema to a stream, see MmWaveTraceReader
+   * \param os the output stream
+   */
+  void Serialize (std::ostream &os) const;
+
+  /**
+   * Read a schema written by Serialize
+   * \param is the input stream
+   * \return true if a valid schema has been read
+   */
+  bool Deserialize (std::istream &is);
+
+private:
+  std::vector<Column> m_columns; //!< the columns
+  std::vector<std::string> m_labels; //!< the label table
+  uint32_t m_recordSize; //!< the size of a binary record
+  bool m_textHeader; //!< true if the text trace starts with the column names
+};
+
+/**
+ * \ingroup mmwave
+ * Buffered output of a trace with a fixed schema.
+ * Records are appended to an in-memory buffer, which is written to the file
+ * when it grows larger than a threshold, when Flush is called, and when the
+ * sink is destroyed. The trace is either written as text, with the same
+ * tab-separated layout used by the text traces of the module, or in binary
+ * form, i.e., a header with the schema followed by the packed records, which
+ * can be converted to text offline with MmWaveTraceReader. Records are
+ * written with the stream operator, one value per column, e.g.
+ * \code
+ *   sink->Append () << frameNum << sfNum << 10 * std::log10 (sinr);
+ * \endcode
+ */
+class MmWaveTraceSink : public SimpleRefCount<MmWaveTraceSink>
+{
+public:
+  /**
+   * Format of the output file
+   */
+  enum Format
+  {
+    TEXT = 0,
+    BINARY = 1
+  };
+
+  /**
+   * Builder of a record, which is committed to the sink when destroyed
+   */
+  class Record
+  {
+public:
+    /**
+     * Constructor
+     * \param sink the sink the record is appended to
+     */
+    Record (MmWaveTraceSink *sink);
+
+    /**
+     * Copy constructor, which takes the ownership of the record
+     * \param other the record
+     */
+    Record (const Record &other);
+
+    /**
+     * Destructor, which commits the record
+     */
+    ~Record ();
+
+    /**
+     * Write the value of the next column.
+     * The value is converted to the type of the column.
+     * \param value the value
+     * \return a reference to the record, to chain the calls
+     */
+    template <class T>
+    Record& operator<< (T value)
+    {
+      NS_ASSERT (m_sink != 0);
+      m_sink->Put (m_column++, value);
+      return *this;
+    }
+
+private:
+    Record& operator= (const Record &);
+
+    mutable MmWaveTraceSink *m_sink; //!< the sink, or 0 if the record has been moved
+    uint32_t m_column; //!< the index of the next column
+  };
+
+  /**
+   * Constructor
+   * \param fileName the name of the output file
+   * \param schema the schema of the records
+   * \param format the format of the output file
+   * \param bufferSize the size of the buffer, in bytes
+   */
+  MmWaveTraceSink (const std::string &fileName, const MmWaveTraceSchema &schema,
+                   Format format, uint32_t bufferSize = 1 << 20);
+
+  /**
+   * Destructor, which flushes the buffer and closes the file
+   */
+  virtual ~MmWaveTraceSink ();
+
+  /**
+   * Start a new record
+   * \return the record builder
+   */
+  Record Append (void);
+
+  /**
+   * Write the buffered records to the file
+   */
+  virtual void Flush (void);
+
+  /**
+   * \return the format of the output file
+   */
+  Format GetFormat (void) const;
+
+  /**
+   * \return the schema of the records
+   */
+  const MmWaveTraceSchema& GetSchema (void) const;
+
+  /**
+   * \return the number of records appended to the sink
+   */
+  uint64_t GetNRecords (void) const;
+
+protected:
+  /**
+   * Store a complete record.
+   * The default implementation appends the record, in the format of the
+   * file, to the buffer, and writes the buffer when it is full.
+   * \param record the binary record
+   */
+  virtual void DoCommit (const uint8_t *record);
+
+  /**
+   * Write data to the file
+   * \param data the data
+   * \param size the size of the data
+   */
+  void Write (const char *data, uint32_t size);
+
+  MmWaveTraceSchema m_schema; //!< the schema of the records
+  Format m_format; //!< the format of the output file
+  uint32_t m_bufferSize; //!< the size of the buffer, in bytes
+
+private:
+  /**
+   * Write the value of a column of the current record
+   * \param column the index of the column
+   * \param value the value
+   */
+  template <class T>
+  void Put (uint32_t column, T value);
+
+  /**
+   * Commit the current record
+   * \param numColumns the number of values written
+   */
+  void Commit (uint32_t numColumns);
+
+  std::ofstream m_file; //!< the output file
+  std::vector<uint8_t> m_record; //!< the record being built
+  std::string m_buffer; //!< the records not yet written to the file
+  uint64_t m_nRecords; //!< the number of records appended
+};
+
+/**
+ * \ingroup mmwave
+ * Reader of the binary traces written by MmWaveTraceSink
+ */
+class MmWaveTraceReader
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveTraceReader ();
+
+  /**
+   * Open a binary trace and read its schema
+   * \param fileName the name of the file
+   * \return true if the file is a valid binary trace
+   */
+  bool Open (const std::string &fileName);
+
+  /**
+   * \return the schema of the records
+   */
+  const MmWaveTraceSchema& GetSchema (void) const;
+
+  /**
+   * Read the next record
+   * \param record the buffer the record is copied to, resized to the record size
+   * \return false if no complete record is left
+   */
+  bool Read (std::vector<uint8_t> &record);
+
+  /**
+   * Convert the remaining records to the text form of the trace
+   * \param os the output stream
+   * \return the number of records converted
+   */
+  uint64_t ConvertToText (std::ostream &os);
+
+private:
+  std::ifstream m_file; //!< the input file
+  MmWaveTraceSchema m_schema; //!< the schema of the records
+};
+
+template <class T>
+void
+MmWaveTraceSink::Put (uint32_t column, T value)
+{
+  NS_ASSERT_MSG (column < m_schema.GetNColumns (), "Too many values for the trace record");
+  const MmWaveTraceSchema::Column &c = m_schema.GetColumn (column);
+  uint8_t *dst = &m_record[c.m_offset];
+  switch (c.m_type)
+    {
+    case MmWaveTraceSchema::UINT8:
+    case MmWaveTraceSchema::LABEL:
+      {
+        uint8_t v = static_cast<uint8_t> (value);
+        *dst = v;
+        break;
+      }
+    case MmWaveTraceSchema::UINT16:
+      {
+        uint16_t v = static_cast<uint16_t> (value);
+        std::memcpy (dst, &v, sizeof (v));
+        break;
+      }
+    case MmWaveTraceSchema::UINT32:
+      {
+        uint32_t v = static_cast<uint32_t> (value);
+        std::memcpy (dst, &v, sizeof (v));
+        break;
+      }
+    case MmWaveTraceSchema::UINT64:
+      {
+        uint64_t v = static_cast<uint64_t> (value);
+        std::memcpy (dst, &v, sizeof (v));
+        break;
+      }
+    case MmWaveTraceSchema::INT64:
+      {
+        int64_t v = static_cast<int64_t> (value);
+        std::memcpy (dst, &v, sizeof (v));
+        break;
+      }
+    case MmWaveTraceSchema::DOUBLE:
+      {
+        double v = static_cast<double> (value);
+        std::memcpy (dst, &v, sizeof (v));
+        break;
+      }
+    }
+}
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_HELPER_MMWAVE_TRACE_SINK_H_ */
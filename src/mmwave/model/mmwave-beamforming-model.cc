@@ -462,5 +462,292 @@ MmWaveSvdBeamforming::GetFirstEigenvector (MatrixBasedChannelModel::Complex2DVec
   return antennaWeights;
 }
 
+/*----------------------------------------------------------------------------*/
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveCodebookBeamforming);
+
+TypeId
+MmWaveCodebookBeamforming::GetTypeId ()
+{
+  static TypeId
+    tid =
+    TypeId ("ns3::MmWaveCodebookBeamforming")
+    .SetParent<MmWaveBeamformingModel> ()
+    .AddConstructor<MmWaveCodebookBeamforming> ()
+    .AddAttribute ("ChannelModel",
+                   "Pointer to the MatrixBasedChannelModel object used in the simulation scenario",
+                   PointerValue (),
+                   MakePointerAccessor (&MmWaveCodebookBeamforming::m_channel),
+                   MakePointerChecker<MatrixBasedChannelModel> ())
+    .AddAttribute ("NumAzimuthBeams",
+                   "Number of codewords in the azimuth domain, uniformly spaced in the half-space in front of the array",
+                   UintegerValue (15),
+                   MakeUintegerAccessor (&MmWaveCodebookBeamforming::m_numAzimuthBeams),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("NumElevationBeams",
+                   "Number of codewords in the elevation domain, uniformly spaced in [0, PI]",
+                   UintegerValue (5),
+                   MakeUintegerAccessor (&MmWaveCodebookBeamforming::m_numElevationBeams),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("UseCache",
+                   "Reuse the selected beam pair until the channel matrix changes",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MmWaveCodebookBeamforming::m_useCache),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+MmWaveCodebookBeamforming::MmWaveCodebookBeamforming ()
+  : m_useCache {true}
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveCodebookBeamforming::~MmWaveCodebookBeamforming ()
+{
+}
+
+void
+MmWaveCodebookBeamforming::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_channel = 0;
+  m_cacheChannelMap.clear ();
+  m_cacheBfVectors.clear ();
+  MmWaveBeamformingModel::DoDispose ();
+}
+
+ThreeGppAntennaArrayModel::ComplexVector
+MmWaveCodebookBeamforming::Codebook::GetBeam (uint32_t beamIndex) const
+{
+  NS_ASSERT_MSG (beamIndex < m_numBeams, "Codeword " << beamIndex << " does not exist");
+  auto first = m_bank.begin () + beamIndex * m_numElements;
+  return ThreeGppAntennaArrayModel::ComplexVector (first, first + m_numElements);
+}
+
+Ptr<const MmWaveCodebookBeamforming::Codebook>
+MmWaveCodebookBeamforming::GetCodebook (Ptr<const ThreeGppAntennaArrayModel> antenna,
+                                        uint32_t numAzimuthBeams,
+                                        uint32_t numElevationBeams)
+{
+  NS_LOG_FUNCTION (antenna << numAzimuthBeams << numElevationBeams);
+
+  uint32_t numElements = antenna->GetNumberOfElements ();
+
+  // the geometry of the array is fully described by the element locations
+  // (which also account for the orientation of the panel)
+  std::vector<double> key {static_cast<double> (numAzimuthBeams), static_cast<double> (numElevationBeams)};
+  key.reserve (2 + 3 * numElements);
+  for (uint32_t eIndex = 0; eIndex < numElements; eIndex++)
+    {
+      Vector loc = antenna->GetElementLocation (eIndex);
+      key.push_back (loc.x);
+      key.push_back (loc.y);
+      key.push_back (loc.z);
+    }
+
+  // codebooks are immutable, hence they can be shared among all the devices
+  static std::map<std::vector<double>, Ptr<const Codebook> > codebooks;
+  auto it = codebooks.find (key);
+  if (it != codebooks.end ())
+    {
+      return it->second;
+    }
+
+  DoubleValue bearing;
+  antenna->GetAttribute ("BearingAngle", bearing);
+
+  Ptr<Codebook> codebook = Create<Codebook> ();
+  codebook->m_numElements = numElements;
+  codebook->m_numBeams = numAzimuthBeams * numElevationBeams;
+  codebook->m_bank.reserve (codebook->m_numBeams * numElements);
+  codebook->m_directions.reserve (codebook->m_numBeams);
+
+  // the total power is divided equally among the antenna elements
+  double power = 1 / sqrt (numElements);
+
+  for (uint32_t vIndex = 0; vIndex < numElevationBeams; vIndex++)
+    {
+      double vAngleRadian = (vIndex + 0.5) * M_PI / numElevationBeams;
+      for (uint32_t hIndex = 0; hIndex < numAzimuthBeams; hIndex++)
+        {
+          double hAngleRadian = bearing.Get () - M_PI / 2 + (hIndex + 0.5) * M_PI / numAzimuthBeams;
+          for (uint32_t eIndex = 0; eIndex < numElements; eIndex++)
+            {
+              Vector loc = antenna->GetElementLocation (eIndex);
+              double phase = -2 * M_PI * (sin (vAngleRadian) * cos (hAngleRadian) * loc.x
+                                          + sin (vAngleRadian) * sin (hAngleRadian) * loc.y
+                                          + cos (vAngleRadian) * loc.z);
+              codebook->m_bank.push_back (std::polar (power, phase));
+            }
+          codebook->m_directions.push_back (Angles (hAngleRadian, vAngleRadian));
+        }
+    }
+
+  NS_LOG_DEBUG ("Created codebook with " << codebook->m_numBeams << " beams for an array with " << numElements << " elements");
+  codebooks.insert (std::make_pair (key, codebook));
+  return codebook;
+}
+
+void
+MmWaveCodebookBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna)
+{
+  NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
+
+  Ptr<MobilityModel> thisMob = m_device->GetNode ()->GetObject<MobilityModel> ();
+  NS_ASSERT_MSG (thisMob, "This device " << m_device << " does not have a mobility model");
+  Ptr<MobilityModel> otherMob = otherDevice->GetNode ()->GetObject<MobilityModel> ();
+  NS_ASSERT_MSG (otherMob, "The otherDevice " << otherDevice << " does not have a mobility model");
+
+  // this will trigger a new computation (if needed)
+  auto channelMatrix = m_channel->GetChannel (thisMob, otherMob, m_antenna, otherAntenna);
+
+  std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> bfVectors;
+
+  bool toCache {false};
+
+  if (m_useCache)
+    {
+      auto entry {m_cacheChannelMap.find (otherDevice)};
+      if (entry != m_cacheChannelMap.end () && entry->second == channelMatrix) // hit: the channel was already cached
+        {
+          NS_LOG_DEBUG ("channel cached " << channelMatrix);
+          bfVectors = m_cacheBfVectors.find (otherDevice)->second;
+        }
+      else
+        {
+          NS_LOG_DEBUG ("new channel " << channelMatrix);
+          toCache = true;
+        }
+    }
+
+  if (!m_useCache || toCache)
+    {
+      if (channelMatrix->m_channel[0][0].size () == 0)
+        {
+          NS_LOG_LOGIC ("Channel has no MPCs");
+
+          ThreeGppAntennaArrayModel::ComplexVector thisBf;
+          thisBf.resize (m_antenna->GetNumberOfElements ());
+          ThreeGppAntennaArrayModel::ComplexVector otherBf;
+          otherBf.resize (otherAntenna->GetNumberOfElements ());
+
+          bfVectors = std::make_pair (thisBf, otherBf);
+        }
+      else
+        {
+          Ptr<const Codebook> thisCodebook = GetCodebook (m_antenna, m_numAzimuthBeams, m_numElevationBeams);
+          Ptr<const Codebook> otherCodebook = GetCodebook (otherAntenna, m_numAzimuthBeams, m_numElevationBeams);
+
+          // the channel matrix is H_us, with s the device that created it
+          uint32_t thisDeviceId = m_device->GetNode ()->GetId ();
+          uint32_t otherDeviceId = otherDevice->GetNode ()->GetId ();
+          bool isReverse = channelMatrix->IsReverse (thisDeviceId, otherDeviceId);
+
+          std::pair<uint32_t, uint32_t> beamPair;
+          if (!isReverse)
+            {
+              beamPair = SelectBeamPair (channelMatrix, thisCodebook, otherCodebook);
+            }
+          else
+            {
+              beamPair = SelectBeamPair (channelMatrix, otherCodebook, thisCodebook);
+              beamPair = std::make_pair (beamPair.second, beamPair.first);
+            }
+
+          NS_LOG_DEBUG ("selected codewords " << beamPair.first << " and " << beamPair.second);
+          bfVectors = std::make_pair (thisCodebook->GetBeam (beamPair.first),
+                                      otherCodebook->GetBeam (beamPair.second));
+        }
+    }
+
+  // configure the antennas to use the selected beam pair
+  m_antenna->SetBeamformingVector (std::get<0> (bfVectors));
+  otherAntenna->SetBeamformingVector (std::get<1> (bfVectors));
+
+  if (toCache)
+    {
+      m_cacheChannelMap[otherDevice] = channelMatrix;
+      m_cacheBfVectors[otherDevice] = bfVectors;
+    }
+}
+
+std::pair<uint32_t, uint32_t>
+MmWaveCodebookBeamforming::SelectBeamPair (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                           Ptr<const Codebook> sCodebook,
+                                           Ptr<const Codebook> uCodebook) const
+{
+  NS_LOG_FUNCTION (this);
+
+  // channel[u][s][cluster]
+  uint32_t uSize = params->m_channel.size ();
+  uint32_t sSize = params->m_channel[0].size ();
+  uint32_t numCluster = params->m_channel[0][0].size ();
+  NS_ASSERT_MSG (sSize == sCodebook->m_numElements && uSize == uCodebook->m_numElements,
+                 "The size of the channel matrix does not match the size of the codebooks");
+
+  // flatten the channel matrix as [cluster][u][s] to scan it contiguously
+  ThreeGppAntennaArrayModel::ComplexVector channel (numCluster * uSize * sSize);
+  for (uint32_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+      for (uint32_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+          for (uint32_t cIndex = 0; cIndex < numCluster; cIndex++)
+            {
+              channel[(cIndex * uSize + uIndex) * sSize + sIndex] = params->m_channel[uIndex][sIndex][cIndex];
+            }
+        }
+    }
+
+  // project the channel on each s codeword, i.e., compute H_c * w_s
+  // for every cluster c, stored as [sBeam][cluster][u]
+  ThreeGppAntennaArrayModel::ComplexVector projection (sCodebook->m_numBeams * numCluster * uSize);
+  for (uint32_t sBeam = 0; sBeam < sCodebook->m_numBeams; sBeam++)
+    {
+      const std::complex<double>* sW = &sCodebook->m_bank[sBeam * sSize];
+      for (uint32_t row = 0; row < numCluster * uSize; row++)
+        {
+          const std::complex<double>* h = &channel[row * sSize];
+          std::complex<double> sum (0, 0);
+          for (uint32_t sIndex = 0; sIndex < sSize; sIndex++)
+            {
+              sum += h[sIndex] * sW[sIndex];
+            }
+          projection[sBeam * numCluster * uSize + row] = sum;
+        }
+    }
+
+  // evaluate the gain of each pair, summing the power over the clusters
+  std::pair<uint32_t, uint32_t> bestPair (0, 0);
+  double bestGain = -1;
+  for (uint32_t sBeam = 0; sBeam < sCodebook->m_numBeams; sBeam++)
+    {
+      const std::complex<double>* p = &projection[sBeam * numCluster * uSize];
+      for (uint32_t uBeam = 0; uBeam < uCodebook->m_numBeams; uBeam++)
+        {
+          const std::complex<double>* uW = &uCodebook->m_bank[uBeam * uSize];
+          double gain = 0;
+          for (uint32_t cIndex = 0; cIndex < numCluster; cIndex++)
+            {
+              std::complex<double> sum (0, 0);
+              for (uint32_t uIndex = 0; uIndex < uSize; uIndex++)
+                {
+                  sum += uW[uIndex] * p[cIndex * uSize + uIndex];
+                }
+              gain += std::norm (sum);
+            }
+          if (gain > bestGain)
+            {
+              bestGain = gain;
+              bestPair = std::make_pair (sBeam, uBeam);
+            }
+        }
+    }
+
+  NS_LOG_DEBUG ("best beam pair gain " << bestGain);
+  return bestPair;
+}
+
 } // namespace mmwave
 } // namespace ns3
@@ -190,6 +190,99 @@ private:
 };
 
 
+/**
+ * This class extends the MmWaveBeamformingModel interface.
+ * It implements a beam sweeping algorithm over a finite codebook of
+ * steering vectors. The codebook spans a uniform grid of azimuth and
+ * elevation angles, it is computed once for each antenna array geometry and
+ * it is shared among all the devices using the same geometry.
+ * The beam pair maximizing the beamforming gain over the channel matrix is
+ * selected through an exhaustive search over the two codebooks.
+ */
+class MmWaveCodebookBeamforming : public MmWaveBeamformingModel
+{
+public:
+  /**
+   * Bank of precomputed steering vectors.
+   * The weights are stored beam by beam in a contiguous vector, i.e., the
+   * weight of the element e for the beam b is m_bank[b * m_numElements + e]
+   */
+  struct Codebook : public SimpleRefCount<Codebook>
+  {
+    uint32_t m_numElements; //!< number of antenna elements
+    uint32_t m_numBeams; //!< number of codewords
+    ThreeGppAntennaArrayModel::ComplexVector m_bank; //!< the steering vectors
+    std::vector<Angles> m_directions; //!< the pointing direction of each codeword
+
+    /**
+     * Returns the steering vector of a codeword
+     * \param beamIndex the index of the codeword
+     * \return the steering vector
+     */
+    ThreeGppAntennaArrayModel::ComplexVector GetBeam (uint32_t beamIndex) const;
+  };
+
+  /**
+   * Constructor
+   */
+  MmWaveCodebookBeamforming ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveCodebookBeamforming () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Selects the best beam pair to communicate with the target device
+   * and sets both the antennas.
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   */
+  void SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<ThreeGppAntennaArrayModel> otherAntenna) override;
+
+  /**
+   * Returns the codebook associated to the geometry of an antenna array.
+   * The codebook is computed on the first call and then reused for any
+   * other array with the same geometry and the same codebook size.
+   * \param antenna the antenna array
+   * \param numAzimuthBeams number of codewords in the azimuth domain
+   * \param numElevationBeams number of codewords in the elevation domain
+   * \return the codebook
+   */
+  static Ptr<const Codebook> GetCodebook (Ptr<const ThreeGppAntennaArrayModel> antenna,
+                                          uint32_t numAzimuthBeams,
+                                          uint32_t numElevationBeams);
+
+private:
+  void DoDispose (void) override;
+
+  /**
+   * Searches for the beam pair with the highest beamforming gain
+   * \param params the channel matrix
+   * \param sCodebook the codebook of the transmitter (s) side
+   * \param uCodebook the codebook of the receiver (u) side
+   * \return a pair with the indices of the selected s and u codewords
+   */
+  std::pair<uint32_t, uint32_t> SelectBeamPair (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                Ptr<const Codebook> sCodebook,
+                                                Ptr<const Codebook> uCodebook) const;
+
+  Ptr<MatrixBasedChannelModel> m_channel; //!< pointer to the MatrixChannel, to retrieve the matrix on which the beam search is performed
+
+  std::map<Ptr<NetDevice>, Ptr<const MatrixBasedChannelModel::ChannelMatrix> > m_cacheChannelMap; //!< map that stores the channel previously used for the search
+  std::map<Ptr<NetDevice>, std::pair<ThreeGppAntennaArrayModel::ComplexVector, ThreeGppAntennaArrayModel::ComplexVector> > m_cacheBfVectors; //!< map that stores the previously selected bf vectors
+  uint32_t m_numAzimuthBeams; //!< number of codewords in the azimuth domain
+  uint32_t m_numElevationBeams; //!< number of codewords in the elevation domain
+  bool m_useCache; //!< reuse the selected beam pair until the channel matrix changes
+};
+
+
 } // namespace mmwave
 } // namespace ns3
 
@@ -810,8 +810,7 @@ MmWaveEnbMac::DoDlHarqFeedback (DlHarqInfo params)
   if (params.m_harqStatus == DlHarqInfo::ACK)
     {
       // discard buffer
-      Ptr<PacketBurst> emptyBuf = CreateObject <PacketBurst> ();
-      (*it).second.at (params.m_harqProcessId).m_pktBurst = emptyBuf;
+      (*it).second.at (params.m_harqProcessId).m_tb = 0;
       NS_LOG_DEBUG (this << " HARQ-ACK UE " << params.m_rnti << " harqId " << (uint16_t)params.m_harqProcessId);
     }
   else if (params.m_harqStatus == DlHarqInfo::NACK)
@@ -819,10 +818,10 @@ MmWaveEnbMac::DoDlHarqFeedback (DlHarqInfo params)
       /*if (params.m_numRetx == 3)
       {
               std::map <uint16_t, std::map<uint8_t, LteMacSapUser*> >::iterator rntiIt = m_rlcAttached.find (params.m_rnti);
-              for (unsigned i = 0; i < (*it).second.at (params.m_harqProcessId).m_lcidList.size (); i++)
+              for (unsigned i = 0; i < (*it).second.at (params.m_harqProcessId).m_tb->GetLcidList ().size (); i++)
               {
                               std::map<uint8_t, LteMacSapUser*>::iterator lcidIt =
-                                              rntiIt->second.find ((*it).second.at (params.m_harqProcessId).m_lcidList[i]);
+                                              rntiIt->second.find ((*it).second.at (params.m_harqProcessId).m_tb->GetLcidList ()[i]);
                               NS_ASSERT (lcidIt != rntiIt->second.end ());
                               lcidIt->second->NotifyDlHarqDeliveryFailure (params.m_harqProcessId);
               }
@@ -939,9 +938,7 @@ MmWaveEnbMac::DoSchedConfigIndication (MmWaveMacSchedSapUser::SchedConfigIndPara
                   // new data -> force emptying correspondent harq pkt buffer
                   std::map <uint16_t, MmWaveDlHarqProcessesBuffer_t>::iterator harqIt = m_miDlHarqProcessesPackets.find (rnti);
                   NS_ASSERT (harqIt != m_miDlHarqProcessesPackets.end ());
-                  Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
-                  harqIt->second.at (tbUid).m_pktBurst = pb;
-                  harqIt->second.at (tbUid).m_lcidList.clear ();
+                  harqIt->second.at (tbUid).m_tb = 0;
 
                   std::map<uint32_t, struct MacPduInfo>::iterator pduMapIt = mapRet.first;
                   pduMapIt->second.m_numRlcPdu = 0;
@@ -960,7 +957,7 @@ MmWaveEnbMac::DoSchedConfigIndication (MmWaveMacSchedSapUser::SchedConfigIndPara
                       txOpParams.rnti = rnti;
                       txOpParams.lcid = rlcPduInfo[ipdu].m_lcid;
                       (*lcidIt).second->NotifyTxOpportunity (txOpParams);
-                      harqIt->second.at (tbUid).m_lcidList.push_back (rlcPduInfo[ipdu].m_lcid);
+                      pduMapIt->second.m_lcidList.push_back (rlcPduInfo[ipdu].m_lcid);
                     }
 
                   if (pduMapIt->second.m_numRlcPdu == 0)
@@ -982,10 +979,10 @@ MmWaveEnbMac::DoSchedConfigIndication (MmWaveMacSchedSapUser::SchedConfigIndPara
                       NS_LOG_DEBUG ("Subheader " << i << " size " << pduMapIt->second.m_macHeader.GetSubheaders ().at (i).m_size);
                     }
                   NS_LOG_DEBUG ("Total MAC PDU size " << pduMapIt->second.m_pdu->GetSize ());
-                  harqIt->second.at (tbUid).m_pktBurst->AddPacket (pduMapIt->second.m_pdu);
+                  harqIt->second.at (tbUid).m_tb = Create<MmWaveMacTransportBlock> (pduMapIt->second.m_pdu, pduMapIt->second.m_lcidList);
 
                   m_txMacPacketTraceEnb (rnti, m_componentCarrierId, pduMapIt->second.m_pdu->GetSize ());
-                  m_phySapProvider->SendMacPdu (pduMapIt->second.m_pdu);
+                  m_phySapProvider->SendMacPdu (pduMapIt->second.m_pdu, pduSfn);
                   m_macPduMap.erase (pduMapIt);                        // delete map entry
                 }
               else
@@ -996,21 +993,13 @@ MmWaveEnbMac::DoSchedConfigIndication (MmWaveMacSchedSapUser::SchedConfigIndPara
                       // HARQ retransmission -> retrieve TB from HARQ buffer
                       std::map <uint16_t, MmWaveDlHarqProcessesBuffer_t>::iterator it = m_miDlHarqProcessesPackets.find (rnti);
                       NS_ASSERT (it != m_miDlHarqProcessesPackets.end ());
-                      Ptr<PacketBurst> pb = it->second.at (tbUid).m_pktBurst;
-                      for (std::list<Ptr<Packet> >::const_iterator j = pb->Begin (); j != pb->End (); ++j)
+                      Ptr<const MmWaveMacTransportBlock> tb = it->second.at (tbUid).m_tb;
+                      if (tb)
                         {
-                          Ptr<Packet> pkt = (*j)->Copy ();
-                          MmWaveMacPduTag tag;                                                                          // update PDU tag for retransmission
-                          if (!pkt->RemovePacketTag (tag))
-                            {
-                              NS_FATAL_ERROR ("No MAC PDU tag");
-                            }
-                          tag.SetSfn (SfnSf (ind.m_sfnSf.m_frameNum, ind.m_sfnSf.m_sfNum, ind.m_sfnSf.m_slotNum, dciElem.m_symStart));
-                          tag.SetNumSym (dciElem.m_numSym);
-                          pkt->AddPacketTag (tag);
-
-                          m_txMacPacketTraceEnb (rnti, m_componentCarrierId, pkt->GetSize ());
-                          m_phySapProvider->SendMacPdu (pkt);
+                          // send the same PDU again, in the TTI of the retransmission
+                          SfnSf retxSfn (ind.m_sfnSf.m_frameNum, ind.m_sfnSf.m_sfNum, ind.m_sfnSf.m_slotNum, dciElem.m_symStart);
+                          m_txMacPacketTraceEnb (rnti, m_componentCarrierId, tb->GetSize ());
+                          m_phySapProvider->SendMacPdu (tb->GetPdu (), retxSfn);
                         }
                     }
                 }
@@ -1071,11 +1060,6 @@ MmWaveEnbMac::DoAddUe (uint16_t rnti)
   MmWaveDlHarqProcessesBuffer_t buf;
   uint16_t harqNum = m_phyMacConfig->GetNumHarqProcess ();
   buf.resize (harqNum);
-  for (uint8_t i = 0; i < harqNum; i++)
-    {
-      Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
-      buf.at (i).m_pktBurst = pb;
-    }
   m_miDlHarqProcessesPackets.insert (std::pair <uint16_t, MmWaveDlHarqProcessesBuffer_t> (rnti, buf));
 
 }
@@ -38,6 +38,7 @@
 
 #include "mmwave-mac.h"
 #include "mmwave-enb-mac.h"
+#include "mmwave-mac-transport-block.h"
 #include <ns3/lte-enb-cmac-sap.h>
 #include <ns3/lte-mac-sap.h>
 #include "mmwave-phy-mac-common.h"
@@ -49,10 +50,10 @@ namespace mmwave {
 
 struct MmWaveDlHarqProcessInfo
 {
-  Ptr<PacketBurst> m_pktBurst;
-  // maintain list of LCs contained in this TB
-  // used to signal HARQ failure to RLC handlers
-  std::vector<uint8_t> m_lcidList;
+  // TB under transmission, null if the process is idle; it is shared
+  // by the transmission and the retransmissions of the TB, and holds
+  // the list of LCs used to signal HARQ failure to RLC handlers
+  Ptr<const MmWaveMacTransportBlock> m_tb;
 };
 
 typedef std::vector <MmWaveDlHarqProcessInfo> MmWaveDlHarqProcessesBuffer_t;
@@ -1017,16 +1017,10 @@ MmWaveEnbPhy::StartTti (void)
       ttiPeriod = NanoSeconds (m_phyMacConfig->GetSymbolPeriod ().GetNanoSeconds () * currTti.m_dci.m_numSym);
       NS_ASSERT (currTti.m_tddMode == TtiAllocInfo::DL_slotAllocInfo);
 
-      Ptr<PacketBurst> pktBurst = GetPacketBurst (SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));
-      if (pktBurst && pktBurst->GetNPackets () > 0)
-        {
-          std::list< Ptr<Packet> > pkts = pktBurst->GetPackets ();
-          MmWaveMacPduTag macTag;
-          pkts.front ()->PeekPacketTag (macTag);
-          NS_ASSERT ((macTag.GetSfn ().m_frameNum == m_frameNum) && (macTag.GetSfn ().m_sfNum == m_sfNum)
-                     && (macTag.GetSfn ().m_slotNum == m_slotNum) && (macTag.GetSfn ().m_symStart == currTti.m_dci.m_symStart));
-        }
-      else
+      // the TB is queued by the MAC for this TTI: the MAC PDU tag of a
+      // retransmitted PDU still refers to its first transmission
+      TransportBlock tb = GetTransportBlock (SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));
+      if (tb.IsEmpty ())
         {
           // sometimes the UE will be scheduled when no data is queued
           // in this case, send an empty PDU
@@ -1039,8 +1033,7 @@ MmWaveEnbPhy::StartTti (void)
           emptyPdu->AddPacketTag (tag);
           LteRadioBearerTag bearerTag (currTti.m_dci.m_rnti, 3, 0);
           emptyPdu->AddPacketTag (bearerTag);
-          pktBurst = CreateObject<PacketBurst> ();
-          pktBurst->AddPacket (emptyPdu);
+          tb.AddPacket (emptyPdu);
         }
       NS_LOG_DEBUG ("ENB " << m_cellId << " TXing DL DATA frame " << m_frameNum << " subframe " << (unsigned)m_sfNum << " slot "
                            << (uint16_t)m_slotNum << " symbols " << (unsigned)currTti.m_dci.m_symStart << "-" << (unsigned)(currTti.m_dci.m_symStart + currTti.m_dci.m_numSym - 1)
@@ -1049,7 +1042,7 @@ MmWaveEnbPhy::StartTti (void)
       // Trace current DL transmission info
       TraceDlPhyTransmission (currTti.m_dci, PhyTransmissionTraceParams::DATA);
 
-      Simulator::Schedule (NanoSeconds (1.0), &MmWaveEnbPhy::SendDataChannels, this, pktBurst, ttiPeriod - NanoSeconds (2.0), currTti);
+      Simulator::Schedule (NanoSeconds (1.0), &MmWaveEnbPhy::SendDataChannels, this, tb, ttiPeriod - NanoSeconds (2.0), currTti);
     }
   else if (currTti.m_tddMode == TtiAllocInfo::UL_slotAllocInfo)        // Scheduled UL data Tti
     {
@@ -1057,7 +1050,7 @@ MmWaveEnbPhy::StartTti (void)
       //NS_LOG_DEBUG ("Slot " << (uint8_t)m_slotNum << " scheduled for Uplink");
       m_downlinkSpectrumPhy->AddExpectedTb (currTti.m_dci.m_rnti, currTti.m_dci.m_ndi, currTti.m_dci.m_tbSize,
                                             currTti.m_dci.m_mcs, m_channelChunks, currTti.m_dci.m_harqProcess, currTti.m_dci.m_rv, false,
-                                            currTti.m_dci.m_symStart, currTti.m_dci.m_numSym);
+                                            SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart), currTti.m_dci.m_numSym);
 
       for (uint8_t i = 0; i < m_deviceMap.size (); i++)
         {
@@ -1143,7 +1136,7 @@ MmWaveEnbPhy::EndSlot (void)
 }
 
 void
-MmWaveEnbPhy::SendDataChannels (Ptr<PacketBurst> pb, Time slotPrd, TtiAllocInfo& slotInfo)
+MmWaveEnbPhy::SendDataChannels (TransportBlock tb, Time slotPrd, TtiAllocInfo& slotInfo)
 {
   if (slotInfo.m_isOmni)
     {
@@ -1186,7 +1179,7 @@ MmWaveEnbPhy::SendDataChannels (Ptr<PacketBurst> pb, Time slotPrd, TtiAllocInfo&
 
 
   std::list<Ptr<MmWaveControlMessage> > ctrlMsgs;
-  m_downlinkSpectrumPhy->StartTxDataFrames (pb, ctrlMsgs, slotPrd, slotInfo.m_ttiIdx);
+  m_downlinkSpectrumPhy->StartTxDataFrames (std::move (tb), ctrlMsgs, slotPrd, slotInfo.m_ttiIdx);
 }
 
 void
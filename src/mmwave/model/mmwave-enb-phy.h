@@ -128,7 +128,7 @@ public:
 
   SlotAllocInfo m_currSlotAllocInfo;  //!< Holds the allocation info for the current NR slot
 
-  void SendDataChannels (Ptr<PacketBurst> pb, Time slotPrd, TtiAllocInfo& slotInfo);
+  void SendDataChannels (TransportBlock tb, Time slotPrd, TtiAllocInfo& slotInfo);
 
   void SendCtrlChannels (std::list<Ptr<MmWaveControlMessage> > ctrlMsg, Time slotPrd);
 
@@ -32,6 +32,7 @@
 #include "mmwave-flex-tti-mac-scheduler.h"
 #include <ns3/lte-common.h>
 #include <ns3/boolean.h>
+#include <ns3/perf-counters.h>
 #include <stdlib.h>     /* abs */
 #include "mmwave-mac-pdu-header.h"
 #include "mmwave-mac-pdu-tag.h"
@@ -190,15 +191,9 @@ void
 MmWaveFlexTtiMacScheduler::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
-  m_wbCqiRxed.clear ();
-  m_dlHarqProcessesDciInfoMap.clear ();
-  m_dlHarqProcessesTimer.clear ();
-  m_dlHarqProcessesRlcPduMap.clear ();
+  m_ueContexts.Clear ();
+  m_harqTimers.Clear ();
   m_dlHarqInfoList.clear ();
-  m_ulHarqCurrentProcessId.clear ();
-  m_ulHarqProcessesStatus.clear ();
-  m_ulHarqProcessesTimer.clear ();
-  m_ulHarqProcessesDciInfoMap.clear ();
   delete m_macCschedSapProvider;
   delete m_macSchedSapProvider;
 }
@@ -326,9 +321,14 @@ MmWaveFlexTtiMacScheduler::DoSchedDlRlcBufferReq (const struct MmWaveMacSchedSap
   // initialize statistics of the flow in case of new flows
   if (newLc == true)
     {
-      m_wbCqiRxed.insert ( std::pair<uint16_t, uint8_t > (params.m_rnti, 1));   // only codeword 0 at this stage (SISO)
-      // initialized to 1 (i.e., the lowest value for transmitting a signal)
-      m_wbCqiTimers.insert ( std::pair<uint16_t, uint32_t > (params.m_rnti, m_cqiTimersThreshold));
+      MmWaveFlexTtiUeContext &ctx = m_ueContexts.Get (params.m_rnti);
+      if (!ctx.m_hasDlCqi)
+        {
+          ctx.m_hasDlCqi = true;
+          ctx.m_dlCqi = 1;   // only codeword 0 at this stage (SISO)
+          // initialized to 1 (i.e., the lowest value for transmitting a signal)
+          ctx.m_dlCqiTimer = m_cqiTimersThreshold;
+        }
     }
 }
 
@@ -337,31 +337,18 @@ MmWaveFlexTtiMacScheduler::DoSchedDlCqiInfoReq (const struct MmWaveMacSchedSapPr
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint8_t>::iterator it;
   for (unsigned int i = 0; i < params.m_cqiList.size (); i++)
     {
       if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::WB )
         {
           // wideband CQI reporting
-          std::map <uint16_t,uint8_t>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
-          it = m_wbCqiRxed.find (rnti);
-          if (it == m_wbCqiRxed.end ())
-            {
-              // create the new entry
-              m_wbCqiRxed.insert ( std::pair<uint16_t, uint8_t > (rnti, params.m_cqiList.at (i).m_wbCqi) ); // only codeword 0 at this stage (SISO)
-              // generate correspondent timer
-              m_wbCqiTimers.insert ( std::pair<uint16_t, uint32_t > (rnti, m_cqiTimersThreshold));
-            }
-          else
-            {
-              // update the CQI value
-              (*it).second = params.m_cqiList.at (i).m_wbCqi;
-              // update correspondent timer
-              std::map <uint16_t,uint32_t>::iterator itTimers;
-              itTimers = m_wbCqiTimers.find (rnti);
-              (*itTimers).second = m_cqiTimersThreshold;
-            }
+          MmWaveFlexTtiUeContext &ctx = m_ueContexts.Get (rnti);
+          // create or update the entry, only codeword 0 at this stage (SISO)
+          ctx.m_hasDlCqi = true;
+          ctx.m_dlCqi = params.m_cqiList.at (i).m_wbCqi;
+          // generate or update the correspondent timer
+          ctx.m_dlCqiTimer = m_cqiTimersThreshold;
         }
       else if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::SB )
         {
@@ -391,7 +378,6 @@ MmWaveFlexTtiMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapPr
     case UlCqiInfo::PUSCH:
       {
         std::map <uint32_t, struct AllocMapElem>::iterator itMap;
-        std::map <uint16_t, struct UlCqiMapElem>::iterator itCqi;
         itMap = m_ulAllocationMap.find (params.m_sfnSf.Encode ());
         if (itMap == m_ulAllocationMap.end ())
           {
@@ -403,11 +389,12 @@ MmWaveFlexTtiMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapPr
           {
             // convert from fixed point notation Sxxxxxxxxxxx.xxx to double
             //double sinr = LteFfConverter::fpS11dot3toDouble (params.m_ulCqi.m_sinr.at (i));
-            itCqi = m_ueUlCqi.find (itMap->second.m_rntiPerChunk.at (i));
-            if (itCqi == m_ueUlCqi.end ())
+            MmWaveFlexTtiUeContext &ctx = m_ueContexts.Get (itMap->second.m_rntiPerChunk.at (i));
+            if (!ctx.m_hasUlCqi)
               {
                 // create a new entry
-                std::vector <double> newCqi;
+                std::vector <double> &newCqi = ctx.m_ulCqi;
+                newCqi.clear ();
                 for (uint32_t j = 0; j < m_phyMacConfig->GetNumRb (); j++)
                   {
                     unsigned chunkInd = i;
@@ -423,21 +410,20 @@ MmWaveFlexTtiMacScheduler::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapPr
                         newCqi.push_back (30.0);
                       }
                   }
-                m_ueUlCqi.insert (std::pair <uint16_t, struct UlCqiMapElem> (itMap->second.m_rntiPerChunk.at (i),
-                                                                             UlCqiMapElem (newCqi, itMap->second.m_numSym, itMap->second.m_tbSize)) );
+                ctx.m_hasUlCqi = true;
+                ctx.m_ulCqiNumSym = itMap->second.m_numSym;
+                ctx.m_ulCqiTbSize = itMap->second.m_tbSize;
                 // generate correspondent timer
-                m_ueCqiTimers.insert (std::pair <uint16_t, uint32_t > (itMap->second.m_rntiPerChunk.at (i), m_cqiTimersThreshold));
+                ctx.m_ulCqiTimer = m_cqiTimersThreshold;
               }
             else
               {
                 // update the value
-                (*itCqi).second.m_ueUlCqi.at (i) = params.m_ulCqi.m_sinr.at (i);
-                (*itCqi).second.m_numSym = itMap->second.m_numSym;
-                (*itCqi).second.m_tbSize = itMap->second.m_tbSize;
+                ctx.m_ulCqi.at (i) = params.m_ulCqi.m_sinr.at (i);
+                ctx.m_ulCqiNumSym = itMap->second.m_numSym;
+                ctx.m_ulCqiTbSize = itMap->second.m_tbSize;
                 // update correspondent timer
-                std::map <uint16_t, uint32_t>::iterator itTimers;
-                itTimers = m_ueCqiTimers.find (itMap->second.m_rntiPerChunk.at (i));
-                (*itTimers).second = m_cqiTimersThreshold;
+                ctx.m_ulCqiTimer = m_cqiTimersThreshold;
 
                 NS_LOG_INFO ("UL CQI report for RNTI " << itMap->second.m_rntiPerChunk.at (i) << " chunk " << i << " SINR " << params.m_ulCqi.m_sinr.at (i) << \
                              " frame " << frameNum << " subframe " << (unsigned)subframeNum << " slot " << (unsigned)slotNum << " startSym " << (unsigned)symNum);
@@ -461,52 +447,30 @@ MmWaveFlexTtiMacScheduler::RefreshHarqProcesses ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itTimers;
-  for (itTimers = m_dlHarqProcessesTimer.begin (); itTimers != m_dlHarqProcessesTimer.end (); itTimers++)
+  // only the processes whose timer expires in this slot are visited
+  m_expiredHarqTimers.clear ();
+  m_harqTimers.Advance (m_expiredHarqTimers);
+  for (std::vector<MmWaveHarqTimerWheel::Timer>::const_iterator it = m_expiredHarqTimers.begin (); it != m_expiredHarqTimers.end (); it++)
     {
-      for (uint16_t i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
+      MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (it->m_rnti);
+      if (ctx == nullptr)
         {
-          if ((*itTimers).second.at (i) == m_phyMacConfig->GetHarqTimeout ())
-            {             // reset HARQ process
-              NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers).first);
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
-              if (itStat == m_dlHarqProcessesStatus.end ())
-                {
-                  NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers).first);
-                }
-              (*itStat).second.at (i) = 0;
-              (*itTimers).second.at (i) = 0;
-            }
-          else
-            {
-              (*itTimers).second.at (i)++;
-            }
+          continue;
         }
-    }
-
-  std::map <uint16_t, UlHarqProcessesTimer_t>::iterator itTimers2;
-  for (itTimers2 = m_ulHarqProcessesTimer.begin (); itTimers2 != m_ulHarqProcessesTimer.end (); itTimers2++)
-    {
-      for (uint16_t i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
-        {
-          if ((*itTimers2).second.at (i) == m_phyMacConfig->GetHarqTimeout ())
-            {             // reset HARQ process
-              NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers2).first);
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find ((*itTimers2).first);
-              if (itStat == m_ulHarqProcessesStatus.end ())
-                {
-                  NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers2).first);
-                }
-              (*itStat).second.at (i) = 0;
-              (*itTimers2).second.at (i) = 0;
-            }
-          else
-            {
-              (*itTimers2).second.at (i)++;
-            }
+      // timers restarted by a later transmission have a different expiry
+      if (!it->m_uplink && ctx->m_hasDlHarq && ctx->m_dlHarqExpiry.at (it->m_harqId) == it->m_expiry)
+        {             // reset HARQ process
+          NS_LOG_INFO (this << " Reset HARQ proc " << (unsigned)it->m_harqId << " for RNTI " << ctx->m_rnti);
+          ctx->m_dlHarqStatus.at (it->m_harqId) = 0;
+          ctx->m_dlHarqExpiry.at (it->m_harqId) = 0;
+        }
+      else if (it->m_uplink && ctx->m_hasUlHarq && ctx->m_ulHarqExpiry.at (it->m_harqId) == it->m_expiry)
+        {             // reset HARQ process
+          NS_LOG_INFO (this << " Reset HARQ proc " << (unsigned)it->m_harqId << " for RNTI " << ctx->m_rnti);
+          ctx->m_ulHarqStatus.at (it->m_harqId) = 0;
+          ctx->m_ulHarqExpiry.at (it->m_harqId) = 0;
         }
     }
-
 }
 
 uint8_t
@@ -522,13 +486,8 @@ MmWaveFlexTtiMacScheduler::UpdateDlHarqProcessId (uint16_t rnti)
       return tbUid;
     }
 
-//	std::map <uint16_t, uint8_t>::iterator it = m_dlHarqCurrentProcessId.find (rnti);
-//	if (it == m_dlHarqCurrentProcessId.end ())
-//	{
-//		NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
-//	}
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
-  if (itStat == m_dlHarqProcessesStatus.end ())
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+  if (ctx == nullptr || !ctx->m_hasDlHarq)
     {
       NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
     }
@@ -537,9 +496,9 @@ MmWaveFlexTtiMacScheduler::UpdateDlHarqProcessId (uint16_t rnti)
   uint8_t harqId = m_phyMacConfig->GetNumHarqProcess ();
   for (unsigned i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
     {
-      if (itStat->second[i] == 0)
+      if (ctx->m_dlHarqStatus[i] == 0)
         {
-          itStat->second[i] = 1;
+          ctx->m_dlHarqStatus[i] = 1;
           harqId = i;
           break;
         }
@@ -577,13 +536,8 @@ MmWaveFlexTtiMacScheduler::UpdateUlHarqProcessId (uint16_t rnti)
       return tbUid;
     }
 
-//	std::map <uint16_t, uint8_t>::iterator it = m_ulHarqCurrentProcessId.find (rnti);
-//	if (it == m_ulHarqCurrentProcessId.end ())
-//	{
-//		NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
-//	}
-  std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
-  if (itStat == m_ulHarqProcessesStatus.end ())
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+  if (ctx == nullptr || !ctx->m_hasUlHarq)
     {
       NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
     }
@@ -592,9 +546,9 @@ MmWaveFlexTtiMacScheduler::UpdateUlHarqProcessId (uint16_t rnti)
   uint8_t harqId = m_phyMacConfig->GetNumHarqProcess ();
   for (unsigned i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
     {
-      if (itStat->second[i] == 0)
+      if (ctx->m_ulHarqStatus[i] == 0)
         {
-          itStat->second[i] = 1;
+          ctx->m_ulHarqStatus[i] = 1;
           harqId = i;
           break;
         }
@@ -657,6 +611,7 @@ void
 MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
 {
   NS_LOG_FUNCTION (this);
+  NS_PERF_TIMER ("mmwave", "MmWaveFlexTtiMacScheduler::DoSchedTriggerReq");
 
   uint16_t frameNum = params.m_snfSf.m_frameNum;
   uint8_t sfNum = params.m_snfSf.m_sfNum;
@@ -719,8 +674,10 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
   else
     {
       // Process DL HARQ feedback and assign slots for RETX if resources available
-      std::vector <struct DlHarqInfo> dlInfoListUntxed;            // TBs not able to be retransmitted in this sf
-      std::vector <struct UlHarqInfo> ulInfoListUntxed;
+      // the TBs not able to be retransmitted in this sf are compacted in place
+      // at the head of the lists, keeping their order
+      unsigned dlNumUntxed = 0;
+      unsigned ulNumUntxed = 0;
 
       for (unsigned i = 0; i < m_dlHarqInfoList.size (); i++)
         {
@@ -731,46 +688,30 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
           uint8_t harqId = m_dlHarqInfoList.at (i).m_harqProcessId;
           uint16_t rnti = m_dlHarqInfoList.at (i).m_rnti;
           itUeInfo = ueInfo.find (rnti);
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
-          if (itStat == m_dlHarqProcessesStatus.end ())
+          MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+          if (ctx == nullptr || !ctx->m_hasDlHarq)
             {
               NS_FATAL_ERROR ("No HARQ status info found for UE " << rnti);
             }
-          std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (rnti);
-          if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << m_dlHarqInfoList.at (i).m_rnti);
-            }
-          if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::ACK || itStat->second.at (harqId) == 0)
+          if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::ACK || ctx->m_dlHarqStatus.at (harqId) == 0)
             {             // acknowledgment or process timeout, reset process
               //NS_LOG_DEBUG ("UE" << rnti << " DL harqId " << (unsigned)harqId << " HARQ-ACK received");
-              itStat->second.at (harqId) = 0;                      // release process ID
-              for (uint16_t k = 0; k < itRlcPdu->second.size (); k++)                           // clear RLC buffers
-                {
-                  itRlcPdu->second.at (harqId).clear ();
-                }
+              ctx->m_dlHarqStatus.at (harqId) = 0;                      // release process ID
+              ctx->m_dlHarqRlcPdu.at (harqId).clear ();                 // clear RLC buffers
               continue;
             }
           else if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::NACK)
             {
-              std::map <uint16_t, DlHarqProcessesDciInfoList_t>::iterator itHarq = m_dlHarqProcessesDciInfoMap.find (rnti);
-              if (itHarq == m_dlHarqProcessesDciInfoMap.end ())
-                {
-                  NS_FATAL_ERROR ("No DCI/HARQ buffer entry found for UE " << rnti);
-                }
-              DciInfoElementTdma dciInfoReTx = itHarq->second.at (harqId);
+              DciInfoElementTdma dciInfoReTx = ctx->m_dlHarqDci.at (harqId);
               //NS_LOG_DEBUG ("UE" << rnti << " DL harqId " << (unsigned)harqId << " HARQ-NACK received, rv " << (unsigned)dciInfoReTx.m_rv);
               NS_ASSERT (harqId == dciInfoReTx.m_harqProcess);
               //NS_ASSERT(itStat->second.at (harqId) > 0);
-              NS_ASSERT (itStat->second.at (harqId) - 1 == dciInfoReTx.m_rv);
+              NS_ASSERT (ctx->m_dlHarqStatus.at (harqId) - 1 == dciInfoReTx.m_rv);
               if (dciInfoReTx.m_rv == 3)                   // maximum number of retx reached -> drop process
                 {
                   NS_LOG_INFO ("Max number of retransmissions reached -> drop process");
-                  itStat->second.at (harqId) = 0;
-                  for (uint16_t k = 0; k < (*itRlcPdu).second.size (); k++)
-                    {
-                      itRlcPdu->second.at (harqId).clear ();
-                    }
+                  ctx->m_dlHarqStatus.at (harqId) = 0;
+                  ctx->m_dlHarqRlcPdu.at (harqId).clear ();
                   continue;
                 }
 
@@ -828,7 +769,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
               }
               if (numSymReq <= (m_phyMacConfig->GetSymbolsPerSubframe () - resvCtrl))
               {	// not enough symbols to encode TB at required MCS, attempt in later SF
-                      dlInfoListUntxed.push_back (m_dlHarqInfoList.at (i));
+                      m_dlHarqInfoList.at (dlNumUntxed++) = m_dlHarqInfoList.at (i);
                       continue;
               }*/
 
@@ -841,23 +782,18 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
                   NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
                   dciInfoReTx.m_rv++;
                   dciInfoReTx.m_ndi = 0;
-                  itHarq->second.at (harqId) = dciInfoReTx;
-                  itStat->second.at (harqId) = itStat->second.at (harqId) + 1;
-                  TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::DL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, itUeInfo->first);
+                  ctx->m_dlHarqDci.at (harqId) = dciInfoReTx;
+                  ctx->m_dlHarqStatus.at (harqId) = ctx->m_dlHarqStatus.at (harqId) + 1;
+                  TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::DL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, rnti);
                   ttiInfo.m_dci = dciInfoReTx;
                   NS_LOG_DEBUG ("UE" << dciInfoReTx.m_rnti << " gets DL OFDM symbols " << (unsigned)dciInfoReTx.m_symStart << "-" << (unsigned)(dciInfoReTx.m_symStart + dciInfoReTx.m_numSym - 1) <<
                                 " tbs " << dciInfoReTx.m_tbSize << " harqId " << (unsigned)dciInfoReTx.m_harqProcess << " harqId " << (unsigned)dciInfoReTx.m_harqProcess <<
                                 " rv " << (unsigned)dciInfoReTx.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum << " slot " <<
                                 (unsigned)ret.m_sfnSf.m_slotNum << " RETX");
 
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcList =  m_dlHarqProcessesRlcPduMap.find (rnti);
-                  if (itRlcList == m_dlHarqProcessesRlcPduMap.end ())
-                    {
-                      NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << rnti);
-                    }
-                  for (uint16_t k = 0; k < (*itRlcList).second.at (dciInfoReTx.m_harqProcess).size (); k++)
+                  for (uint16_t k = 0; k < ctx->m_dlHarqRlcPdu.at (dciInfoReTx.m_harqProcess).size (); k++)
                     {
-                      ttiInfo.m_rlcPduInfo.push_back ((*itRlcList).second.at (dciInfoReTx.m_harqProcess).at (k));
+                      ttiInfo.m_rlcPduInfo.push_back (ctx->m_dlHarqRlcPdu.at (dciInfoReTx.m_harqProcess).at (k));
                     }
                   ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
                   ret.m_slotAllocInfo.m_numSymAlloc += dciInfoReTx.m_numSym;
@@ -870,13 +806,12 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
               else
                 {
                   NS_LOG_INFO ("No resource for this retx -> buffer it");
-                  dlInfoListUntxed.push_back (m_dlHarqInfoList.at (i));
+                  m_dlHarqInfoList.at (dlNumUntxed++) = m_dlHarqInfoList.at (i);
                 }
             }
         }
 
-      m_dlHarqInfoList.clear ();
-      m_dlHarqInfoList = dlInfoListUntxed;
+      m_dlHarqInfoList.resize (dlNumUntxed);
 
       // Process UL HARQ feedback
       for (uint16_t i = 0; i < m_ulHarqInfoList.size (); i++)
@@ -889,36 +824,29 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
           uint8_t harqId = harqInfo.m_harqProcessId;
           uint16_t rnti = harqInfo.m_rnti;
           itUeInfo = ueInfo.find (rnti);
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
-          if (itStat == m_ulHarqProcessesStatus.end ())
+          MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+          if (ctx == nullptr || !ctx->m_hasUlHarq)
             {
               NS_LOG_ERROR ("No info found in HARQ buffer for UE (might have changed eNB) " << rnti);
+              continue;
             }
-          if (harqInfo.m_receptionStatus == UlHarqInfo::Ok || itStat->second.at (harqId) == 0)
+          if (harqInfo.m_receptionStatus == UlHarqInfo::Ok || ctx->m_ulHarqStatus.at (harqId) == 0)
             {
               //NS_LOG_DEBUG ("UE" << rnti << " UL harqId " << (unsigned)harqInfo.m_harqProcessId << " HARQ-ACK received");
-              if (itStat != m_ulHarqProcessesStatus.end ())
-                {
-                  itStat->second.at (harqId) = 0;                        // release process ID
-                }
+              ctx->m_ulHarqStatus.at (harqId) = 0;                        // release process ID
             }
           else if (harqInfo.m_receptionStatus == UlHarqInfo::NotOk)
             {
-              std::map <uint16_t, UlHarqProcessesDciInfoList_t>::iterator itHarq = m_ulHarqProcessesDciInfoMap.find (rnti);
-              if (itHarq == m_ulHarqProcessesDciInfoMap.end ())
-                {
-                  NS_LOG_ERROR ("No info found in UL-HARQ buffer for UE (might have changed eNB) " << rnti);
-                }
               // retx correspondent block: retrieve the UL-DCI
-              DciInfoElementTdma dciInfoReTx = itHarq->second.at (harqId);
+              DciInfoElementTdma dciInfoReTx = ctx->m_ulHarqDci.at (harqId);
               //NS_LOG_DEBUG ("UE" << rnti << " UL harqId " << (unsigned)harqInfo.m_harqProcessId << " HARQ-NACK received, rv " << (unsigned)dciInfoReTx.m_rv);
               NS_ASSERT (harqId == dciInfoReTx.m_harqProcess);
-              NS_ASSERT (itStat->second.at (harqId) > 0);
-              NS_ASSERT (itStat->second.at (harqId) - 1 == dciInfoReTx.m_rv);
+              NS_ASSERT (ctx->m_ulHarqStatus.at (harqId) > 0);
+              NS_ASSERT (ctx->m_ulHarqStatus.at (harqId) - 1 == dciInfoReTx.m_rv);
               if (dciInfoReTx.m_rv == 3)
                 {
                   NS_LOG_INFO ("Max number of retransmissions reached (UL)-> drop process");
-                  itStat->second.at (harqId) = 0;
+                  ctx->m_ulHarqStatus.at (harqId) = 0;
                   continue;
                 }
 
@@ -930,8 +858,8 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
                   NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
                   dciInfoReTx.m_rv++;
                   dciInfoReTx.m_ndi = 0;
-                  itStat->second.at (harqId) = itStat->second.at (harqId) + 1;
-                  itHarq->second.at (harqId) = dciInfoReTx;
+                  ctx->m_ulHarqStatus.at (harqId) = ctx->m_ulHarqStatus.at (harqId) + 1;
+                  ctx->m_ulHarqDci.at (harqId) = dciInfoReTx;
                   TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::UL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, rnti);
                   ttiInfo.m_dci = dciInfoReTx;
                   NS_LOG_DEBUG ("UE" << dciInfoReTx.m_rnti << " gets UL OFDM symbols " << (unsigned)dciInfoReTx.m_symStart << "-" << (unsigned)(dciInfoReTx.m_symStart + dciInfoReTx.m_numSym - 1) <<
@@ -947,13 +875,12 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
                 }
               else
                 {
-                  ulInfoListUntxed.push_back (m_ulHarqInfoList.at (i));
+                  m_ulHarqInfoList.at (ulNumUntxed++) = m_ulHarqInfoList.at (i);
                 }
             }
         }
 
-      m_ulHarqInfoList.clear ();
-      m_ulHarqInfoList = ulInfoListUntxed;
+      m_ulHarqInfoList.resize (ulNumUntxed);
     }
 
   // ********************* END OF HARQ SECTION, START OF NEW DATA SCHEDULING ********************* //
@@ -975,11 +902,11 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
             {
               NS_LOG_INFO (this << " User " << itRlcBuf->m_rnti << " LC " << (uint16_t)itRlcBuf->m_logicalChannelIdentity << " is active, status  "
                            << (*itRlcBuf).m_rlcStatusPduSize << " retx " << (*itRlcBuf).m_rlcRetransmissionQueueSize << " tx " << (*itRlcBuf).m_rlcTransmissionQueueSize);
-              std::map <uint16_t,uint8_t>::iterator itCqi = m_wbCqiRxed.find (itRlcBuf->m_rnti);
+              MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (itRlcBuf->m_rnti);
               uint8_t cqi = 0;
-              if (itCqi != m_wbCqiRxed.end ())
+              if (ctx != nullptr && ctx->m_hasDlCqi)
                 {
-                  cqi = itCqi->second;
+                  cqi = ctx->m_dlCqi;
                 }
               else                   // no CQI available
                 {
@@ -1050,17 +977,16 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
   // get info on active UL flows
   if (symAvail > 0 && !m_dlOnly)        // remaining symbols in future UL subframe after HARQ retx sched
     {
-      std::map <uint16_t,uint32_t>::iterator ceBsrIt;
-      for (ceBsrIt = m_ceBsrRxed.begin (); ceBsrIt != m_ceBsrRxed.end (); ceBsrIt++)
+      for (MmWaveFlexTtiUeContextTable::Iterator itCtx = m_ueContexts.Begin (); itCtx != m_ueContexts.End (); itCtx++)
         {
-          if (ceBsrIt->second > 0)                // UL buffer size > 0
+          MmWaveFlexTtiUeContext &ctx = **itCtx;
+          if (ctx.m_hasBsr && ctx.m_bsr > 0)                // UL buffer size > 0
             {
-              std::map <uint16_t, struct UlCqiMapElem>::iterator itCqi = m_ueUlCqi.find (ceBsrIt->first);
               int cqi = 0;
               uint8_t mcs {0};
-              if (itCqi == m_ueUlCqi.end ())                   // no cqi info for this UE
+              if (!ctx.m_hasUlCqi)                   // no cqi info for this UE
                 {
-                  NS_LOG_INFO (this << " UE " << ceBsrIt->first << " does not have UL-CQI");
+                  NS_LOG_INFO (this << " UE " << ctx.m_rnti << " does not have UL-CQI");
                   cqi = 1;
                   mcs = 0;
                 }
@@ -1072,7 +998,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
                   for (uint32_t ichunk = 0; ichunk < m_phyMacConfig->GetNumRb (); ichunk++)
                     {
                       NS_ASSERT (specIt != specVals.ValuesEnd ());
-                      *specIt = itCqi->second.m_ueUlCqi.at (ichunk);                           //sinrLin;
+                      *specIt = ctx.m_ulCqi.at (ichunk);                           //sinrLin;
                       specIt++;
                     }
 
@@ -1080,14 +1006,14 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
 
                   if (cqi == 0 && !m_fixedMcsUl)                       // out of range (SINR too low)
                     {
-                      NS_LOG_INFO ("*** RNTI " << ceBsrIt->first << " UL-CQI out of range, skipping allocation in UL");
+                      NS_LOG_INFO ("*** RNTI " << ctx.m_rnti << " UL-CQI out of range, skipping allocation in UL");
                       break;                            // do not allocate UE in uplink
                     }
                 }
-              itUeInfo = ueInfo.find (ceBsrIt->first);
+              itUeInfo = ueInfo.find (ctx.m_rnti);
               if (itUeInfo == ueInfo.end ())
                 {
-                  itUeInfo = ueInfo.insert (std::pair<uint16_t, struct UeSchedInfo> (ceBsrIt->first, UeSchedInfo () )).first;
+                  itUeInfo = ueInfo.insert (std::pair<uint16_t, struct UeSchedInfo> (ctx.m_rnti, UeSchedInfo () )).first;
                   nFlowsUl++;
                 }
               else if (itUeInfo->second.m_maxUlBufSize == 0)
@@ -1102,7 +1028,7 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
                 {
                   itUeInfo->second.m_ulMcs = mcs;                      //m_amc->GetMcsFromCqi (cqi);  // get MCS
                 }
-              itUeInfo->second.m_maxUlBufSize = ceBsrIt->second + m_rlcHdrSize + m_macHdrSize + 8;
+              itUeInfo->second.m_maxUlBufSize = ctx.m_bsr + m_rlcHdrSize + m_macHdrSize + 8;
             }
         }
     }
@@ -1342,19 +1268,15 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
 
           if (m_harqOn == true)
             {                   // store DCI for HARQ buffer
-              std::map <uint16_t, DlHarqProcessesDciInfoList_t>::iterator itDciInfo = m_dlHarqProcessesDciInfoMap.find (dci.m_rnti);
-              if (itDciInfo == m_dlHarqProcessesDciInfoMap.end ())
+              MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (dci.m_rnti);
+              if (ctx == nullptr || !ctx->m_hasDlHarq)
                 {
                   NS_FATAL_ERROR ("Unable to find RNTI entry in DCI HARQ buffer for RNTI " << dci.m_rnti);
                 }
-              (*itDciInfo).second.at (dci.m_harqProcess) = dci;
+              ctx->m_dlHarqDci.at (dci.m_harqProcess) = dci;
               // refresh timer
-              std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (dci.m_rnti);
-              if (itHarqTimer == m_dlHarqProcessesTimer.end ())
-                {
-                  NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)dci.m_rnti);
-                }
-              (*itHarqTimer).second.at (dci.m_harqProcess) = 0;
+              ctx->m_dlHarqExpiry.at (dci.m_harqProcess) = m_harqTimers.Schedule (dci.m_rnti, dci.m_harqProcess, false,
+                                                                                    m_phyMacConfig->GetHarqTimeout () + 1);
             }
 
           // distribute bytes between active RLC queues
@@ -1401,12 +1323,12 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
               if (m_harqOn == true)
                 {
                   // store RLC PDU list for HARQ
-                  std::map <uint16_t, DlHarqRlcPduList_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduMap.find (dci.m_rnti);
-                  if (itRlcPdu == m_dlHarqProcessesRlcPduMap.end ())
+                  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (dci.m_rnti);
+                  if (ctx == nullptr || !ctx->m_hasDlHarq)
                     {
                       NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << dci.m_rnti);
                     }
-                  (*itRlcPdu).second.at (dci.m_harqProcess).push_back (ueSchedInfo.m_rlcPduInfo[i]);
+                  ctx->m_dlHarqRlcPdu.at (dci.m_harqProcess).push_back (ueSchedInfo.m_rlcPduInfo[i]);
                 }
             }
           // reorder/reindex slots to maintain DL before UL slot order
@@ -1478,22 +1400,17 @@ MmWaveFlexTtiMacScheduler::DoSchedTriggerReq (const struct MmWaveMacSchedSapProv
           if (m_harqOn == true)
             {
               uint8_t harqId = dci.m_harqProcess;
-              std::map <uint16_t, UlHarqProcessesDciInfoList_t>::iterator itHarqTbInfo = m_ulHarqProcessesDciInfoMap.find (dci.m_rnti);
-              if (itHarqTbInfo == m_ulHarqProcessesDciInfoMap.end ())
+              MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (dci.m_rnti);
+              if (ctx == nullptr || !ctx->m_hasUlHarq)
                 {
                   NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << dci.m_rnti);
                 }
-              (*itHarqTbInfo).second.at (harqId) = dci;
+              ctx->m_ulHarqDci.at (harqId) = dci;
               // Update HARQ process status (RV 0)
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (dci.m_rnti);
-              NS_ASSERT (itStat->second[dci.m_harqProcess] > 0);
+              NS_ASSERT (ctx->m_ulHarqStatus[dci.m_harqProcess] > 0);
               // refresh timer
-              std::map <uint16_t, UlHarqProcessesTimer_t>::iterator itHarqTimer =  m_ulHarqProcessesTimer.find (dci.m_rnti);
-              if (itHarqTimer == m_ulHarqProcessesTimer.end ())
-                {
-                  NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)dci.m_rnti);
-                }
-              (*itHarqTimer).second.at (dci.m_harqProcess) = 0;
+              ctx->m_ulHarqExpiry.at (dci.m_harqProcess) = m_harqTimers.Schedule (dci.m_rnti, dci.m_harqProcess, true,
+                                                                                    m_phyMacConfig->GetHarqTimeout () + 1);
             }
         }
       itUeInfo++;
@@ -1519,8 +1436,6 @@ MmWaveFlexTtiMacScheduler::DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSchedS
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint32_t>::iterator it;
-
   for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
     {
       if ( params.m_macCeList.at (i).m_macCeType == MacCeElement::BSR )
@@ -1540,19 +1455,19 @@ MmWaveFlexTtiMacScheduler::DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSchedS
             }
 
           uint16_t rnti = params.m_macCeList.at (i).m_rnti;
-          it = m_ceBsrRxed.find (rnti);
-          if (it == m_ceBsrRxed.end ())
+          MmWaveFlexTtiUeContext &ctx = m_ueContexts.Get (rnti);
+          if (!ctx.m_hasBsr)
             {
               // create the new entry
-              m_ceBsrRxed.insert ( std::pair<uint16_t, uint32_t > (rnti, buffer));
+              ctx.m_hasBsr = true;
               NS_LOG_INFO (this << " Insert RNTI " << rnti << " queue " << buffer);
             }
           else
             {
               // update the buffer size value
-              (*it).second = buffer;
               NS_LOG_INFO (this << " Update RNTI " << rnti << " queue " << buffer);
             }
+          ctx.m_bsr = buffer;
         }
     }
 
@@ -1579,29 +1494,28 @@ MmWaveFlexTtiMacScheduler::SortRlcBufferReq (MmWaveMacSchedSapProvider::SchedDlR
 void
 MmWaveFlexTtiMacScheduler::RefreshDlCqiMaps (void)
 {
-  NS_LOG_FUNCTION (this << m_wbCqiTimers.size ());
+  NS_LOG_FUNCTION (this << m_ueContexts.GetSize ());
   // refresh DL CQI P01 Map
-  std::map <uint16_t,uint32_t>::iterator itP10 = m_wbCqiTimers.begin ();
-  while (itP10 != m_wbCqiTimers.end ())
+  for (MmWaveFlexTtiUeContextTable::Iterator itCtx = m_ueContexts.Begin (); itCtx != m_ueContexts.End (); itCtx++)
     {
-      NS_LOG_INFO (this << " P10-CQI for user " << (*itP10).first << " is " << (uint32_t)(*itP10).second << " thr " << (uint32_t)m_cqiTimersThreshold);
-      if ((*itP10).second == 0)
+      MmWaveFlexTtiUeContext &ctx = **itCtx;
+      if (!ctx.m_hasDlCqi)
+        {
+          continue;
+        }
+      NS_LOG_INFO (this << " P10-CQI for user " << ctx.m_rnti << " is " << (uint32_t)ctx.m_dlCqiTimer << " thr " << (uint32_t)m_cqiTimersThreshold);
+      if (ctx.m_dlCqiTimer == 0)
         {
           // delete correspondent entries
-          std::map <uint16_t,uint8_t>::iterator itMap = m_wbCqiRxed.find ((*itP10).first);
-          NS_ASSERT_MSG (itMap != m_wbCqiRxed.end (), " Does not find CQI report for user " << (*itP10).first);
-          NS_LOG_INFO (this << " P10-CQI exired for user " << (*itP10).first);
-          m_wbCqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itP10;
-          itP10++;
-          m_wbCqiTimers.erase (temp);
+          NS_LOG_INFO (this << " P10-CQI exired for user " << ctx.m_rnti);
+          ctx.m_hasDlCqi = false;
         }
       else
         {
-          (*itP10).second--;
-          itP10++;
+          ctx.m_dlCqiTimer--;
         }
     }
+  m_ueContexts.Purge ();
 
   return;
 }
@@ -1611,28 +1525,27 @@ void
 MmWaveFlexTtiMacScheduler::RefreshUlCqiMaps (void)
 {
   // refresh UL CQI  Map
-  std::map <uint16_t,uint32_t>::iterator itUl = m_ueCqiTimers.begin ();
-  while (itUl != m_ueCqiTimers.end ())
+  for (MmWaveFlexTtiUeContextTable::Iterator itCtx = m_ueContexts.Begin (); itCtx != m_ueContexts.End (); itCtx++)
     {
-      NS_LOG_INFO (this << " UL-CQI for user " << (*itUl).first << " is " << (uint32_t)(*itUl).second << " thr " << (uint32_t)m_cqiTimersThreshold);
-      if ((*itUl).second == 0)
+      MmWaveFlexTtiUeContext &ctx = **itCtx;
+      if (!ctx.m_hasUlCqi)
+        {
+          continue;
+        }
+      NS_LOG_INFO (this << " UL-CQI for user " << ctx.m_rnti << " is " << (uint32_t)ctx.m_ulCqiTimer << " thr " << (uint32_t)m_cqiTimersThreshold);
+      if (ctx.m_ulCqiTimer == 0)
         {
           // delete correspondent entries
-          std::map <uint16_t, struct UlCqiMapElem>::iterator itMap = m_ueUlCqi.find ((*itUl).first);
-          NS_ASSERT_MSG (itMap != m_ueUlCqi.end (), " Does not find CQI report for user " << (*itUl).first);
-          NS_LOG_INFO (this << " UL-CQI expired for user " << (*itUl).first);
-          itMap->second.m_ueUlCqi.clear ();
-          m_ueUlCqi.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itUl;
-          itUl++;
-          m_ueCqiTimers.erase (temp);
+          NS_LOG_INFO (this << " UL-CQI expired for user " << ctx.m_rnti);
+          ctx.m_hasUlCqi = false;
+          ctx.m_ulCqi.clear ();
         }
       else
         {
-          (*itUl).second--;
-          itUl++;
+          ctx.m_ulCqiTimer--;
         }
     }
+  m_ueContexts.Purge ();
 
   return;
 }
@@ -1701,17 +1614,17 @@ MmWaveFlexTtiMacScheduler::UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size)
 {
 
   size = size - 2; // remove the minimum RLC overhead
-  std::map <uint16_t,uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
-  if (it != m_ceBsrRxed.end ())
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+  if (ctx != nullptr && ctx->m_hasBsr)
     {
-      NS_LOG_INFO (this << " Update RLC BSR UE " << rnti << " size " << size << " BSR " << (*it).second);
-      if ((*it).second >= size)
+      NS_LOG_INFO (this << " Update RLC BSR UE " << rnti << " size " << size << " BSR " << ctx->m_bsr);
+      if (ctx->m_bsr >= size)
         {
-          (*it).second -= size;
+          ctx->m_bsr -= size;
         }
       else
         {
-          (*it).second = 0;
+          ctx->m_bsr = 0;
         }
     }
   else
@@ -1740,35 +1653,22 @@ MmWaveFlexTtiMacScheduler::DoCschedUeConfigReq (const struct MmWaveMacCschedSapP
 {
   NS_LOG_FUNCTION (this << " RNTI " << params.m_rnti << " txMode " << (uint16_t)params.m_transmissionMode);
 
-  if (m_dlHarqProcessesStatus.find (params.m_rnti) == m_dlHarqProcessesStatus.end ())
+  MmWaveFlexTtiUeContext &ctx = m_ueContexts.Get (params.m_rnti);
+  if (!ctx.m_hasDlHarq)
     {
-      //m_dlHarqCurrentProcessId.insert (std::pair <uint16_t,uint8_t > (params.m_rnti, 0));
-      DlHarqProcessesStatus_t dlHarqPrcStatus;
-      dlHarqPrcStatus.resize (m_phyMacConfig->GetNumHarqProcess (), 0);
-      m_dlHarqProcessesStatus.insert (std::pair <uint16_t, DlHarqProcessesStatus_t> (params.m_rnti, dlHarqPrcStatus));
-      DlHarqProcessesTimer_t dlHarqProcessesTimer;
-      dlHarqProcessesTimer.resize (m_phyMacConfig->GetNumHarqProcess (),0);
-      m_dlHarqProcessesTimer.insert (std::pair <uint16_t, DlHarqProcessesTimer_t> (params.m_rnti, dlHarqProcessesTimer));
-      DlHarqProcessesDciInfoList_t dlHarqTbInfoList;
-      dlHarqTbInfoList.resize (m_phyMacConfig->GetNumHarqProcess ());
-      m_dlHarqProcessesDciInfoMap.insert (std::pair <uint16_t, DlHarqProcessesDciInfoList_t> (params.m_rnti, dlHarqTbInfoList));
-      DlHarqRlcPduList_t dlHarqRlcPduList;
-      dlHarqRlcPduList.resize (m_phyMacConfig->GetNumHarqProcess ());
-      m_dlHarqProcessesRlcPduMap.insert (std::pair <uint16_t, DlHarqRlcPduList_t> (params.m_rnti, dlHarqRlcPduList));
+      ctx.m_hasDlHarq = true;
+      ctx.m_dlHarqStatus.assign (m_phyMacConfig->GetNumHarqProcess (), 0);
+      ctx.m_dlHarqExpiry.assign (m_phyMacConfig->GetNumHarqProcess (), 0);
+      ctx.m_dlHarqDci.assign (m_phyMacConfig->GetNumHarqProcess (), DciInfoElementTdma ());
+      ctx.m_dlHarqRlcPdu.assign (m_phyMacConfig->GetNumHarqProcess (), std::vector <struct RlcPduInfo> ());
     }
 
-  if (m_ulHarqProcessesStatus.find (params.m_rnti) == m_ulHarqProcessesStatus.end ())
+  if (!ctx.m_hasUlHarq)
     {
-      //				m_ulHarqCurrentProcessId.insert (std::pair <uint16_t,uint8_t > (rnti, 0));
-      UlHarqProcessesStatus_t ulHarqPrcStatus;
-      ulHarqPrcStatus.resize (m_phyMacConfig->GetNumHarqProcess (), 0);
-      m_ulHarqProcessesStatus.insert (std::pair <uint16_t, UlHarqProcessesStatus_t> (params.m_rnti, ulHarqPrcStatus));
-      UlHarqProcessesTimer_t ulHarqProcessesTimer;
-      ulHarqProcessesTimer.resize (m_phyMacConfig->GetNumHarqProcess (),0);
-      m_ulHarqProcessesTimer.insert (std::pair <uint16_t, UlHarqProcessesTimer_t> (params.m_rnti, ulHarqProcessesTimer));
-      UlHarqProcessesDciInfoList_t ulHarqTbInfoList;
-      ulHarqTbInfoList.resize (m_phyMacConfig->GetNumHarqProcess ());
-      m_ulHarqProcessesDciInfoMap.insert (std::pair <uint16_t, UlHarqProcessesDciInfoList_t> (params.m_rnti, ulHarqTbInfoList));
+      ctx.m_hasUlHarq = true;
+      ctx.m_ulHarqStatus.assign (m_phyMacConfig->GetNumHarqProcess (), 0);
+      ctx.m_ulHarqExpiry.assign (m_phyMacConfig->GetNumHarqProcess (), 0);
+      ctx.m_ulHarqDci.assign (m_phyMacConfig->GetNumHarqProcess (), DciInfoElementTdma ());
     }
 }
 
@@ -1807,16 +1707,14 @@ MmWaveFlexTtiMacScheduler::DoCschedUeReleaseReq (const struct MmWaveMacCschedSap
 {
   NS_LOG_FUNCTION (this << " Release RNTI " << params.m_rnti);
 
-  //m_dlHarqCurrentProcessId.erase (params.m_rnti);
-  m_dlHarqProcessesStatus.erase  (params.m_rnti);
-  m_dlHarqProcessesTimer.erase (params.m_rnti);
-  m_dlHarqProcessesDciInfoMap.erase  (params.m_rnti);
-  m_dlHarqProcessesRlcPduMap.erase  (params.m_rnti);
-  //m_ulHarqCurrentProcessId.erase  (params.m_rnti);
-  m_ulHarqProcessesTimer.erase (params.m_rnti);
-  m_ulHarqProcessesStatus.erase  (params.m_rnti);
-  m_ulHarqProcessesDciInfoMap.erase  (params.m_rnti);
-  m_ceBsrRxed.erase (params.m_rnti);
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (params.m_rnti);
+  if (ctx != nullptr)
+    {
+      ctx->m_hasDlHarq = false;
+      ctx->m_hasUlHarq = false;
+      ctx->m_hasBsr = false;
+      m_ueContexts.Purge ();
+    }
   std::list<MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it = m_rlcBufferReq.begin ();
   while (it != m_rlcBufferReq.end ())
     {
@@ -35,6 +35,8 @@
 #include "mmwave-mac-csched-sap.h"
 #include "mmwave-mac-scheduler.h"
 #include "mmwave-amc.h"
+#include "mmwave-flex-tti-ue-context.h"
+#include "mmwave-harq-timer-wheel.h"
 #include "string"
 #include <vector>
 #include <set>
@@ -46,17 +48,6 @@ namespace mmwave {
 class MmWaveFlexTtiMacScheduler : public MmWaveMacScheduler
 {
 public:
-  typedef std::vector < uint8_t > DlHarqProcessesStatus_t;
-  typedef std::vector < uint8_t > DlHarqProcessesTimer_t;
-  typedef std::vector < DciInfoElementTdma > DlHarqProcessesDciInfoList_t;
-  typedef std::vector < std::vector <struct RlcPduInfo> > DlHarqRlcPduList_t;       // vector of the LCs per per UE HARQ process
-  //	typedef std::vector < RlcPduElement > DlHarqRlcPduList_t; // vector of the 8 HARQ processes per UE
-
-  typedef std::vector < uint8_t > UlHarqProcessesTimer_t;
-  typedef std::vector < DciInfoElementTdma > UlHarqProcessesDciInfoList_t;
-  typedef std::vector < uint8_t > UlHarqProcessesStatus_t;
-
-
   MmWaveFlexTtiMacScheduler ();
 
   virtual ~MmWaveFlexTtiMacScheduler ();
@@ -210,42 +201,17 @@ private:
   std::list <MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters> m_rlcBufferReq;
 
   /*
-   * Map of UE's DL CQI WB received
+   * Per-UE CQI, buffer status and HARQ state
    */
-  std::map <uint16_t,uint8_t> m_wbCqiRxed;
-  /*
-   * Map of UE's timers on DL CQI WB received
-   */
-  std::map <uint16_t,uint32_t> m_wbCqiTimers;
-
-  uint32_t m_cqiTimersThreshold;       // # of TTIs for which a CQI can be considered valid
+  MmWaveFlexTtiUeContextTable m_ueContexts;
 
   /*
-   * Map of UEs' UL-CQI per RBG
+   * Timers of the HARQ processes, and the ones expired in the current slot
    */
-  struct UlCqiMapElem
-  {
-    UlCqiMapElem (std::vector<double> ulCqi, uint8_t nSym, uint32_t tbs)
-      : m_ueUlCqi (ulCqi),
-        m_numSym (nSym),
-        m_tbSize (tbs)
-    {
-    }
-    std::vector <double> m_ueUlCqi;
-    uint8_t         m_numSym;
-    uint32_t        m_tbSize;
-  };
-
-  std::map <uint16_t, struct UlCqiMapElem> m_ueUlCqi;
-  /*
-   * Map of UEs' timers on UL-CQI per RBG
-   */
-  std::map <uint16_t, uint32_t> m_ueCqiTimers;
+  MmWaveHarqTimerWheel m_harqTimers;
+  std::vector<MmWaveHarqTimerWheel::Timer> m_expiredHarqTimers;
 
-  /*
-   * Map of UE's buffer status reports received
-   */
-  std::map <uint16_t,uint32_t> m_ceBsrRxed;
+  uint32_t m_cqiTimersThreshold;       // # of TTIs for which a CQI can be considered valid
 
   uint16_t m_nextRnti;
   uint64_t m_nextRntiDl;
@@ -289,26 +255,9 @@ private:
   uint8_t m_numHarqProcess;
   uint8_t m_harqTimeout;
 
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId;
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus;
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer;
-  std::map <uint16_t, DlHarqProcessesDciInfoList_t> m_dlHarqProcessesDciInfoMap;
-  std::map <uint16_t, DlHarqRlcPduList_t> m_dlHarqProcessesRlcPduMap;
   std::vector <DlHarqInfo> m_dlHarqInfoList;       // HARQ retx buffered
   std::vector <UlHarqInfo> m_ulHarqInfoList;       // HARQ retx buffered
 
-  std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId;
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` trasmission count
-  std::map <uint16_t, UlHarqProcessesStatus_t>    m_ulHarqProcessesStatus;
-  std::map <uint16_t, UlHarqProcessesTimer_t>     m_ulHarqProcessesTimer;
-  std::map <uint16_t, UlHarqProcessesDciInfoList_t> m_ulHarqProcessesDciInfoMap;
-
-
   static const unsigned m_macHdrSize;
   static const unsigned m_subHdrSize;
   static const unsigned m_rlcHdrSize;
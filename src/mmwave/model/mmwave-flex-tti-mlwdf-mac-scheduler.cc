@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-flex-tti-mlwdf-mac-scheduler.h"
+#include <ns3/log.h>
+#include <ns3/eps-bearer.h>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveFlexTtiMlwdfMacScheduler");
+
+namespace mmwave {
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveFlexTtiMlwdfMacScheduler);
+
+template class MmWaveFlexTtiSchedulerEngine<MmWaveFlexTtiMlwdfPolicy>;
+
+double
+MmWaveFlexTtiMlwdfPolicy::GetDelayWeight (const MmWaveFlexTtiUeSchedInfo* ueInfo, double slotUs)
+{
+  double weight = 0.0;
+  const std::vector<MmWaveFlexTtiFlowStats>* flows[2] = {&ueInfo->m_flowStatsDl, &ueInfo->m_flowStatsUl};
+  for (unsigned dir = 0; dir < 2; dir++)
+    {
+      for (unsigned iflow = 0; iflow < flows[dir]->size (); iflow++)
+        {
+          const MmWaveFlexTtiFlowStats &flow = (*flows[dir])[iflow];
+          if (flow.m_totalBufSize == 0 && flow.m_txPacketSizes.empty ())
+            {
+              continue;
+            }
+          double deadlineUs = flow.m_deadlineUs;
+          if (deadlineUs <= 0 && flow.m_qci != 0)
+            {
+              deadlineUs = EpsBearer (static_cast<EpsBearer::Qci> (flow.m_qci)).GetPacketDelayBudgetMs () * 1000.0;
+            }
+          if (deadlineUs > 0)
+            {
+              // the packet will be delivered at the earliest at the end of the slot
+              weight = std::max (weight, (flow.m_txQueueHolDelay + slotUs) / deadlineUs);
+            }
+        }
+    }
+
+  if (weight == 0.0)
+    {
+      EpsBearer defaultBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT);
+      weight = slotUs / (defaultBearer.GetPacketDelayBudgetMs () * 1000.0);
+    }
+  return weight;
+}
+
+void
+MmWaveFlexTtiMlwdfPolicy::AllocateNewData (Engine &engine, MmWaveFlexTtiUeAllocMap &ueAllocMap, int &symAvail)
+{
+  double slotUs = engine.m_phyMacConfig->GetSlotPeriod ().GetMicroSeconds ();
+
+  m_ueList.clear ();
+  m_weights.clear ();
+  for (std::map<uint16_t, MmWaveFlexTtiUeSchedInfo>::iterator ueIt = engine.m_ueSchedInfoMap.begin (); ueIt != engine.m_ueSchedInfoMap.end (); ueIt++)
+    {
+      MmWaveFlexTtiUeSchedInfo* ueInfo = &ueIt->second;
+      if (engine.ComputeUeRates (ueInfo, ueAllocMap) & Engine::BACKLOGGED)
+        {
+          m_ueList.push_back (ueInfo);
+          m_weights.push_back (GetDelayWeight (ueInfo, slotUs));
+          NS_LOG_LOGIC ("UE " << ueInfo->m_rnti << " delay weight " << m_weights.back ());
+        }
+    }
+
+  engine.AllocateByPfMetric (m_ueList, m_weights, symAvail);
+}
+
+TypeId
+MmWaveFlexTtiMlwdfMacScheduler::GetTypeId (void)
+{
+  static TypeId tid = AddAttributes (TypeId ("ns3::MmWaveFlexTtiMlwdfMacScheduler")
+                                     .SetParent<MmWaveMacScheduler> ()
+                                     .AddConstructor<MmWaveFlexTtiMlwdfMacScheduler> ());
+  return tid;
+}
+
+MmWaveFlexTtiMlwdfMacScheduler::MmWaveFlexTtiMlwdfMacScheduler ()
+  : MmWaveFlexTtiSchedulerEngine<MmWaveFlexTtiMlwdfPolicy> ("MmWaveFlexTtiMlwdfMacScheduler")
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveFlexTtiMlwdfMacScheduler::~MmWaveFlexTtiMlwdfMacScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+} // namespace mmwave
+
+} // namespace ns3
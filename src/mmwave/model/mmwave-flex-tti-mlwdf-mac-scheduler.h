@@ -0,0 +1,87 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_MLWDF_MAC_SCHEDULER_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_MLWDF_MAC_SCHEDULER_H_
+
+#include "mmwave-flex-tti-scheduler-engine.h"
+#include <vector>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * Modified Largest Weighted Delay First (M-LWDF) allocation policy.
+ * Each symbol is given to the UE with the highest proportional fair metric,
+ * weighted by the delay of the head-of-line packets of the UE relative to
+ * their deadline. The deadline of a flow is the one set when the bearer is
+ * configured or, if none is set, the packet delay budget of its QCI.
+ * UEs without delay-constrained flows are weighted as if their packets
+ * had just arrived on a default bearer.
+ */
+class MmWaveFlexTtiMlwdfPolicy
+{
+public:
+  typedef MmWaveFlexTtiSchedulerEngine<MmWaveFlexTtiMlwdfPolicy> Engine; //!< the scheduling engine
+
+  static const bool m_rlcHeadersInBuffer = true; //!< the buffer estimate includes the headers
+  static const bool m_releaseUeSchedInfo = true; //!< forget the UE when it is released
+  static const bool m_pduBasedAllocation = false; //!< the TB is shared among the logical channels
+
+  /**
+   * Allocate the symbols left after the HARQ retransmissions
+   * \param engine the scheduling engine
+   * \param ueAllocMap the UEs allocated in the current slot
+   * \param symAvail the number of available symbols
+   */
+  void AllocateNewData (Engine &engine, MmWaveFlexTtiUeAllocMap &ueAllocMap, int &symAvail);
+
+private:
+  /**
+   * \param ueInfo the UE
+   * \param slotUs the duration of the slot, in microseconds
+   * \return the delay weight of the UE
+   */
+  static double GetDelayWeight (const MmWaveFlexTtiUeSchedInfo* ueInfo, double slotUs);
+
+  std::vector<MmWaveFlexTtiUeSchedInfo*> m_ueList; //!< UEs with data to send, in RNTI order
+  std::vector<double> m_weights; //!< delay weights of the UEs
+};
+
+extern template class MmWaveFlexTtiSchedulerEngine<MmWaveFlexTtiMlwdfPolicy>;
+
+/**
+ * \ingroup mmwave
+ * Flex-TTI MAC scheduler with the M-LWDF allocation policy
+ */
+class MmWaveFlexTtiMlwdfMacScheduler : public MmWaveFlexTtiSchedulerEngine<MmWaveFlexTtiMlwdfPolicy>
+{
+public:
+  MmWaveFlexTtiMlwdfMacScheduler ();
+
+  virtual ~MmWaveFlexTtiMlwdfMacScheduler ();
+  static TypeId GetTypeId (void);
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_MLWDF_MAC_SCHEDULER_H_ */
@@ -0,0 +1,72 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-flex-tti-scheduler-engine.h"
+
+namespace ns3 {
+
+namespace mmwave {
+
+MmWaveFlexTtiFlowStats::MmWaveFlexTtiFlowStats (bool uplink, MmWaveFlexTtiUeSchedInfo* ueSchedInfo, uint8_t lcid)
+  : m_isUplink (uplink),
+    m_ueSchedInfo (ueSchedInfo),
+    m_lcid (lcid),
+    m_arrivalRate (0.0),
+    m_grantedRate (0.0),
+    m_qci (0),
+    m_txQueueHolDelay (0),
+    m_reTxQueueHolDelay (0),
+    m_probErr (0.0),
+    m_deadlineUs (0),
+    m_totalBufSize (0),
+    m_totalSchedSize (0)
+{
+  NS_ASSERT (ueSchedInfo != 0);
+}
+
+MmWaveFlexTtiUeSchedInfo::MmWaveFlexTtiUeSchedInfo (uint16_t rnti)
+  : m_rnti (rnti),
+    m_dlMcs (0),
+    m_ulMcs (0),
+    m_maxDlBufSize (0),
+    m_maxUlBufSize (0),
+    m_maxDlSymbols (0),
+    m_maxUlSymbols (0),
+    m_dlSymbols (0),
+    m_ulSymbols (0),
+    m_dlSymbolsRetx (0),
+    m_ulSymbolsRetx (0),
+    m_dlTbSize (0),
+    m_ulTbSize (0),
+    m_dlAllocDone (false),
+    m_ulAllocDone (false),
+    m_avgTputDl (0.0),
+    m_avgTputUl (0.0),
+    m_lastAvgTputDl (0.0),
+    m_lastAvgTputUl (0.0),
+    m_currTputDl (0.0),
+    m_currTputUl (0.0),
+    m_totBufDl (0),
+    m_totBufUl (0),
+    m_allocUlLast (false)
+{
+}
+
+} // namespace mmwave
+
+} // namespace ns3
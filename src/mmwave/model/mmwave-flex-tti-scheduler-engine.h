@@ -0,0 +1,1714 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_SCHEDULER_ENGINE_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_SCHEDULER_ENGINE_H_
+
+#include "mmwave-mac-sched-sap.h"
+#include "mmwave-mac-csched-sap.h"
+#include "mmwave-mac-scheduler.h"
+#include "mmwave-amc.h"
+#include "mmwave-flex-tti-ue-context.h"
+#include "mmwave-harq-timer-wheel.h"
+#include "mmwave-spectrum-value-helper.h"
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/uinteger.h>
+#include <ns3/lte-common.h>
+#include <ns3/eps-bearer.h>
+#include <ns3/perf-counters.h>
+#include <algorithm>
+#include <list>
+#include <string>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+namespace mmwave {
+
+struct MmWaveFlexTtiUeSchedInfo;
+
+/**
+ * \ingroup mmwave
+ * Buffer and delay statistics of a DL logical channel or of an UL logical
+ * channel group, as estimated by the flex-TTI MAC schedulers
+ */
+struct MmWaveFlexTtiFlowStats
+{
+  /**
+   * Constructor
+   * \param uplink true for an UL logical channel group
+   * \param ueSchedInfo the UE the flow belongs to
+   * \param lcid the LCID (DL) or the LCG ID (UL)
+   */
+  MmWaveFlexTtiFlowStats (bool uplink, MmWaveFlexTtiUeSchedInfo* ueSchedInfo, uint8_t lcid);
+
+  bool m_isUplink; //!< is uplink?
+  MmWaveFlexTtiUeSchedInfo* m_ueSchedInfo; //!< pointer to parent UE Info
+  uint8_t m_lcid; //!< LCID (for DL) or LC Group ID (for UL)
+  double m_arrivalRate; //!< Mbps
+  double m_grantedRate; //!< Mbps
+  uint8_t m_qci; //!< We interpret QCI 69 as delay critical
+  double m_txQueueHolDelay; //!< delay of the head-of-line packet, in microseconds
+  uint32_t m_reTxQueueHolDelay; //!< delay of the head-of-line retransmission
+  double m_probErr; //!< expected probability of each HARQ TX/reTX failure (i.e. 1/E[num TX to success])
+  double m_deadlineUs; //!< relative deadline
+  std::list<uint32_t> m_txPacketSizes; //!< estimated packet sizes from consecutive BSRs
+  uint32_t m_totalBufSize; //!< estimated number of buffered bytes
+  std::list<uint32_t> m_retxPacketSizes; //!< sizes of the packets to be retransmitted
+  std::list<double> m_txPacketDelays; //!< estimated delays for each packet
+  std::list<double> m_retxPacketDelays; //!< delays of the packets to be retransmitted
+
+  // We maintain a queue of PDU sizes scheduled in the last M subframes.
+  // M = delay between scheduling and transmission (default DL = 1, UL = 2)
+  // The sum of these M elements is subtracted from the BSR to account for
+  // data that has been scheduled but not yet extracted from the DL or UL queue.
+  std::list<uint32_t> m_schedPacketSizes; //!< PDU sizes scheduled in the last M subframes
+  uint32_t m_totalSchedSize; //!< total of last M elements in list
+};
+
+/**
+ * \ingroup mmwave
+ * Per-UE allocation state of the flex-TTI MAC schedulers
+ */
+struct MmWaveFlexTtiUeSchedInfo
+{
+  /**
+   * Constructor
+   * \param rnti the RNTI of the UE
+   */
+  MmWaveFlexTtiUeSchedInfo (uint16_t rnti = 0);
+
+  uint16_t m_rnti; //!< the RNTI of the UE
+  uint8_t m_dlMcs; //!< DL MCS for the current slot
+  uint8_t m_ulMcs; //!< UL MCS for the current slot
+  uint32_t m_maxDlBufSize; //!< unused
+  uint32_t m_maxUlBufSize; //!< unused
+  uint8_t m_maxDlSymbols; //!< unused
+  uint8_t m_maxUlSymbols; //!< unused
+  uint8_t m_dlSymbols; //!< DL symbols allocated in the current slot
+  uint8_t m_ulSymbols; //!< UL symbols allocated in the current slot
+  uint8_t m_dlSymbolsRetx; //!< DL symbols allocated to retransmissions in the current slot
+  uint8_t m_ulSymbolsRetx; //!< UL symbols allocated to retransmissions in the current slot
+  uint32_t m_dlTbSize; //!< DL TB size allocated in the current slot
+  uint32_t m_ulTbSize; //!< UL TB size allocated in the current slot
+  std::vector <struct RlcPduInfo> m_rlcPduInfo; //!< RLC PDUs to be sent in the DL TB
+  bool m_dlAllocDone; //!< true if no more DL symbols are needed
+  bool m_ulAllocDone; //!< true if no more UL symbols are needed
+  std::vector<MmWaveFlexTtiFlowStats> m_flowStatsDl; //!< DL flows, indexed by LCID
+  std::vector<MmWaveFlexTtiFlowStats> m_flowStatsUl; //!< UL flows, indexed by LCG ID
+  double m_avgTputDl; //!< average DL throughput
+  double m_avgTputUl; //!< average UL throughput
+  double m_lastAvgTputDl; //!< average DL throughput when the DL allocation was completed
+  double m_lastAvgTputUl; //!< average UL throughput when the UL allocation was completed
+  double m_currTputDl; //!< DL throughput achievable in the current slot
+  double m_currTputUl; //!< UL throughput achievable in the current slot
+  uint32_t m_totBufDl; //!< total DL buffered bytes
+  uint32_t m_totBufUl; //!< total UL buffered bytes
+  bool m_allocUlLast; //!< true if the last symbol was allocated in UL
+};
+
+typedef std::map<uint16_t, MmWaveFlexTtiUeSchedInfo*> MmWaveFlexTtiUeAllocMap; //!< UEs allocated in a slot, by RNTI
+
+/**
+ * \ingroup mmwave
+ * The scheduling engine shared by the flex-TTI MAC schedulers.
+ *
+ * The engine implements the SAPs towards the MAC, the processing of the
+ * CQI, BSR and HARQ feedback, the HARQ retransmissions and the generation of
+ * the DCIs. The allocation of the symbols left for new data, which is what
+ * tells a scheduler from another, is delegated to the Policy, which must
+ * provide:
+ *
+ * - void AllocateNewData (MmWaveFlexTtiSchedulerEngine<Policy> &engine,
+ *   MmWaveFlexTtiUeAllocMap &ueAllocMap, int &symAvail): allocate up to symAvail symbols
+ *   to the UEs, filling the m_dlSymbols, m_ulSymbols, m_dlMcs, m_ulMcs and
+ *   m_rlcPduInfo fields of the UeSchedInfo of each UE added to ueAllocMap;
+ * - static const bool m_rlcHeadersInBuffer: account for the RLC and MAC
+ *   subheaders when computing the buffered bytes with ComputeUeRates;
+ * - static const bool m_releaseUeSchedInfo: forget the allocation state of
+ *   a UE when it is released;
+ * - static const bool m_pduBasedAllocation: the policy allocates whole RLC
+ *   PDUs, so that the flows track the queued packets instead of the RLC
+ *   queue size and the TB is not split evenly among the logical channels.
+ *
+ * Since the engine is instantiated for each policy, the per-slot loop of
+ * the policy is compiled together with the rest of the scheduler.
+ * The policy is a friend of the engine and can use its state and the
+ * ComputeUeRates, AllocateSymbol, GetDlCqi and GetUlCqi helpers.
+ */
+template <class Policy>
+class MmWaveFlexTtiSchedulerEngine : public MmWaveMacScheduler
+{
+public:
+  typedef MmWaveFlexTtiFlowStats FlowStats; //!< statistics of a flow
+  typedef MmWaveFlexTtiUeSchedInfo UeSchedInfo; //!< allocation state of a UE
+  typedef MmWaveFlexTtiUeAllocMap UeAllocMap; //!< UEs allocated in a slot, by RNTI
+
+  /**
+   * Flags returned by ComputeUeRates
+   */
+  enum UeRateFlags
+  {
+    DL_CQI = 1, //!< the DL MCS has been updated
+    UL_CQI = 2, //!< the UL MCS has been updated
+    BACKLOGGED = 4 //!< the UE has been added to the allocation map
+  };
+
+  /**
+   * Constructor
+   * \param logComponent the name of the log component of the scheduler
+   */
+  MmWaveFlexTtiSchedulerEngine (const std::string &logComponent);
+  virtual ~MmWaveFlexTtiSchedulerEngine ();
+  virtual void DoDispose (void) override;
+
+  /**
+   * Add the attributes of the engine to the TypeId of a scheduler
+   * \param tid the TypeId of the scheduler
+   * \return the TypeId with the attributes
+   */
+  static TypeId AddAttributes (TypeId tid);
+
+  virtual void SetMacSchedSapUser (MmWaveMacSchedSapUser* sap) override;
+  virtual void SetMacCschedSapUser (MmWaveMacCschedSapUser* sap) override;
+
+  virtual MmWaveMacSchedSapProvider* GetMacSchedSapProvider () override;
+  virtual MmWaveMacCschedSapProvider* GetMacCschedSapProvider () override;
+
+  virtual void ConfigureCommonParameters (Ptr<MmWavePhyMacCommon> config) override;
+
+  void DoCschedCellConfigReq (const struct MmWaveMacCschedSapProvider::CschedCellConfigReqParameters& params);
+  void DoCschedUeConfigReq (const struct MmWaveMacCschedSapProvider::CschedUeConfigReqParameters& params);
+  void DoCschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params);
+  void DoCschedLcReleaseReq (const struct MmWaveMacCschedSapProvider::CschedLcReleaseReqParameters& params);
+  void DoCschedUeReleaseReq (const struct MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters& params);
+
+  void DoSchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+  void DoSchedDlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
+  void DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
+  void DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params);
+  void DoSchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params);
+  void DoSchedSetMcs (int mcs);
+
+protected:
+  friend Policy;
+
+  /**
+   * Update the MCS, the buffered bytes and the achievable throughput of a UE,
+   * and add the UE to the allocation map if it has data to send
+   * \param ueInfo the UE
+   * \param ueAllocMap the UEs allocated in the current slot
+   * \return a combination of UeRateFlags
+   */
+  uint8_t ComputeUeRates (UeSchedInfo* ueInfo, UeAllocMap &ueAllocMap);
+
+  /**
+   * Allocate one more symbol to a UE, in UL or in DL, and update its
+   * achievable and average throughput
+   * \param ueInfo the UE
+   * \param symAvail the number of symbols still available in the slot
+   * \return true if a symbol has been allocated
+   */
+  bool AllocateSymbol (UeSchedInfo* ueInfo, int &symAvail);
+
+  /**
+   * Allocate the available symbols one at a time, each time to the UE
+   * with the highest weighted proportional fair metric among those that
+   * still need resources. Ties go to the UE that comes first in the list.
+   * \param ueList the candidate UEs
+   * \param weights the weight of each candidate UE
+   * \param symAvail the number of symbols still available in the slot
+   */
+  void AllocateByPfMetric (const std::vector<UeSchedInfo*> &ueList, const std::vector<double> &weights, int &symAvail);
+
+  /**
+   * \param ueInfo the UE
+   * \return the proportional fair metric of the UE
+   */
+  static double
+  GetPfMetric (const UeSchedInfo* ueInfo)
+  {
+    return std::max (ueInfo->m_currTputDl,ueInfo->m_currTputUl) / std::max (1E-9,(ueInfo->m_avgTputDl + ueInfo->m_avgTputDl));
+  }
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \return the wideband DL CQI of the UE, or 1 if no CQI is available
+   */
+  uint8_t GetDlCqi (uint16_t rnti);
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \param mcs the UL MCS of the UE, or 0 if no SINR is available
+   * \return the UL CQI of the UE, or 1 if no SINR is available
+   */
+  uint8_t GetUlCqi (uint16_t rnti, uint8_t &mcs);
+
+  /**
+   * Clear the allocation state of the UEs allocated in a slot
+   * \param ueAllocMap the UEs allocated in the slot
+   */
+  void ResetAllocation (UeAllocMap &ueAllocMap);
+
+  /**
+   * Add the UL control symbol to the slot and send it to the MAC
+   * \param ret the allocation of the slot
+   */
+  void SendSlotAllocation (MmWaveMacSchedSapUser::SchedConfigIndParameters &ret);
+
+  void RefreshDlCqiMaps (void);
+  void RefreshUlCqiMaps (void);
+
+  /**
+   * \brief Refresh HARQ processes according to the timers
+   */
+  void RefreshHarqProcesses (void);
+
+  uint8_t UpdateDlHarqProcessId (uint16_t rnti);
+  uint8_t UpdateUlHarqProcessId (uint16_t rnti);
+
+  /**
+   * \param val the BSR index
+   * \return the buffer size corresponding to the BSR index
+   */
+  uint32_t
+  BsrId2BufferSize (uint8_t val)
+  {
+    NS_ABORT_MSG_UNLESS (val < 64, "val = " << val << " is out of range");
+    return BufferSizeLevelBsrTable[val];
+  }
+
+  NS_LOG_TEMPLATE_DECLARE; //!< the log component of the scheduler
+
+  Policy m_policy; //!< the allocation policy
+
+  Ptr<MmWaveAmc> m_amc; //!< the AMC model
+
+  MmWaveFlexTtiUeContextTable m_ueContexts; //!< Per-UE CQI, buffer status and HARQ state
+  MmWaveHarqTimerWheel m_harqTimers; //!< the timers of the HARQ processes
+  std::vector<MmWaveHarqTimerWheel::Timer> m_expiredHarqTimers; //!< the HARQ timers expired in the current slot
+
+  uint32_t m_cqiTimersThreshold; //!< # of TTIs for which a CQI can be considered valid
+
+  uint8_t m_tbUid; //!< HARQ process ID used when HARQ is disabled
+
+  MmWaveMacSchedSapProvider* m_macSchedSapProvider; //!< the SCHED SAP provider
+  MmWaveMacSchedSapUser* m_macSchedSapUser; //!< the SCHED SAP user
+  MmWaveMacCschedSapUser* m_macCschedSapUser; //!< the CSCHED SAP user
+  MmWaveMacCschedSapProvider* m_macCschedSapProvider; //!< the CSCHED SAP provider
+
+  MmWaveMacCschedSapProvider::CschedCellConfigReqParameters m_cschedCellConfig; //!< the cell configuration
+
+  struct AllocMapElem
+  {
+    AllocMapElem (std::vector<uint16_t> rntiMap, uint8_t nSym, uint32_t tbs)
+      : m_rntiPerChunk (rntiMap),
+        m_numSym (nSym),
+        m_tbSize (tbs)
+    {
+    }
+
+    std::vector <uint16_t> m_rntiPerChunk;
+    uint8_t m_numSym;
+    uint32_t m_tbSize;
+  };
+  /*
+   * Map of previous allocated UE per RBG
+   * (used to retrieve info from UL-CQI)
+   */
+  std::map <uint32_t, struct AllocMapElem> m_ulAllocationMap;
+
+  // HARQ attributes
+  /**
+   * m_harqOn when false inhibit te HARQ mechanisms (by default active)
+   */
+  bool m_harqOn;
+
+  std::vector <DlHarqInfo> m_dlHarqInfoList; //!< DL HARQ retx buffered
+  std::vector <UlHarqInfo> m_ulHarqInfoList; //!< UL HARQ retx buffered
+
+  static const unsigned m_subHdrSize = 4; //!< size of the MAC subheader
+  static const unsigned m_rlcHdrSize = 3; //!< size of the RLC header
+
+  //for testing
+  bool m_fixedMcsDl; //!< unused
+  bool m_fixedMcsUl; //!< unused
+  uint8_t m_mcsDefaultDl; //!< unused
+  uint8_t m_mcsDefaultUl; //!< unused
+  bool m_dlOnly; //!< unused
+  bool m_ulOnly; //!< unused
+
+  std::map<uint16_t, UeSchedInfo> m_ueSchedInfoMap; //!< allocation state of the UEs, by RNTI
+
+  bool m_fixedTti; //!< one slot per TTI
+  uint8_t m_symPerSlot; //!< symbols per slot
+
+  double m_timeWindow; //!< time window of the average throughput, in slots
+
+  std::vector <FlowStats*> m_flowHeap; //!< all the configured flows
+};
+
+/**
+ * \ingroup mmwave
+ * CSCHED SAP provider of the flex-TTI scheduling engine
+ */
+template <class Policy>
+class MmWaveFlexTtiEngineCschedSapProvider : public MmWaveMacCschedSapProvider
+{
+public:
+  MmWaveFlexTtiEngineCschedSapProvider (MmWaveFlexTtiSchedulerEngine<Policy>* scheduler)
+    : m_scheduler (scheduler)
+  {
+  }
+
+  // inherited from MmWaveMacCschedSapProvider
+  virtual void CschedCellConfigReq (const struct MmWaveMacCschedSapProvider::CschedCellConfigReqParameters& params)
+  {
+    m_scheduler->DoCschedCellConfigReq (params);
+  }
+  virtual void CschedUeConfigReq (const struct MmWaveMacCschedSapProvider::CschedUeConfigReqParameters& params)
+  {
+    m_scheduler->DoCschedUeConfigReq (params);
+  }
+  virtual void CschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params)
+  {
+    m_scheduler->DoCschedLcConfigReq (params);
+  }
+  virtual void CschedLcReleaseReq (const struct MmWaveMacCschedSapProvider::CschedLcReleaseReqParameters& params)
+  {
+    m_scheduler->DoCschedLcReleaseReq (params);
+  }
+  virtual void CschedUeReleaseReq (const struct MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters& params)
+  {
+    m_scheduler->DoCschedUeReleaseReq (params);
+  }
+
+private:
+  MmWaveFlexTtiSchedulerEngine<Policy>* m_scheduler; //!< the scheduler
+};
+
+/**
+ * \ingroup mmwave
+ * SCHED SAP provider of the flex-TTI scheduling engine
+ */
+template <class Policy>
+class MmWaveFlexTtiEngineSchedSapProvider : public MmWaveMacSchedSapProvider
+{
+public:
+  MmWaveFlexTtiEngineSchedSapProvider (MmWaveFlexTtiSchedulerEngine<Policy>* scheduler)
+    : m_scheduler (scheduler)
+  {
+  }
+
+  virtual void SchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+  {
+    m_scheduler->DoSchedDlRlcBufferReq (params);
+  }
+  virtual void SchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
+  {
+    m_scheduler->DoSchedTriggerReq (params);
+  }
+  virtual void SchedDlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters& params)
+  {
+    m_scheduler->DoSchedDlCqiInfoReq (params);
+  }
+  virtual void SchedUlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters& params)
+  {
+    m_scheduler->DoSchedUlCqiInfoReq (params);
+  }
+  virtual void SchedUlMacCtrlInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params)
+  {
+    m_scheduler->DoSchedUlMacCtrlInfoReq (params);
+  }
+  virtual void SchedSetMcs (int mcs)
+  {
+    m_scheduler->DoSchedSetMcs (mcs);
+  }
+
+private:
+  MmWaveFlexTtiSchedulerEngine<Policy>* m_scheduler; //!< the scheduler
+};
+
+
+/**
+ * Implementation of the templates declared above.
+ */
+
+template <class Policy>
+const unsigned MmWaveFlexTtiSchedulerEngine<Policy>::m_subHdrSize;
+
+template <class Policy>
+const unsigned MmWaveFlexTtiSchedulerEngine<Policy>::m_rlcHdrSize;
+
+template <class Policy>
+MmWaveFlexTtiSchedulerEngine<Policy>::MmWaveFlexTtiSchedulerEngine (const std::string &logComponent)
+  : NS_LOG_TEMPLATE_DEFINE (logComponent),
+    m_tbUid (0),
+    m_macSchedSapUser (0),
+    m_macCschedSapUser (0),
+    m_timeWindow (99.0)
+{
+  NS_LOG_FUNCTION (this);
+  m_macSchedSapProvider = new MmWaveFlexTtiEngineSchedSapProvider<Policy> (this);
+  m_macCschedSapProvider = new MmWaveFlexTtiEngineCschedSapProvider<Policy> (this);
+}
+
+template <class Policy>
+MmWaveFlexTtiSchedulerEngine<Policy>::~MmWaveFlexTtiSchedulerEngine ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_ueContexts.Clear ();
+  m_harqTimers.Clear ();
+  m_dlHarqInfoList.clear ();
+  delete m_macCschedSapProvider;
+  delete m_macSchedSapProvider;
+}
+
+template <class Policy>
+TypeId
+MmWaveFlexTtiSchedulerEngine<Policy>::AddAttributes (TypeId tid)
+{
+  return tid
+         .AddAttribute ("CqiTimerThreshold",
+                        "The number of TTIs a CQI is valid (default 1000 - 1 sec.)",
+                        UintegerValue (100),
+                        MakeUintegerAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_cqiTimersThreshold),
+                        MakeUintegerChecker<uint32_t> ())
+         .AddAttribute ("HarqEnabled",
+                        "Activate/Deactivate the HARQ [by default is active].",
+                        BooleanValue (false),
+                        MakeBooleanAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_harqOn),
+                        MakeBooleanChecker ())
+         .AddAttribute ("FixedMcsDl",
+                        "Fix MCS to value set in McsDlDefault",
+                        BooleanValue (false),
+                        MakeBooleanAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_fixedMcsDl),
+                        MakeBooleanChecker ())
+         .AddAttribute ("McsDefaultDl",
+                        "Fixed DL MCS",
+                        UintegerValue (1),
+                        MakeUintegerAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_mcsDefaultDl),
+                        MakeUintegerChecker<uint8_t> ())
+         .AddAttribute ("FixedMcsUl",
+                        "Fix MCS to value set in McsUlDefault (for testing)",
+                        BooleanValue (false),
+                        MakeBooleanAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_fixedMcsUl),
+                        MakeBooleanChecker ())
+         .AddAttribute ("McsDefaultUl",
+                        "Fixed UL MCS (for testing)",
+                        UintegerValue (1),
+                        MakeUintegerAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_mcsDefaultUl),
+                        MakeUintegerChecker<uint8_t> ())
+         .AddAttribute ("DlSchedOnly",
+                        "Only schedule downlink traffic (for testing)",
+                        BooleanValue (false),
+                        MakeBooleanAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_dlOnly),
+                        MakeBooleanChecker ())
+         .AddAttribute ("UlSchedOnly",
+                        "Only schedule uplink traffic (for testing)",
+                        BooleanValue (false),
+                        MakeBooleanAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_ulOnly),
+                        MakeBooleanChecker ())
+         .AddAttribute ("FixedTti",
+                        "Fix slot size",
+                        BooleanValue (false),
+                        MakeBooleanAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_fixedTti),
+                        MakeBooleanChecker ())
+         .AddAttribute ("SymPerSlot",
+                        "Number of symbols per slot in Fixed TTI mode",
+                        UintegerValue (6),
+                        MakeUintegerAccessor (&MmWaveFlexTtiSchedulerEngine<Policy>::m_symPerSlot),
+                        MakeUintegerChecker<uint8_t> ());
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::SetMacSchedSapUser (MmWaveMacSchedSapUser* sap)
+{
+  m_macSchedSapUser = sap;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::SetMacCschedSapUser (MmWaveMacCschedSapUser* sap)
+{
+  m_macCschedSapUser = sap;
+}
+
+template <class Policy>
+MmWaveMacSchedSapProvider*
+MmWaveFlexTtiSchedulerEngine<Policy>::GetMacSchedSapProvider ()
+{
+  return m_macSchedSapProvider;
+}
+
+template <class Policy>
+MmWaveMacCschedSapProvider*
+MmWaveFlexTtiSchedulerEngine<Policy>::GetMacCschedSapProvider ()
+{
+  return m_macCschedSapProvider;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::ConfigureCommonParameters (Ptr<MmWavePhyMacCommon> config)
+{
+  m_phyMacConfig = config;
+  m_amc = CreateObject <MmWaveAmc> (m_phyMacConfig);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoSchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti << (uint32_t) params.m_logicalChannelIdentity);
+  typename std::map <uint16_t, UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  if (itUe == m_ueSchedInfoMap.end ())
+    {
+      NS_LOG_ERROR ("UE entry not found in sched info map");
+      return;
+    }
+
+  uint8_t lcid = params.m_logicalChannelIdentity;
+  if ((unsigned)lcid >= itUe->second.m_flowStatsDl.size ())
+    {
+      NS_LOG_ERROR ("LC not registered");
+      return;
+    }
+
+  FlowStats &flow = itUe->second.m_flowStatsDl[lcid];
+  if (params.m_txPacketSizes.size () > 0)
+    {
+      flow.m_txPacketSizes.clear ();
+      flow.m_txPacketDelays.clear ();
+      // add the new DL PDCP packet sizes and their delays
+      uint32_t totalSize = 0;
+      double maxDelay = 0.0;
+      std::list<uint32_t>::const_iterator itSize = params.m_txPacketSizes.begin ();
+      std::list<double>::const_iterator itDelay = params.m_txPacketDelays.begin ();
+      while (itSize != params.m_txPacketSizes.end () && itDelay != params.m_txPacketDelays.end ())
+        {
+          totalSize += *itSize;
+          if (totalSize > flow.m_totalSchedSize)
+            {
+              if (!Policy::m_pduBasedAllocation)
+                {
+                  flow.m_totalBufSize = params.m_rlcTransmissionQueueSize;
+                }
+              flow.m_txPacketSizes.push_back (*itSize);
+              flow.m_txPacketDelays.push_back (*itDelay);
+              if (*itDelay > maxDelay)
+                {
+                  maxDelay = *itDelay;
+                }
+            }
+          itSize++;
+          itDelay++;
+        }
+      flow.m_txQueueHolDelay = maxDelay;
+    }
+  else if (!Policy::m_pduBasedAllocation && params.m_rlcTransmissionQueueSize > 0)        // case for RlcSm
+    {
+      flow.m_totalBufSize = params.m_rlcTransmissionQueueSize;
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+
+  // the packet-based policies track the delay of the UL packets in subframes
+  double bsrDelayUs = Policy::m_pduBasedAllocation ?
+    m_phyMacConfig->GetSubframePeriod ().GetMicroSeconds () : m_phyMacConfig->GetSlotPeriod ().GetMicroSeconds ();
+
+  for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
+    {
+      if ( params.m_macCeList.at (i).m_macCeType == MacCeElement::BSR )
+        {
+          // buffer status report
+          // the BSR of each LCG is used to estimate the size of the
+          // packets that arrived since the previous report
+          uint16_t rnti = params.m_macCeList.at (i).m_rnti;
+          typename std::map <uint16_t, UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (rnti);
+
+          for (uint8_t lcg = 1; lcg <= 3; ++lcg)
+            {
+              uint8_t bsrId = params.m_macCeList.at (i).m_macCeValue.m_bufferStatus.at (lcg - 1);
+              uint32_t bufSize = BsrId2BufferSize (bsrId);
+              if (bufSize > 0)
+                {
+                  if (itUe == m_ueSchedInfoMap.end ())
+                    {
+                      NS_LOG_ERROR ("UE entry not found in sched info map");
+                    }
+                  else
+                    {
+                      FlowStats &flow = itUe->second.m_flowStatsUl[lcg];
+                      int diff = bufSize - (flow.m_totalBufSize + flow.m_totalSchedSize);
+                      if (diff > 0)
+                        {                               // estimate additional packet sizes
+                          flow.m_totalBufSize += diff;
+                          flow.m_txPacketSizes.push_back (diff);
+                          // since we expect the BSR to be generated following a packet arrival and sent at least by the end of the prev. subframe,
+                          // the maximum delay is one SF (in microseconds)
+                          flow.m_txPacketDelays.push_back (bsrDelayUs);
+                          if (flow.m_txQueueHolDelay == 0)
+                            {
+                              flow.m_txQueueHolDelay = bsrDelayUs;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoSchedDlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (unsigned int i = 0; i < params.m_cqiList.size (); i++)
+    {
+      if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::WB )
+        {
+          // wideband CQI reporting
+          uint16_t rnti = params.m_cqiList.at (i).m_rnti;
+          MmWaveFlexTtiUeContext &ctx = m_ueContexts.Get (rnti);
+          // create or update the entry, only codeword 0 at this stage (SISO)
+          ctx.m_hasDlCqi = true;
+          ctx.m_dlCqi = params.m_cqiList.at (i).m_wbCqi;
+          // generate or update the correspondent timer
+          ctx.m_dlCqiTimer = m_cqiTimersThreshold;
+        }
+      else if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::SB )
+        {
+          // subband CQI reporting high layer configured
+          // Not used by the flex-TTI schedulers
+        }
+      else
+        {
+          NS_LOG_ERROR (this << " CQI type unknown");
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+
+  switch (params.m_ulCqi.m_type)
+    {
+    case UlCqiInfo::PUSCH:
+      {
+        typename std::map <uint32_t, struct AllocMapElem>::iterator itMap;
+        itMap = m_ulAllocationMap.find (params.m_sfnSf.Encode ());
+        if (itMap == m_ulAllocationMap.end ())
+          {
+            NS_LOG_INFO (this << " Does not find info on allocation, size : " << m_ulAllocationMap.size ());
+            return;
+          }
+        NS_ASSERT_MSG (itMap->second.m_rntiPerChunk.size () == m_phyMacConfig->GetNumRb (), "SINR chunk map must cover full BW in TDMA mode");
+        for (unsigned i = 0; i < itMap->second.m_rntiPerChunk.size (); i++)
+          {
+            MmWaveFlexTtiUeContext &ctx = m_ueContexts.Get (itMap->second.m_rntiPerChunk.at (i));
+            if (!ctx.m_hasUlCqi)
+              {
+                // create a new entry, initialized with NO_SINR value
+                ctx.m_ulCqi.assign (m_phyMacConfig->GetNumRb (), 30.0);
+                ctx.m_hasUlCqi = true;
+              }
+            ctx.m_ulCqi.at (i) = params.m_ulCqi.m_sinr.at (i);
+            ctx.m_ulCqiNumSym = itMap->second.m_numSym;
+            ctx.m_ulCqiTbSize = itMap->second.m_tbSize;
+            // generate or update the correspondent timer
+            ctx.m_ulCqiTimer = m_cqiTimersThreshold;
+            NS_LOG_INFO ("UL CQI report for RNTI " << itMap->second.m_rntiPerChunk.at (i) << " chunk " << i << " SINR " << params.m_ulCqi.m_sinr.at (i) <<
+                         " frame " << params.m_sfnSf.m_frameNum << " subframe " << (unsigned)params.m_sfnSf.m_sfNum << " startSym " << (unsigned)params.m_sfnSf.m_slotNum);
+          }
+        // remove obsolete info on allocation
+        m_ulAllocationMap.erase (itMap);
+      }
+      break;
+    default:
+      NS_FATAL_ERROR ("Unknown type of UL-CQI");
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoSchedSetMcs (int mcs)
+{
+  if (mcs >= 0 && mcs <= 28)
+    {
+      m_mcsDefaultDl = mcs;
+      m_mcsDefaultUl = mcs;
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::RefreshHarqProcesses (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // only the processes whose timer expires in this slot are visited
+  m_expiredHarqTimers.clear ();
+  m_harqTimers.Advance (m_expiredHarqTimers);
+  for (std::vector<MmWaveHarqTimerWheel::Timer>::const_iterator it = m_expiredHarqTimers.begin (); it != m_expiredHarqTimers.end (); it++)
+    {
+      MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (it->m_rnti);
+      if (ctx == nullptr)
+        {
+          continue;
+        }
+      // timers restarted by a later transmission have a different expiry
+      if (!it->m_uplink && ctx->m_hasDlHarq && ctx->m_dlHarqExpiry.at (it->m_harqId) == it->m_expiry)
+        {             // reset HARQ process
+          NS_LOG_INFO (this << " Reset HARQ proc " << (unsigned)it->m_harqId << " for RNTI " << ctx->m_rnti);
+          ctx->m_dlHarqStatus.at (it->m_harqId) = 0;
+          ctx->m_dlHarqExpiry.at (it->m_harqId) = 0;
+        }
+      else if (it->m_uplink && ctx->m_hasUlHarq && ctx->m_ulHarqExpiry.at (it->m_harqId) == it->m_expiry)
+        {             // reset HARQ process
+          NS_LOG_INFO (this << " Reset HARQ proc " << (unsigned)it->m_harqId << " for RNTI " << ctx->m_rnti);
+          ctx->m_ulHarqStatus.at (it->m_harqId) = 0;
+          ctx->m_ulHarqExpiry.at (it->m_harqId) = 0;
+        }
+    }
+}
+
+template <class Policy>
+uint8_t
+MmWaveFlexTtiSchedulerEngine<Policy>::UpdateDlHarqProcessId (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+
+  if (m_harqOn == false)
+    {
+      uint8_t tbUid = m_tbUid;
+      m_tbUid = (m_tbUid + 1) % m_phyMacConfig->GetNumHarqProcess ();
+      return tbUid;
+    }
+
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+  if (ctx == nullptr || !ctx->m_hasDlHarq)
+    {
+      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
+    }
+
+  // search for available process ID, if none available return numHarqProcess
+  uint8_t harqId = m_phyMacConfig->GetNumHarqProcess ();
+  for (unsigned i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
+    {
+      if (ctx->m_dlHarqStatus[i] == 0)
+        {
+          ctx->m_dlHarqStatus[i] = 1;
+          harqId = i;
+          break;
+        }
+    }
+  return harqId;
+}
+
+template <class Policy>
+uint8_t
+MmWaveFlexTtiSchedulerEngine<Policy>::UpdateUlHarqProcessId (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+
+  if (m_harqOn == false)
+    {
+      uint8_t tbUid = m_tbUid;
+      m_tbUid = (m_tbUid + 1) % m_phyMacConfig->GetNumHarqProcess ();
+      return tbUid;
+    }
+
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+  if (ctx == nullptr || !ctx->m_hasUlHarq)
+    {
+      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
+    }
+
+  // search for available process ID, if none available return numHarqProcess
+  uint8_t harqId = m_phyMacConfig->GetNumHarqProcess ();
+  for (unsigned i = 0; i < m_phyMacConfig->GetNumHarqProcess (); i++)
+    {
+      if (ctx->m_ulHarqStatus[i] == 0)
+        {
+          ctx->m_ulHarqStatus[i] = 1;
+          harqId = i;
+          break;
+        }
+    }
+  return harqId;
+}
+
+template <class Policy>
+uint8_t
+MmWaveFlexTtiSchedulerEngine<Policy>::GetDlCqi (uint16_t rnti)
+{
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+  if (ctx != nullptr && ctx->m_hasDlCqi)
+    {
+      return ctx->m_dlCqi;
+    }
+  NS_LOG_INFO (this << " UE " << rnti << " does not have DL-CQI");
+  return 1;               // lowest value for trying a transmission
+}
+
+template <class Policy>
+uint8_t
+MmWaveFlexTtiSchedulerEngine<Policy>::GetUlCqi (uint16_t rnti, uint8_t &mcs)
+{
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+  if (ctx != nullptr && ctx->m_hasUlCqi)
+    {
+      // translate vector of doubles to SpectrumValue's
+      SpectrumValue specVals (MmWaveSpectrumValueHelper::GetSpectrumModel (m_phyMacConfig));
+      Values::iterator specIt = specVals.ValuesBegin ();
+      for (uint32_t ichunk = 0; ichunk < m_phyMacConfig->GetNumRb (); ichunk++)
+        {
+          NS_ASSERT (specIt != specVals.ValuesEnd ());
+          *specIt = ctx->m_ulCqi.at (ichunk);                   //sinrLin;
+          specIt++;
+        }
+      // for UL CQI, we need to know the TB size previously allocated to accurately compute CQI/MCS
+      return m_amc->CreateCqiFeedbackWbTdma (specVals, mcs);
+    }
+  NS_LOG_INFO (this << " UE " << rnti << " does not have UL-CQI");
+  mcs = 0;
+  return 1;
+}
+
+template <class Policy>
+uint8_t
+MmWaveFlexTtiSchedulerEngine<Policy>::ComputeUeRates (UeSchedInfo* ueInfo, UeAllocMap &ueAllocMap)
+{
+  uint8_t flags = 0;
+  const unsigned hdrSize = Policy::m_rlcHeadersInBuffer ? m_subHdrSize + m_rlcHdrSize : 0;
+
+  // get DL-CQI and compute DL rate per symbol
+  uint8_t cqi = GetDlCqi (ueInfo->m_rnti);
+  if (cqi != 0)
+    {
+      ueInfo->m_dlMcs = m_amc->GetMcsFromCqi (cqi);                // update MCS
+      flags |= DL_CQI;
+      // compute total DL bytes buffered
+      for (unsigned iflow = 0; iflow < ueInfo->m_flowStatsDl.size (); iflow++)
+        {
+          if (ueInfo->m_flowStatsDl[iflow].m_totalBufSize > 0)
+            {
+              ueInfo->m_totBufDl += ueInfo->m_flowStatsDl[iflow].m_totalBufSize;
+              RlcPduInfo newRlcEl;
+              newRlcEl.m_lcid = ueInfo->m_flowStatsDl[iflow].m_lcid;
+              newRlcEl.m_size = ueInfo->m_flowStatsDl[iflow].m_totalBufSize + hdrSize;
+              ueInfo->m_rlcPduInfo.push_back (newRlcEl);
+            }
+        }
+      if (ueInfo->m_totBufDl > 0)
+        {
+          uint32_t tbSizeMax = m_amc->CalculateTbSize (ueInfo->m_dlMcs, 1)*8; // Bytes -> Bits
+          ueInfo->m_currTputDl = std::min (ueInfo->m_totBufDl,tbSizeMax) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds ());
+          ueAllocMap.insert (std::make_pair (ueInfo->m_rnti, ueInfo));
+          flags |= BACKLOGGED;
+        }
+    }
+
+  // get UL-CQI and compute UL rate per symbol
+  uint8_t mcs = 0;
+  cqi = GetUlCqi (ueInfo->m_rnti, mcs);
+  if (cqi != 0)
+    {
+      ueInfo->m_ulMcs = mcs;
+      flags |= UL_CQI;
+      for (unsigned iflow = 0; iflow < ueInfo->m_flowStatsUl.size (); iflow++)
+        {
+          ueInfo->m_totBufUl += ueInfo->m_flowStatsUl[iflow].m_totalBufSize + hdrSize;
+        }
+      if (ueInfo->m_totBufUl > 0)
+        {
+          uint32_t tbSizeMax = m_amc->CalculateTbSize (ueInfo->m_ulMcs, 1)*8; // Bytes -> Bits
+          ueInfo->m_currTputUl = std::min (ueInfo->m_totBufUl,tbSizeMax) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds ());
+          ueAllocMap.insert (std::make_pair (ueInfo->m_rnti, ueInfo));
+          flags |= BACKLOGGED;
+        }
+    }
+  return flags;
+}
+
+template <class Policy>
+bool
+MmWaveFlexTtiSchedulerEngine<Policy>::AllocateSymbol (UeSchedInfo* ueInfo, int &symAvail)
+{
+  if (ueInfo->m_totBufDl == 0)
+    {
+      ueInfo->m_dlAllocDone = true;
+    }
+  if (ueInfo->m_totBufUl == 0)
+    {
+      ueInfo->m_ulAllocDone = true;
+    }
+
+  // evenly distribute symbols between DL and UL flows of same UE
+  if ((ueInfo->m_allocUlLast || ueInfo->m_dlAllocDone) && !ueInfo->m_ulAllocDone)
+    {
+      ueInfo->m_ulSymbols++;
+      symAvail--;
+      ueInfo->m_ulTbSize = m_amc->CalculateTbSize (ueInfo->m_ulMcs, ueInfo->m_ulSymbols);
+      if (ueInfo->m_ulTbSize >= ueInfo->m_totBufUl)
+        {
+          ueInfo->m_ulAllocDone = true;
+          ueInfo->m_lastAvgTputUl = ueInfo->m_avgTputUl;
+        }
+      ueInfo->m_allocUlLast = true;
+
+      uint32_t tbSize = ueInfo->m_ulTbSize * 8; // Bytes -> Bits
+      ueInfo->m_currTputUl = std::min (ueInfo->m_totBufUl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds ());
+      ueInfo->m_avgTputUl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputUl) +
+        ((1.0 / m_timeWindow) * ((double)ueInfo->m_ulTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds ())));
+      return true;
+    }
+  else if (!ueInfo->m_dlAllocDone)
+    {
+      ueInfo->m_dlSymbols++;
+      symAvail--;
+      ueInfo->m_dlTbSize = m_amc->CalculateTbSize (ueInfo->m_dlMcs, ueInfo->m_dlSymbols);
+      if (ueInfo->m_dlTbSize >= ueInfo->m_totBufDl)
+        {
+          ueInfo->m_dlAllocDone = true;
+          ueInfo->m_lastAvgTputDl = ueInfo->m_avgTputDl;
+        }
+      ueInfo->m_allocUlLast = false;
+
+      uint32_t tbSize = ueInfo->m_dlTbSize * 8; // Bytes -> Bits
+      ueInfo->m_currTputDl = std::min (ueInfo->m_totBufDl,tbSize) / (m_phyMacConfig->GetSlotPeriod ().GetSeconds ());
+      ueInfo->m_avgTputDl = ((1.0 - (1.0 / m_timeWindow)) * ueInfo->m_lastAvgTputDl) +
+        ((1.0 / m_timeWindow) * ((double)ueInfo->m_dlTbSize / (m_phyMacConfig->GetSlotPeriod ().GetSeconds ())));
+      return true;
+    }
+  return false;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::AllocateByPfMetric (const std::vector<UeSchedInfo*> &ueList, const std::vector<double> &weights, int &symAvail)
+{
+  NS_ASSERT (ueList.size () == weights.size ());
+  while (symAvail > 0)
+    {
+      UeSchedInfo* bestUe = 0;
+      double bestMetric = 0.0;
+      for (unsigned i = 0; i < ueList.size (); i++)
+        {
+          UeSchedInfo* ueInfo = ueList[i];
+          if (ueInfo->m_totBufDl == 0)
+            {
+              ueInfo->m_dlAllocDone = true;
+            }
+          if (ueInfo->m_totBufUl == 0)
+            {
+              ueInfo->m_ulAllocDone = true;
+            }
+          if (ueInfo->m_dlAllocDone && ueInfo->m_ulAllocDone)
+            {
+              continue;
+            }
+          double metric = weights[i] * GetPfMetric (ueInfo);
+          if (bestUe == 0 || metric > bestMetric)
+            {
+              bestUe = ueInfo;
+              bestMetric = metric;
+            }
+        }
+      if (bestUe == 0)
+        {
+          break;
+        }
+      AllocateSymbol (bestUe, symAvail);
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::ResetAllocation (UeAllocMap &ueAllocMap)
+{
+  for (typename UeAllocMap::iterator itUeAllocMap = ueAllocMap.begin (); itUeAllocMap != ueAllocMap.end (); itUeAllocMap++)
+    {
+      UeSchedInfo* ueInfo = itUeAllocMap->second;
+      ueInfo->m_dlSymbols = 0;
+      ueInfo->m_ulSymbols = 0;
+      ueInfo->m_dlTbSize = 0;
+      ueInfo->m_ulTbSize = 0;
+      ueInfo->m_dlSymbolsRetx = 0;
+      ueInfo->m_ulSymbolsRetx = 0;
+      ueInfo->m_currTputDl = 0;
+      ueInfo->m_currTputUl = 0;
+      ueInfo->m_avgTputDl = 0;
+      ueInfo->m_avgTputUl = 0;
+      ueInfo->m_totBufDl = 0;
+      ueInfo->m_totBufUl = 0;
+      ueInfo->m_dlAllocDone = false;
+      ueInfo->m_ulAllocDone = false;
+      ueInfo->m_rlcPduInfo.clear ();
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::SendSlotAllocation (MmWaveMacSchedSapUser::SchedConfigIndParameters &ret)
+{
+  // add slot for UL control
+  TtiAllocInfo ulCtrlTti (0xFF, TtiAllocInfo::UL_slotAllocInfo, TtiAllocInfo::CTRL, 0);
+  ulCtrlTti.m_dci.m_numSym = 1;
+  ulCtrlTti.m_dci.m_symStart = m_phyMacConfig->GetSymbPerSlot () - 1;
+  ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ulCtrlTti);
+  m_macSchedSapUser->SchedConfigInd (ret);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoSchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
+{
+  NS_PERF_TIMER ("mmwave", "MmWaveFlexTtiSchedulerEngine::DoSchedTriggerReq");
+  uint16_t frameNum = params.m_snfSf.m_frameNum;
+  uint8_t sfNum = params.m_snfSf.m_sfNum;
+  uint8_t slotNum = params.m_snfSf.m_slotNum;
+
+  MmWaveMacSchedSapUser::SchedConfigIndParameters ret;
+  ret.m_sfnSf = params.m_snfSf;
+  ret.m_slotAllocInfo.m_sfnSf = ret.m_sfnSf;
+
+  NS_LOG_DEBUG ("Creating scheduling allocation info for: frame " << frameNum << " subframe "
+                << (unsigned)sfNum << " slot " << (unsigned)slotNum);
+
+  // Add TTI for DL control at the beginning of the slot
+  TtiAllocInfo dlCtrlSlot (0, TtiAllocInfo::DL_slotAllocInfo, TtiAllocInfo::CTRL, 0);
+  dlCtrlSlot.m_dci.m_numSym = 1;
+  dlCtrlSlot.m_dci.m_symStart = 0;
+  ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (dlCtrlSlot);
+  int resvCtrl = m_phyMacConfig->GetDlCtrlSymbols () + m_phyMacConfig->GetUlCtrlSymbols ();
+  int symAvail = m_phyMacConfig->GetSymbPerSlot () - resvCtrl;
+  uint8_t ttiIdx = 1;
+  uint8_t symIdx = m_phyMacConfig->GetDlCtrlSymbols ();      // symbols reserved for control at beginning of subframe
+
+  // process received CQIs
+  RefreshDlCqiMaps ();
+  RefreshUlCqiMaps ();
+
+  // Process DL HARQ feedback
+  RefreshHarqProcesses ();
+
+  UeAllocMap ueAllocMap;                 // map of allocated users for this SF
+  typename UeAllocMap::iterator itUeAllocMap;
+  typename std::map <uint16_t, UeSchedInfo>::iterator itUeSchedInfoMap;
+
+  // retrieve past HARQ retx buffered
+  if (m_dlHarqInfoList.size () > 0 && params.m_dlHarqInfoList.size () > 0)
+    {
+      m_dlHarqInfoList.insert (m_dlHarqInfoList.end (), params.m_dlHarqInfoList.begin (), params.m_dlHarqInfoList.end ());
+    }
+  else if (params.m_dlHarqInfoList.size () > 0)
+    {
+      m_dlHarqInfoList = params.m_dlHarqInfoList;
+    }
+  if (m_ulHarqInfoList.size () > 0 && params.m_ulHarqInfoList.size () > 0)
+    {
+      m_ulHarqInfoList.insert (m_ulHarqInfoList.end (), params.m_ulHarqInfoList.begin (), params.m_ulHarqInfoList.end ());
+    }
+  else if (params.m_ulHarqInfoList.size () > 0)
+    {
+      m_ulHarqInfoList = params.m_ulHarqInfoList;
+    }
+
+  if (m_harqOn == false)                // Ignore HARQ feedback
+    {
+      m_dlHarqInfoList.clear ();
+    }
+  else
+    {
+      // Process DL HARQ feedback and assign slots for RETX if resources available
+      // the TBs not able to be retransmitted in this sf are compacted in place
+      // at the head of the lists, keeping their order
+      unsigned dlNumUntxed = 0;
+      unsigned ulNumUntxed = 0;
+
+      for (unsigned i = 0; i < m_dlHarqInfoList.size (); i++)
+        {
+          if (symAvail == 0)
+            {
+              break;                    // no symbols left to allocate
+            }
+          uint8_t harqId = m_dlHarqInfoList.at (i).m_harqProcessId;
+          uint16_t rnti = m_dlHarqInfoList.at (i).m_rnti;
+          itUeSchedInfoMap = m_ueSchedInfoMap.find (rnti);
+          NS_ASSERT (itUeSchedInfoMap != m_ueSchedInfoMap.end ());
+          MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+          if (ctx == nullptr || !ctx->m_hasDlHarq)
+            {
+              NS_FATAL_ERROR ("No HARQ status info found for UE " << rnti);
+            }
+          if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::ACK || ctx->m_dlHarqStatus.at (harqId) == 0)
+            {             // acknowledgment or process timeout, reset process
+              ctx->m_dlHarqStatus.at (harqId) = 0;                      // release process ID
+              ctx->m_dlHarqRlcPdu.at (harqId).clear ();                 // clear RLC buffers
+              continue;
+            }
+          else if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::NACK)
+            {
+              DciInfoElementTdma dciInfoReTx = ctx->m_dlHarqDci.at (harqId);
+              NS_ASSERT (harqId == dciInfoReTx.m_harqProcess);
+              NS_ASSERT (ctx->m_dlHarqStatus.at (harqId) - 1 == dciInfoReTx.m_rv);
+              if (dciInfoReTx.m_rv == 3)                   // maximum number of retx reached -> drop process
+                {
+                  NS_LOG_INFO ("Max number of retransmissions reached -> drop process");
+                  ctx->m_dlHarqStatus.at (harqId) = 0;
+                  ctx->m_dlHarqRlcPdu.at (harqId).clear ();
+                  continue;
+                }
+              // allocate retx if enough symbols are available
+              if (symAvail >= dciInfoReTx.m_numSym)
+                {
+                  symAvail -= dciInfoReTx.m_numSym;
+                  dciInfoReTx.m_symStart = symIdx;
+                  symIdx += dciInfoReTx.m_numSym;
+                  NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
+                  dciInfoReTx.m_rv++;
+                  dciInfoReTx.m_ndi = 0;
+                  ctx->m_dlHarqDci.at (harqId) = dciInfoReTx;
+                  ctx->m_dlHarqStatus.at (harqId) = ctx->m_dlHarqStatus.at (harqId) + 1;
+                  TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::DL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, rnti);
+                  ttiInfo.m_dci = dciInfoReTx;
+                  NS_LOG_DEBUG ("UE" << dciInfoReTx.m_rnti << " gets DL symbols " << (unsigned)dciInfoReTx.m_symStart << "-" << (unsigned)(dciInfoReTx.m_symStart + dciInfoReTx.m_numSym - 1) <<
+                                " tbs " << dciInfoReTx.m_tbSize << " harqId " << (unsigned)dciInfoReTx.m_harqProcess <<
+                                " rv " << (unsigned)dciInfoReTx.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum << " RETX");
+                  ttiInfo.m_rlcPduInfo = ctx->m_dlHarqRlcPdu.at (dciInfoReTx.m_harqProcess);
+                  ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+                  ret.m_slotAllocInfo.m_numSymAlloc += dciInfoReTx.m_numSym;
+
+                  itUeSchedInfoMap->second.m_dlSymbolsRetx = dciInfoReTx.m_numSym;
+                  ueAllocMap.insert (std::make_pair (rnti, &itUeSchedInfoMap->second));
+                }
+              else
+                {
+                  NS_LOG_INFO ("No resource for this retx -> buffer it");
+                  m_dlHarqInfoList.at (dlNumUntxed++) = m_dlHarqInfoList.at (i);
+                }
+            }
+        }
+
+      m_dlHarqInfoList.resize (dlNumUntxed);
+
+      // Process UL HARQ feedback
+      for (uint16_t i = 0; i < m_ulHarqInfoList.size (); i++)
+        {
+          if (symAvail == 0)
+            {
+              break;                    // no symbols left to allocate
+            }
+          UlHarqInfo harqInfo = m_ulHarqInfoList.at (i);
+          uint8_t harqId = harqInfo.m_harqProcessId;
+          uint16_t rnti = harqInfo.m_rnti;
+          itUeSchedInfoMap = m_ueSchedInfoMap.find (rnti);
+          NS_ASSERT (itUeSchedInfoMap != m_ueSchedInfoMap.end ());
+          MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (rnti);
+          if (ctx == nullptr || !ctx->m_hasUlHarq)
+            {
+              NS_LOG_ERROR ("No info found in HARQ buffer for UE (might have changed eNB) " << rnti);
+              continue;
+            }
+          if (harqInfo.m_receptionStatus == UlHarqInfo::Ok || ctx->m_ulHarqStatus.at (harqId) == 0)
+            {
+              ctx->m_ulHarqStatus.at (harqId) = 0;                        // release process ID
+            }
+          else if (harqInfo.m_receptionStatus == UlHarqInfo::NotOk)
+            {
+              // retx correspondent block: retrieve the UL-DCI
+              DciInfoElementTdma dciInfoReTx = ctx->m_ulHarqDci.at (harqId);
+              NS_ASSERT (harqId == dciInfoReTx.m_harqProcess);
+              NS_ASSERT (ctx->m_ulHarqStatus.at (harqId) > 0);
+              NS_ASSERT (ctx->m_ulHarqStatus.at (harqId) - 1 == dciInfoReTx.m_rv);
+              if (dciInfoReTx.m_rv == 3)
+                {
+                  NS_LOG_INFO ("Max number of retransmissions reached (UL)-> drop process");
+                  ctx->m_ulHarqStatus.at (harqId) = 0;
+                  continue;
+                }
+
+              if (symAvail >= dciInfoReTx.m_numSym)
+                {
+                  symAvail -= dciInfoReTx.m_numSym;
+                  dciInfoReTx.m_symStart = symIdx;
+                  symIdx += dciInfoReTx.m_numSym;
+                  NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
+                  dciInfoReTx.m_rv++;
+                  dciInfoReTx.m_ndi = 0;
+                  ctx->m_ulHarqStatus.at (harqId) = ctx->m_ulHarqStatus.at (harqId) + 1;
+                  ctx->m_ulHarqDci.at (harqId) = dciInfoReTx;
+                  TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::UL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, rnti);
+                  ttiInfo.m_dci = dciInfoReTx;
+                  NS_LOG_DEBUG ("UE" << dciInfoReTx.m_rnti << " gets UL symbols " << (unsigned)dciInfoReTx.m_symStart << "-" << (unsigned)(dciInfoReTx.m_symStart + dciInfoReTx.m_numSym - 1) <<
+                                " tbs " << dciInfoReTx.m_tbSize << " harqId " << (unsigned)dciInfoReTx.m_harqProcess << " rv " << (unsigned)dciInfoReTx.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum <<
+                                " RETX");
+                  ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+                  ret.m_slotAllocInfo.m_numSymAlloc += dciInfoReTx.m_numSym;
+
+                  itUeSchedInfoMap->second.m_ulSymbolsRetx = dciInfoReTx.m_numSym;
+                  ueAllocMap.insert (std::make_pair (rnti, &itUeSchedInfoMap->second));
+                }
+              else
+                {
+                  m_ulHarqInfoList.at (ulNumUntxed++) = m_ulHarqInfoList.at (i);
+                }
+            }
+        }
+
+      m_ulHarqInfoList.resize (ulNumUntxed);
+    }
+
+  // no further allocations
+  if (symAvail == 0)
+    {
+      SendSlotAllocation (ret);
+
+      // reset the alloc info for the next scheduler call
+      for (itUeAllocMap = ueAllocMap.begin (); itUeAllocMap != ueAllocMap.end (); itUeAllocMap++)
+        {
+          itUeAllocMap->second->m_dlSymbolsRetx = 0;
+          itUeAllocMap->second->m_ulSymbolsRetx = 0;
+        }
+      return;
+    }
+
+  // ********************* END OF HARQ SECTION, START OF NEW DATA SCHEDULING ********************* //
+
+  m_policy.AllocateNewData (*this, ueAllocMap, symAvail);
+
+  // no further allocations
+  if (ueAllocMap.size () == 0)
+    {
+      SendSlotAllocation (ret);
+      return;
+    }
+
+  // iterate through map of allocated UEs, assign TDMA symbol indices and create DCIs
+  for (itUeAllocMap = ueAllocMap.begin (); itUeAllocMap != ueAllocMap.end (); itUeAllocMap++)
+    {
+      UeSchedInfo *ueInfo = itUeAllocMap->second;
+      if (ueInfo->m_dlSymbols > 0)
+        {
+          DciInfoElementTdma dci;
+          dci.m_rnti = ueInfo->m_rnti;
+          dci.m_format = 0;
+          dci.m_symStart = symIdx;
+          dci.m_numSym = ueInfo->m_dlSymbols;
+          symIdx += ueInfo->m_dlSymbols;
+          NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
+          dci.m_mcs = ueInfo->m_dlMcs;
+          dci.m_rv = 0;
+          dci.m_ndi = 1;
+          dci.m_tbSize = m_amc->CalculateTbSize (dci.m_mcs, dci.m_numSym);
+          dci.m_harqProcess = UpdateDlHarqProcessId (ueInfo->m_rnti);
+          NS_ASSERT (dci.m_harqProcess < m_phyMacConfig->GetNumHarqProcess ());
+          TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::DL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, ueInfo->m_rnti);
+          ttiInfo.m_dci = dci;
+          NS_LOG_DEBUG ("UE" << dci.m_rnti << " gets DL symbols " << (unsigned)dci.m_symStart << "-" << (unsigned)(dci.m_symStart + dci.m_numSym - 1) <<
+                        " tbs " << dci.m_tbSize << " mcs " << (unsigned)dci.m_mcs << " harqId " << (unsigned)dci.m_harqProcess << " rv " << (unsigned)dci.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum);
+
+          MmWaveFlexTtiUeContext* ctx = nullptr;
+          if (m_harqOn == true)
+            {                   // store DCI for HARQ buffer
+              ctx = m_ueContexts.Find (dci.m_rnti);
+              if (ctx == nullptr || !ctx->m_hasDlHarq)
+                {
+                  NS_FATAL_ERROR ("Unable to find RNTI entry in DCI HARQ buffer for RNTI " << dci.m_rnti);
+                }
+              ctx->m_dlHarqDci.at (dci.m_harqProcess) = dci;
+              // refresh timer
+              ctx->m_dlHarqExpiry.at (dci.m_harqProcess) = m_harqTimers.Schedule (dci.m_rnti, dci.m_harqProcess, false,
+                                                                                    m_phyMacConfig->GetHarqTimeout () + 1);
+            }
+
+          std::vector <struct RlcPduInfo> &rlcPduInfo = ueInfo->m_rlcPduInfo;
+          if (Policy::m_pduBasedAllocation)
+            {
+              unsigned totalBytesAlloc = 0;
+              for (unsigned i = 0; i < rlcPduInfo.size (); i++)
+                {
+                  totalBytesAlloc += rlcPduInfo[i].m_size;
+                }
+              for (unsigned i = 0; i < rlcPduInfo.size (); i++)
+                {
+                  // give remaining bytes to default bearer
+                  if (rlcPduInfo[i].m_lcid == 3 && totalBytesAlloc < dci.m_tbSize)
+                    {
+                      rlcPduInfo[i].m_size += dci.m_tbSize - totalBytesAlloc;
+                    }
+                }
+              ttiInfo.m_rlcPduInfo = rlcPduInfo;
+            }
+          else
+            {
+              // distribute bytes between active RLC queues
+              unsigned bytesRem = dci.m_tbSize;
+              unsigned numFulfilled = 0;
+              uint16_t avgPduSize = bytesRem / rlcPduInfo.size ();
+              // first for loop computes extra to add to average if some flows are less than average
+              for (unsigned i = 0; i < rlcPduInfo.size (); i++)
+                {
+                  if (rlcPduInfo[i].m_size < avgPduSize)
+                    {
+                      bytesRem -= rlcPduInfo[i].m_size;
+                      numFulfilled++;
+                    }
+                }
+
+              if (numFulfilled < rlcPduInfo.size ())
+                {
+                  avgPduSize = bytesRem / (rlcPduInfo.size () - numFulfilled);
+                }
+
+              for (unsigned i = 0; i < rlcPduInfo.size (); i++)
+                {
+                  if (rlcPduInfo[i].m_size > avgPduSize)
+                    {
+                      rlcPduInfo[i].m_size = avgPduSize;
+                    }
+                  // else tbSize equals RLC queue size
+                  NS_ASSERT (rlcPduInfo[i].m_size > 0);
+                }
+              // each RLC PDU is requested twice, in the same order
+              ttiInfo.m_rlcPduInfo = rlcPduInfo;
+              ttiInfo.m_rlcPduInfo.insert (ttiInfo.m_rlcPduInfo.end (), rlcPduInfo.begin (), rlcPduInfo.end ());
+            }
+
+          if (m_harqOn == true)
+            {
+              // store RLC PDU list for HARQ
+              std::vector <struct RlcPduInfo> &harqRlcPdu = ctx->m_dlHarqRlcPdu.at (dci.m_harqProcess);
+              harqRlcPdu.insert (harqRlcPdu.end (), ttiInfo.m_rlcPduInfo.begin (), ttiInfo.m_rlcPduInfo.end ());
+
+              // reorder/reindex slots to maintain DL before UL slot order
+              bool reordered = false;
+              std::deque <TtiAllocInfo>::iterator itTti = ret.m_slotAllocInfo.m_ttiAllocInfo.begin ();
+              for (unsigned iTti = 0; iTti < ret.m_slotAllocInfo.m_ttiAllocInfo.size (); iTti++)
+                {
+                  if (ret.m_slotAllocInfo.m_ttiAllocInfo [iTti].m_tddMode == TtiAllocInfo::UL_slotAllocInfo)
+                    {
+                      ttiInfo.m_ttiIdx = ret.m_slotAllocInfo.m_ttiAllocInfo [iTti].m_ttiIdx;
+                      ttiInfo.m_dci.m_symStart = ret.m_slotAllocInfo.m_ttiAllocInfo [iTti].m_dci.m_symStart;
+                      ret.m_slotAllocInfo.m_ttiAllocInfo.insert (itTti, ttiInfo);
+                      for (unsigned jTti = iTti + 1; jTti < ret.m_slotAllocInfo.m_ttiAllocInfo.size (); jTti++)
+                        {
+                          ret.m_slotAllocInfo.m_ttiAllocInfo[jTti].m_ttiIdx++;                                 // increase indices of UL slots
+                          ret.m_slotAllocInfo.m_ttiAllocInfo[jTti].m_dci.m_symStart =
+                            ret.m_slotAllocInfo.m_ttiAllocInfo[jTti - 1].m_dci.m_symStart +
+                            ret.m_slotAllocInfo.m_ttiAllocInfo[jTti - 1].m_dci.m_numSym;
+                        }
+                      reordered = true;
+                      break;
+                    }
+                  itTti++;
+                }
+              if (!reordered)
+                {
+                  ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+                }
+            }
+          else
+            {
+              ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+            }
+          ret.m_slotAllocInfo.m_numSymAlloc += dci.m_numSym;
+        }
+    }
+  ttiIdx = ret.m_slotAllocInfo.m_ttiAllocInfo.back ().m_ttiIdx + 1;
+  symIdx = ret.m_slotAllocInfo.m_ttiAllocInfo.back ().m_dci.m_symStart + ret.m_slotAllocInfo.m_ttiAllocInfo.back ().m_dci.m_numSym;
+
+  for (itUeAllocMap = ueAllocMap.begin (); itUeAllocMap != ueAllocMap.end (); itUeAllocMap++)
+    {
+      UeSchedInfo *ueInfo = itUeAllocMap->second;
+      // Note: UL-DCI applies to subframe i+Tsched
+      if (ueInfo->m_ulSymbols > 0)
+        {
+          DciInfoElementTdma dci;
+          dci.m_rnti = ueInfo->m_rnti;
+          dci.m_format = 1;
+          dci.m_symStart = symIdx;
+          dci.m_numSym = ueInfo->m_ulSymbols;
+          symIdx += ueInfo->m_ulSymbols;
+          NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
+          dci.m_mcs = ueInfo->m_ulMcs;
+          dci.m_ndi = 1;
+          dci.m_tbSize = m_amc->CalculateTbSize (dci.m_mcs, dci.m_numSym);
+          dci.m_harqProcess = UpdateUlHarqProcessId (ueInfo->m_rnti);
+          NS_ASSERT (dci.m_harqProcess < m_phyMacConfig->GetNumHarqProcess ());
+          TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::UL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, ueInfo->m_rnti);
+          ttiInfo.m_dci = dci;
+          NS_LOG_DEBUG ("UE" << dci.m_rnti << " gets UL symbols " << (unsigned)dci.m_symStart << "-" << (unsigned)(dci.m_symStart + dci.m_numSym - 1) <<
+                        " tbs " << dci.m_tbSize << " mcs " << (unsigned)dci.m_mcs << " harqId " << (unsigned)dci.m_harqProcess << " rv " << (unsigned)dci.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum);
+          ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+          ret.m_slotAllocInfo.m_numSymAlloc += dci.m_numSym;
+          std::vector<uint16_t> ueChunkMap (m_phyMacConfig->GetNumRb (), dci.m_rnti);
+          SfnSf slotSfn = ret.m_slotAllocInfo.m_sfnSf;
+          slotSfn.m_slotNum = dci.m_symStart;                // use the start symbol index of the slot because the absolute UL slot index depends on the future DL allocation
+          // insert into allocation map to recall previous allocations upon receiving UL-CQI
+          m_ulAllocationMap.insert ( std::pair<uint32_t, struct AllocMapElem> (slotSfn.Encode (), AllocMapElem (ueChunkMap, dci.m_numSym, dci.m_tbSize)) );
+
+          if (m_harqOn == true)
+            {
+              uint8_t harqId = dci.m_harqProcess;
+              MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (dci.m_rnti);
+              if (ctx == nullptr || !ctx->m_hasUlHarq)
+                {
+                  NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << dci.m_rnti);
+                }
+              ctx->m_ulHarqDci.at (harqId) = dci;
+              // Update HARQ process status (RV 0)
+              NS_ASSERT (ctx->m_ulHarqStatus[dci.m_harqProcess] > 0);
+              // refresh timer
+              ctx->m_ulHarqExpiry.at (dci.m_harqProcess) = m_harqTimers.Schedule (dci.m_rnti, dci.m_harqProcess, true,
+                                                                                    m_phyMacConfig->GetHarqTimeout () + 1);
+            }
+        }
+    }
+
+  // reset the alloc info for the next scheduler call
+  ResetAllocation (ueAllocMap);
+
+  SendSlotAllocation (ret);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::RefreshDlCqiMaps (void)
+{
+  NS_LOG_FUNCTION (this << m_ueContexts.GetSize ());
+  // refresh DL CQI P01 Map
+  for (MmWaveFlexTtiUeContextTable::Iterator itCtx = m_ueContexts.Begin (); itCtx != m_ueContexts.End (); itCtx++)
+    {
+      MmWaveFlexTtiUeContext &ctx = **itCtx;
+      if (!ctx.m_hasDlCqi)
+        {
+          continue;
+        }
+      NS_LOG_INFO (this << " P10-CQI for user " << ctx.m_rnti << " is " << (uint32_t)ctx.m_dlCqiTimer << " thr " << (uint32_t)m_cqiTimersThreshold);
+      if (ctx.m_dlCqiTimer == 0)
+        {
+          // delete correspondent entries
+          NS_LOG_INFO (this << " P10-CQI exired for user " << ctx.m_rnti);
+          ctx.m_hasDlCqi = false;
+        }
+      else
+        {
+          ctx.m_dlCqiTimer--;
+        }
+    }
+  m_ueContexts.Purge ();
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::RefreshUlCqiMaps (void)
+{
+  // refresh UL CQI  Map
+  for (MmWaveFlexTtiUeContextTable::Iterator itCtx = m_ueContexts.Begin (); itCtx != m_ueContexts.End (); itCtx++)
+    {
+      MmWaveFlexTtiUeContext &ctx = **itCtx;
+      if (!ctx.m_hasUlCqi)
+        {
+          continue;
+        }
+      NS_LOG_INFO (this << " UL-CQI for user " << ctx.m_rnti << " is " << (uint32_t)ctx.m_ulCqiTimer << " thr " << (uint32_t)m_cqiTimersThreshold);
+      if (ctx.m_ulCqiTimer == 0)
+        {
+          // delete correspondent entries
+          NS_LOG_INFO (this << " UL-CQI expired for user " << ctx.m_rnti);
+          ctx.m_hasUlCqi = false;
+          ctx.m_ulCqi.clear ();
+        }
+      else
+        {
+          ctx.m_ulCqiTimer--;
+        }
+    }
+  m_ueContexts.Purge ();
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoCschedCellConfigReq (const struct MmWaveMacCschedSapProvider::CschedCellConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  // Read the subset of parameters used
+  m_cschedCellConfig = params;
+  MmWaveMacCschedSapUser::CschedUeConfigCnfParameters cnf;
+  cnf.m_result = SUCCESS;
+  m_macCschedSapUser->CschedUeConfigCnf (cnf);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoCschedUeConfigReq (const struct MmWaveMacCschedSapProvider::CschedUeConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << " RNTI " << params.m_rnti << " txMode " << (uint16_t)params.m_transmissionMode);
+
+  typename std::map <uint16_t, UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  if (itUe == m_ueSchedInfoMap.end ())
+    {
+      itUe = m_ueSchedInfoMap.insert (std::make_pair (params.m_rnti, UeSchedInfo (params.m_rnti))).first;
+      for (unsigned i = 0; i <= 3; i++)
+        {
+          itUe->second.m_flowStatsDl.push_back (FlowStats (false, &(itUe->second), i));
+          itUe->second.m_flowStatsUl.push_back (FlowStats (true, &(itUe->second), i));
+        }
+    }
+
+  MmWaveFlexTtiUeContext &ctx = m_ueContexts.Get (params.m_rnti);
+  if (!ctx.m_hasDlHarq)
+    {
+      ctx.m_hasDlHarq = true;
+      ctx.m_dlHarqStatus.assign (m_phyMacConfig->GetNumHarqProcess (), 0);
+      ctx.m_dlHarqExpiry.assign (m_phyMacConfig->GetNumHarqProcess (), 0);
+      ctx.m_dlHarqDci.assign (m_phyMacConfig->GetNumHarqProcess (), DciInfoElementTdma ());
+      ctx.m_dlHarqRlcPdu.assign (m_phyMacConfig->GetNumHarqProcess (), std::vector <struct RlcPduInfo> ());
+    }
+
+  if (!ctx.m_hasUlHarq)
+    {
+      ctx.m_hasUlHarq = true;
+      ctx.m_ulHarqStatus.assign (m_phyMacConfig->GetNumHarqProcess (), 0);
+      ctx.m_ulHarqExpiry.assign (m_phyMacConfig->GetNumHarqProcess (), 0);
+      ctx.m_ulHarqDci.assign (m_phyMacConfig->GetNumHarqProcess (), DciInfoElementTdma ());
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoCschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  typename std::map <uint16_t, UeSchedInfo>::iterator itUe = m_ueSchedInfoMap.find (params.m_rnti);
+  if (itUe == m_ueSchedInfoMap.end ())
+    {
+      NS_LOG_ERROR ("Cannot find UE info entry");
+      return;
+    }
+
+  UeSchedInfo &ueInfo = itUe->second;
+  EpsBearer lowLatBearer (EpsBearer::NGBR_LOW_LAT_EMBB_AR);
+  for (uint16_t i = 0; i < params.m_logicalChannelConfigList.size (); i++)
+    {
+      const LogicalChannelConfigListElement_s &lcConfig = params.m_logicalChannelConfigList[i];
+      if (lcConfig.m_direction == LogicalChannelConfigListElement_s::DIR_DL)
+        {
+          uint8_t lcid = lcConfig.m_logicalChannelIdentity;
+          for (unsigned j = ueInfo.m_flowStatsDl.size (); j <= lcid; j++)
+            {
+              ueInfo.m_flowStatsDl.push_back (FlowStats (false, &ueInfo, j));
+            }
+          ueInfo.m_flowStatsDl[lcid].m_qci = lcConfig.m_qci;
+          if (lcConfig.m_qci == EpsBearer::NGBR_LOW_LAT_EMBB_AR)
+            {
+              ueInfo.m_flowStatsDl[lcid].m_deadlineUs = lowLatBearer.GetPacketDelayBudgetMs () * 1000;
+            }
+          m_flowHeap.push_back ( &(ueInfo.m_flowStatsDl[lcid]) );
+        }
+      else if (lcConfig.m_direction == LogicalChannelConfigListElement_s::DIR_UL)
+        {
+          uint8_t lcid = lcConfig.m_logicalChannelGroup;   // use LCG ID instead of LCID
+          for (unsigned j = ueInfo.m_flowStatsUl.size (); j <= lcid; j++)
+            {
+              ueInfo.m_flowStatsUl.push_back (FlowStats (true, &ueInfo, j));
+            }
+          ueInfo.m_flowStatsUl[lcid].m_isUplink = true;
+          ueInfo.m_flowStatsUl[lcid].m_qci = lcConfig.m_qci;
+          if (lcConfig.m_qci == EpsBearer::NGBR_LOW_LAT_EMBB_AR)
+            {
+              ueInfo.m_flowStatsUl[lcid].m_deadlineUs = lowLatBearer.GetPacketDelayBudgetMs () * 1000;
+            }
+          m_flowHeap.push_back ( &(ueInfo.m_flowStatsUl[lcid]) );
+        }
+      else if (lcConfig.m_direction == LogicalChannelConfigListElement_s::DIR_BOTH)
+        {
+          uint8_t lcid = lcConfig.m_logicalChannelIdentity;
+          for (unsigned j = ueInfo.m_flowStatsDl.size (); j <= lcid; j++)
+            {
+              ueInfo.m_flowStatsDl.push_back (FlowStats (false, &ueInfo, j));
+              ueInfo.m_flowStatsUl.push_back (FlowStats (true, &ueInfo, j));
+            }
+          ueInfo.m_flowStatsDl[lcid].m_qci = lcConfig.m_qci;
+          ueInfo.m_flowStatsUl[lcid].m_qci = lcConfig.m_qci;
+          // bidirectional bearers are always given the deadline of the low latency bearers
+          ueInfo.m_flowStatsDl[lcid].m_deadlineUs = lowLatBearer.GetPacketDelayBudgetMs () * 1000;
+          ueInfo.m_flowStatsUl[lcid].m_deadlineUs = lowLatBearer.GetPacketDelayBudgetMs () * 1000;
+
+          m_flowHeap.push_back ( &(ueInfo.m_flowStatsDl[lcid]) );
+          m_flowHeap.push_back ( &(ueInfo.m_flowStatsUl[lcid]) );
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoCschedLcReleaseReq (const struct MmWaveMacCschedSapProvider::CschedLcReleaseReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiSchedulerEngine<Policy>::DoCschedUeReleaseReq (const struct MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << " Release RNTI " << params.m_rnti);
+
+  if (Policy::m_releaseUeSchedInfo)
+    {
+      m_ueSchedInfoMap.erase (params.m_rnti);
+    }
+  MmWaveFlexTtiUeContext* ctx = m_ueContexts.Find (params.m_rnti);
+  if (ctx != nullptr)
+    {
+      ctx->m_hasDlHarq = false;
+      ctx->m_hasUlHarq = false;
+      ctx->m_hasBsr = false;
+      m_ueContexts.Purge ();
+    }
+}
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_SCHEDULER_ENGINE_H_ */
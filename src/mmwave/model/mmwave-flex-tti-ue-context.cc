@@ -0,0 +1,166 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-flex-tti-ue-context.h"
+#include <ns3/log.h>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveFlexTtiUeContext");
+
+namespace mmwave {
+
+MmWaveFlexTtiUeContext::MmWaveFlexTtiUeContext ()
+  : m_index (0)
+{
+  Reset (0);
+}
+
+void
+MmWaveFlexTtiUeContext::Reset (uint16_t rnti)
+{
+  m_rnti = rnti;
+  m_hasDlCqi = false;
+  m_dlCqi = 0;
+  m_dlCqiTimer = 0;
+  m_hasUlCqi = false;
+  m_ulCqi.clear ();
+  m_ulCqiNumSym = 0;
+  m_ulCqiTbSize = 0;
+  m_ulCqiTimer = 0;
+  m_hasBsr = false;
+  m_bsr = 0;
+  m_hasDlHarq = false;
+  m_dlHarqStatus.clear ();
+  m_dlHarqExpiry.clear ();
+  m_dlHarqDci.clear ();
+  m_dlHarqRlcPdu.clear ();
+  m_hasUlHarq = false;
+  m_ulHarqStatus.clear ();
+  m_ulHarqExpiry.clear ();
+  m_ulHarqDci.clear ();
+}
+
+bool
+MmWaveFlexTtiUeContext::IsEmpty (void) const
+{
+  return !(m_hasDlCqi || m_hasUlCqi || m_hasBsr || m_hasDlHarq || m_hasUlHarq);
+}
+
+MmWaveFlexTtiUeContextTable::MmWaveFlexTtiUeContextTable ()
+{
+}
+
+MmWaveFlexTtiUeContext*
+MmWaveFlexTtiUeContextTable::Find (uint16_t rnti) const
+{
+  std::unordered_map<uint16_t, uint32_t>::const_iterator it = m_indexOfRnti.find (rnti);
+  if (it == m_indexOfRnti.end ())
+    {
+      return nullptr;
+    }
+  return const_cast<MmWaveFlexTtiUeContext*> (&m_contexts[it->second]);
+}
+
+MmWaveFlexTtiUeContext&
+MmWaveFlexTtiUeContextTable::Get (uint16_t rnti)
+{
+  MmWaveFlexTtiUeContext* ctx = Find (rnti);
+  if (ctx != nullptr)
+    {
+      return *ctx;
+    }
+
+  uint32_t index;
+  if (!m_freeIndexes.empty ())
+    {
+      index = m_freeIndexes.back ();
+      m_freeIndexes.pop_back ();
+    }
+  else
+    {
+      index = m_contexts.size ();
+      m_contexts.push_back (MmWaveFlexTtiUeContext ());
+    }
+  NS_LOG_LOGIC ("New context " << index << " for RNTI " << rnti);
+
+  ctx = &m_contexts[index];
+  ctx->Reset (rnti);
+  ctx->m_index = index;
+  m_indexOfRnti[rnti] = index;
+
+  std::vector<MmWaveFlexTtiUeContext*>::iterator pos =
+    std::lower_bound (m_sorted.begin (), m_sorted.end (), rnti,
+                      [] (const MmWaveFlexTtiUeContext* c, uint16_t r) { return c->m_rnti < r; });
+  m_sorted.insert (pos, ctx);
+  return *ctx;
+}
+
+void
+MmWaveFlexTtiUeContextTable::Purge (void)
+{
+  std::vector<MmWaveFlexTtiUeContext*>::iterator last = m_sorted.begin ();
+  for (std::vector<MmWaveFlexTtiUeContext*>::iterator it = m_sorted.begin (); it != m_sorted.end (); ++it)
+    {
+      MmWaveFlexTtiUeContext* ctx = *it;
+      if (ctx->IsEmpty ())
+        {
+          NS_LOG_LOGIC ("Free context " << ctx->m_index << " of RNTI " << ctx->m_rnti);
+          m_indexOfRnti.erase (ctx->m_rnti);
+          m_freeIndexes.push_back (ctx->m_index);
+          ctx->Reset (0);
+        }
+      else
+        {
+          *last++ = ctx;
+        }
+    }
+  m_sorted.erase (last, m_sorted.end ());
+}
+
+void
+MmWaveFlexTtiUeContextTable::Clear (void)
+{
+  m_sorted.clear ();
+  m_indexOfRnti.clear ();
+  m_freeIndexes.clear ();
+  m_contexts.clear ();
+}
+
+uint32_t
+MmWaveFlexTtiUeContextTable::GetSize (void) const
+{
+  return m_sorted.size ();
+}
+
+MmWaveFlexTtiUeContextTable::Iterator
+MmWaveFlexTtiUeContextTable::Begin (void) const
+{
+  return m_sorted.begin ();
+}
+
+MmWaveFlexTtiUeContextTable::Iterator
+MmWaveFlexTtiUeContextTable::End (void) const
+{
+  return m_sorted.end ();
+}
+
+} // namespace mmwave
+
+} // namespace ns3
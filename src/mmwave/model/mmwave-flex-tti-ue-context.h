@@ -0,0 +1,158 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_UE_CONTEXT_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_UE_CONTEXT_H_
+
+#include "mmwave-phy-mac-common.h"
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * Per-UE state of the flex-TTI MAC schedulers.
+ * Each group of fields is guarded by a presence flag, which is set when the
+ * corresponding information is received (or configured) and cleared when it
+ * expires or the UE is released.
+ */
+struct MmWaveFlexTtiUeContext
+{
+  typedef std::vector < uint8_t > HarqProcessesStatus_t; //!< 0: process available, x>0: transmission count
+  typedef std::vector < uint64_t > HarqProcessesExpiry_t; //!< slot in which the process timer expires, 0 if not running
+  typedef std::vector < DciInfoElementTdma > HarqProcessesDciInfoList_t; //!< DCI of the last (re)transmission
+  typedef std::vector < std::vector <struct RlcPduInfo> > HarqRlcPduList_t; //!< RLC PDUs of each process
+
+  /**
+   * Constructor
+   */
+  MmWaveFlexTtiUeContext ();
+
+  /**
+   * Clear all the state and assign the context to a new UE
+   * \param rnti the RNTI of the UE
+   */
+  void Reset (uint16_t rnti);
+
+  /**
+   * \return true if no information is stored for the UE
+   */
+  bool IsEmpty (void) const;
+
+  uint16_t m_rnti; //!< the RNTI of the UE
+  uint32_t m_index; //!< the index of the context in the table
+
+  bool m_hasDlCqi; //!< true if a wideband DL CQI is available
+  uint8_t m_dlCqi; //!< the wideband DL CQI
+  uint32_t m_dlCqiTimer; //!< number of TTIs for which the DL CQI is still valid
+
+  bool m_hasUlCqi; //!< true if the UL SINR is available
+  std::vector<double> m_ulCqi; //!< the UL SINR of each RB
+  uint8_t m_ulCqiNumSym; //!< number of symbols of the UL allocation the SINR refers to
+  uint32_t m_ulCqiTbSize; //!< TB size of the UL allocation the SINR refers to
+  uint32_t m_ulCqiTimer; //!< number of TTIs for which the UL SINR is still valid
+
+  bool m_hasBsr; //!< true if a buffer status report has been received
+  uint32_t m_bsr; //!< the UL buffer size
+
+  bool m_hasDlHarq; //!< true if the DL HARQ processes are configured
+  HarqProcessesStatus_t m_dlHarqStatus; //!< status of the DL HARQ processes
+  HarqProcessesExpiry_t m_dlHarqExpiry; //!< expiry of the timers of the DL HARQ processes
+  HarqProcessesDciInfoList_t m_dlHarqDci; //!< DCIs of the DL HARQ processes
+  HarqRlcPduList_t m_dlHarqRlcPdu; //!< RLC PDUs of the DL HARQ processes
+
+  bool m_hasUlHarq; //!< true if the UL HARQ processes are configured
+  HarqProcessesStatus_t m_ulHarqStatus; //!< status of the UL HARQ processes
+  HarqProcessesExpiry_t m_ulHarqExpiry; //!< expiry of the timers of the UL HARQ processes
+  HarqProcessesDciInfoList_t m_ulHarqDci; //!< DCIs of the UL HARQ processes
+};
+
+/**
+ * \ingroup mmwave
+ * Table of the contexts of the UEs served by a flex-TTI MAC scheduler.
+ * The contexts are stored densely and reused when a UE leaves the cell,
+ * and they never move in memory, so that a pointer to a context stays valid
+ * until the context is purged. The RNTI of a UE is mapped to its context with
+ * a hash table, while an RNTI-ordered index allows the schedulers to visit
+ * the UEs in the same order as the std::map based implementation.
+ */
+class MmWaveFlexTtiUeContextTable
+{
+public:
+  typedef std::vector<MmWaveFlexTtiUeContext*>::const_iterator Iterator; //!< RNTI-ordered iterator
+
+  /**
+   * Constructor
+   */
+  MmWaveFlexTtiUeContextTable ();
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \return the context of the UE, or nullptr if the UE is not in the table
+   */
+  MmWaveFlexTtiUeContext* Find (uint16_t rnti) const;
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \return the context of the UE, created if the UE is not in the table
+   */
+  MmWaveFlexTtiUeContext& Get (uint16_t rnti);
+
+  /**
+   * Free the contexts that do not store any information.
+   * Contexts are not freed as soon as they become empty, so that the
+   * schedulers can clear the state of a UE while iterating over the table.
+   */
+  void Purge (void);
+
+  /**
+   * Remove all the contexts
+   */
+  void Clear (void);
+
+  /**
+   * \return the number of UEs in the table
+   */
+  uint32_t GetSize (void) const;
+
+  /**
+   * \return an iterator to the context with the lowest RNTI
+   */
+  Iterator Begin (void) const;
+
+  /**
+   * \return the past-the-end iterator
+   */
+  Iterator End (void) const;
+
+private:
+  std::deque<MmWaveFlexTtiUeContext> m_contexts; //!< the storage of the contexts
+  std::vector<uint32_t> m_freeIndexes; //!< indexes of the contexts that can be reused
+  std::unordered_map<uint16_t, uint32_t> m_indexOfRnti; //!< map from the RNTI to the index of the context
+  std::vector<MmWaveFlexTtiUeContext*> m_sorted; //!< the contexts in use, ordered by RNTI
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_UE_CONTEXT_H_ */
@@ -0,0 +1,107 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-harq-timer-wheel.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveHarqTimerWheel");
+
+namespace mmwave {
+
+MmWaveHarqTimerWheel::MmWaveHarqTimerWheel ()
+  : m_now (0),
+    m_mask (0),
+    m_buckets (1)
+{
+}
+
+uint64_t
+MmWaveHarqTimerWheel::GetNow (void) const
+{
+  return m_now;
+}
+
+uint64_t
+MmWaveHarqTimerWheel::Schedule (uint16_t rnti, uint8_t harqId, bool uplink, uint32_t delay)
+{
+  NS_ASSERT (delay > 0);
+  if (delay > m_mask)
+    {
+      Grow (delay);
+    }
+
+  Timer timer;
+  timer.m_expiry = m_now + delay;
+  timer.m_rnti = rnti;
+  timer.m_harqId = harqId;
+  timer.m_uplink = uplink;
+  m_buckets[timer.m_expiry & m_mask].push_back (timer);
+  NS_LOG_LOGIC ("HARQ timer of RNTI " << rnti << " process " << (unsigned)harqId <<
+                (uplink ? " (UL)" : " (DL)") << " expires in slot " << timer.m_expiry);
+  return timer.m_expiry;
+}
+
+void
+MmWaveHarqTimerWheel::Advance (std::vector<Timer> &expired)
+{
+  m_now++;
+  std::vector<Timer> &bucket = m_buckets[m_now & m_mask];
+  // all the timers in the bucket expire now, since no timer is
+  // scheduled farther than the size of the wheel
+  expired.insert (expired.end (), bucket.begin (), bucket.end ());
+  bucket.clear ();
+}
+
+void
+MmWaveHarqTimerWheel::Clear (void)
+{
+  for (std::vector<std::vector<Timer> >::iterator it = m_buckets.begin (); it != m_buckets.end (); ++it)
+    {
+      it->clear ();
+    }
+  m_now = 0;
+}
+
+void
+MmWaveHarqTimerWheel::Grow (uint32_t delay)
+{
+  uint64_t size = m_buckets.size ();
+  while (size <= delay)
+    {
+      size *= 2;
+    }
+  NS_LOG_FUNCTION (this << delay << size);
+
+  std::vector<std::vector<Timer> > buckets (size);
+  for (std::vector<std::vector<Timer> >::iterator it = m_buckets.begin (); it != m_buckets.end (); ++it)
+    {
+      for (std::vector<Timer>::iterator timerIt = it->begin (); timerIt != it->end (); ++timerIt)
+        {
+          buckets[timerIt->m_expiry & (size - 1)].push_back (*timerIt);
+        }
+    }
+  m_buckets.swap (buckets);
+  m_mask = size - 1;
+}
+
+} // namespace mmwave
+
+} // namespace ns3
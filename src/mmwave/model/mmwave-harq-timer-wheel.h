@@ -0,0 +1,99 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_HARQ_TIMER_WHEEL_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_HARQ_TIMER_WHEEL_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * Timing wheel of the HARQ process timers of a MAC scheduler.
+ * The wheel counts the scheduler slots, and each timer is stored in the
+ * bucket of the slot in which it expires, so that advancing the wheel only
+ * visits the timers that actually expire. Timers are never cancelled: the
+ * owner records the expiry slot of the last timer started for each process,
+ * see Schedule, and ignores the expired timers which do not match it.
+ */
+class MmWaveHarqTimerWheel
+{
+public:
+  /**
+   * A HARQ process timer
+   */
+  struct Timer
+  {
+    uint64_t m_expiry; //!< the slot in which the timer expires
+    uint16_t m_rnti; //!< the RNTI of the UE
+    uint8_t m_harqId; //!< the HARQ process ID
+    bool m_uplink; //!< true for an UL HARQ process
+  };
+
+  /**
+   * Constructor
+   */
+  MmWaveHarqTimerWheel ();
+
+  /**
+   * \return the current slot
+   */
+  uint64_t GetNow (void) const;
+
+  /**
+   * Start a timer
+   * \param rnti the RNTI of the UE
+   * \param harqId the HARQ process ID
+   * \param uplink true for an UL HARQ process
+   * \param delay the number of slots after which the timer expires (at least 1)
+   * \return the slot in which the timer expires
+   */
+  uint64_t Schedule (uint16_t rnti, uint8_t harqId, bool uplink, uint32_t delay);
+
+  /**
+   * Move to the next slot
+   * \param expired the vector the timers expiring in the new slot are appended to
+   */
+  void Advance (std::vector<Timer> &expired);
+
+  /**
+   * Remove all the timers and restart from slot 0
+   */
+  void Clear (void);
+
+private:
+  /**
+   * Resize the wheel so that it can hold timers expiring up to delay slots from now
+   * \param delay the maximum delay
+   */
+  void Grow (uint32_t delay);
+
+  uint64_t m_now; //!< the current slot
+  uint64_t m_mask; //!< the number of buckets minus one (the number of buckets is a power of 2)
+  std::vector<std::vector<Timer> > m_buckets; //!< the timers, by expiry slot modulo the number of buckets
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_HARQ_TIMER_WHEEL_H_ */
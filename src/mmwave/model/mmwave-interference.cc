@@ -30,6 +30,7 @@
 #include "mmwave-interference.h"
 #include <ns3/simulator.h>
 #include <ns3/log.h>
+#include <ns3/perf-counters.h>
 #include "mmwave-chunk-processor.h"
 #include <stdio.h>
 
@@ -199,6 +200,7 @@ void
 mmWaveInterference::ConditionallyEvaluateChunk ()
 {
   NS_LOG_FUNCTION (this);
+  NS_PERF_TIMER ("mmwave", "mmWaveInterference::ConditionallyEvaluateChunk");
   if (m_receiving)
     {
       NS_LOG_DEBUG (this << " Receiving");
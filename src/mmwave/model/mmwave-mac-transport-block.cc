@@ -0,0 +1,55 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-mac-transport-block.h"
+#include <ns3/log.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveMacTransportBlock");
+
+namespace mmwave {
+
+MmWaveMacTransportBlock::MmWaveMacTransportBlock (Ptr<Packet> pdu, const std::vector<uint8_t> &lcidList)
+  : m_pdu (pdu),
+    m_lcidList (lcidList)
+{
+  NS_LOG_FUNCTION (this << pdu);
+}
+
+Ptr<Packet>
+MmWaveMacTransportBlock::GetPdu (void) const
+{
+  return m_pdu;
+}
+
+uint32_t
+MmWaveMacTransportBlock::GetSize (void) const
+{
+  return m_pdu->GetSize ();
+}
+
+const std::vector<uint8_t> &
+MmWaveMacTransportBlock::GetLcidList (void) const
+{
+  return m_lcidList;
+}
+
+} // namespace mmwave
+
+} // namespace ns3
@@ -0,0 +1,77 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_MAC_TRANSPORT_BLOCK_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_MAC_TRANSPORT_BLOCK_H_
+
+#include <ns3/packet.h>
+#include <ns3/simple-ref-count.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * Transport block held by a MAC HARQ process.
+ * The TB is built once, when the MAC PDU is complete, and is never modified
+ * afterwards: the first transmission and all the retransmissions hand the
+ * same PDU to the PHY, together with the frame, subframe, slot and first
+ * symbol of the transmission (see MmWavePhySapProvider::SendMacPdu), so that
+ * retransmissions do not copy the packet to update its MmWaveMacPduTag.
+ * The MmWaveMacPduTag of the PDU thus describes the first transmission only.
+ */
+class MmWaveMacTransportBlock : public SimpleRefCount<MmWaveMacTransportBlock>
+{
+public:
+  /**
+   * Constructor
+   * \param pdu the MAC PDU, with its header and tags
+   * \param lcidList the LCs of the RLC PDUs multiplexed in the MAC PDU
+   */
+  MmWaveMacTransportBlock (Ptr<Packet> pdu, const std::vector<uint8_t> &lcidList);
+
+  /**
+   * \return the MAC PDU. The PDU is shared by all the transmissions of the
+   *         TB, and must not be modified
+   */
+  Ptr<Packet> GetPdu (void) const;
+
+  /**
+   * \return the size of the MAC PDU, in bytes
+   */
+  uint32_t GetSize (void) const;
+
+  /**
+   * \return the LCs of the RLC PDUs multiplexed in the MAC PDU, used to
+   *         signal HARQ failures to the RLC
+   */
+  const std::vector<uint8_t> & GetLcidList (void) const;
+
+private:
+  Ptr<Packet> m_pdu; //!< the MAC PDU
+  std::vector<uint8_t> m_lcidList; //!< the LCs of the RLC PDUs
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_MAC_TRANSPORT_BLOCK_H_ */
@@ -81,6 +81,7 @@ struct MacPduInfo
   uint8_t m_numRlcPdu;
   Ptr<Packet> m_pdu;
   MmWaveMacPduHeader m_macHeader;
+  std::vector<uint8_t> m_lcidList;       // LCs of the RLC PDUs in this MAC PDU
 };
 
 class MmWaveMac : public Object
@@ -51,6 +51,16 @@ public:
 
   virtual void SendMacPdu (Ptr<Packet> p ) = 0;
 
+  /**
+   * Send a MAC PDU in the TTI starting at a given symbol of a given slot,
+   * regardless of the MmWaveMacPduTag of the PDU. This allows the MAC to
+   * retransmit the same PDU, without copying it to update its tag.
+   *
+   * \param p the MAC PDU
+   * \param sfn the frame, subframe, slot and first symbol of the transmission
+   */
+  virtual void SendMacPdu (Ptr<Packet> p, SfnSf sfn) = 0;
+
   virtual void SendControlMessage (Ptr<MmWaveControlMessage> msg) = 0;
 
   virtual void SendRachPreamble (uint8_t PreambleId, uint8_t Rnti) = 0;
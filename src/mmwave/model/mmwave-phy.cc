@@ -61,6 +61,8 @@ public:
 
   virtual void SendMacPdu (Ptr<Packet> p );
 
+  virtual void SendMacPdu (Ptr<Packet> p, SfnSf sfn);
+
   virtual void SendControlMessage (Ptr<MmWaveControlMessage> msg);
 
   virtual void SendRachPreamble (uint8_t PreambleId, uint8_t Rnti);
@@ -83,6 +85,12 @@ MmWaveMemberPhySapProvider::SendMacPdu (Ptr<Packet> p)
   m_phy->SetMacPdu (p);
 }
 
+void
+MmWaveMemberPhySapProvider::SendMacPdu (Ptr<Packet> p, SfnSf sfn)
+{
+  m_phy->SetMacPdu (p, sfn);
+}
+
 void
 MmWaveMemberPhySapProvider::SendControlMessage (Ptr<MmWaveControlMessage> msg)
 {
@@ -215,17 +223,7 @@ MmWavePhy::SetMacPdu (Ptr<Packet> p)
   MmWaveMacPduTag tag;
   if (p->PeekPacketTag (tag))
     {
-      NS_ASSERT ((tag.GetSfn ().m_sfNum >= 0) && (tag.GetSfn ().m_sfNum < m_phyMacConfig->GetSubframesPerFrame ()));
-      std::map<uint64_t, Ptr<PacketBurst> >::iterator it = m_packetBurstMap.find (tag.GetSfn ().Encode ());
-      if (it == m_packetBurstMap.end ())
-        {
-          it = m_packetBurstMap.insert (std::pair<uint64_t, Ptr<PacketBurst> > (tag.GetSfn ().Encode (), CreateObject<PacketBurst> ())).first;
-        }
-      else
-        {
-          NS_FATAL_ERROR ("Packet burst map entry already exists");
-        }
-      it->second->AddPacket (p);
+      SetMacPdu (p, tag.GetSfn ());
     }
   else
     {
@@ -233,23 +231,33 @@ MmWavePhy::SetMacPdu (Ptr<Packet> p)
     }
 }
 
-Ptr<PacketBurst>
-MmWavePhy::GetPacketBurst (SfnSf sfn)
+void
+MmWavePhy::SetMacPdu (Ptr<Packet> p, SfnSf sfn)
+{
+  NS_ASSERT ((sfn.m_sfNum >= 0) && (sfn.m_sfNum < m_phyMacConfig->GetSubframesPerFrame ()));
+  bool inserted = m_transportBlockMap.insert (std::make_pair (sfn.Encode (), TransportBlock (p))).second;
+  if (!inserted)
+    {
+      NS_FATAL_ERROR ("Transport block map entry already exists");
+    }
+}
+
+TransportBlock
+MmWavePhy::GetTransportBlock (SfnSf sfn)
 {
-  Ptr<PacketBurst> pburst;
-  std::map<uint64_t, Ptr<PacketBurst> >::iterator it = m_packetBurstMap.find (sfn.Encode ());
-  if (it == m_packetBurstMap.end ())
+  TransportBlock tb;
+  std::map<uint64_t, TransportBlock>::iterator it = m_transportBlockMap.find (sfn.Encode ());
+  if (it == m_transportBlockMap.end ())
     {
-      NS_LOG_ERROR ("GetPacketBurst(): Packet burst not found for frame " << (unsigned)sfn.m_frameNum << " subframe "
-                                                                          << (unsigned)sfn.m_sfNum << " slot " << (unsigned)sfn.m_slotNum << "sym start " << (unsigned)sfn.m_symStart);
-      return pburst;
+      NS_LOG_ERROR ("GetTransportBlock(): Transport block not found for frame " << (unsigned)sfn.m_frameNum << " subframe "
+                                                                                << (unsigned)sfn.m_sfNum << " slot " << (unsigned)sfn.m_slotNum << "sym start " << (unsigned)sfn.m_symStart);
     }
   else
     {
-      pburst = it->second;
-      m_packetBurstMap.erase (it);
+      tb = std::move (it->second);
+      m_transportBlockMap.erase (it);
     }
-  return pburst;
+  return tb;
 }
 
 void
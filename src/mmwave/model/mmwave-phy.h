@@ -51,6 +51,7 @@
 #include "mmwave-spectrum-phy.h"
 #include "mmwave-net-device.h"
 #include "mmwave-phy-sap.h"
+#include "mmwave-transport-block.h"
 #include <string>
 #include <map>
 
@@ -111,11 +112,24 @@ public:
 
   virtual void SetMacPdu (Ptr<Packet> pb);
 
+  /**
+   * Queue a MAC PDU for the TTI starting at a given symbol of a given slot
+   *
+   * \param pb the MAC PDU
+   * \param sfn the frame, subframe, slot and first symbol of the TTI
+   */
+  virtual void SetMacPdu (Ptr<Packet> pb, SfnSf sfn);
+
   virtual void SendRachPreamble (uint32_t PreambleId, uint32_t Rnti);
 
 
-//	virtual Ptr<PacketBurst> GetPacketBurst (void);
-  virtual Ptr<PacketBurst> GetPacketBurst (SfnSf);
+  /**
+   * Take the TB queued for the TTI starting at a given symbol of a given slot
+   *
+   * \param sfn the frame, subframe, slot and first symbol of the TTI
+   * \return the TB, empty if no MAC PDU was queued
+   */
+  virtual TransportBlock GetTransportBlock (SfnSf sfn);
 
   void SetConfigurationParameters (Ptr<MmWavePhyMacCommon> ptrConfig);
   Ptr<MmWavePhyMacCommon> GetConfigurationParameters (void) const;
@@ -169,7 +183,7 @@ protected:
 
   Ptr<MmWavePhyMacCommon> m_phyMacConfig;
 
-  std::map<uint64_t, Ptr<PacketBurst> > m_packetBurstMap;
+  std::map<uint64_t, TransportBlock> m_transportBlockMap;
   std::vector< std::list<Ptr<MmWaveControlMessage> > > m_controlMessageQueue;
 
   std::vector <SlotAllocInfo> m_slotAllocInfo;  //!< Maps slot number to its allocation info
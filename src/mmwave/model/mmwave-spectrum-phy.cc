@@ -55,8 +55,8 @@
 #include <stdio.h>
 #include <ns3/double.h>
 #include <ns3/mmwave-lte-mi-error-model.h>
-#include "mmwave-mac-pdu-tag.h"
 #include <ns3/three-gpp-antenna-array-model.h>
+#include <ns3/perf-counters.h>
 
 namespace ns3 {
 
@@ -137,8 +137,7 @@ MmWaveSpectrumPhy::Reset ()
   m_endRxDlCtrlEvent.Cancel ();
   m_rxControlMessageList.clear ();
   m_transportBlocks.clear ();
-  m_rxPacketBurstList.clear ();
-  //m_txPacketBurst = 0;
+  m_rxTransportBlockList.clear ();
   //m_rxSpectrumModel = 0;
 }
 
@@ -266,7 +265,7 @@ MmWaveSpectrumPhy::SetPhyRxCtrlEndOkCallback (MmWavePhyRxCtrlEndOkCallback c)
 void
 MmWaveSpectrumPhy::AddExpectedTb (uint16_t rnti, uint8_t ndi, uint32_t tbSize, uint8_t mcs,
                                   std::vector<int> chunkMap, uint8_t harqId, uint8_t rv, bool downlink,
-                                  uint8_t symStart, uint8_t numSym)
+                                  SfnSf sfn, uint8_t numSym)
 {
   auto it = m_transportBlocks.find (rnti);
   if (it != m_transportBlocks.end ())
@@ -275,7 +274,7 @@ MmWaveSpectrumPhy::AddExpectedTb (uint16_t rnti, uint8_t ndi, uint32_t tbSize, u
     }
   // insert new entry
   //ExpectedTbInfo_t tbInfo = {ndi, tbSize, mcs, chunkMap, harqId, rv, 0.0, downlink, false, false, 0};
-  ExpectedTb expTbInfo {ndi, tbSize, mcs, chunkMap, harqId, rv, downlink, symStart, numSym};
+  ExpectedTb expTbInfo {ndi, tbSize, mcs, chunkMap, harqId, rv, downlink, sfn, numSym};
   m_transportBlocks.emplace (std::make_pair(rnti, TransportBlockInfo (expTbInfo)));
 }
 
@@ -422,7 +421,7 @@ MmWaveSpectrumPhy::StartRxData (Ptr<MmwaveSpectrumSignalParametersDataFrame> par
           // this is a useful signal
           m_interferenceData->StartRx (params->psd);
 
-          if (m_rxPacketBurstList.empty ())
+          if (m_rxTransportBlockList.empty ())
             {
               NS_ASSERT (m_state == IDLE);
               // first transmission, i.e., we're IDLE and we start RX
@@ -445,14 +444,14 @@ MmWaveSpectrumPhy::StartRxData (Ptr<MmwaveSpectrumSignalParametersDataFrame> par
             }
 
 
-          if (params->packetBurst && !params->packetBurst->GetPackets ().empty ())
+          if (!params->transportBlock.IsEmpty ())
             {
-              m_rxPacketBurstList.push_back (params->packetBurst);
+              m_rxTransportBlockList.push_back (params->transportBlock);
             }
 
           m_rxControlMessageList.insert (m_rxControlMessageList.end (), params->ctrlMsgList.begin (), params->ctrlMsgList.end ());
 
-          NS_LOG_LOGIC (this << " numSimultaneousRxEvents = " << m_rxPacketBurstList.size ());
+          NS_LOG_LOGIC (this << " numSimultaneousRxEvents = " << m_rxTransportBlockList.size ());
         }
         break;
 
@@ -539,6 +538,7 @@ MmWaveSpectrumPhy::StartRxCtrl (Ptr<MmWaveSpectrumSignalParametersDlCtrlFrame> d
 void
 MmWaveSpectrumPhy::EndRxData ()
 {
+  NS_PERF_TIMER ("mmwave", "MmWaveSpectrumPhy::EndRxData");
   NS_ASSERT (m_state = RX_DATA);
 
   m_interferenceData->EndRx (); // trigger the SINR computation
@@ -556,7 +556,7 @@ MmWaveSpectrumPhy::EndRxData ()
                     ", Avg SINR dB=" << 10*std::log10(itTb->second.m_sinrAvg) <<
                     ", GetNumBands=" << m_sinrPerceived.GetSpectrumModel ()->GetNumBands ());
 
-      if ((m_dataErrorModelEnabled) && (m_rxPacketBurstList.size () > 0))
+      if ((m_dataErrorModelEnabled) && (m_rxTransportBlockList.size () > 0))
         {
           // Retrieve HARQ history
           std::function <const MmWaveErrorModel::MmWaveErrorModelHistory & (uint16_t, uint8_t)> RetrieveHistory;
@@ -606,10 +606,11 @@ MmWaveSpectrumPhy::EndRxData ()
 
   // fire the traces and send the ACKs/NACKs
   std::map <uint16_t, DlHarqInfo> harqDlInfoMap;
-  for (auto packetBurst : m_rxPacketBurstList)
+  for (const TransportBlock &tb : m_rxTransportBlockList)
     {
-      for (auto packet : packetBurst->GetPackets ())
+      for (TransportBlock::Iterator it = tb.Begin (); it != tb.End (); ++it)
         {
+          const Ptr<Packet> &packet = *it;
           if (packet->GetSize () == 0)
             {
               continue;
@@ -626,25 +627,21 @@ MmWaveSpectrumPhy::EndRxData ()
             {
               if (!itTb->second.m_isCorrupted)
                 {
-                  m_phyRxDataEndOkCallback (packet);
+                  // the packet is shared with the other receivers of the TB
+                  m_phyRxDataEndOkCallback (packet->Copy ());
                 }
               else
                 {
                   NS_LOG_INFO ("TB failed");
                 }
 
-              MmWaveMacPduTag pduTag;
-              if (packet->PeekPacketTag (pduTag) == false)
-                {
-                  NS_FATAL_ERROR ("No radio bearer tag found");
-                }
-
               RxPacketTraceParams traceParams;
               traceParams.m_tbSize = itTb->second.m_expected.m_tbSize;
               traceParams.m_cellId = m_cellId;
-              traceParams.m_frameNum = pduTag.GetSfn ().m_frameNum;
-              traceParams.m_sfNum = pduTag.GetSfn ().m_sfNum;
-              traceParams.m_slotNum = pduTag.GetSfn ().m_slotNum;
+              // the MAC PDU tag of a retransmitted PDU refers to its first transmission
+              traceParams.m_frameNum = itTb->second.m_expected.m_sfn.m_frameNum;
+              traceParams.m_sfNum = itTb->second.m_expected.m_sfn.m_sfNum;
+              traceParams.m_slotNum = itTb->second.m_expected.m_sfn.m_slotNum;
               traceParams.m_rnti = rnti;
               traceParams.m_mcs = itTb->second.m_expected.m_mcs;
               traceParams.m_rv = itTb->second.m_expected.m_rv;
@@ -794,7 +791,7 @@ MmWaveSpectrumPhy::EndRxData ()
     }
 
   ChangeState (IDLE);
-  m_rxPacketBurstList.clear ();
+  m_rxTransportBlockList.clear ();
   m_transportBlocks.clear ();
   m_rxControlMessageList.clear ();
 }
@@ -819,7 +816,7 @@ MmWaveSpectrumPhy::EndRxCtrl ()
 }
 
 bool
-MmWaveSpectrumPhy::StartTxDataFrames (Ptr<PacketBurst> pb, std::list<Ptr<MmWaveControlMessage> > ctrlMsgList, Time duration, uint8_t slotInd)
+MmWaveSpectrumPhy::StartTxDataFrames (TransportBlock tb, std::list<Ptr<MmWaveControlMessage> > ctrlMsgList, Time duration, uint8_t slotInd)
 {
   switch (m_state)
     {
@@ -839,7 +836,7 @@ MmWaveSpectrumPhy::StartTxDataFrames (Ptr<PacketBurst> pb, std::list<Ptr<MmWaveC
           txParams->duration = duration;
           txParams->txPhy = this->GetObject<SpectrumPhy> ();
           txParams->psd = m_txPsd;
-          txParams->packetBurst = pb;
+          txParams->transportBlock = std::move (tb);
           txParams->cellId = m_cellId;
           txParams->ctrlMsgList = ctrlMsgList;
           txParams->slotInd = slotInd;
@@ -52,7 +52,7 @@
 #include <ns3/spectrum-interference.h>
 #include <ns3/data-rate.h>
 #include <ns3/generic-phy.h>
-#include <ns3/packet-burst.h>
+#include "mmwave-transport-block.h"
 #include "mmwave-spectrum-signal-parameters.h"
 #include "ns3/random-variable-stream.h"
 #include "mmwave-interference.h"
@@ -74,7 +74,7 @@ namespace mmwave {
   struct ExpectedTb
   {
     ExpectedTb (uint8_t ndi, uint32_t tbSize, uint8_t mcs, const std::vector<int> &rbBitmap,
-                uint8_t harqProcessId, uint8_t rv, bool isDownlink, uint8_t symStart,
+                uint8_t harqProcessId, uint8_t rv, bool isDownlink, SfnSf sfn,
                 uint8_t numSym) :
       m_ndi (ndi),
       m_tbSize (tbSize),
@@ -83,8 +83,9 @@ namespace mmwave {
       m_harqProcessId (harqProcessId),
       m_rv (rv),
       m_isDownlink (isDownlink),
-      m_symStart (symStart),
-      m_numSym (numSym) {}
+      m_symStart (sfn.m_symStart),
+      m_numSym (numSym),
+      m_sfn (sfn) {}
       
     ExpectedTb () = delete;
     ExpectedTb (const ExpectedTb &o) = default;
@@ -98,6 +99,7 @@ namespace mmwave {
     bool m_isDownlink           {0}; //!< is Downlink?
     uint8_t m_symStart          {0}; //!< Sym start
     uint8_t m_numSym            {0}; //!< Num sym
+    SfnSf m_sfn;                     //!< Frame, subframe, slot and sym start
   };
 
   struct TransportBlockInfo
@@ -215,7 +217,7 @@ public:
   void SetComponentCarrierId (uint8_t componentCarrierId);
 
 
-  bool StartTxDataFrames (Ptr<PacketBurst> pb, std::list<Ptr<MmWaveControlMessage> > ctrlMsgList, Time duration, uint8_t slotInd);
+  bool StartTxDataFrames (TransportBlock tb, std::list<Ptr<MmWaveControlMessage> > ctrlMsgList, Time duration, uint8_t slotInd);
 
   bool StartTxDlControlFrames (std::list<Ptr<MmWaveControlMessage> > ctrlMsgList, Time duration);       // control frames from enb to ue
   bool StartTxUlControlFrames (void);       // control frames from ue to enb
@@ -241,11 +243,11 @@ public:
    * \param harqId the ID of the HARQ process
    * \param rv the number of retransmissions
    * \param downlink a boolean flag for a downlink transmission
-   * \param symStart the first symbol of this TB
+   * \param sfn the frame, subframe, slot and first symbol of this TB
    * \param numSym the number of symbols of the TB
    */
   void AddExpectedTb (uint16_t rnti, uint8_t ndi, uint32_t tbSize, uint8_t mcs, std::vector<int> map, uint8_t harqId,
-                      uint8_t rv, bool downlink, uint8_t symStart, uint8_t numSym);
+                      uint8_t rv, bool downlink, SfnSf sfn, uint8_t numSym);
 
   void SetHarqPhyModule (Ptr<MmWaveHarqPhy> harq);
 
@@ -273,8 +275,7 @@ private:
   Ptr<SpectrumChannel> m_channel;
   Ptr<const SpectrumModel> m_rxSpectrumModel;
   Ptr<SpectrumValue> m_txPsd;
-  //Ptr<PacketBurst> m_txPacketBurst;
-  std::list<Ptr<PacketBurst> > m_rxPacketBurstList;
+  std::vector<TransportBlock> m_rxTransportBlockList;
   std::list<Ptr<MmWaveControlMessage> > m_rxControlMessageList;
 
   Time m_firstRxStart;
@@ -78,10 +78,7 @@ MmwaveSpectrumSignalParametersDataFrame::MmwaveSpectrumSignalParametersDataFrame
 {
   NS_LOG_FUNCTION (this << &p);
   cellId = p.cellId;
-  if (p.packetBurst)
-    {
-      packetBurst = p.packetBurst->Copy ();
-    }
+  transportBlock = p.transportBlock;
   ctrlMsgList = p.ctrlMsgList;
   slotInd = p.slotInd;
 }
@@ -31,6 +31,7 @@
 
 
 #include <ns3/spectrum-signal-parameters.h>
+#include "mmwave-transport-block.h"
 
 namespace ns3 {
 
@@ -83,7 +84,11 @@ struct MmwaveSpectrumSignalParametersDataFrame : public SpectrumSignalParameters
   */
   MmwaveSpectrumSignalParametersDataFrame (const MmwaveSpectrumSignalParametersDataFrame& p);
 
-  Ptr<PacketBurst> packetBurst;
+  /**
+   * The transmitted TB; its packets are shared by the copies of the
+   * parameters delivered to each receiver, and must not be modified
+   */
+  TransportBlock transportBlock;
 
   std::list<Ptr<MmWaveControlMessage> > ctrlMsgList;
 
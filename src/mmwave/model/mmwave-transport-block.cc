@@ -0,0 +1,154 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-transport-block.h"
+
+namespace ns3 {
+
+namespace mmwave {
+
+const uint32_t TransportBlock::INLINE_PACKETS;
+
+TransportBlock::TransportBlock ()
+  : m_nPackets (0)
+{
+}
+
+TransportBlock::TransportBlock (Ptr<Packet> packet)
+  : m_nPackets (1)
+{
+  m_inline[0] = packet;
+}
+
+TransportBlock::TransportBlock (Ptr<const PacketBurst> burst)
+  : m_nPackets (0)
+{
+  if (burst)
+    {
+      for (std::list<Ptr<Packet> >::const_iterator it = burst->Begin (); it != burst->End (); ++it)
+        {
+          AddPacket (*it);
+        }
+    }
+}
+
+TransportBlock::TransportBlock (const TransportBlock &o)
+  : m_packets (o.m_packets),
+    m_nPackets (o.m_nPackets)
+{
+  for (uint32_t i = 0; i < INLINE_PACKETS; i++)
+    {
+      m_inline[i] = o.m_inline[i];
+    }
+}
+
+TransportBlock::TransportBlock (TransportBlock &&o)
+  : m_packets (std::move (o.m_packets)),
+    m_nPackets (o.m_nPackets)
+{
+  for (uint32_t i = 0; i < INLINE_PACKETS; i++)
+    {
+      m_inline[i] = o.m_inline[i];
+      o.m_inline[i] = 0;
+    }
+  o.m_packets.clear ();
+  o.m_nPackets = 0;
+}
+
+TransportBlock &
+TransportBlock::operator= (const TransportBlock &o)
+{
+  if (this != &o)
+    {
+      for (uint32_t i = 0; i < INLINE_PACKETS; i++)
+        {
+          m_inline[i] = o.m_inline[i];
+        }
+      m_packets = o.m_packets;
+      m_nPackets = o.m_nPackets;
+    }
+  return *this;
+}
+
+TransportBlock &
+TransportBlock::operator= (TransportBlock &&o)
+{
+  if (this != &o)
+    {
+      for (uint32_t i = 0; i < INLINE_PACKETS; i++)
+        {
+          m_inline[i] = o.m_inline[i];
+          o.m_inline[i] = 0;
+        }
+      m_packets = std::move (o.m_packets);
+      m_nPackets = o.m_nPackets;
+      o.m_packets.clear ();
+      o.m_nPackets = 0;
+    }
+  return *this;
+}
+
+void
+TransportBlock::AddPacket (Ptr<Packet> packet)
+{
+  if (m_nPackets < INLINE_PACKETS)
+    {
+      m_inline[m_nPackets] = packet;
+    }
+  else
+    {
+      if (m_nPackets == INLINE_PACKETS)
+        {
+          // move the inline packets to the vector
+          m_packets.reserve (2 * INLINE_PACKETS);
+          for (uint32_t i = 0; i < INLINE_PACKETS; i++)
+            {
+              m_packets.push_back (m_inline[i]);
+              m_inline[i] = 0;
+            }
+        }
+      m_packets.push_back (packet);
+    }
+  m_nPackets++;
+}
+
+uint32_t
+TransportBlock::GetSize (void) const
+{
+  uint32_t size = 0;
+  for (Iterator it = Begin (); it != End (); ++it)
+    {
+      size += (*it)->GetSize ();
+    }
+  return size;
+}
+
+Ptr<PacketBurst>
+TransportBlock::ToPacketBurst (void) const
+{
+  Ptr<PacketBurst> burst = CreateObject<PacketBurst> ();
+  for (Iterator it = Begin (); it != End (); ++it)
+    {
+      burst->AddPacket (*it);
+    }
+  return burst;
+}
+
+} // namespace mmwave
+
+} // namespace ns3
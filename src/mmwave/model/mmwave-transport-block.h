@@ -0,0 +1,155 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_TRANSPORT_BLOCK_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_TRANSPORT_BLOCK_H_
+
+#include <ns3/packet.h>
+#include <ns3/packet-burst.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * Packets of a transport block, as they are passed along the PHY.
+ * This is a value type which replaces PacketBurst on the PHY paths: it is
+ * not an Object, and it holds the first packets inline, so that the usual
+ * TB with a single MAC PDU does not allocate. It can be moved, and copying
+ * it only copies the pointers to the packets.
+ *
+ * The packets are shared by all the copies of the TB, in particular by the
+ * signal parameters delivered to each receiver, and must not be modified:
+ * a receiver must copy a packet before handing it over to the upper layers.
+ * A PacketBurst can be converted to and from a TransportBlock, e.g., for the
+ * code and traces which still use PacketBurst.
+ */
+class TransportBlock
+{
+public:
+  /// Iterator over the packets
+  typedef const Ptr<Packet> * Iterator;
+
+  /**
+   * Create an empty TB
+   */
+  TransportBlock ();
+  /**
+   * Create a TB with a single packet
+   * \param packet the packet
+   */
+  TransportBlock (Ptr<Packet> packet);
+  /**
+   * Create a TB with the packets of a burst
+   * \param burst the burst, or 0 for an empty TB
+   */
+  TransportBlock (Ptr<const PacketBurst> burst);
+  /**
+   * Copy constructor, the packets are shared
+   * \param o the TB to copy
+   */
+  TransportBlock (const TransportBlock &o);
+  /**
+   * Move constructor, \p o is left empty
+   * \param o the TB to move
+   */
+  TransportBlock (TransportBlock &&o);
+  /**
+   * Copy assignment, the packets are shared
+   * \param o the TB to copy
+   * \return this TB
+   */
+  TransportBlock & operator= (const TransportBlock &o);
+  /**
+   * Move assignment, \p o is left empty
+   * \param o the TB to move
+   * \return this TB
+   */
+  TransportBlock & operator= (TransportBlock &&o);
+
+  /**
+   * Add a packet at the end of the TB
+   * \param packet the packet
+   */
+  void AddPacket (Ptr<Packet> packet);
+  /**
+   * \return the number of packets
+   */
+  uint32_t GetNPackets (void) const;
+  /**
+   * \return true if the TB has no packets
+   */
+  bool IsEmpty (void) const;
+  /**
+   * \return the sum of the sizes of the packets, in bytes
+   */
+  uint32_t GetSize (void) const;
+  /**
+   * \return an iterator to the first packet
+   */
+  Iterator Begin (void) const;
+  /**
+   * \return an iterator past the last packet
+   */
+  Iterator End (void) const;
+  /**
+   * \return a new burst, with the packets of the TB
+   */
+  Ptr<PacketBurst> ToPacketBurst (void) const;
+
+private:
+  /// Number of packets held inline
+  static const uint32_t INLINE_PACKETS = 2;
+
+  Ptr<Packet> m_inline[INLINE_PACKETS]; //!< the packets, if there are at most INLINE_PACKETS
+  std::vector<Ptr<Packet> > m_packets; //!< the packets, if there are more than INLINE_PACKETS
+  uint32_t m_nPackets; //!< the number of packets
+};
+
+inline uint32_t
+TransportBlock::GetNPackets (void) const
+{
+  return m_nPackets;
+}
+
+inline bool
+TransportBlock::IsEmpty (void) const
+{
+  return m_nPackets == 0;
+}
+
+inline TransportBlock::Iterator
+TransportBlock::Begin (void) const
+{
+  return m_nPackets <= INLINE_PACKETS ? m_inline : m_packets.data ();
+}
+
+inline TransportBlock::Iterator
+TransportBlock::End (void) const
+{
+  return Begin () + m_nPackets;
+}
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_TRANSPORT_BLOCK_H_ */
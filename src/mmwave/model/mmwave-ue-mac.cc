@@ -285,11 +285,6 @@ MmWaveUeMac::SetConfigurationParameters (Ptr<MmWavePhyMacCommon> ptrConfig)
 
   m_miUlHarqProcessesPacket.clear ();
   m_miUlHarqProcessesPacket.resize (m_phyMacConfig->GetNumHarqProcess ());
-  for (uint8_t i = 0; i < m_miUlHarqProcessesPacket.size (); i++)
-    {
-      Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
-      m_miUlHarqProcessesPacket.at (i).m_pktBurst = pb;
-    }
   m_miUlHarqProcessesPacketTimer.clear ();
   m_miUlHarqProcessesPacketTimer.resize (m_phyMacConfig->GetNumHarqProcess (), 0);
 
@@ -317,9 +312,7 @@ MmWaveUeMac::DoTransmitPdu (LteMacSapProvider::TransmitPduParameters params)
     }
   else
     {
-      MmWaveMacPduTag tag;
-      it->second.m_pdu->PeekPacketTag (tag);
-      if (tag.GetSfn ().m_frameNum < m_frameNum)
+      if (it->second.m_sfnSf.m_frameNum < m_frameNum)
         {
           return;
         }
@@ -334,7 +327,7 @@ MmWaveUeMac::DoTransmitPdu (LteMacSapProvider::TransmitPduParameters params)
 
       MacSubheader subheader (params.lcid, params.pdu->GetSize ());
       it->second.m_macHeader.AddSubheader (subheader);           // add RLC PDU sub-header into MAC header
-      m_miUlHarqProcessesPacket.at (params.harqProcessId).m_lcidList.push_back (params.lcid);
+      it->second.m_lcidList.push_back (params.lcid);
       if (it->second.m_size <
           (params.pdu->GetSize () + it->second.m_macHeader.GetSerializedSize ()))
         {
@@ -355,13 +348,13 @@ MmWaveUeMac::DoTransmitPdu (LteMacSapProvider::TransmitPduParameters params)
 
           LteRadioBearerTag bearerTag (params.rnti, 0, 0);
           it->second.m_pdu->AddPacketTag (bearerTag);
-          m_miUlHarqProcessesPacket.at (params.harqProcessId).m_pktBurst->AddPacket (it->second.m_pdu);
+          m_miUlHarqProcessesPacket.at (params.harqProcessId).m_tb = Create<MmWaveMacTransportBlock> (it->second.m_pdu, it->second.m_lcidList);
           m_miUlHarqProcessesPacketTimer.at (params.harqProcessId) = m_phyMacConfig->GetHarqTimeout ();
           //m_harqProcessId = (m_harqProcessId + 1) % m_phyMacConfig->GetHarqTimeout();
 
           m_txMacPacketTraceUe (params.rnti, m_componentCarrierId, it->second.m_pdu->GetSize ());
 
-          m_phySapProvider->SendMacPdu (it->second.m_pdu);
+          m_phySapProvider->SendMacPdu (it->second.m_pdu, it->second.m_sfnSf);
           m_macPduMap.erase (it);                // delete map entry
         }
       else
@@ -485,13 +478,11 @@ MmWaveUeMac::RefreshHarqProcessesPacketBuffer (void)
     {
       if (m_miUlHarqProcessesPacketTimer.at (i) == 0)
         {
-          if (m_miUlHarqProcessesPacket.at (i).m_pktBurst->GetSize () > 0)
+          if (m_miUlHarqProcessesPacket.at (i).m_tb)
             {
               // timer expired: drop packets in buffer for this process
               NS_LOG_INFO (this << " HARQ Proc Id " << i << " packets buffer expired");
-              Ptr<PacketBurst> emptyPb = CreateObject <PacketBurst> ();
-              m_miUlHarqProcessesPacket.at (i).m_pktBurst = emptyPb;
-              m_miUlHarqProcessesPacket.at (i).m_lcidList.clear ();
+              m_miUlHarqProcessesPacket.at (i).m_tb = 0;
             }
         }
       else
@@ -592,9 +583,9 @@ MmWaveUeMac::DoReceivePhyPdu (Ptr<Packet> p)
 //MmWaveUeMac::DoNotifyHarqDeliveryFailure (uint8_t harqId)
 //{
 //  NS_LOG_FUNCTION (this);
-//  for (unsigned i = 0; i < m_miUlHarqProcessesPacket.at (harqId).m_lcidList.size (); i++)
+//  for (unsigned i = 0; i < m_miUlHarqProcessesPacket.at (harqId).m_tb->GetLcidList ().size (); i++)
 //  {
-//      uint8_t lcid = m_miUlHarqProcessesPacket.at (harqId).m_lcidList[i];
+//      uint8_t lcid = m_miUlHarqProcessesPacket.at (harqId).m_tb->GetLcidList ()[i];
 //      std::map <uint8_t, LcInfo>::const_iterator it = m_lcInfoMap.find (lcid);
 //      NS_ASSERT_MSG (it != m_lcInfoMap.end (), "received packet with unknown lcid");
 //      it->second.macSapUser->NotifyHarqDeliveryFailure (harqId);
@@ -668,9 +659,7 @@ MmWaveUeMac::DoReceiveControlMessage  (Ptr<MmWaveControlMessage> msg)
             if (dciInfoElem.m_ndi == 1)
               {
                 // New transmission -> empty pkt buffer queue (for deleting eventual pkts not acked )
-                Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
-                m_miUlHarqProcessesPacket.at (dciInfoElem.m_harqProcess).m_pktBurst = pb;
-                m_miUlHarqProcessesPacket.at (dciInfoElem.m_harqProcess).m_lcidList.clear ();
+                m_miUlHarqProcessesPacket.at (dciInfoElem.m_harqProcess).m_tb = 0;
                 // Retrieve data from RLC
                 std::map <uint8_t, LteMacSapProvider::ReportBufferStatusParameters>::iterator itBsr;
                 uint16_t activeLcs = 0;
@@ -707,7 +696,8 @@ MmWaveUeMac::DoReceiveControlMessage  (Ptr<MmWaveControlMessage> msg)
                     NS_ASSERT ((slotNum < m_phyMacConfig->GetSlotsPerSubframe ()) && (sfNum < m_phyMacConfig->GetSubframesPerFrame ())
                                 && (deltaSubframe >= 0) && (slotNum >= 0) && (sfNum >= 0) && (frameNum >= m_frameNum));
 
-                    MmWaveMacPduTag tag (SfnSf (frameNum, sfNum, slotNum, dciInfoElem.m_symStart));
+                    SfnSf pduSfn (frameNum, sfNum, slotNum, dciInfoElem.m_symStart);
+                    MmWaveMacPduTag tag (pduSfn);
                     Ptr<Packet> emptyPdu = Create <Packet> ();
                     MmWaveMacPduHeader header;
                     MacSubheader subheader (3, 0);                      // lcid = 3, size = 0
@@ -716,10 +706,10 @@ MmWaveUeMac::DoReceiveControlMessage  (Ptr<MmWaveControlMessage> msg)
                     emptyPdu->AddPacketTag (tag);
                     LteRadioBearerTag bearerTag (dciInfoElem.m_rnti, 3, 0);
                     emptyPdu->AddPacketTag (bearerTag);
-                    m_miUlHarqProcessesPacket.at (dciInfoElem.m_harqProcess).m_pktBurst->AddPacket (emptyPdu);
+                    m_miUlHarqProcessesPacket.at (dciInfoElem.m_harqProcess).m_tb = Create<MmWaveMacTransportBlock> (emptyPdu, std::vector<uint8_t> ());
                     m_miUlHarqProcessesPacketTimer.at (dciInfoElem.m_harqProcess) = m_phyMacConfig->GetHarqTimeout ();
                     //m_harqProcessId = (m_harqProcessId + 1) % m_phyMacConfig->GetHarqTimeout();
-                    m_phySapProvider->SendMacPdu (emptyPdu);
+                    m_phySapProvider->SendMacPdu (emptyPdu, pduSfn);
                     return;
                   }
 
@@ -876,21 +866,9 @@ MmWaveUeMac::DoReceiveControlMessage  (Ptr<MmWaveControlMessage> msg)
               {
                 // HARQ retransmission -> retrieve data from HARQ buffer
                 NS_LOG_DEBUG (this << " UE MAC RETX HARQ " << (unsigned)dciInfoElem.m_harqProcess);
-                Ptr<PacketBurst> pb = m_miUlHarqProcessesPacket.at (dciInfoElem.m_harqProcess).m_pktBurst;
-                for (std::list<Ptr<Packet> >::const_iterator j = pb->Begin (); j != pb->End (); ++j)
+                Ptr<const MmWaveMacTransportBlock> tb = m_miUlHarqProcessesPacket.at (dciInfoElem.m_harqProcess).m_tb;
+                if (tb)
                   {
-                    Ptr<Packet> pkt = (*j)->Copy ();
-                    // update packet tag
-                    MmWaveMacPduTag tag;
-                    if (!pkt->RemovePacketTag (tag))
-                      {
-                        NS_FATAL_ERROR ("No MAC PDU tag");
-                      }
-                    LteRadioBearerTag bearerTag;
-                    if (!pkt->PeekPacketTag (bearerTag))
-                      {
-                        NS_FATAL_ERROR ("No radio bearer tag");
-                      }
                     uint8_t slotNum = (m_slotNum + m_phyMacConfig->GetUlSchedDelay ()) % m_phyMacConfig->GetSlotsPerSubframe ();
                     uint8_t deltaSubframe = (m_slotNum + m_phyMacConfig->GetUlSchedDelay ()) / m_phyMacConfig->GetSlotsPerSubframe ();
                     uint8_t sfNum = (m_sfNum + deltaSubframe) % m_phyMacConfig->GetSubframesPerFrame ();
@@ -899,11 +877,9 @@ MmWaveUeMac::DoReceiveControlMessage  (Ptr<MmWaveControlMessage> msg)
                     NS_ASSERT ((slotNum < m_phyMacConfig->GetSlotsPerSubframe ()) && (sfNum < m_phyMacConfig->GetSubframesPerFrame ())
                                 && (deltaSubframe >= 0) && (slotNum >= 0) && (sfNum >= 0) && (frameNum >= m_frameNum));
 
-                    tag.SetSfn (SfnSf (frameNum, sfNum, slotNum, dciInfoElem.m_symStart));
-                    pkt->AddPacketTag (tag);
-
-                    m_txMacPacketTraceUe (m_rnti, m_componentCarrierId, pkt->GetSize ());
-                    m_phySapProvider->SendMacPdu (pkt);
+                    // send the same PDU again, in the TTI of the retransmission
+                    m_txMacPacketTraceUe (m_rnti, m_componentCarrierId, tb->GetSize ());
+                    m_phySapProvider->SendMacPdu (tb->GetPdu (), SfnSf (frameNum, sfNum, slotNum, dciInfoElem.m_symStart));
                   }
                 m_miUlHarqProcessesPacketTimer.at (dciInfoElem.m_harqProcess) = m_phyMacConfig->GetHarqTimeout ();
               }
@@ -38,6 +38,7 @@
 #define SRC_MMWAVE_MODEL_MMWAVE_UE_MAC_H_
 
 #include "mmwave-mac.h"
+#include "mmwave-mac-transport-block.h"
 #include <ns3/lte-ue-cmac-sap.h>
 #include <ns3/lte-mac-sap.h>
 #include <ns3/lte-radio-bearer-tag.h>
@@ -148,10 +149,10 @@ private:
 
   struct UlHarqProcessInfo
   {
-    Ptr<PacketBurst> m_pktBurst;
-    // maintain list of LCs contained in this TB
-    // used to signal HARQ failure to RLC handlers
-    std::vector<uint8_t> m_lcidList;
+    // TB under transmission, null if the process is idle; it is shared
+    // by the transmission and the retransmissions of the TB, and holds
+    // the list of LCs used to signal HARQ failure to RLC handlers
+    Ptr<const MmWaveMacTransportBlock> m_tb;
   };
 
   //uint8_t m_harqProcessId;
@@ -584,7 +584,7 @@ MmWaveUePhy::StartTti ()
       currTtiDuration = currTti.m_dci.m_numSym * m_phyMacConfig->GetSymbolPeriod ();
       m_downlinkSpectrumPhy->AddExpectedTb (currTti.m_dci.m_rnti, currTti.m_dci.m_ndi, currTti.m_dci.m_tbSize, currTti.m_dci.m_mcs,
                                             m_channelChunks, currTti.m_dci.m_harqProcess, currTti.m_dci.m_rv, true,
-                                            currTti.m_dci.m_symStart, currTti.m_dci.m_numSym);
+                                            SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart), currTti.m_dci.m_numSym);
       m_reportDlTbSize (m_imsi, currTti.m_dci.m_tbSize);
       NS_LOG_DEBUG ("UE" << m_rnti << " imsi" << m_imsi << " RXing DL DATA frame " << m_frameNum << " subframe " << (unsigned)m_sfNum << " symbols "
                          << (unsigned)currTti.m_dci.m_symStart << "-" << (unsigned)(currTti.m_dci.m_symStart + currTti.m_dci.m_numSym - 1) <<
@@ -595,17 +595,12 @@ MmWaveUePhy::StartTti ()
     {
       SetSubChannelsForTransmission (m_channelChunks);
       currTtiDuration = currTti.m_dci.m_numSym * m_phyMacConfig->GetSymbolPeriod ();
-      Ptr<PacketBurst> pktBurst = GetPacketBurst (SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));
-      if (pktBurst && pktBurst->GetNPackets () > 0)
+      TransportBlock tb = GetTransportBlock (SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));
+      if (!tb.IsEmpty ())
         {
-          std::list< Ptr<Packet> > pkts = pktBurst->GetPackets ();
-          MmWaveMacPduTag tag;
-          pkts.front ()->PeekPacketTag (tag);
-          NS_ASSERT ((tag.GetSfn ().m_frameNum == m_frameNum) && (tag.GetSfn ().m_sfNum == m_sfNum)
-                     && (tag.GetSfn ().m_slotNum == m_slotNum) && (tag.GetSfn ().m_symStart == currTti.m_dci.m_symStart));
-
+          // the MAC PDU tag of a retransmitted PDU still refers to its first transmission
           LteRadioBearerTag bearerTag;
-          if (!pkts.front ()->PeekPacketTag (bearerTag))
+          if (!(*tb.Begin ())->PeekPacketTag (bearerTag))
             {
               NS_FATAL_ERROR ("No radio bearer tag");
             }
@@ -619,10 +614,10 @@ MmWaveUePhy::StartTti ()
       // Trace current UL transmission info
       TraceUlPhyTransmission (currTti.m_dci, PhyTransmissionTraceParams::DATA);
 
-      if (pktBurst != 0)
+      if (!tb.IsEmpty ())
         {
           std::list<Ptr<MmWaveControlMessage> > ctrlMsg = GetControlMessages ();
-          m_sendDataChannelEvent = Simulator::Schedule (NanoSeconds (1.0), &MmWaveUePhy::SendDataChannels, this, pktBurst, ctrlMsg, currTtiDuration - NanoSeconds (2.0), m_slotNum);
+          m_sendDataChannelEvent = Simulator::Schedule (NanoSeconds (1.0), &MmWaveUePhy::SendDataChannels, this, tb, ctrlMsg, currTtiDuration - NanoSeconds (2.0), m_slotNum);
         }
     }
   else
@@ -713,7 +708,7 @@ MmWaveUePhy::DelayPhyDataPacketReceived (Ptr<Packet> p)
 }
 
 void
-MmWaveUePhy::SendDataChannels (Ptr<PacketBurst> pb, std::list<Ptr<MmWaveControlMessage> > ctrlMsg, Time duration, uint8_t slotInd)
+MmWaveUePhy::SendDataChannels (TransportBlock tb, std::list<Ptr<MmWaveControlMessage> > ctrlMsg, Time duration, uint8_t slotInd)
 {
 
   //Ptr<ThreeGppAntennaArrayModel> antennaArray = DynamicCast<ThreeGppAntennaArrayModel> (GetDlSpectrumPhy ()->GetRxAntenna());
@@ -724,15 +719,15 @@ MmWaveUePhy::SendDataChannels (Ptr<PacketBurst> pb, std::list<Ptr<MmWaveControlM
    * */
   //antennaArray->SetSector (3,16);
 
-  if (pb->GetNPackets () > 0)
+  if (!tb.IsEmpty ())
     {
       LteRadioBearerTag tag;
-      if (!pb->GetPackets ().front ()->PeekPacketTag (tag))
+      if (!(*tb.Begin ())->PeekPacketTag (tag))
         {
           NS_FATAL_ERROR ("No radio bearer tag");
         }
-      // call only if the packet burst is > 0
-      m_downlinkSpectrumPhy->StartTxDataFrames (pb, ctrlMsg, duration, slotInd);
+      // call only if the transport block is not empty
+      m_downlinkSpectrumPhy->StartTxDataFrames (std::move (tb), ctrlMsg, duration, slotInd);
     }
 }
 
@@ -860,7 +855,7 @@ MmWaveUePhy::DoReset ()
   m_cellId = 0;
   m_raPreambleId = 255;       // value out of range
 
-  m_packetBurstMap.clear ();
+  m_transportBlockMap.clear ();
   m_controlMessageQueue.clear ();
   m_subChannelsForTx.clear ();
 
@@ -157,7 +157,7 @@ public:
   void PhyDataPacketReceived (Ptr<Packet> p);
   void DelayPhyDataPacketReceived (Ptr<Packet> p);
 
-  void SendDataChannels (Ptr<PacketBurst> pb, std::list<Ptr<MmWaveControlMessage> > ctrlMsg, Time duration, uint8_t slotInd);
+  void SendDataChannels (TransportBlock tb, std::list<Ptr<MmWaveControlMessage> > ctrlMsg, Time duration, uint8_t slotInd);
 
   void SendCtrlChannels (std::list<Ptr<MmWaveControlMessage> > ctrlMsg, Time prd);
 
@@ -318,6 +318,145 @@ MmWaveSvdBeamformingTestCase::DoRun (void)
     }
 }
 
+/**
+* This test case checks if the MmWaveCodebookBeamforming works properly
+*/
+class MmWaveCodebookBeamformingTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveCodebookBeamformingTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveCodebookBeamformingTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveCodebookBeamformingTestCase::MmWaveCodebookBeamformingTestCase ()
+  : TestCase ("Checks if the MmWaveCodebookBeamforming class works as expected")
+{
+}
+
+MmWaveCodebookBeamformingTestCase::~MmWaveCodebookBeamformingTestCase ()
+{
+}
+
+void
+MmWaveCodebookBeamformingTestCase::DoRun (void)
+{
+  // Create the tx and rx nodes
+  Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel> ();
+  txMob->SetPosition (Vector (0, 0, 0));
+  Ptr<Node> txNode = CreateObject<Node> ();
+  txNode->AggregateObject (txMob);
+  Ptr<NetDevice> txDevice = CreateObject<SimpleNetDevice> ();
+  txDevice->SetNode (txNode);
+  txNode->AddDevice (txDevice);
+
+  Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel> ();
+  rxMob->SetPosition (Vector (1, 0, 0));
+  Ptr<Node> rxNode = CreateObject<Node> ();
+  rxNode->AggregateObject (rxMob);
+  Ptr<NetDevice> rxDevice = CreateObject<SimpleNetDevice> ();
+  rxDevice->SetNode (rxNode);
+  rxNode->AddDevice (rxDevice);
+
+  // Create the antennas
+  Ptr<ThreeGppAntennaArrayModel> txAntenna = CreateObjectWithAttributes<ThreeGppAntennaArrayModel> ("NumRows", UintegerValue (4),
+                                                                                                    "NumColumns", UintegerValue (4),
+                                                                                                    "IsotropicElements", BooleanValue (true));
+  Ptr<ThreeGppAntennaArrayModel> rxAntenna = CreateObjectWithAttributes<ThreeGppAntennaArrayModel> ("NumRows", UintegerValue (2),
+                                                                                                    "NumColumns", UintegerValue (2),
+                                                                                                    "IsotropicElements", BooleanValue (true));
+
+  // Create a single path channel model
+  MatrixBasedChannelModel::DoubleVector aodAz {10};
+  MatrixBasedChannelModel::DoubleVector aodEl {80};
+  MatrixBasedChannelModel::DoubleVector aoaAz {-30};
+  MatrixBasedChannelModel::DoubleVector aoaEl {100};
+  MatrixBasedChannelModel::DoubleVector phaseShift {0};
+  MatrixBasedChannelModel::DoubleVector pathLoss {0};
+  MatrixBasedChannelModel::DoubleVector delay {0};
+
+  Ptr<SimpleMatrixBasedChannelModel> channelModel = CreateObject<SimpleMatrixBasedChannelModel> ();
+  channelModel->SetAodAzimuth (aodAz);
+  channelModel->SetAodElevation (aodEl);
+  channelModel->SetAoaAzimuth (aoaAz);
+  channelModel->SetAoaElevation (aoaEl);
+  channelModel->SetPhaseShift (phaseShift);
+  channelModel->SetPathLoss (pathLoss);
+  channelModel->SetDelay (delay);
+
+  uint32_t numAzimuthBeams = 15;
+  uint32_t numElevationBeams = 5;
+  Ptr<MmWaveCodebookBeamforming> bfModule = CreateObjectWithAttributes<MmWaveCodebookBeamforming> ("Device", PointerValue (txDevice),
+                                                                                                   "Antenna", PointerValue (txAntenna),
+                                                                                                   "ChannelModel", PointerValue (channelModel),
+                                                                                                   "NumAzimuthBeams", UintegerValue (numAzimuthBeams),
+                                                                                                   "NumElevationBeams", UintegerValue (numElevationBeams));
+
+  bfModule->SetBeamformingVectorForDevice (rxDevice, rxAntenna);
+  ThreeGppAntennaArrayModel::ComplexVector txBfVector = txAntenna->GetBeamformingVector ();
+  ThreeGppAntennaArrayModel::ComplexVector rxBfVector = rxAntenna->GetBeamformingVector ();
+
+  // The selected beams must be codewords
+  Ptr<const MmWaveCodebookBeamforming::Codebook> txCodebook = MmWaveCodebookBeamforming::GetCodebook (txAntenna, numAzimuthBeams, numElevationBeams);
+  Ptr<const MmWaveCodebookBeamforming::Codebook> rxCodebook = MmWaveCodebookBeamforming::GetCodebook (rxAntenna, numAzimuthBeams, numElevationBeams);
+  NS_TEST_ASSERT_MSG_EQ (txCodebook->m_numBeams, numAzimuthBeams * numElevationBeams, "Unexpected codebook size");
+
+  // The codebook must be shared among arrays with the same geometry
+  Ptr<ThreeGppAntennaArrayModel> sameAntenna = CreateObjectWithAttributes<ThreeGppAntennaArrayModel> ("NumRows", UintegerValue (4),
+                                                                                                      "NumColumns", UintegerValue (4));
+  NS_TEST_ASSERT_MSG_EQ (MmWaveCodebookBeamforming::GetCodebook (sameAntenna, numAzimuthBeams, numElevationBeams), txCodebook,
+                         "Arrays with the same geometry should share the codebook");
+  NS_TEST_ASSERT_MSG_NE (rxCodebook, txCodebook, "Arrays with different geometries should not share the codebook");
+
+  // The selected pair must be the best one of the codebook and its gain must
+  // be close to the gain of beams perfectly aligned with the path
+  auto channelMatrix = channelModel->GetChannel (txMob, rxMob, txAntenna, rxAntenna);
+  auto computeGain = [&channelMatrix] (const ThreeGppAntennaArrayModel::ComplexVector &sW,
+                                       const ThreeGppAntennaArrayModel::ComplexVector &uW)
+    {
+      std::complex<double> sum (0, 0);
+      for (uint32_t uIndex = 0; uIndex < uW.size (); uIndex++)
+        {
+          for (uint32_t sIndex = 0; sIndex < sW.size (); sIndex++)
+            {
+              sum += uW[uIndex] * channelMatrix->m_channel[uIndex][sIndex][0] * sW[sIndex];
+            }
+        }
+      return std::norm (sum);
+    };
+
+  double selectedGain = computeGain (txBfVector, rxBfVector);
+  for (uint32_t sBeam = 0; sBeam < txCodebook->m_numBeams; sBeam++)
+    {
+      for (uint32_t uBeam = 0; uBeam < rxCodebook->m_numBeams; uBeam++)
+        {
+          double gain = computeGain (txCodebook->GetBeam (sBeam), rxCodebook->GetBeam (uBeam));
+          NS_TEST_ASSERT_MSG_LT_OR_EQ (gain, selectedGain * (1 + 1e-9), "A codeword pair with higher gain exists");
+        }
+    }
+
+  double optimalGain = computeGain (GetManualBfVector (txAntenna, Angles (DegreesToRadians (aodAz[0]), DegreesToRadians (aodEl[0]))),
+                                    GetManualBfVector (rxAntenna, Angles (DegreesToRadians (aoaAz[0]), DegreesToRadians (aoaEl[0]))));
+  NS_TEST_ASSERT_MSG_GT (selectedGain, optimalGain / 2, "The codebook gain should be within 3 dB from the optimal one");
+
+  // A new search on the same channel must select the same beam pair
+  txAntenna->SetBeamformingVector (ThreeGppAntennaArrayModel::ComplexVector (txAntenna->GetNumberOfElements ()));
+  bfModule->SetBeamformingVectorForDevice (rxDevice, rxAntenna);
+  NS_TEST_ASSERT_MSG_EQ ((txAntenna->GetBeamformingVector () == txBfVector), true, "The same beam should be selected");
+}
+
 /**
 * This suite tests if the beamforming module works properly
 */
@@ -333,6 +472,7 @@ MmWaveBeamformingTest::MmWaveBeamformingTest ()
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new MmWaveDftBeamformingTestCase, TestCase::QUICK);
   AddTestCase (new MmWaveSvdBeamformingTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveCodebookBeamformingTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,124 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "mmwave-flex-tti-scheduler-driver.h"
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * \file mmwave-flex-tti-scheduler-benchmark.cc
+ * \ingroup test
+ *
+ * \brief Microbenchmark of the flex-TTI MAC schedulers.
+ * Each scheduler is driven through its SAPs, without PHY and MAC, for a
+ * fixed number of slots and with a growing number of UEs per cell. The
+ * average wall-clock time needed to process a slot is printed on the
+ * standard output. The suite is not part of the default test.py run, use
+ * ./waf --run "test-runner --suite=mmwave-flex-tti-scheduler-benchmark"
+ */
+
+class MmWaveFlexTtiSchedulerBenchmarkTestCase : public TestCase
+{
+public:
+  MmWaveFlexTtiSchedulerBenchmarkTestCase (std::string schedulerType, uint32_t numUes, uint32_t numSlots,
+                                           bool ueChurn);
+  virtual ~MmWaveFlexTtiSchedulerBenchmarkTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  std::string m_schedulerType; //!< TypeId name of the scheduler
+  uint32_t m_numUes; //!< number of UEs in the cell
+  uint32_t m_numSlots; //!< number of slots to schedule
+  bool m_ueChurn; //!< whether UEs leave and join the cell during the run
+};
+
+MmWaveFlexTtiSchedulerBenchmarkTestCase::MmWaveFlexTtiSchedulerBenchmarkTestCase (std::string schedulerType, uint32_t numUes, uint32_t numSlots,
+                                                                                  bool ueChurn)
+  : TestCase (schedulerType + ", " + std::to_string (numUes) + " UEs"),
+    m_schedulerType (schedulerType),
+    m_numUes (numUes),
+    m_numSlots (numSlots),
+    m_ueChurn (ueChurn)
+{
+}
+
+MmWaveFlexTtiSchedulerBenchmarkTestCase::~MmWaveFlexTtiSchedulerBenchmarkTestCase ()
+{
+}
+
+void
+MmWaveFlexTtiSchedulerBenchmarkTestCase::DoRun (void)
+{
+  MmWaveFlexTtiSchedulerDriver driver (m_schedulerType, m_numUes, 1);
+  driver.SetUeChurn (m_ueChurn);
+
+  // warm up, so that all the UEs have reported CQIs and buffer status
+  driver.Run (100);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  driver.Run (m_numSlots);
+  int64_t elapsedMs = clock.End ();
+
+  NS_TEST_ASSERT_MSG_EQ (driver.GetNumSlots (), m_numSlots + 100, "Not all the slots have been scheduled");
+  NS_TEST_ASSERT_MSG_GT (driver.GetNumDci (), 0, "No DCI has been scheduled");
+
+  std::cout << std::left << std::setw (40) << m_schedulerType
+            << std::right << std::setw (5) << m_numUes << " UEs "
+            << std::setw (10) << std::fixed << std::setprecision (2)
+            << (elapsedMs * 1000.0 / m_numSlots) << " us/slot "
+            << std::setw (10) << driver.GetNumDci () << " DCIs" << std::endl;
+}
+
+class MmWaveFlexTtiSchedulerBenchmarkTestSuite : public TestSuite
+{
+public:
+  MmWaveFlexTtiSchedulerBenchmarkTestSuite ();
+};
+
+MmWaveFlexTtiSchedulerBenchmarkTestSuite::MmWaveFlexTtiSchedulerBenchmarkTestSuite ()
+  : TestSuite ("mmwave-flex-tti-scheduler-benchmark", PERFORMANCE)
+{
+  // the MaxWeight scheduler is left out, since it can't sustain large cells
+  // (see the golden-trace test), and the PF one runs without churn and for
+  // fewer slots, since it is more than an order of magnitude slower
+  std::string schedulers[4] = {"ns3::MmWaveFlexTtiMacScheduler",
+                               "ns3::MmWaveFlexTtiMaxRateMacScheduler",
+                               "ns3::MmWaveFlexTtiPfMacScheduler",
+                               "ns3::MmWaveFlexTtiMlwdfMacScheduler"};
+  bool ueChurn[4] = {true, true, false, true};
+  uint32_t numSlots[4] = {2000, 2000, 100, 2000};
+  uint32_t numUes[5] = {10, 50, 100, 250, 500};
+
+  for (uint32_t s = 0; s < 4; s++)
+    {
+      for (uint32_t n = 0; n < 5; n++)
+        {
+          AddTestCase (new MmWaveFlexTtiSchedulerBenchmarkTestCase (schedulers[s], numUes[n], numSlots[s], ueChurn[s]),
+                       TestCase::QUICK);
+        }
+    }
+}
+
+static MmWaveFlexTtiSchedulerBenchmarkTestSuite mmwaveFlexTtiSchedulerBenchmarkTestSuite; //!< the benchmark suite
@@ -0,0 +1,387 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-flex-tti-scheduler-driver.h"
+#include <ns3/log.h>
+#include <ns3/object-factory.h>
+#include <ns3/eps-bearer.h>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveFlexTtiSchedulerDriver");
+
+namespace mmwave {
+
+static const uint32_t HARQ_FEEDBACK_DELAY = 4; //!< slots between a DCI and its HARQ feedback
+static const uint32_t UL_CQI_DELAY = 2; //!< slots between a UL grant and its UL CQI report
+static const uint32_t CHURN_PERIOD = 100; //!< a UE leaves the cell every CHURN_PERIOD slots
+static const uint32_t QUIET_SLOTS = 40; //!< slots a leaving UE stays idle before being released
+
+MmWaveFlexTtiSchedulerDriver::MmWaveFlexTtiSchedulerDriver (std::string schedulerType, uint32_t numUes, uint32_t seed)
+  : m_nextRnti (1),
+    m_rng (seed),
+    m_slot (0),
+    m_digest (14695981039346656037ULL),
+    m_numDci (0),
+    m_ueChurn (true)
+{
+  NS_LOG_FUNCTION (this << schedulerType << numUes << seed);
+
+  m_config = CreateObject<MmWavePhyMacCommon> ();
+
+  ObjectFactory factory;
+  factory.SetTypeId (schedulerType);
+  m_scheduler = factory.Create<MmWaveMacScheduler> ();
+  m_scheduler->ConfigureCommonParameters (m_config);
+  m_scheduler->SetMacSchedSapUser (this);
+  m_scheduler->SetMacCschedSapUser (this);
+  m_schedSap = m_scheduler->GetMacSchedSapProvider ();
+  m_cschedSap = m_scheduler->GetMacCschedSapProvider ();
+
+  MmWaveMacCschedSapProvider::CschedCellConfigReqParameters cellConfig;
+  m_cschedSap->CschedCellConfigReq (cellConfig);
+
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      AddUe ();
+    }
+}
+
+MmWaveFlexTtiSchedulerDriver::~MmWaveFlexTtiSchedulerDriver ()
+{
+  NS_LOG_FUNCTION (this);
+  m_scheduler->Dispose ();
+}
+
+uint32_t
+MmWaveFlexTtiSchedulerDriver::Rand (void)
+{
+  // 32-bit LCG (Numerical Recipes), only the upper bits are used
+  m_rng = m_rng * 1664525u + 1013904223u;
+  return m_rng >> 8;
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::Hash (uint64_t v)
+{
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      m_digest ^= (v >> (8 * i)) & 0xFF;
+      m_digest *= 1099511628211ULL;
+    }
+}
+
+SfnSf
+MmWaveFlexTtiSchedulerDriver::GetSfnSf (uint32_t slot) const
+{
+  uint32_t slotsPerSf = m_config->GetSlotsPerSubframe ();
+  uint32_t sfPerFrame = m_config->GetSubframesPerFrame ();
+  return SfnSf (slot / (slotsPerSf * sfPerFrame), (slot / slotsPerSf) % sfPerFrame, slot % slotsPerSf);
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::AddUe (void)
+{
+  UeState ue;
+  ue.m_rnti = m_nextRnti++;
+  ue.m_active = true;
+  ue.m_quietSlots = 0;
+  m_ues.push_back (ue);
+
+  MmWaveMacCschedSapProvider::CschedUeConfigReqParameters ueConfig = MmWaveMacCschedSapProvider::CschedUeConfigReqParameters ();
+  ueConfig.m_rnti = ue.m_rnti;
+  ueConfig.m_transmissionMode = 0;
+  m_cschedSap->CschedUeConfigReq (ueConfig);
+
+  // SRB1 and a default data radio bearer, as configured by the eNB MAC
+  MmWaveMacCschedSapProvider::CschedLcConfigReqParameters lcConfig = MmWaveMacCschedSapProvider::CschedLcConfigReqParameters ();
+  lcConfig.m_rnti = ue.m_rnti;
+  lcConfig.m_reconfigureFlag = false;
+  uint8_t lcids[2] = {1, 3};
+  uint8_t qcis[2] = {EpsBearer::GBR_CONV_VOICE, EpsBearer::NGBR_VIDEO_TCP_DEFAULT};
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      LogicalChannelConfigListElement_s lc;
+      lc.m_logicalChannelIdentity = lcids[i];
+      lc.m_logicalChannelGroup = i;
+      lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+      lc.m_qci = qcis[i];
+      lc.m_eRabMaximulBitrateUl = 0;
+      lc.m_eRabMaximulBitrateDl = 0;
+      lc.m_eRabGuaranteedBitrateUl = 0;
+      lc.m_eRabGuaranteedBitrateDl = 0;
+      lcConfig.m_logicalChannelConfigList.push_back (lc);
+    }
+  m_cschedSap->CschedLcConfigReq (lcConfig);
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::SetUeChurn (bool churn)
+{
+  NS_LOG_FUNCTION (this << churn);
+  m_ueChurn = churn;
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::Run (uint32_t numSlots)
+{
+  NS_LOG_FUNCTION (this << numSlots);
+
+  for (uint32_t n = 0; n < numSlots; n++, m_slot++)
+    {
+      SfnSf sfnSf = GetSfnSf (m_slot);
+
+      // UE churn: a UE stops generating traffic and is released after a while
+      if (m_ueChurn && m_slot % CHURN_PERIOD == CHURN_PERIOD / 2 && m_ues.size () > 1)
+        {
+          m_ues.at (Rand () % m_ues.size ()).m_active = false;
+        }
+      uint32_t numReleased = 0;
+      for (std::vector<UeState>::iterator it = m_ues.begin (); it != m_ues.end (); )
+        {
+          if (it->m_active || ++it->m_quietSlots < QUIET_SLOTS)
+            {
+              ++it;
+              continue;
+            }
+          uint16_t rnti = it->m_rnti;
+          MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters release;
+          release.m_rnti = rnti;
+          m_cschedSap->CschedUeReleaseReq (release);
+          for (std::list<PendingDci>::iterator itDci = m_pendingDci.begin (); itDci != m_pendingDci.end (); )
+            {
+              itDci = (itDci->m_dci.m_rnti == rnti) ? m_pendingDci.erase (itDci) : ++itDci;
+            }
+          it = m_ues.erase (it);
+          numReleased++;
+        }
+      for (uint32_t i = 0; i < numReleased; i++)
+        {
+          AddUe ();
+        }
+
+      // DL CQI reports
+      MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters dlCqi;
+      dlCqi.m_sfnsf = sfnSf;
+      for (uint32_t i = 0; i < m_ues.size (); i++)
+        {
+          if (Rand () % 4 == 0)
+            {
+              DlCqiInfo cqi;
+              cqi.m_rnti = m_ues[i].m_rnti;
+              cqi.m_ri = 1;
+              cqi.m_cqiType = DlCqiInfo::WB;
+              cqi.m_wbCqi = Rand () % 16;
+              cqi.m_wbPmi = 0;
+              dlCqi.m_cqiList.push_back (cqi);
+            }
+        }
+      m_schedSap->SchedDlCqiInfoReq (dlCqi);
+
+      // UL CQI reports for the past UL grants
+      while (!m_pendingUlCqi.empty () && m_pendingUlCqi.front ().m_slot + UL_CQI_DELAY <= m_slot)
+        {
+          PendingDci grant = m_pendingUlCqi.front ();
+          m_pendingUlCqi.pop_front ();
+          MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+          ulCqi.m_sfnSf = grant.m_sfnSf;
+          ulCqi.m_sfnSf.m_symStart = grant.m_dci.m_symStart;
+          ulCqi.m_ulCqi.m_type = UlCqiInfo::PUSCH;
+          double sinrDb = (double)(Rand () % 400) / 10.0 - 10.0;
+          for (uint32_t i = 0; i < m_config->GetNumRb (); i++)
+            {
+              ulCqi.m_ulCqi.m_sinr.push_back (std::pow (10.0, (sinrDb + (double)(Rand () % 20) / 10.0) / 10.0));
+            }
+          m_schedSap->SchedUlCqiInfoReq (ulCqi);
+        }
+
+      // buffer status reports and RLC buffer status
+      MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters ulMacCtrl;
+      ulMacCtrl.m_sfnSf = sfnSf;
+      for (uint32_t i = 0; i < m_ues.size (); i++)
+        {
+          bool leaving = !m_ues[i].m_active && m_ues[i].m_quietSlots == 1;
+          if (leaving || (m_ues[i].m_active && Rand () % 5 == 0))
+            {
+              MacCeElement bsr;
+              bsr.m_rnti = m_ues[i].m_rnti;
+              bsr.m_macCeType = MacCeElement::BSR;
+              bsr.m_macCeValue.m_phr = 0;
+              bsr.m_macCeValue.m_crnti = 0;
+              bsr.m_macCeValue.m_bufferStatus.push_back (leaving || Rand () % 8 ? 0 : Rand () % 7);
+              bsr.m_macCeValue.m_bufferStatus.push_back (leaving ? 0 : Rand () % 9);
+              bsr.m_macCeValue.m_bufferStatus.push_back (0);
+              bsr.m_macCeValue.m_bufferStatus.push_back (0);
+              ulMacCtrl.m_macCeList.push_back (bsr);
+            }
+          if (leaving || (m_ues[i].m_active && Rand () % 3 == 0))
+            {
+              MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters rlc;
+              rlc.m_rnti = m_ues[i].m_rnti;
+              rlc.m_logicalChannelIdentity = (leaving || Rand () % 10) ? 3 : 1;
+              rlc.m_rlcTransmissionQueueSize = leaving ? 0 : Rand () % 12000;
+              rlc.m_rlcTransmissionQueueHolDelay = 0;
+              rlc.m_rlcRetransmissionQueueSize = (leaving || Rand () % 10) ? 0 : Rand () % 1500;
+              rlc.m_rlcRetransmissionHolDelay = 0;
+              rlc.m_rlcStatusPduSize = (leaving || Rand () % 10) ? 0 : 20;
+              rlc.m_arrivalRate = 0;
+              m_schedSap->SchedDlRlcBufferReq (rlc);
+            }
+        }
+      if (!ulMacCtrl.m_macCeList.empty ())
+        {
+          m_schedSap->SchedUlMacCtrlInfoReq (ulMacCtrl);
+        }
+
+      // HARQ feedback and slot trigger
+      MmWaveMacSchedSapProvider::SchedTriggerReqParameters trigger;
+      trigger.m_snfSf = sfnSf;
+      while (!m_pendingDci.empty () && m_pendingDci.front ().m_slot + HARQ_FEEDBACK_DELAY <= m_slot)
+        {
+          const DciInfoElementTdma &dci = m_pendingDci.front ().m_dci;
+          bool active = false;
+          for (uint32_t i = 0; i < m_ues.size (); i++)
+            {
+              if (m_ues[i].m_rnti == dci.m_rnti)
+                {
+                  active = m_ues[i].m_active;
+                }
+            }
+          bool error = active && Rand () % 5 == 0;
+          if (dci.m_format == DciInfoElementTdma::DL_dci)
+            {
+              DlHarqInfo harq;
+              harq.m_rnti = dci.m_rnti;
+              harq.m_harqProcessId = dci.m_harqProcess;
+              harq.m_harqStatus = error ? DlHarqInfo::NACK : DlHarqInfo::ACK;
+              harq.m_numRetx = dci.m_rv;
+              trigger.m_dlHarqInfoList.push_back (harq);
+            }
+          else
+            {
+              UlHarqInfo harq;
+              harq.m_rnti = dci.m_rnti;
+              harq.m_harqProcessId = dci.m_harqProcess;
+              harq.m_receptionStatus = error ? UlHarqInfo::NotOk : UlHarqInfo::Ok;
+              harq.m_numRetx = dci.m_rv;
+              trigger.m_ulHarqInfoList.push_back (harq);
+            }
+          m_pendingDci.pop_front ();
+        }
+      for (uint32_t i = 0; i < m_ues.size (); i++)
+        {
+          trigger.m_ueList.push_back (m_ues[i].m_rnti);
+        }
+      m_schedSap->SchedTriggerReq (trigger);
+    }
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::SchedConfigInd (const struct SchedConfigIndParameters& params)
+{
+  Hash (params.m_sfnSf.Encode ());
+  Hash (params.m_slotAllocInfo.m_numSymAlloc);
+  Hash (params.m_slotAllocInfo.m_ttiAllocInfo.size ());
+  for (std::deque<TtiAllocInfo>::const_iterator it = params.m_slotAllocInfo.m_ttiAllocInfo.begin ();
+       it != params.m_slotAllocInfo.m_ttiAllocInfo.end (); ++it)
+    {
+      // the RNTI of the TTI is not hashed, the one in the DCI is the reference
+      const DciInfoElementTdma &dci = it->m_dci;
+      Hash (((uint64_t)it->m_tddMode << 16) | ((uint64_t)it->m_ttiType << 8) | it->m_ttiIdx);
+      Hash (((uint64_t)dci.m_rnti << 48) | ((uint64_t)dci.m_format << 40) | ((uint64_t)dci.m_symStart << 32)
+            | ((uint64_t)dci.m_numSym << 24) | ((uint64_t)dci.m_mcs << 16) | ((uint64_t)dci.m_ndi << 8) | dci.m_rv);
+      Hash (((uint64_t)dci.m_tbSize << 8) | dci.m_harqProcess);
+      for (uint32_t i = 0; i < it->m_rlcPduInfo.size (); i++)
+        {
+          Hash (((uint64_t)it->m_rlcPduInfo[i].m_lcid << 32) | it->m_rlcPduInfo[i].m_size);
+        }
+
+      if (it->m_ttiType == TtiAllocInfo::CTRL_DATA)
+        {
+          m_numDci++;
+          PendingDci pending;
+          pending.m_slot = m_slot;
+          pending.m_sfnSf = params.m_sfnSf;
+          pending.m_dci = dci;
+          m_pendingDci.push_back (pending);
+          if (dci.m_format == DciInfoElementTdma::UL_dci)
+            {
+              m_pendingUlCqi.push_back (pending);
+            }
+        }
+    }
+}
+
+uint64_t
+MmWaveFlexTtiSchedulerDriver::GetDigest (void) const
+{
+  return m_digest;
+}
+
+uint64_t
+MmWaveFlexTtiSchedulerDriver::GetNumDci (void) const
+{
+  return m_numDci;
+}
+
+uint32_t
+MmWaveFlexTtiSchedulerDriver::GetNumSlots (void) const
+{
+  return m_slot;
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+{
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+{
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+{
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+{
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+{
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+{
+}
+
+void
+MmWaveFlexTtiSchedulerDriver::CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+{
+}
+
+} // namespace mmwave
+
+} // namespace ns3
@@ -0,0 +1,161 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MMWAVE_FLEX_TTI_SCHEDULER_DRIVER_H
+#define MMWAVE_FLEX_TTI_SCHEDULER_DRIVER_H
+
+#include <ns3/mmwave-mac-scheduler.h>
+#include <ns3/mmwave-mac-sched-sap.h>
+#include <ns3/mmwave-mac-csched-sap.h>
+#include <ns3/mmwave-phy-mac-common.h>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ * \brief Drives a flex-TTI MAC scheduler through its SAPs, without any PHY or MAC
+ *
+ * The driver plays the role of the eNB MAC: it configures a set of UEs and
+ * then, for each slot, feeds the scheduler with a synthetic but deterministic
+ * workload (DL CQIs, RLC buffer status, BSRs, UL CQIs for past UL grants and
+ * HARQ feedback for past DCIs) before triggering the allocation of the slot.
+ * Unless disabled, a few UEs leave the cell and new ones join it during the
+ * run, so that the configuration and release primitives are exercised as well.
+ *
+ * Every SchedConfigInd produced by the scheduler is folded into a 64-bit
+ * FNV-1a digest, which allows to compare the allocations of two scheduler
+ * implementations slot by slot.
+ */
+class MmWaveFlexTtiSchedulerDriver : public MmWaveMacSchedSapUser,
+                                     public MmWaveMacCschedSapUser
+{
+public:
+  /**
+   * Constructor
+   * \param schedulerType the TypeId name of the scheduler to drive
+   * \param numUes the number of UEs in the cell
+   * \param seed the seed of the workload generator
+   */
+  MmWaveFlexTtiSchedulerDriver (std::string schedulerType, uint32_t numUes, uint32_t seed);
+
+  virtual ~MmWaveFlexTtiSchedulerDriver ();
+
+  /**
+   * Enable or disable the UE churn (enabled by default)
+   * \param churn whether UEs leave and join the cell during the run
+   */
+  void SetUeChurn (bool churn);
+
+  /**
+   * Run the scheduler for a number of slots
+   * \param numSlots the number of slots to schedule
+   */
+  void Run (uint32_t numSlots);
+
+  /**
+   * \return the digest of all the allocations produced so far
+   */
+  uint64_t GetDigest (void) const;
+
+  /**
+   * \return the number of DCIs (DL and UL, new and retx) produced so far
+   */
+  uint64_t GetNumDci (void) const;
+
+  /**
+   * \return the number of slots scheduled so far
+   */
+  uint32_t GetNumSlots (void) const;
+
+  // inherited from MmWaveMacSchedSapUser
+  virtual void SchedConfigInd (const struct SchedConfigIndParameters& params) override;
+
+  // inherited from MmWaveMacCschedSapUser
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params) override;
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params) override;
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params) override;
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params) override;
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params) override;
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params) override;
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params) override;
+
+private:
+  /// State of a UE as seen by the driver
+  struct UeState
+  {
+    uint16_t m_rnti; //!< the RNTI
+    bool m_active; //!< false once the UE is about to leave the cell
+    uint32_t m_quietSlots; //!< number of slots the UE has been inactive
+  };
+
+  /// DCI waiting for the HARQ feedback
+  struct PendingDci
+  {
+    uint32_t m_slot; //!< index of the slot in which the DCI was issued
+    SfnSf m_sfnSf; //!< the slot in which the DCI was issued
+    DciInfoElementTdma m_dci; //!< the DCI
+  };
+
+  /**
+   * \return a new pseudo-random number
+   */
+  uint32_t Rand (void);
+
+  /**
+   * Fold a value into the digest
+   * \param v the value
+   */
+  void Hash (uint64_t v);
+
+  /**
+   * Configure a new UE and its logical channels
+   */
+  void AddUe (void);
+
+  /**
+   * \param slot the slot index
+   * \return the SfnSf corresponding to a slot index
+   */
+  SfnSf GetSfnSf (uint32_t slot) const;
+
+  Ptr<MmWavePhyMacCommon> m_config; //!< the PHY/MAC parameters
+  Ptr<MmWaveMacScheduler> m_scheduler; //!< the scheduler under test
+  MmWaveMacSchedSapProvider* m_schedSap; //!< the SCHED SAP of the scheduler
+  MmWaveMacCschedSapProvider* m_cschedSap; //!< the CSCHED SAP of the scheduler
+
+  std::vector<UeState> m_ues; //!< the UEs in the cell
+  uint16_t m_nextRnti; //!< the RNTI to assign to the next UE
+  uint32_t m_rng; //!< state of the workload generator
+  uint32_t m_slot; //!< index of the current slot
+  uint64_t m_digest; //!< digest of the allocations
+  uint64_t m_numDci; //!< number of DCIs received from the scheduler
+  bool m_ueChurn; //!< whether UEs leave and join the cell during the run
+  std::list<PendingDci> m_pendingDci; //!< DCIs waiting for the HARQ feedback
+  std::list<PendingDci> m_pendingUlCqi; //!< UL grants waiting for the UL CQI report
+};
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* MMWAVE_FLEX_TTI_SCHEDULER_DRIVER_H */
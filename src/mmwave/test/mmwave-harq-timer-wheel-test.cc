@@ -0,0 +1,114 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/mmwave-harq-timer-wheel.h"
+#include <map>
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+ * \file mmwave-harq-timer-wheel-test.cc
+ * \ingroup test
+ *
+ * \brief Test of the timing wheel of the HARQ process timers.
+ * Timers with increasing delays are started while the wheel advances, so
+ * that the wheel has to grow while holding running timers, and every timer
+ * must expire exactly in the slot returned when it was started.
+ */
+
+class MmWaveHarqTimerWheelTestCase : public TestCase
+{
+public:
+  MmWaveHarqTimerWheelTestCase ();
+  virtual ~MmWaveHarqTimerWheelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MmWaveHarqTimerWheelTestCase::MmWaveHarqTimerWheelTestCase ()
+  : TestCase ("HARQ timers expire in the slot they are scheduled for")
+{
+}
+
+MmWaveHarqTimerWheelTestCase::~MmWaveHarqTimerWheelTestCase ()
+{
+}
+
+void
+MmWaveHarqTimerWheelTestCase::DoRun (void)
+{
+  MmWaveHarqTimerWheel wheel;
+  std::multimap<uint64_t, uint16_t> pending; // expiry slot -> RNTI
+  std::vector<MmWaveHarqTimerWheel::Timer> expired;
+  uint32_t numExpired = 0;
+
+  for (uint32_t slot = 0; slot < 400; slot++)
+    {
+      if (slot < 200)
+        {
+          // delays from 1 to 100 slots, the wheel grows while holding timers
+          uint32_t delay = 1 + (slot * 37) % (1 + slot / 2);
+          uint16_t rnti = slot + 1;
+          uint64_t expiry = wheel.Schedule (rnti, slot % 20, slot % 2, delay);
+          NS_TEST_ASSERT_MSG_EQ (expiry, wheel.GetNow () + delay, "Wrong expiry slot");
+          pending.insert (std::make_pair (expiry, rnti));
+        }
+
+      expired.clear ();
+      wheel.Advance (expired);
+      std::multimap<uint64_t, uint16_t>::iterator it = pending.find (wheel.GetNow ());
+      NS_TEST_ASSERT_MSG_EQ (expired.size (), pending.count (wheel.GetNow ()),
+                             "Wrong number of timers expired in slot " << wheel.GetNow ());
+      for (uint32_t i = 0; i < expired.size (); i++, it++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (expired[i].m_expiry, wheel.GetNow (), "Timer expired in the wrong slot");
+          NS_TEST_ASSERT_MSG_EQ (expired[i].m_rnti, it->second, "Timers expired out of order");
+          NS_TEST_ASSERT_MSG_EQ ((unsigned)expired[i].m_harqId, (it->second - 1) % 20, "Wrong HARQ process");
+        }
+      numExpired += expired.size ();
+      pending.erase (wheel.GetNow ());
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (numExpired, 200, "Not all the timers expired");
+
+  wheel.Schedule (1, 0, false, 3);
+  wheel.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (wheel.GetNow (), 0, "The wheel did not restart from slot 0");
+  for (uint32_t slot = 0; slot < 5; slot++)
+    {
+      wheel.Advance (expired);
+    }
+  NS_TEST_ASSERT_MSG_EQ (expired.size (), 0, "A cleared timer expired");
+}
+
+class MmWaveHarqTimerWheelTestSuite : public TestSuite
+{
+public:
+  MmWaveHarqTimerWheelTestSuite ();
+};
+
+MmWaveHarqTimerWheelTestSuite::MmWaveHarqTimerWheelTestSuite ()
+  : TestSuite ("mmwave-harq-timer-wheel", UNIT)
+{
+  AddTestCase (new MmWaveHarqTimerWheelTestCase, TestCase::QUICK);
+}
+
+static MmWaveHarqTimerWheelTestSuite mmwaveHarqTimerWheelTestSuite; //!< the HARQ timer wheel test suite
@@ -0,0 +1,192 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020, University of Padova, Dep. of Information Engineering, SIGNET lab
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-trace-sink.h"
+#include "ns3/mmwave-threaded-trace-sink.h"
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveTraceSinkTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks that a trace written by the MmWaveTraceSink in binary
+* form and converted with the MmWaveTraceReader is identical to the same trace
+* written as text, and that the text is identical to the one produced by
+* std::ostream, which was used by the traces of the module. The same checks
+* are done on the MmWaveThreadedTraceSink, with a ring small enough to make
+* the simulation thread wait for the writer thread.
+*/
+class MmWaveTraceSinkTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  * \param bufferSize the size of the buffer of the sinks
+  * \param threaded true to test the MmWaveThreadedTraceSink
+  */
+  MmWaveTraceSinkTestCase (uint32_t bufferSize, bool threaded);
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveTraceSinkTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * \param fileName the name of the file
+  * \return the content of the file
+  */
+  static std::string ReadFile (const std::string &fileName);
+
+  /**
+  * \param fileName the name of the file
+  * \param schema the schema of the records
+  * \param format the format of the file
+  * \return a new sink of the type under test
+  */
+  Ptr<MmWaveTraceSink> CreateSink (const std::string &fileName, const MmWaveTraceSchema &schema,
+                                   MmWaveTraceSink::Format format) const;
+
+  uint32_t m_bufferSize; //!< the size of the buffer of the sinks
+  bool m_threaded; //!< true to test the MmWaveThreadedTraceSink
+};
+
+MmWaveTraceSinkTestCase::MmWaveTraceSinkTestCase (uint32_t bufferSize, bool threaded)
+  : TestCase (std::string (threaded ? "Threaded binary" : "Binary") + " and text trace sinks, buffer of "
+              + std::to_string (bufferSize) + " bytes"),
+    m_bufferSize (bufferSize),
+    m_threaded (threaded)
+{
+}
+
+MmWaveTraceSinkTestCase::~MmWaveTraceSinkTestCase ()
+{
+}
+
+std::string
+MmWaveTraceSinkTestCase::ReadFile (const std::string &fileName)
+{
+  std::ifstream is (fileName.c_str (), std::ios::binary);
+  std::ostringstream content;
+  content << is.rdbuf ();
+  return content.str ();
+}
+
+Ptr<MmWaveTraceSink>
+MmWaveTraceSinkTestCase::CreateSink (const std::string &fileName, const MmWaveTraceSchema &schema,
+                                     MmWaveTraceSink::Format format) const
+{
+  if (m_threaded)
+    {
+      return Create<MmWaveThreadedTraceSink> (fileName, schema, format, 64, m_bufferSize);
+    }
+  return Create<MmWaveTraceSink> (fileName, schema, format, m_bufferSize);
+}
+
+void
+MmWaveTraceSinkTestCase::DoRun (void)
+{
+  MmWaveTraceSchema schema;
+  schema.AddColumn ("DL/UL", MmWaveTraceSchema::LABEL)
+  .AddColumn ("time", MmWaveTraceSchema::DOUBLE)
+  .AddColumn ("frame", MmWaveTraceSchema::UINT16)
+  .AddColumn ("sym", MmWaveTraceSchema::UINT8)
+  .AddColumn ("cellId", MmWaveTraceSchema::UINT64)
+  .AddColumn ("tbSize", MmWaveTraceSchema::UINT32)
+  .AddColumn ("offset", MmWaveTraceSchema::INT64)
+  .AddColumn ("SINR(dB)", MmWaveTraceSchema::DOUBLE)
+  .AddColumn ("corrupt", MmWaveTraceSchema::UINT8)
+  .AddLabel ("DL")
+  .AddLabel ("UL");
+
+  std::string textFile = CreateTempDirFilename ("trace.txt");
+  std::string binaryFile = CreateTempDirFilename ("trace.bin");
+  std::ostringstream expected;
+  expected << "DL/UL\ttime\tframe\tsym\tcellId\ttbSize\toffset\tSINR(dB)\tcorrupt" << std::endl;
+
+  uint32_t numRecords = 5000;
+  {
+    Ptr<MmWaveTraceSink> text = CreateSink (textFile, schema, MmWaveTraceSink::TEXT);
+    Ptr<MmWaveTraceSink> binary = CreateSink (binaryFile, schema, MmWaveTraceSink::BINARY);
+    for (uint32_t i = 0; i < numRecords; i++)
+      {
+        double time = i * 0.000125;
+        uint16_t frame = i / 80;
+        uint8_t sym = i % 14;
+        uint64_t cellId = 1 + i % 3;
+        uint32_t tbSize = 100 * i + 7;
+        int64_t offset = 1000 - (int64_t) i;
+        double sinr = 10 * std::log10 (0.01 + i * 0.37);
+        bool corrupt = (i % 7 == 0);
+
+        text->Append () << i % 2 << time << frame << sym << cellId << tbSize << offset << sinr << corrupt;
+        binary->Append () << i % 2 << time << frame << sym << cellId << tbSize << offset << sinr << corrupt;
+        expected << (i % 2 ? "UL" : "DL") << "\t" << time << "\t" << frame << "\t" << +sym << "\t"
+                 << cellId << "\t" << tbSize << "\t" << offset << "\t" << sinr << "\t" << corrupt << std::endl;
+      }
+    NS_TEST_ASSERT_MSG_EQ (text->GetNRecords (), numRecords, "Wrong number of text records");
+    NS_TEST_ASSERT_MSG_EQ (binary->GetNRecords (), numRecords, "Wrong number of binary records");
+
+    // the records appended so far must be in the file after a flush
+    text->Flush ();
+    NS_TEST_ASSERT_MSG_EQ (ReadFile (textFile), expected.str (), "The text trace is incomplete after a flush");
+    // the sinks are flushed and closed when destroyed
+  }
+
+  NS_TEST_ASSERT_MSG_EQ (ReadFile (textFile), expected.str (), "The text trace differs from the std::ostream output");
+
+  MmWaveTraceReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (binaryFile), true, "Invalid binary trace");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetSchema ().GetNColumns (), schema.GetNColumns (), "Wrong number of columns");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetSchema ().GetRecordSize (), schema.GetRecordSize (), "Wrong record size");
+  std::ostringstream converted;
+  uint64_t numConverted = reader.ConvertToText (converted);
+  NS_TEST_ASSERT_MSG_EQ (numConverted, numRecords, "Wrong number of converted records");
+  NS_TEST_ASSERT_MSG_EQ (converted.str (), expected.str (), "The converted binary trace differs from the text trace");
+}
+
+/**
+* Test suite for the MmWaveTraceSink
+*/
+class MmWaveTraceSinkTestSuite : public TestSuite
+{
+public:
+  MmWaveTraceSinkTestSuite ();
+};
+
+MmWaveTraceSinkTestSuite::MmWaveTraceSinkTestSuite ()
+  : TestSuite ("mmwave-trace-sink", UNIT)
+{
+  AddTestCase (new MmWaveTraceSinkTestCase (1 << 20, false), TestCase::QUICK);
+  AddTestCase (new MmWaveTraceSinkTestCase (100, false), TestCase::QUICK);
+  AddTestCase (new MmWaveTraceSinkTestCase (1 << 20, true), TestCase::QUICK);
+  AddTestCase (new MmWaveTraceSinkTestCase (100, true), TestCase::QUICK);
+}
+
+static MmWaveTraceSinkTestSuite mmwaveTraceSinkTestSuite; //!< the test suite
@@ -227,6 +227,17 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
                 }
             }
         }
+
+      // the other channels to remote nodes are declared explicitly
+      const std::vector<MpiInterface::RemoteChannel> &remoteChannels = MpiInterface::GetRemoteChannels ();
+      for (std::vector<MpiInterface::RemoteChannel>::const_iterator it = remoteChannels.begin ();
+           it != remoteChannels.end (); ++it)
+        {
+          if (it->systemId != MpiInterface::GetSystemId () && it->delay < m_lookAhead)
+            {
+              m_lookAhead = it->delay;
+            }
+        }
     }
 
   // m_lookAhead is now set
@@ -26,6 +26,7 @@
 
 #include "mpi-interface.h"
 
+#include <ns3/channel.h>
 #include <ns3/global-value.h>
 #include <ns3/string.h>
 #include <ns3/log.h>
@@ -38,6 +39,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("MpiInterface");
 
 ParallelCommunicationInterface* MpiInterface::g_parallelCommunicationInterface = 0;
+std::vector<MpiInterface::RemoteChannel> MpiInterface::g_remoteChannels;
 
 void
 MpiInterface::Destroy ()
@@ -149,6 +151,25 @@ MpiInterface::Disable ()
   g_parallelCommunicationInterface->Disable ();
   delete g_parallelCommunicationInterface;
   g_parallelCommunicationInterface = 0;
+  g_remoteChannels.clear ();
+}
+
+void
+MpiInterface::AddRemoteChannel (Ptr<Channel> channel, uint32_t systemId, Time delay)
+{
+  NS_LOG_FUNCTION (channel << systemId << delay);
+  NS_ASSERT_MSG (delay.IsStrictlyPositive (), "The delay of a remote channel must be positive");
+  RemoteChannel remoteChannel;
+  remoteChannel.channel = channel;
+  remoteChannel.systemId = systemId;
+  remoteChannel.delay = delay;
+  g_remoteChannels.push_back (remoteChannel);
+}
+
+const std::vector<MpiInterface::RemoteChannel> &
+MpiInterface::GetRemoteChannels (void)
+{
+  return g_remoteChannels;
 }
 
 
@@ -30,6 +30,8 @@
 #include <ns3/nstime.h>
 #include <ns3/packet.h>
 
+#include <vector>
+
 #include "mpi.h"
 
 namespace ns3 {
@@ -39,6 +41,7 @@ namespace ns3 {
  */
 
 class ParallelCommunicationInterface;
+class Channel;
 
 /**
  * \ingroup mpi
@@ -139,6 +142,40 @@ public:
    */
   static void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
 
+  /**
+   * \brief A channel, other than a point-to-point one, which forwards
+   * packets to another rank.
+   */
+  struct RemoteChannel
+  {
+    Ptr<Channel> channel; //!< The channel.
+    uint32_t systemId;    //!< The rank the packets are forwarded to.
+    Time delay;           //!< The minimum delay of the packets forwarded to the rank.
+  };
+
+  /**
+   * \brief Declare a channel which forwards packets to another rank.
+   *
+   * The point-to-point links between the ranks are found by the parallel
+   * simulator implementations. The other channels which forward packets
+   * to other ranks with SendPacket, e.g., shared wireless channels, must
+   * be declared before Simulator::Run, so that the lookahead does not
+   * exceed the minimum delay between the transmission of a packet and its
+   * reception in the other rank.
+   *
+   * \param channel the channel
+   * \param systemId the rank the packets are forwarded to
+   * \param delay the minimum delay of the packets forwarded to the rank
+   */
+  static void AddRemoteChannel (Ptr<Channel> channel, uint32_t systemId, Time delay);
+
+  /**
+   * \brief Get the channels declared with AddRemoteChannel.
+   *
+   * \return the channels
+   */
+  static const std::vector<RemoteChannel> & GetRemoteChannels (void);
+
   /**
    * \brief Return the communicator used to run ns-3.
    *
@@ -161,6 +198,11 @@ private:
    * Static instance of the instantiated parallel controller.
    */
   static ParallelCommunicationInterface* g_parallelCommunicationInterface;
+
+  /**
+   * Channels declared with AddRemoteChannel.
+   */
+  static std::vector<RemoteChannel> g_remoteChannels;
 };
 
 } // namespace ns3
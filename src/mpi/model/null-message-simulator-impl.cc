@@ -201,6 +201,23 @@ NullMessageSimulatorImpl::CalculateLookAhead (void)
               remoteChannelBundle->AddChannel (channel, delay.Get () );
             }
         }
+
+      // the other channels to remote nodes are declared explicitly
+      const std::vector<MpiInterface::RemoteChannel> &remoteChannels = MpiInterface::GetRemoteChannels ();
+      for (std::vector<MpiInterface::RemoteChannel>::const_iterator it = remoteChannels.begin ();
+           it != remoteChannels.end (); ++it)
+        {
+          if (it->systemId == MpiInterface::GetSystemId ())
+            {
+              continue;
+            }
+          Ptr<RemoteChannelBundle> remoteChannelBundle = RemoteChannelBundleManager::Find (it->systemId);
+          if (!remoteChannelBundle)
+            {
+              remoteChannelBundle = RemoteChannelBundleManager::Add (it->systemId);
+            }
+          remoteChannelBundle->AddChannel (it->channel, it->delay);
+        }
     }
 
   // Completed setup of remote channel bundles.  Setup send and receive buffers.
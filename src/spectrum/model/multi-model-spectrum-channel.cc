@@ -37,6 +37,7 @@
 #include <ns3/propagation-delay-model.h>
 #include <ns3/antenna-model.h>
 #include <ns3/angles.h>
+#include <ns3/perf-counters.h>
 #include "multi-model-spectrum-channel.h"
 
 namespace ns3 {
@@ -217,6 +218,7 @@ void
 MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 {
   NS_LOG_FUNCTION (this << txParams);
+  NS_PERF_TIMER ("spectrum", "MultiModelSpectrumChannel::StartTx");
 
   NS_ASSERT (txParams->txPhy);
   NS_ASSERT (txParams->psd);
@@ -18,6 +18,7 @@
  * Author: Nicola Baldo <nbaldo@cttc.es>
  */
 
+#include <ns3/abort.h>
 #include <ns3/object.h>
 #include <ns3/simulator.h>
 #include <ns3/log.h>
@@ -33,6 +34,7 @@
 #include <ns3/propagation-delay-model.h>
 #include <ns3/antenna-model.h>
 #include <ns3/angles.h>
+#include <ns3/perf-counters.h>
 
 
 #include "single-model-spectrum-channel.h"
@@ -83,6 +85,7 @@ void
 SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 {
   NS_LOG_FUNCTION (this << txParams->psd << txParams->duration << txParams->txPhy);
+  NS_PERF_TIMER ("spectrum", "SingleModelSpectrumChannel::StartTx");
   NS_ASSERT_MSG (txParams->psd, "NULL txPsd");
   NS_ASSERT_MSG (txParams->txPhy, "NULL txPhy");
 
@@ -101,9 +104,13 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       NS_ASSERT (*(txParams->psd->GetSpectrumModel ()) == *m_spectrumModel);
     }
 
+  DeliverToReceivers (txParams, Seconds (0));
+}
 
-
-
+void
+SingleModelSpectrumChannel::DeliverToReceivers (Ptr<SpectrumSignalParameters> txParams, Time elapsed)
+{
+  NS_LOG_FUNCTION (this << txParams << elapsed);
   Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility ();
 
   for (PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
@@ -168,6 +175,8 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                   delay = m_propagationDelay->GetDelay (senderMobility, receiverMobility);
                 }
             }
+          NS_ABORT_MSG_IF (delay < elapsed, "Signal delivered after the propagation delay to a receiver");
+          delay -= elapsed;
 
 
           Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
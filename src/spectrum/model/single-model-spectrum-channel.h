@@ -61,9 +61,21 @@ public:
   /// Container: SpectrumPhy objects
   typedef std::vector<Ptr<SpectrumPhy> > PhyList;
 
-private:
+protected:
   virtual void DoDispose ();
 
+  /**
+   * Deliver a signal to the SpectrumPhy instances attached to the channel,
+   * except its transmitter. The signal is received after the propagation
+   * delay to each receiver, counted from its transmission.
+   *
+   * \param txParams the parameters of the signal
+   * \param elapsed the time elapsed since the transmission of the signal,
+   *        which must not exceed the propagation delay to any receiver
+   */
+  void DeliverToReceivers (Ptr<SpectrumSignalParameters> txParams, Time elapsed);
+
+private:
   /**
    * Used internally to reschedule transmission after the propagation delay.
    *
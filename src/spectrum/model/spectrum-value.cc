@@ -23,31 +23,242 @@
 #include <ns3/math.h>
 #include <ns3/log.h>
 
+#include <algorithm>
+#include <atomic>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("SpectrumValue");
 
+namespace {
+
+/// Maximum number of free buffers kept in a pool for each number of bands
+const std::size_t MAX_POOLED_STORAGE = 4096;
+
+/// Values of the SpectrumValue instances without a model
+Values g_noValues;
+
+std::atomic<uint64_t> g_allocationCount (0); //!< buffers allocated from the heap
+std::atomic<uint64_t> g_deepCopyCount (0);   //!< values copied to a new buffer
+std::atomic<uint64_t> g_sharedCopyCount (0); //!< copies sharing the values
+
+/// True once the pool of the thread has been destroyed, since values with
+/// static storage duration are released after the thread storage
+thread_local bool g_poolDestroyed = false;
+
+} // unnamed namespace
+
+/**
+ * Free buffers of values of a thread, one list for each number of bands.
+ * The simulations use few spectrum models, so the lists are searched
+ * linearly.
+ */
+struct SpectrumValue::StoragePool
+{
+  ~StoragePool ()
+  {
+    g_poolDestroyed = true;
+    for (std::size_t i = 0; i < m_lists.size (); i++)
+      {
+        for (std::size_t j = 0; j < m_lists[i].second.size (); j++)
+          {
+            delete m_lists[i].second[j];
+          }
+      }
+  }
+
+  /**
+   * \param n the number of values
+   * \return the free buffers with \p n values
+   */
+  std::vector<Storage *>& GetList (std::size_t n)
+  {
+    for (std::size_t i = 0; i < m_lists.size (); i++)
+      {
+        if (m_lists[i].first == n)
+          {
+            return m_lists[i].second;
+          }
+      }
+    m_lists.push_back (std::make_pair (n, std::vector<Storage *> ()));
+    return m_lists.back ().second;
+  }
+
+  std::vector<std::pair<std::size_t, std::vector<Storage *> > > m_lists; //!< free buffers by number of values
+};
+
+SpectrumValue::StoragePool*
+SpectrumValue::GetStoragePool (void)
+{
+  if (g_poolDestroyed)
+    {
+      return 0;
+    }
+  static thread_local StoragePool pool;
+  return &pool;
+}
+
+SpectrumValue::Storage *
+SpectrumValue::AllocateStorage (std::size_t n)
+{
+  StoragePool *pool = GetStoragePool ();
+  std::vector<Storage *> *list = pool != 0 ? &pool->GetList (n) : 0;
+  Storage *storage;
+  if (list == 0 || list->empty ())
+    {
+      g_allocationCount.fetch_add (1, std::memory_order_relaxed);
+      storage = new Storage;
+      storage->values.resize (n);
+    }
+  else
+    {
+      storage = list->back ();
+      list->pop_back ();
+    }
+  storage->refCount = 1;
+  return storage;
+}
+
+void
+SpectrumValue::ReleaseStorage (Storage *storage)
+{
+  if (storage == 0 || --storage->refCount > 0)
+    {
+      return;
+    }
+  StoragePool *pool = GetStoragePool ();
+  std::vector<Storage *> *list = pool != 0 ? &pool->GetList (storage->values.size ()) : 0;
+  if (list != 0 && list->size () < MAX_POOLED_STORAGE)
+    {
+      list->push_back (storage);
+    }
+  else
+    {
+      delete storage;
+    }
+}
+
+void
+SpectrumValue::DoDetach (void)
+{
+  g_deepCopyCount.fetch_add (1, std::memory_order_relaxed);
+  Storage *storage = AllocateStorage (m_storage->values.size ());
+  std::copy (m_storage->values.begin (), m_storage->values.end (), storage->values.begin ());
+  ReleaseStorage (m_storage);
+  m_storage = storage;
+}
+
+const Values&
+SpectrumValue::ConstValues (void) const
+{
+  return m_storage != 0 ? m_storage->values : g_noValues;
+}
+
+Values&
+SpectrumValue::MutableValues (void)
+{
+  Detach ();
+  return m_storage != 0 ? m_storage->values : g_noValues;
+}
+
+uint64_t
+SpectrumValue::GetAllocationCount (void)
+{
+  return g_allocationCount.load (std::memory_order_relaxed);
+}
+
+uint64_t
+SpectrumValue::GetDeepCopyCount (void)
+{
+  return g_deepCopyCount.load (std::memory_order_relaxed);
+}
+
+uint64_t
+SpectrumValue::GetSharedCopyCount (void)
+{
+  return g_sharedCopyCount.load (std::memory_order_relaxed);
+}
+
 SpectrumValue::SpectrumValue ()
+  : m_storage (0)
 {
 }
 
 SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sof)
   : m_spectrumModel (sof),
-    m_values (sof->GetNumBands ())
+    m_storage (AllocateStorage (sof->GetNumBands ()))
+{
+  std::fill (m_storage->values.begin (), m_storage->values.end (), 0.0);
+}
+
+SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sm, Storage *storage)
+  : m_spectrumModel (sm),
+    m_storage (storage)
+{
+}
+
+SpectrumValue::SpectrumValue (const SpectrumValue& other)
+  : SimpleRefCount<SpectrumValue> (other),
+    m_spectrumModel (other.m_spectrumModel),
+    m_storage (other.m_storage)
+{
+  if (m_storage != 0)
+    {
+      g_sharedCopyCount.fetch_add (1, std::memory_order_relaxed);
+      m_storage->refCount++;
+    }
+}
+
+SpectrumValue::SpectrumValue (SpectrumValue&& other)
+  : SimpleRefCount<SpectrumValue> (),
+    m_spectrumModel (other.m_spectrumModel),
+    m_storage (other.m_storage)
 {
+  other.m_storage = 0;
+}
 
+SpectrumValue::~SpectrumValue ()
+{
+  ReleaseStorage (m_storage);
+}
+
+SpectrumValue&
+SpectrumValue::operator= (const SpectrumValue& other)
+{
+  if (other.m_storage != 0)
+    {
+      g_sharedCopyCount.fetch_add (1, std::memory_order_relaxed);
+      other.m_storage->refCount++;
+    }
+  ReleaseStorage (m_storage);
+  m_spectrumModel = other.m_spectrumModel;
+  m_storage = other.m_storage;
+  return *this;
+}
+
+SpectrumValue&
+SpectrumValue::operator= (SpectrumValue&& other)
+{
+  if (this != &other)
+    {
+      ReleaseStorage (m_storage);
+      m_spectrumModel = other.m_spectrumModel;
+      m_storage = other.m_storage;
+      other.m_storage = 0;
+    }
+  return *this;
 }
 
 double&
 SpectrumValue::operator[] (size_t index)
 {
-  return m_values.at (index);
+  return MutableValues ().at (index);
 }
 
 const double&
 SpectrumValue::operator[] (size_t index) const
 {
-  return m_values.at (index);
+  return ConstValues ().at (index);
 }
 
 
@@ -68,28 +279,29 @@ SpectrumValue::GetSpectrumModel () const
 Values::const_iterator
 SpectrumValue::ConstValuesBegin () const
 {
-  return m_values.begin ();
+  return ConstValues ().begin ();
 }
 
 Values::const_iterator
 SpectrumValue::ConstValuesEnd () const
 {
-  return m_values.end ();
+  return ConstValues ().end ();
 }
 
 
 Values::iterator
 SpectrumValue::ValuesBegin ()
 {
-  return m_values.begin ();
+  return MutableValues ().begin ();
 }
 
 Values::iterator
 SpectrumValue::ValuesEnd ()
 {
-  return m_values.end ();
+  return MutableValues ().end ();
 }
 
+
 Bands::const_iterator
 SpectrumValue::ConstBandsBegin () const
 {
@@ -103,20 +315,56 @@ SpectrumValue::ConstBandsEnd () const
 }
 
 
+template <typename Op>
+SpectrumValue
+SpectrumValue::Combine (const SpectrumValue& lhs, const SpectrumValue& rhs, Op op)
+{
+  NS_ASSERT (lhs.m_spectrumModel == rhs.m_spectrumModel);
+  const Values &x = lhs.ConstValues ();
+  const Values &y = rhs.ConstValues ();
+  NS_ASSERT (x.size () == y.size ());
+  if (lhs.m_storage == 0)
+    {
+      return lhs;
+    }
+  SpectrumValue res (lhs.m_spectrumModel, AllocateStorage (x.size ()));
+  Values &z = res.m_storage->values;
+  for (std::size_t i = 0; i < z.size (); i++)
+    {
+      z[i] = op (x[i], y[i]);
+    }
+  return res;
+}
+
+template <typename Op>
+SpectrumValue
+SpectrumValue::Transform (const SpectrumValue& arg, Op op)
+{
+  if (arg.m_storage == 0)
+    {
+      return arg;
+    }
+  const Values &x = arg.ConstValues ();
+  SpectrumValue res (arg.m_spectrumModel, AllocateStorage (x.size ()));
+  Values &z = res.m_storage->values;
+  for (std::size_t i = 0; i < z.size (); i++)
+    {
+      z[i] = op (x[i]);
+    }
+  return res;
+}
+
+
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
+  Values &v = MutableValues ();
+  const Values &w = x.ConstValues ();
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-  NS_ASSERT (m_values.size () == x.m_values.size ());
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (v.size () == w.size ());
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 += *it2;
-      ++it1;
-      ++it2;
+      v[i] += w[i];
     }
 }
 
@@ -124,12 +372,10 @@ SpectrumValue::Add (const SpectrumValue& x)
 void
 SpectrumValue::Add (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 += s;
-      ++it1;
+      v[i] += s;
     }
 }
 
@@ -138,17 +384,13 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
+  Values &v = MutableValues ();
+  const Values &w = x.ConstValues ();
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-  NS_ASSERT (m_values.size () == x.m_values.size ());
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (v.size () == w.size ());
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 -= *it2;
-      ++it1;
-      ++it2;
+      v[i] -= w[i];
     }
 }
 
@@ -164,17 +406,13 @@ SpectrumValue::Subtract (double s)
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
+  Values &v = MutableValues ();
+  const Values &w = x.ConstValues ();
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-  NS_ASSERT (m_values.size () == x.m_values.size ());
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (v.size () == w.size ());
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
+      v[i] *= w[i];
     }
 }
 
@@ -182,12 +420,10 @@ SpectrumValue::Multiply (const SpectrumValue& x)
 void
 SpectrumValue::Multiply (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 *= s;
-      ++it1;
+      v[i] *= s;
     }
 }
 
@@ -197,17 +433,13 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
+  Values &v = MutableValues ();
+  const Values &w = x.ConstValues ();
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-  NS_ASSERT (m_values.size () == x.m_values.size ());
-
-  while (it1 != m_values.end ())
+  NS_ASSERT (v.size () == w.size ());
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
+      v[i] /= w[i];
     }
 }
 
@@ -216,12 +448,10 @@ void
 SpectrumValue::Divide (double s)
 {
   NS_LOG_FUNCTION (this << s);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 /= s;
-      ++it1;
+      v[i] /= s;
     }
 }
 
@@ -231,12 +461,10 @@ SpectrumValue::Divide (double s)
 void
 SpectrumValue::ChangeSign ()
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 = -(*it1);
-      ++it1;
+      v[i] = -v[i];
     }
 }
 
@@ -244,15 +472,16 @@ SpectrumValue::ChangeSign ()
 void
 SpectrumValue::ShiftLeft (int n)
 {
+  Values &v = MutableValues ();
   int i = 0;
-  while (i < (int) m_values.size () - n)
+  while (i < (int) v.size () - n)
     {
-      m_values.at (i) = m_values.at (i + n);
+      v.at (i) = v.at (i + n);
       i++;
     }
-  while (i < (int)m_values.size ())
+  while (i < (int)v.size ())
     {
-      m_values.at (i) = 0;
+      v.at (i) = 0;
       i++;
     }
 }
@@ -261,15 +490,16 @@ SpectrumValue::ShiftLeft (int n)
 void
 SpectrumValue::ShiftRight (int n)
 {
-  int i = m_values.size () - 1;
+  Values &v = MutableValues ();
+  int i = v.size () - 1;
   while (i - n >= 0)
     {
-      m_values.at (i) = m_values.at (i - n);
+      v.at (i) = v.at (i - n);
       i = i - 1;
     }
   while (i >= 0)
     {
-      m_values.at (i) = 0;
+      v.at (i) = 0;
       --i;
     }
 }
@@ -280,12 +510,10 @@ void
 SpectrumValue::Pow (double exp)
 {
   NS_LOG_FUNCTION (this << exp);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 = std::pow (*it1, exp);
-      ++it1;
+      v[i] = std::pow (v[i], exp);
     }
 }
 
@@ -294,12 +522,10 @@ void
 SpectrumValue::Exp (double base)
 {
   NS_LOG_FUNCTION (this << base);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 = std::pow (base, *it1);
-      ++it1;
+      v[i] = std::pow (base, v[i]);
     }
 }
 
@@ -308,25 +534,22 @@ void
 SpectrumValue::Log10 ()
 {
   NS_LOG_FUNCTION (this);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 = std::log10 (*it1);
-      ++it1;
+      v[i] = std::log10 (v[i]);
     }
 }
 
+
 void
 SpectrumValue::Log2 ()
 {
   NS_LOG_FUNCTION (this);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 = log2 (*it1);
-      ++it1;
+      v[i] = log2 (v[i]);
     }
 }
 
@@ -335,12 +558,10 @@ void
 SpectrumValue::Log ()
 {
   NS_LOG_FUNCTION (this);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  Values &v = MutableValues ();
+  for (std::size_t i = 0; i < v.size (); i++)
     {
-      *it1 = std::log (*it1);
-      ++it1;
+      v[i] = std::log (v[i]);
     }
 }
 
@@ -408,11 +629,8 @@ Integral (const SpectrumValue& arg)
 Ptr<SpectrumValue>
 SpectrumValue::Copy () const
 {
-  Ptr<SpectrumValue> p = Create<SpectrumValue> (m_spectrumModel);
-  *p = *this;
-  return p;
-
-  //  return Copy<SpectrumValue> (*this)
+  // Create would copy the argument once more, sharing the values twice
+  return Ptr<SpectrumValue> (new SpectrumValue (*this), false);
 }
 
 
@@ -440,37 +658,27 @@ operator << (std::ostream& os, const SpectrumValue& pvf)
 SpectrumValue
 operator+ (const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = lhs;
-  res.Add (rhs);
-  return res;
+  return SpectrumValue::Combine (lhs, rhs, [] (double x, double y) { return x + y; });
 }
 
 
 SpectrumValue
 operator+ (const SpectrumValue& lhs, double rhs)
 {
-  SpectrumValue res = lhs;
-  res.Add (rhs);
-  return res;
+  return SpectrumValue::Transform (lhs, [rhs] (double x) { return x + rhs; });
 }
 
-
 SpectrumValue
 operator+ (double lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.Add (lhs);
-  return res;
+  return SpectrumValue::Transform (rhs, [lhs] (double x) { return x + lhs; });
 }
 
 
 SpectrumValue
 operator- (const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  res.Add (lhs);
-  return res;
+  return SpectrumValue::Combine (lhs, rhs, [] (double x, double y) { return x - y; });
 }
 
 
@@ -478,71 +686,52 @@ operator- (const SpectrumValue& lhs, const SpectrumValue& rhs)
 SpectrumValue
 operator- (const SpectrumValue& lhs, double rhs)
 {
-  SpectrumValue res = lhs;
-  res.Subtract (rhs);
-  return res;
+  return SpectrumValue::Transform (lhs, [rhs] (double x) { return x - rhs; });
 }
 
-
 SpectrumValue
 operator- (double lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.Subtract (lhs);
-  return res;
+  return SpectrumValue::Transform (rhs, [lhs] (double x) { return x - lhs; });
 }
 
 SpectrumValue
 operator* (const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = lhs;
-  res.Multiply (rhs);
-  return res;
+  return SpectrumValue::Combine (lhs, rhs, [] (double x, double y) { return x * y; });
 }
 
 
 SpectrumValue
 operator* (const SpectrumValue& lhs, double rhs)
 {
-  SpectrumValue res = lhs;
-  res.Multiply (rhs);
-  return res;
+  return SpectrumValue::Transform (lhs, [rhs] (double x) { return x * rhs; });
 }
 
-
 SpectrumValue
 operator* (double lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.Multiply (lhs);
-  return res;
+  return SpectrumValue::Transform (rhs, [lhs] (double x) { return x * lhs; });
 }
 
 
 SpectrumValue
 operator/ (const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = lhs;
-  res.Divide (rhs);
-  return res;
+  return SpectrumValue::Combine (lhs, rhs, [] (double x, double y) { return x / y; });
 }
 
 
 SpectrumValue
 operator/ (const SpectrumValue& lhs, double rhs)
 {
-  SpectrumValue res = lhs;
-  res.Divide (rhs);
-  return res;
+  return SpectrumValue::Transform (lhs, [rhs] (double x) { return x / rhs; });
 }
 
-
 SpectrumValue
 operator/ (double lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.Divide (lhs);
-  return res;
+  return SpectrumValue::Transform (rhs, [lhs] (double x) { return x / lhs; });
 }
 
 
@@ -555,52 +744,40 @@ operator+ (const SpectrumValue& rhs)
 SpectrumValue
 operator- (const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  return res;
+  return SpectrumValue::Transform (rhs, [] (double x) { return -x; });
 }
 
 
 SpectrumValue
 Pow (double lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.Exp (lhs);
-  return res;
+  return SpectrumValue::Transform (rhs, [lhs] (double x) { return std::pow (lhs, x); });
 }
 
 
 SpectrumValue
 Pow (const SpectrumValue& lhs, double rhs)
 {
-  SpectrumValue res = lhs;
-  res.Pow (rhs);
-  return res;
+  return SpectrumValue::Transform (lhs, [rhs] (double x) { return std::pow (x, rhs); });
 }
 
 
 SpectrumValue
 Log10 (const SpectrumValue& arg)
 {
-  SpectrumValue res = arg;
-  res.Log10 ();
-  return res;
+  return SpectrumValue::Transform (arg, [] (double x) { return std::log10 (x); });
 }
 
 SpectrumValue
 Log2 (const SpectrumValue& arg)
 {
-  SpectrumValue res = arg;
-  res.Log2 ();
-  return res;
+  return SpectrumValue::Transform (arg, [] (double x) { return log2 (x); });
 }
 
 SpectrumValue
 Log (const SpectrumValue& arg)
 {
-  SpectrumValue res = arg;
-  res.Log ();
-  return res;
+  return SpectrumValue::Transform (arg, [] (double x) { return std::log (x); });
 }
 
 SpectrumValue&
@@ -664,13 +841,8 @@ SpectrumValue::operator/= (double rhs)
 SpectrumValue&
 SpectrumValue::operator= (double rhs)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = rhs;
-      ++it1;
-    }
+  Values &v = MutableValues ();
+  std::fill (v.begin (), v.end (), rhs);
   return *this;
 }
 
@@ -695,13 +867,13 @@ SpectrumValue::operator>> (int n) const
 uint32_t
 SpectrumValue::GetValuesN () const
 {
-  return m_values.size ();
+  return ConstValues ().size ();
 }
 
 const double &
 SpectrumValue::ValuesAt (uint32_t pos) const
 {
-  return m_values.at (pos);
+  return ConstValues ().at (pos);
 }
 
 } // namespace ns3
@@ -54,6 +54,14 @@ typedef std::vector<double> Values;
  * The intended use of this class is to represent frequency-dependent
  * things, such as power spectral densities, frequency-dependent
  * propagation losses, spectral masks, etc.
+ *
+ * The values are copied on write: copies of a SpectrumValue share the
+ * same values, until one of them is modified, either by an operator or
+ * through a non-const accessor. Hence a reference or an iterator obtained
+ * from a non-const accessor must not be used to modify the values after
+ * the SpectrumValue has been copied. The buffers of the values are
+ * recycled by a pool of each thread, one free list for each number of
+ * bands.
  */
 class SpectrumValue : public SimpleRefCount<SpectrumValue>
 {
@@ -80,6 +88,42 @@ public:
 
   SpectrumValue ();
 
+  /**
+   * Copy constructor, the values are shared until one of the copies is
+   * modified
+   *
+   * @param other the SpectrumValue to copy
+   */
+  SpectrumValue (const SpectrumValue& other);
+
+  /**
+   * Move constructor
+   *
+   * @param other the SpectrumValue to move, left without values
+   */
+  SpectrumValue (SpectrumValue&& other);
+
+  ~SpectrumValue ();
+
+  /**
+   * Copy assignment, the values are shared until one of the copies is
+   * modified
+   *
+   * @param other the SpectrumValue to copy
+   *
+   * @return this SpectrumValue
+   */
+  SpectrumValue& operator= (const SpectrumValue& other);
+
+  /**
+   * Move assignment
+   *
+   * @param other the SpectrumValue to move, left without values
+   *
+   * @return this SpectrumValue
+   */
+  SpectrumValue& operator= (SpectrumValue&& other);
+
 
   /**
    * Access value at given frequency index
@@ -524,8 +568,120 @@ public:
    */
   typedef void (* TracedCallback)(Ptr<SpectrumValue> value);
 
+  /**
+   * \brief Get the number of buffers of values allocated from the heap,
+   * rather than recycled from the pool, since the start of the program
+   * \return the number of allocations
+   */
+  static uint64_t GetAllocationCount (void);
+
+  /**
+   * \brief Get the number of times the values of a SpectrumValue have been
+   * copied to a new buffer, because they were shared with a copy and had to
+   * be modified, since the start of the program
+   * \return the number of copies
+   */
+  static uint64_t GetDeepCopyCount (void);
+
+  /**
+   * \brief Get the number of copies of a SpectrumValue which shared the
+   * values, instead of copying them, since the start of the program
+   * \return the number of shared copies
+   */
+  static uint64_t GetSharedCopyCount (void);
+
 
 private:
+  /**
+   * Values shared by the copies of a SpectrumValue
+   */
+  struct Storage
+  {
+    uint32_t refCount; //!< number of SpectrumValue instances sharing the values
+    Values values;     //!< the values
+  };
+
+  /**
+   * Create a SpectrumValue with uninitialized values
+   *
+   * @param sm the SpectrumModel
+   * @param storage the values, not shared
+   */
+  SpectrumValue (Ptr<const SpectrumModel> sm, Storage *storage);
+
+  /**
+   * Get a buffer of values from the pool of the calling thread, or allocate
+   * a new one if the pool is empty
+   *
+   * @param n the number of values
+   *
+   * @return the buffer, with uninitialized values and a reference count of 1
+   */
+  static Storage * AllocateStorage (std::size_t n);
+  /**
+   * Release a reference to a buffer of values, and return the buffer to
+   * the pool of the calling thread if it was the last one
+   *
+   * @param storage the buffer, or 0
+   */
+  static void ReleaseStorage (Storage *storage);
+  /**
+   * \return the values, or an empty vector if there is no model
+   */
+  const Values& ConstValues (void) const;
+  /**
+   * \return the values, which are not shared anymore, or an empty vector
+   * if there is no model
+   */
+  Values& MutableValues (void);
+
+  /// Pools of buffers of values
+  struct StoragePool;
+  /**
+   * \return the pool of buffers of values of the calling thread, or 0 if
+   * the thread is exiting and the pool has been destroyed
+   */
+  static StoragePool* GetStoragePool (void);
+
+  /**
+   * Make sure that the values are not shared, before modifying them
+   */
+  void Detach (void)
+  {
+    if (m_storage != 0 && m_storage->refCount > 1)
+      {
+        DoDetach ();
+      }
+  }
+  /**
+   * Copy the shared values to a new buffer
+   */
+  void DoDetach (void);
+
+  /**
+   * Apply an element-wise binary operation to two SpectrumValue, in a
+   * single pass
+   *
+   * @param lhs the left operand
+   * @param rhs the right operand
+   * @param op the operation
+   *
+   * @return the result
+   */
+  template <typename Op>
+  static SpectrumValue Combine (const SpectrumValue& lhs, const SpectrumValue& rhs, Op op);
+  /**
+   * Apply an element-wise unary operation to a SpectrumValue, in a
+   * single pass
+   *
+   * @param arg the operand
+   * @param op the operation
+   *
+   * @return the result
+   */
+  template <typename Op>
+  static SpectrumValue Transform (const SpectrumValue& arg, Op op);
+
   /**
    * Add a SpectrumValue (element to element addition)
    * \param x SpectrumValue
@@ -611,10 +767,11 @@ private:
    * Set of values which implement the codomain of the functions in
    * the Function Space defined by SpectrumValue. There is no restriction
    * on what these values represent (a transmission power density, a
-   * propagation loss, etc.).
+   * propagation loss, etc.). The values can be shared with copies of this
+   * SpectrumValue, and are 0 if the SpectrumValue has no model.
    *
    */
-  Values m_values;
+  Storage *m_storage;
 
 
 };
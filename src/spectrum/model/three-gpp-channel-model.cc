@@ -33,6 +33,7 @@
 #include <ns3/simulator.h>
 #include "ns3/mobility-model.h"
 #include "ns3/pointer.h"
+#include "ns3/perf-counters.h"
 
 namespace ns3 {
 
@@ -1044,6 +1045,7 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
                                      double dis2D, double hBS, double hUT) const
 {
   NS_LOG_FUNCTION (this);
+  NS_PERF_TIMER ("spectrum", "ThreeGppChannelModel::GetNewChannel");
 
   NS_ASSERT_MSG (m_frequency > 0.0, "Set the operating frequency first!");
 
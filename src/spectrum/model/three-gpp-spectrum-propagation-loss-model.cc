@@ -30,6 +30,7 @@
 #include "ns3/string.h"
 #include "ns3/simulator.h"
 #include "ns3/pointer.h"
+#include "ns3/perf-counters.h"
 #include <map>
 
 namespace ns3 {
@@ -301,6 +302,7 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<const Sp
                                                                     Ptr<const MobilityModel> b) const
 {
   NS_LOG_FUNCTION (this);
+  NS_PERF_TIMER ("spectrum", "ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity");
   uint32_t aId = a->GetObject<Node> ()->GetId (); // id of the node a
   uint32_t bId = b->GetObject<Node> ()->GetId (); // id of the node b
 
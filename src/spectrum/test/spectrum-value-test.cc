@@ -76,6 +76,76 @@ SpectrumValueTestCase::DoRun (void)
 }
 
 
+/**
+ * Check that the copies of a SpectrumValue share the values until they
+ * are modified, and that the buffers of the values are recycled
+ */
+class SpectrumValueCopyOnWriteTestCase : public TestCase
+{
+public:
+  SpectrumValueCopyOnWriteTestCase ();
+  virtual void DoRun (void);
+};
+
+SpectrumValueCopyOnWriteTestCase::SpectrumValueCopyOnWriteTestCase ()
+  : TestCase ("Copy on write and pooling of the values of SpectrumValue")
+{
+}
+
+void
+SpectrumValueCopyOnWriteTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (int i = 1; i <= 7; i++)
+    {
+      freqs.push_back (i);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+
+  SpectrumValue a (model);
+  for (uint32_t i = 0; i < a.GetValuesN (); i++)
+    {
+      a[i] = i;
+    }
+
+  uint64_t deepCopies = SpectrumValue::GetDeepCopyCount ();
+  uint64_t sharedCopies = SpectrumValue::GetSharedCopyCount ();
+  SpectrumValue b = a;
+  Ptr<SpectrumValue> c = a.Copy ();
+  NS_TEST_ASSERT_MSG_EQ (SpectrumValue::GetSharedCopyCount () - sharedCopies, 2, "The copies do not share the values");
+  NS_TEST_ASSERT_MSG_EQ (SpectrumValue::GetDeepCopyCount (), deepCopies, "Values copied before being modified");
+  NS_TEST_ASSERT_MSG_EQ (&*b.ConstValuesBegin (), &*a.ConstValuesBegin (), "The copies do not share the values");
+
+  // modifying a copy leaves the others unchanged
+  b *= 2;
+  (*c)[1] = 10;
+  NS_TEST_ASSERT_MSG_EQ (SpectrumValue::GetDeepCopyCount () - deepCopies, 2, "Values not copied when modified");
+  for (uint32_t i = 0; i < a.GetValuesN (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (a[i], i, "Original values modified by a copy");
+      NS_TEST_ASSERT_MSG_EQ (b[i], 2 * i, "Wrong values of the modified copy");
+    }
+  NS_TEST_ASSERT_MSG_EQ ((*c)[1], 10, "Wrong value of the modified copy");
+  NS_TEST_ASSERT_MSG_EQ ((*c)[2], 2, "Wrong value of the modified copy");
+
+  // the last copy is not shared anymore, and is modified in place
+  const double *values = &*c->ConstValuesBegin ();
+  *c += a;
+  NS_TEST_ASSERT_MSG_EQ (&*c->ConstValuesBegin (), values, "Values not modified in place");
+
+  // the buffers of the temporaries are recycled, once the pool holds enough
+  SpectrumValue d = a + b;
+  d = a * b + d / 2.0;
+  uint64_t allocations = SpectrumValue::GetAllocationCount ();
+  for (uint32_t i = 1; i < 10; i++)
+    {
+      d = a * b + d / 2.0;
+    }
+  NS_TEST_ASSERT_MSG_EQ (SpectrumValue::GetAllocationCount (), allocations, "Buffers of the temporaries not recycled");
+  NS_TEST_ASSERT_MSG_EQ_TOL (d[3], 36 - 27 / 1024.0, TOLERANCE, "Wrong result");
+}
+
+
 
 
 
@@ -241,6 +311,7 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  AddTestCase (new SpectrumValueCopyOnWriteTestCase (), TestCase::QUICK);
 
 }
 
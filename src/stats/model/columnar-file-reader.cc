@@ -0,0 +1,397 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "columnar-file-reader.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ColumnarFileReader");
+
+namespace {
+
+/**
+ * \brief Extract a value from a buffer
+ *
+ * \param buffer the buffer
+ * \param [in,out] pos the position of the value, advanced past it
+ * \param [out] value the value
+ * \return false if the buffer is too short
+ */
+template <class T>
+bool
+Get (const std::vector<char> &buffer, std::size_t &pos, T &value)
+{
+  if (pos + sizeof (T) > buffer.size ())
+    {
+      return false;
+    }
+  std::memcpy (&value, buffer.data () + pos, sizeof (T));
+  pos += sizeof (T);
+  return true;
+}
+
+} // unnamed namespace
+
+ColumnarFileReader::ColumnarFileReader ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+ColumnarFileReader::Open (const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_columns.clear ();
+  m_nRows.clear ();
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+
+  m_file.open (filename.c_str (), std::ios_base::in | std::ios_base::binary);
+  if (!m_file.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename);
+      return false;
+    }
+
+  const std::size_t magicSize = sizeof (ColumnarFile::MAGIC);
+  m_file.seekg (0, std::ios_base::end);
+  uint64_t fileSize = m_file.tellg ();
+  if (fileSize < 2 * magicSize + sizeof (uint32_t))
+    {
+      NS_LOG_ERROR (filename << " is not a columnar file");
+      return false;
+    }
+
+  // check the magic at both ends, and read the size of the footer
+  char head[magicSize];
+  m_file.seekg (0);
+  m_file.read (head, magicSize);
+  std::vector<char> tail (sizeof (uint32_t) + magicSize);
+  m_file.seekg (fileSize - tail.size ());
+  m_file.read (tail.data (), tail.size ());
+  if (!m_file
+      || std::memcmp (head, ColumnarFile::MAGIC, magicSize) != 0
+      || std::memcmp (tail.data () + sizeof (uint32_t), ColumnarFile::MAGIC, magicSize) != 0)
+    {
+      NS_LOG_ERROR (filename << " is not a complete columnar file");
+      return false;
+    }
+  std::size_t pos = 0;
+  uint32_t footerSize;
+  Get (tail, pos, footerSize);
+  if (footerSize > fileSize - tail.size () - magicSize)
+    {
+      NS_LOG_ERROR (filename << " has a corrupted footer");
+      return false;
+    }
+
+  std::vector<char> footer (footerSize);
+  m_file.seekg (fileSize - tail.size () - footerSize);
+  m_file.read (footer.data (), footer.size ());
+
+  bool ok = true;
+  pos = 0;
+  uint32_t nColumns = 0;
+  ok = ok && Get (footer, pos, nColumns);
+  for (uint32_t i = 0; ok && i < nColumns; ++i)
+    {
+      uint8_t type;
+      uint32_t nameSize;
+      ok = ok && Get (footer, pos, type) && Get (footer, pos, nameSize)
+        && pos + nameSize <= footer.size ();
+      if (ok)
+        {
+          Column column;
+          column.m_type = static_cast<ColumnarFile::ColumnType> (type);
+          column.m_name.assign (footer.data () + pos, nameSize);
+          pos += nameSize;
+          m_columns.push_back (column);
+        }
+    }
+
+  uint32_t nRowGroups = 0;
+  ok = ok && Get (footer, pos, nRowGroups);
+  for (uint32_t rg = 0; ok && rg < nRowGroups; ++rg)
+    {
+      uint64_t nRows;
+      ok = ok && Get (footer, pos, nRows);
+      m_nRows.push_back (nRows);
+      for (std::vector<Column>::iterator it = m_columns.begin (); ok && it != m_columns.end (); ++it)
+        {
+          Chunk chunk;
+          ok = ok && Get (footer, pos, chunk.m_offset) && Get (footer, pos, chunk.m_size)
+            && Get (footer, pos, chunk.m_width) && Get (footer, pos, chunk.m_min)
+            && Get (footer, pos, chunk.m_max);
+          it->m_chunks.push_back (chunk);
+        }
+    }
+
+  for (std::vector<Column>::iterator it = m_columns.begin (); ok && it != m_columns.end (); ++it)
+    {
+      uint32_t dictionarySize;
+      ok = ok && Get (footer, pos, dictionarySize);
+      for (uint32_t i = 0; ok && i < dictionarySize; ++i)
+        {
+          uint64_t value;
+          ok = ok && Get (footer, pos, value);
+          it->m_dictionary.push_back (value);
+        }
+    }
+
+  if (!ok || !m_file)
+    {
+      NS_LOG_ERROR (filename << " has a corrupted footer");
+      m_columns.clear ();
+      m_nRows.clear ();
+      return false;
+    }
+  return true;
+}
+
+uint32_t
+ColumnarFileReader::GetNColumns (void) const
+{
+  return m_columns.size ();
+}
+
+std::string
+ColumnarFileReader::GetColumnName (uint32_t column) const
+{
+  NS_ASSERT (column < m_columns.size ());
+  return m_columns[column].m_name;
+}
+
+ColumnarFile::ColumnType
+ColumnarFileReader::GetColumnType (uint32_t column) const
+{
+  NS_ASSERT (column < m_columns.size ());
+  return m_columns[column].m_type;
+}
+
+bool
+ColumnarFileReader::FindColumn (const std::string &name, uint32_t &column) const
+{
+  for (uint32_t i = 0; i < m_columns.size (); ++i)
+    {
+      if (m_columns[i].m_name == name)
+        {
+          column = i;
+          return true;
+        }
+    }
+  return false;
+}
+
+uint64_t
+ColumnarFileReader::GetNRows (void) const
+{
+  uint64_t nRows = 0;
+  for (std::vector<uint64_t>::const_iterator it = m_nRows.begin (); it != m_nRows.end (); ++it)
+    {
+      nRows += *it;
+    }
+  return nRows;
+}
+
+uint32_t
+ColumnarFileReader::GetNRowGroups (void) const
+{
+  return m_nRows.size ();
+}
+
+double
+ColumnarFileReader::GetMin (uint32_t column) const
+{
+  NS_ASSERT (column < m_columns.size ());
+  const Column &c = m_columns[column];
+  double min = 0;
+  for (std::vector<Chunk>::const_iterator it = c.m_chunks.begin (); it != c.m_chunks.end (); ++it)
+    {
+      double value = ToDouble (c.m_type, it->m_min);
+      if (it == c.m_chunks.begin () || value < min)
+        {
+          min = value;
+        }
+    }
+  return min;
+}
+
+double
+ColumnarFileReader::GetMax (uint32_t column) const
+{
+  NS_ASSERT (column < m_columns.size ());
+  const Column &c = m_columns[column];
+  double max = 0;
+  for (std::vector<Chunk>::const_iterator it = c.m_chunks.begin (); it != c.m_chunks.end (); ++it)
+    {
+      double value = ToDouble (c.m_type, it->m_max);
+      if (it == c.m_chunks.begin () || value > max)
+        {
+          max = value;
+        }
+    }
+  return max;
+}
+
+const std::vector<uint64_t>&
+ColumnarFileReader::GetDictionary (uint32_t column) const
+{
+  NS_ASSERT (column < m_columns.size ());
+  return m_columns[column].m_dictionary;
+}
+
+bool
+ColumnarFileReader::ReadColumn (uint32_t column, std::vector<int64_t> &values)
+{
+  NS_LOG_FUNCTION (this << column);
+  std::vector<uint64_t> raw;
+  if (column >= m_columns.size () || m_columns[column].m_type != ColumnarFile::INT64
+      || !ReadRaw (column, raw))
+    {
+      return false;
+    }
+  values.assign (raw.begin (), raw.end ());
+  return true;
+}
+
+bool
+ColumnarFileReader::ReadColumn (uint32_t column, std::vector<uint64_t> &values)
+{
+  NS_LOG_FUNCTION (this << column);
+  if (column >= m_columns.size ()
+      || (m_columns[column].m_type != ColumnarFile::UINT64
+          && m_columns[column].m_type != ColumnarFile::DICTIONARY))
+    {
+      return false;
+    }
+  return ReadRaw (column, values);
+}
+
+bool
+ColumnarFileReader::ReadColumn (uint32_t column, std::vector<double> &values)
+{
+  NS_LOG_FUNCTION (this << column);
+  std::vector<uint64_t> raw;
+  if (column >= m_columns.size () || !ReadRaw (column, raw))
+    {
+      return false;
+    }
+  ColumnarFile::ColumnType type = m_columns[column].m_type;
+  values.resize (raw.size ());
+  for (std::size_t i = 0; i < raw.size (); ++i)
+    {
+      values[i] = ToDouble (type, raw[i]);
+    }
+  return true;
+}
+
+bool
+ColumnarFileReader::ReadRaw (uint32_t column, std::vector<uint64_t> &values)
+{
+  const Column &c = m_columns[column];
+  values.clear ();
+  values.reserve (GetNRows ());
+
+  std::vector<char> buffer;
+  for (uint32_t rg = 0; rg < c.m_chunks.size (); ++rg)
+    {
+      const Chunk &chunk = c.m_chunks[rg];
+      if (chunk.m_size != m_nRows[rg] * chunk.m_width)
+        {
+          NS_LOG_ERROR ("Corrupted chunk of column " << c.m_name);
+          return false;
+        }
+      buffer.resize (chunk.m_size);
+      m_file.seekg (chunk.m_offset);
+      m_file.read (buffer.data (), buffer.size ());
+      if (!m_file)
+        {
+          NS_LOG_ERROR ("Can't read chunk of column " << c.m_name);
+          m_file.clear ();
+          return false;
+        }
+
+      std::size_t pos = 0;
+      for (uint64_t i = 0; i < m_nRows[rg]; ++i)
+        {
+          uint64_t value;
+          switch (chunk.m_width)
+            {
+            case 1:
+              {
+                uint8_t v;
+                Get (buffer, pos, v);
+                value = v;
+                break;
+              }
+            case 2:
+              {
+                uint16_t v;
+                Get (buffer, pos, v);
+                value = v;
+                break;
+              }
+            case 4:
+              {
+                uint32_t v;
+                Get (buffer, pos, v);
+                value = v;
+                break;
+              }
+            default:
+              Get (buffer, pos, value);
+            }
+
+          if (c.m_type == ColumnarFile::DICTIONARY)
+            {
+              if (value >= c.m_dictionary.size ())
+                {
+                  NS_LOG_ERROR ("Corrupted chunk of column " << c.m_name);
+                  return false;
+                }
+              value = c.m_dictionary[value];
+            }
+          values.push_back (value);
+        }
+    }
+  return true;
+}
+
+double
+ColumnarFileReader::ToDouble (ColumnarFile::ColumnType type, uint64_t bits)
+{
+  switch (type)
+    {
+    case ColumnarFile::INT64:
+      return static_cast<int64_t> (bits);
+    case ColumnarFile::DOUBLE:
+      {
+        double value;
+        std::memcpy (&value, &bits, sizeof (double));
+        return value;
+      }
+    default:
+      return bits;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef COLUMNAR_FILE_READER_H
+#define COLUMNAR_FILE_READER_H
+
+#include "ns3/columnar-file-writer.h"
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Reads tables written by ColumnarFileWriter
+ *
+ * Open only parses the footer; the values of a column are read from the
+ * file when the column is requested, without touching the other columns.
+ * The minimum and maximum of a column are available from the footer without
+ * reading its values.
+ *
+ * The reader does not need a running simulation, so it can be used by
+ * post-processing programs as well.
+ */
+class ColumnarFileReader
+{
+public:
+  ColumnarFileReader ();
+
+  /**
+   * \brief Open a file and read its footer
+   * \param filename the name of the file
+   * \return false if the file can not be opened or is not a complete
+   *         columnar file
+   */
+  bool Open (const std::string &filename);
+
+  /**
+   * \return the number of columns
+   */
+  uint32_t GetNColumns (void) const;
+  /**
+   * \param column the index of the column
+   * \return the name of the column
+   */
+  std::string GetColumnName (uint32_t column) const;
+  /**
+   * \param column the index of the column
+   * \return the type of the column
+   */
+  ColumnarFile::ColumnType GetColumnType (uint32_t column) const;
+  /**
+   * \brief Look for a column by name
+   * \param name the name of the column
+   * \param [out] column the index of the column, if found
+   * \return true if the column was found
+   */
+  bool FindColumn (const std::string &name, uint32_t &column) const;
+  /**
+   * \return the number of rows
+   */
+  uint64_t GetNRows (void) const;
+  /**
+   * \return the number of row groups
+   */
+  uint32_t GetNRowGroups (void) const;
+
+  /**
+   * \param column the index of the column
+   * \return the minimum value of the column, converted to double
+   */
+  double GetMin (uint32_t column) const;
+  /**
+   * \param column the index of the column
+   * \return the maximum value of the column, converted to double
+   */
+  double GetMax (uint32_t column) const;
+  /**
+   * \param column the index of a DICTIONARY column
+   * \return the distinct values of the column
+   */
+  const std::vector<uint64_t>& GetDictionary (uint32_t column) const;
+
+  /**
+   * \brief Read the values of an INT64 column
+   * \param column the index of the column
+   * \param [out] values the values
+   * \return false if the column has a different type or can not be read
+   */
+  bool ReadColumn (uint32_t column, std::vector<int64_t> &values);
+  /**
+   * \brief Read the values of an UINT64 or DICTIONARY column
+   *
+   * The values of a DICTIONARY column are decoded.
+   *
+   * \param column the index of the column
+   * \param [out] values the values
+   * \return false if the column has a different type or can not be read
+   */
+  bool ReadColumn (uint32_t column, std::vector<uint64_t> &values);
+  /**
+   * \brief Read the values of a column of any type, converted to double
+   * \param column the index of the column
+   * \param [out] values the values
+   * \return false if the column can not be read
+   */
+  bool ReadColumn (uint32_t column, std::vector<double> &values);
+
+private:
+  /**
+   * Position and statistics of a column chunk
+   */
+  struct Chunk
+  {
+    uint64_t m_offset;  //!< offset of the chunk in the file
+    uint64_t m_size;    //!< size of the chunk in bytes
+    uint8_t m_width;    //!< bytes per value
+    uint64_t m_min;     //!< bit pattern of the minimum value
+    uint64_t m_max;     //!< bit pattern of the maximum value
+  };
+
+  /**
+   * Description of a column
+   */
+  struct Column
+  {
+    std::string m_name;                  //!< name
+    ColumnarFile::ColumnType m_type;     //!< type
+    std::vector<Chunk> m_chunks;         //!< one chunk per row group
+    std::vector<uint64_t> m_dictionary;  //!< distinct values of a DICTIONARY column
+  };
+
+  /**
+   * \brief Read the raw values of a column
+   *
+   * The values are the bit patterns of the values, with the dictionary
+   * indexes already decoded.
+   *
+   * \param column the index of the column
+   * \param [out] values the bit patterns of the values
+   * \return false if the column can not be read
+   */
+  bool ReadRaw (uint32_t column, std::vector<uint64_t> &values);
+  /**
+   * \param type the type of a column
+   * \param bits the bit pattern of a value
+   * \return the value converted to double
+   */
+  static double ToDouble (ColumnarFile::ColumnType type, uint64_t bits);
+
+  std::ifstream m_file;            //!< input file
+  std::vector<Column> m_columns;   //!< columns of the table
+  std::vector<uint64_t> m_nRows;   //!< number of rows of each row group
+};
+
+} // namespace ns3
+
+#endif /* COLUMNAR_FILE_READER_H */
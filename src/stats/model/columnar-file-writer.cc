@@ -0,0 +1,337 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "columnar-file-writer.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ColumnarFileWriter");
+
+const char ColumnarFile::MAGIC[8] = { 'N', 'S', '3', 'C', 'O', 'L', '0', '1' };
+
+namespace {
+
+/**
+ * \brief Append the bytes of a value to a buffer
+ * \param buffer the buffer
+ * \param value the value
+ */
+template <class T>
+void
+Put (std::vector<char> &buffer, T value)
+{
+  const char *bytes = reinterpret_cast<const char*> (&value);
+  buffer.insert (buffer.end (), bytes, bytes + sizeof (T));
+}
+
+/**
+ * \brief Compare two values of a column
+ * \param type the type of the column
+ * \param a the bit pattern of the first value
+ * \param b the bit pattern of the second value
+ * \return true if a is smaller than b
+ */
+bool
+IsLess (ColumnarFile::ColumnType type, uint64_t a, uint64_t b)
+{
+  switch (type)
+    {
+    case ColumnarFile::INT64:
+      return static_cast<int64_t> (a) < static_cast<int64_t> (b);
+    case ColumnarFile::DOUBLE:
+      {
+        double da, db;
+        std::memcpy (&da, &a, sizeof (double));
+        std::memcpy (&db, &b, sizeof (double));
+        return da < db;
+      }
+    default:
+      return a < b;
+    }
+}
+
+} // unnamed namespace
+
+ColumnarFileWriter::ColumnarFileWriter ()
+  : m_rowGroupSize (65536),
+    m_bufferedRows (0),
+    m_nRows (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ColumnarFileWriter::~ColumnarFileWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+uint32_t
+ColumnarFileWriter::AddColumn (const std::string &name, ColumnarFile::ColumnType type)
+{
+  NS_LOG_FUNCTION (this << name << type);
+  NS_ASSERT_MSG (!m_file.is_open (), "Columns must be added before opening the file");
+  Column column;
+  column.m_name = name;
+  column.m_type = type;
+  m_columns.push_back (column);
+  return m_columns.size () - 1;
+}
+
+void
+ColumnarFileWriter::SetRowGroupSize (uint32_t rows)
+{
+  NS_LOG_FUNCTION (this << rows);
+  NS_ASSERT (rows > 0);
+  m_rowGroupSize = rows;
+}
+
+bool
+ColumnarFileWriter::Open (const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_file.open (filename.c_str (), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!m_file.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename);
+      return false;
+    }
+  m_file.write (ColumnarFile::MAGIC, sizeof (ColumnarFile::MAGIC));
+  return true;
+}
+
+bool
+ColumnarFileWriter::IsOpen (void) const
+{
+  return m_file.is_open ();
+}
+
+void
+ColumnarFileWriter::SetInt (uint32_t column, int64_t value)
+{
+  NS_ASSERT (column < m_columns.size () && m_columns[column].m_type == ColumnarFile::INT64);
+  SetUint (column, static_cast<uint64_t> (value));
+}
+
+void
+ColumnarFileWriter::SetUint (uint32_t column, uint64_t value)
+{
+  NS_ASSERT (column < m_columns.size ());
+  Column &c = m_columns[column];
+  if (c.m_type == ColumnarFile::DICTIONARY)
+    {
+      std::unordered_map<uint64_t, uint32_t>::const_iterator it = c.m_index.find (value);
+      if (it == c.m_index.end ())
+        {
+          it = c.m_index.insert (std::make_pair (value, c.m_dictionary.size ())).first;
+          c.m_dictionary.push_back (value);
+        }
+      value = it->second;
+    }
+
+  if (c.m_values.size () == m_bufferedRows)
+    {
+      c.m_values.push_back (value);
+    }
+  else
+    {
+      c.m_values.back () = value;
+    }
+}
+
+void
+ColumnarFileWriter::SetDouble (uint32_t column, double value)
+{
+  NS_ASSERT (column < m_columns.size () && m_columns[column].m_type == ColumnarFile::DOUBLE);
+  uint64_t bits;
+  std::memcpy (&bits, &value, sizeof (double));
+  SetUint (column, bits);
+}
+
+void
+ColumnarFileWriter::EndRow (void)
+{
+  for (uint32_t i = 0; i < m_columns.size (); ++i)
+    {
+      if (m_columns[i].m_values.size () == m_bufferedRows)
+        {
+          // the bit pattern of zero is the same for all the types
+          SetUint (i, 0);
+        }
+    }
+  m_bufferedRows++;
+  m_nRows++;
+
+  if (m_bufferedRows >= m_rowGroupSize)
+    {
+      Flush ();
+    }
+}
+
+void
+ColumnarFileWriter::Flush (void)
+{
+  NS_LOG_FUNCTION (this << m_bufferedRows);
+  if (!m_file.is_open () || m_bufferedRows == 0)
+    {
+      return;
+    }
+
+  RowGroup rowGroup;
+  rowGroup.m_nRows = m_bufferedRows;
+  for (std::vector<Column>::iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      // drop the values of a row that was started but not completed
+      it->m_values.resize (m_bufferedRows);
+      rowGroup.m_chunks.push_back (WriteChunk (*it));
+      it->m_values.clear ();
+    }
+  m_rowGroups.push_back (rowGroup);
+  m_bufferedRows = 0;
+  m_file.flush ();
+}
+
+void
+ColumnarFileWriter::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+  Flush ();
+  WriteFooter ();
+  m_file.close ();
+}
+
+uint64_t
+ColumnarFileWriter::GetNRows (void) const
+{
+  return m_nRows;
+}
+
+ColumnarFileWriter::Chunk
+ColumnarFileWriter::WriteChunk (Column &column)
+{
+  Chunk chunk;
+  chunk.m_offset = m_file.tellp ();
+  chunk.m_width = sizeof (uint64_t);
+  chunk.m_min = 0;
+  chunk.m_max = 0;
+
+  std::vector<char> buffer;
+  if (column.m_type == ColumnarFile::DICTIONARY)
+    {
+      if (column.m_dictionary.size () <= 0x100)
+        {
+          chunk.m_width = 1;
+        }
+      else if (column.m_dictionary.size () <= 0x10000)
+        {
+          chunk.m_width = 2;
+        }
+      else
+        {
+          chunk.m_width = 4;
+        }
+    }
+  buffer.reserve (column.m_values.size () * chunk.m_width);
+
+  bool first = true;
+  for (std::vector<uint64_t>::const_iterator it = column.m_values.begin (); it != column.m_values.end (); ++it)
+    {
+      uint64_t value = *it;
+      switch (chunk.m_width)
+        {
+        case 1:
+          Put<uint8_t> (buffer, value);
+          break;
+        case 2:
+          Put<uint16_t> (buffer, value);
+          break;
+        case 4:
+          Put<uint32_t> (buffer, value);
+          break;
+        default:
+          Put<uint64_t> (buffer, value);
+        }
+
+      if (column.m_type == ColumnarFile::DICTIONARY)
+        {
+          value = column.m_dictionary[value];
+        }
+      if (first || IsLess (column.m_type, value, chunk.m_min))
+        {
+          chunk.m_min = value;
+        }
+      if (first || IsLess (column.m_type, chunk.m_max, value))
+        {
+          chunk.m_max = value;
+        }
+      first = false;
+    }
+
+  m_file.write (buffer.data (), buffer.size ());
+  chunk.m_size = buffer.size ();
+  return chunk;
+}
+
+void
+ColumnarFileWriter::WriteFooter (void)
+{
+  std::vector<char> footer;
+
+  Put<uint32_t> (footer, m_columns.size ());
+  for (std::vector<Column>::const_iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      Put<uint8_t> (footer, it->m_type);
+      Put<uint32_t> (footer, it->m_name.size ());
+      footer.insert (footer.end (), it->m_name.begin (), it->m_name.end ());
+    }
+
+  Put<uint32_t> (footer, m_rowGroups.size ());
+  for (std::vector<RowGroup>::const_iterator rg = m_rowGroups.begin (); rg != m_rowGroups.end (); ++rg)
+    {
+      Put<uint64_t> (footer, rg->m_nRows);
+      for (std::vector<Chunk>::const_iterator it = rg->m_chunks.begin (); it != rg->m_chunks.end (); ++it)
+        {
+          Put<uint64_t> (footer, it->m_offset);
+          Put<uint64_t> (footer, it->m_size);
+          Put<uint8_t> (footer, it->m_width);
+          Put<uint64_t> (footer, it->m_min);
+          Put<uint64_t> (footer, it->m_max);
+        }
+    }
+
+  for (std::vector<Column>::const_iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      Put<uint32_t> (footer, it->m_dictionary.size ());
+      for (std::vector<uint64_t>::const_iterator v = it->m_dictionary.begin (); v != it->m_dictionary.end (); ++v)
+        {
+          Put<uint64_t> (footer, *v);
+        }
+    }
+
+  Put<uint32_t> (footer, footer.size ());
+  footer.insert (footer.end (), ColumnarFile::MAGIC, ColumnarFile::MAGIC + sizeof (ColumnarFile::MAGIC));
+  m_file.write (footer.data (), footer.size ());
+}
+
+} // namespace ns3
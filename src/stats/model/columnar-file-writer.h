@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef COLUMNAR_FILE_WRITER_H
+#define COLUMNAR_FILE_WRITER_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Common definitions of the columnar statistics file format
+ *
+ * A columnar file stores a table with a fixed set of typed columns. Rows are
+ * buffered in memory and written in row groups: each row group stores the
+ * values of every column contiguously (a column chunk), so that a reader can
+ * load a single column without touching the others. The file ends with a
+ * footer that describes the columns, the position of every chunk, the
+ * minimum and maximum value of every chunk and the dictionaries of the
+ * dictionary-encoded columns:
+ *
+ * \verbatim
+   magic (8 bytes)
+   row group 0: chunk of column 0, chunk of column 1, ...
+   row group 1: ...
+   footer
+   footer size (uint32_t)
+   magic (8 bytes)
+   \endverbatim
+ *
+ * Numbers are stored in the byte order of the host that wrote the file.
+ */
+class ColumnarFile
+{
+public:
+  /**
+   * Type of the values of a column
+   */
+  enum ColumnType
+  {
+    INT64 = 0,      //!< signed integers, 8 bytes per value
+    UINT64 = 1,     //!< unsigned integers, 8 bytes per value
+    DOUBLE = 2,     //!< floating point numbers, 8 bytes per value
+    DICTIONARY = 3  //!< unsigned identifiers, stored as indexes in a dictionary
+  };
+
+  static const char MAGIC[8]; //!< magic string at the beginning and at the end of the file
+};
+
+/**
+ * \ingroup stats
+ *
+ * \brief Writes tables in the columnar statistics file format
+ *
+ * The columns are declared with AddColumn before the file is opened. Then,
+ * for each row, the value of every column is set with SetInt, SetUint or
+ * SetDouble, and the row is completed with EndRow. A row group is written
+ * every time the number of buffered rows reaches the row group size, and
+ * when Flush is called. The footer is written by Close, which is also called
+ * by the destructor: a file that is not closed cannot be read back.
+ *
+ * Columns of type DICTIONARY are meant for identifiers that repeat over many
+ * rows (IMSIs, node IDs, cell IDs, ...). Each distinct value is stored once
+ * in the footer, and the chunks only contain its index, using 1, 2 or 4
+ * bytes per row depending on the number of distinct values.
+ */
+class ColumnarFileWriter : public SimpleRefCount<ColumnarFileWriter>
+{
+public:
+  ColumnarFileWriter ();
+  /**
+   * Closes the file, if still open
+   */
+  ~ColumnarFileWriter ();
+
+  /**
+   * \brief Add a column to the table
+   * \param name the name of the column
+   * \param type the type of the values of the column
+   * \return the index of the column
+   */
+  uint32_t AddColumn (const std::string &name, ColumnarFile::ColumnType type);
+  /**
+   * \brief Set the number of rows after which a row group is written
+   * \param rows the number of rows
+   */
+  void SetRowGroupSize (uint32_t rows);
+  /**
+   * \brief Create the file, overwriting it if it exists
+   * \param filename the name of the file
+   * \return true if the file was successfully opened
+   */
+  bool Open (const std::string &filename);
+  /**
+   * \return true if the file is open
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * \brief Set the value of an INT64 column in the current row
+   * \param column the index of the column
+   * \param value the value
+   */
+  void SetInt (uint32_t column, int64_t value);
+  /**
+   * \brief Set the value of an UINT64 or DICTIONARY column in the current row
+   * \param column the index of the column
+   * \param value the value
+   */
+  void SetUint (uint32_t column, uint64_t value);
+  /**
+   * \brief Set the value of a DOUBLE column in the current row
+   * \param column the index of the column
+   * \param value the value
+   */
+  void SetDouble (uint32_t column, double value);
+  /**
+   * \brief Complete the current row
+   *
+   * Columns whose value was not set in the current row are set to zero.
+   */
+  void EndRow (void);
+
+  /**
+   * \brief Write the buffered rows as a new row group
+   */
+  void Flush (void);
+  /**
+   * \brief Write the buffered rows and the footer, and close the file
+   */
+  void Close (void);
+  /**
+   * \return the number of rows completed so far
+   */
+  uint64_t GetNRows (void) const;
+
+private:
+  /**
+   * Description and buffered values of a column
+   */
+  struct Column
+  {
+    std::string m_name;                              //!< name
+    ColumnarFile::ColumnType m_type;                 //!< type
+    std::vector<uint64_t> m_values;                  //!< buffered values (bit pattern or dictionary index)
+    std::vector<uint64_t> m_dictionary;              //!< distinct values of a DICTIONARY column
+    std::unordered_map<uint64_t, uint32_t> m_index;  //!< index of each distinct value in m_dictionary
+  };
+
+  /**
+   * Position and statistics of a column chunk
+   */
+  struct Chunk
+  {
+    uint64_t m_offset;  //!< offset of the chunk in the file
+    uint64_t m_size;    //!< size of the chunk in bytes
+    uint8_t m_width;    //!< bytes per value
+    uint64_t m_min;     //!< bit pattern of the minimum value
+    uint64_t m_max;     //!< bit pattern of the maximum value
+  };
+
+  /**
+   * Position of a row group and of its chunks
+   */
+  struct RowGroup
+  {
+    uint64_t m_nRows;            //!< number of rows
+    std::vector<Chunk> m_chunks; //!< one chunk per column
+  };
+
+  /**
+   * \brief Write the buffered values of a column as a chunk
+   * \param column the column
+   * \return the description of the written chunk
+   */
+  Chunk WriteChunk (Column &column);
+  /**
+   * \brief Write the footer
+   */
+  void WriteFooter (void);
+
+  std::ofstream m_file;                //!< output file
+  std::vector<Column> m_columns;       //!< columns of the table
+  std::vector<RowGroup> m_rowGroups;   //!< row groups written so far
+  uint32_t m_rowGroupSize;             //!< rows per row group
+  uint64_t m_bufferedRows;             //!< rows buffered since the last row group
+  uint64_t m_nRows;                    //!< total number of rows
+};
+
+} // namespace ns3
+
+#endif /* COLUMNAR_FILE_WRITER_H */
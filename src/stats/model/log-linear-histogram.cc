@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "log-linear-histogram.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LogLinearHistogram");
+
+namespace {
+
+/**
+ * \param value a positive value
+ * \return the position of the most significant bit set in the value
+ */
+inline uint8_t
+GetMsb (uint64_t value)
+{
+#if defined (__GNUC__)
+  return 63 - __builtin_clzll (value);
+#else
+  uint8_t msb = 0;
+  while (value >>= 1)
+    {
+      msb++;
+    }
+  return msb;
+#endif
+}
+
+} // unnamed namespace
+
+LogLinearHistogram::LogLinearHistogram (uint8_t precision)
+  : m_precision (precision)
+{
+  NS_ABORT_MSG_IF (precision < 1 || precision > 16, "Unsupported precision " << +precision);
+  Clear ();
+}
+
+void
+LogLinearHistogram::AddValue (uint64_t value, uint64_t count)
+{
+  if (count == 0)
+    {
+      return;
+    }
+
+  uint32_t bucket = GetBucket (value);
+  if (bucket >= m_buckets.size ())
+    {
+      m_buckets.resize (bucket + 1, 0);
+    }
+  m_buckets[bucket] += count;
+
+  if (m_count == 0 || value < m_min)
+    {
+      m_min = value;
+    }
+  if (m_count == 0 || value > m_max)
+    {
+      m_max = value;
+    }
+  m_count += count;
+  m_sum += static_cast<double> (value) * count;
+}
+
+void
+LogLinearHistogram::Merge (const LogLinearHistogram &other)
+{
+  NS_ABORT_MSG_IF (other.m_precision != m_precision,
+                   "Can't merge histograms with precision " << +m_precision << " and " << +other.m_precision);
+  if (other.m_count == 0)
+    {
+      return;
+    }
+
+  if (other.m_buckets.size () > m_buckets.size ())
+    {
+      m_buckets.resize (other.m_buckets.size (), 0);
+    }
+  for (uint32_t i = 0; i < other.m_buckets.size (); ++i)
+    {
+      m_buckets[i] += other.m_buckets[i];
+    }
+
+  if (m_count == 0 || other.m_min < m_min)
+    {
+      m_min = other.m_min;
+    }
+  if (m_count == 0 || other.m_max > m_max)
+    {
+      m_max = other.m_max;
+    }
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+}
+
+void
+LogLinearHistogram::Clear (void)
+{
+  m_buckets.clear ();
+  m_count = 0;
+  m_min = 0;
+  m_max = 0;
+  m_sum = 0;
+}
+
+uint8_t
+LogLinearHistogram::GetPrecision (void) const
+{
+  return m_precision;
+}
+
+uint64_t
+LogLinearHistogram::GetCount (void) const
+{
+  return m_count;
+}
+
+uint64_t
+LogLinearHistogram::GetMin (void) const
+{
+  return m_min;
+}
+
+uint64_t
+LogLinearHistogram::GetMax (void) const
+{
+  return m_max;
+}
+
+double
+LogLinearHistogram::GetMean (void) const
+{
+  return m_count > 0 ? m_sum / m_count : 0.0;
+}
+
+uint64_t
+LogLinearHistogram::GetQuantile (double quantile) const
+{
+  if (m_count == 0 || quantile <= 0)
+    {
+      return m_min;
+    }
+  if (quantile >= 1)
+    {
+      return m_max;
+    }
+
+  // rank of the quantile among the sorted values, starting from 1
+  uint64_t rank = std::max<uint64_t> (1, std::ceil (quantile * m_count));
+  uint64_t cumulative = 0;
+  for (uint32_t i = 0; i < m_buckets.size (); ++i)
+    {
+      cumulative += m_buckets[i];
+      if (cumulative >= rank)
+        {
+          uint64_t estimate = GetBucketStart (i) + (GetBucketWidth (i) - 1) / 2;
+          return std::min (std::max (estimate, m_min), m_max);
+        }
+    }
+  return m_max;
+}
+
+void
+LogLinearHistogram::Serialize (std::ostream &os) const
+{
+  std::streamsize precision = os.precision (std::numeric_limits<double>::digits10 + 2);
+
+  uint32_t nBuckets = 0;
+  for (std::vector<uint64_t>::const_iterator it = m_buckets.begin (); it != m_buckets.end (); ++it)
+    {
+      if (*it > 0)
+        {
+          nBuckets++;
+        }
+    }
+
+  os << +m_precision << " " << m_count << " " << m_min << " " << m_max << " " << m_sum << " " << nBuckets;
+  for (uint32_t i = 0; i < m_buckets.size (); ++i)
+    {
+      if (m_buckets[i] > 0)
+        {
+          os << " " << i << " " << m_buckets[i];
+        }
+    }
+
+  os.precision (precision);
+}
+
+bool
+LogLinearHistogram::Deserialize (std::istream &is)
+{
+  uint32_t precision;
+  uint64_t count;
+  uint64_t min;
+  uint64_t max;
+  double sum;
+  uint32_t nBuckets;
+  if (!(is >> precision >> count >> min >> max >> sum >> nBuckets)
+      || precision < 1 || precision > 16)
+    {
+      NS_LOG_WARN ("Invalid histogram header");
+      return false;
+    }
+
+  LogLinearHistogram histogram (precision);
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < nBuckets; ++i)
+    {
+      uint32_t bucket;
+      uint64_t bucketCount;
+      if (!(is >> bucket >> bucketCount) || bucket > histogram.GetBucket (std::numeric_limits<uint64_t>::max ()))
+        {
+          NS_LOG_WARN ("Invalid histogram bucket");
+          return false;
+        }
+      if (bucket >= histogram.m_buckets.size ())
+        {
+          histogram.m_buckets.resize (bucket + 1, 0);
+        }
+      histogram.m_buckets[bucket] += bucketCount;
+      total += bucketCount;
+    }
+  if (total != count)
+    {
+      NS_LOG_WARN ("Inconsistent histogram count");
+      return false;
+    }
+
+  histogram.m_count = count;
+  histogram.m_min = min;
+  histogram.m_max = max;
+  histogram.m_sum = sum;
+  *this = histogram;
+  return true;
+}
+
+uint32_t
+LogLinearHistogram::GetBucket (uint64_t value) const
+{
+  if (value < (uint64_t (1) << (m_precision + 1)))
+    {
+      // one bucket per value
+      return value;
+    }
+  // keep the m_precision bits following the most significant one
+  uint8_t shift = GetMsb (value) - m_precision;
+  return (uint32_t (shift) << m_precision) + (value >> shift);
+}
+
+uint64_t
+LogLinearHistogram::GetBucketStart (uint32_t bucket) const
+{
+  if (bucket < (uint32_t (1) << (m_precision + 1)))
+    {
+      return bucket;
+    }
+  uint8_t shift = (bucket >> m_precision) - 1;
+  uint64_t mantissa = bucket - (uint32_t (shift) << m_precision);
+  return mantissa << shift;
+}
+
+uint64_t
+LogLinearHistogram::GetBucketWidth (uint32_t bucket) const
+{
+  if (bucket < (uint32_t (1) << (m_precision + 1)))
+    {
+      return 1;
+    }
+  uint8_t shift = (bucket >> m_precision) - 1;
+  return uint64_t (1) << shift;
+}
+
+} // namespace ns3
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LOG_LINEAR_HISTOGRAM_H
+#define LOG_LINEAR_HISTOGRAM_H
+
+#include <vector>
+#include <stdint.h>
+#include <istream>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Histogram with bounded relative error, used to estimate quantiles
+ *
+ * The histogram counts non-negative integer values (e.g., delays in
+ * nanoseconds) in log-linear buckets, in the same way as HDR histograms: each
+ * power of two [2^k, 2^(k+1)) is split in 2^p buckets of equal width, where p
+ * is the precision of the histogram, and values smaller than 2^(p+1) have a
+ * bucket each. The width of a bucket is thus at most 2^-p times the values it
+ * holds, and so is the error of the quantiles.
+ *
+ * The memory used by the histogram only depends on the precision and on the
+ * largest value added, not on the number of values. Histograms with the same
+ * precision can be merged, e.g., to combine the results of several runs, and
+ * serialized to text streams.
+ */
+class LogLinearHistogram
+{
+public:
+  /**
+   * \brief Constructor
+   * \param precision number of bits of the values that are preserved
+   */
+  LogLinearHistogram (uint8_t precision = 7);
+
+  /**
+   * \brief Add a value to the histogram
+   * \param value the value
+   * \param count the number of occurrences of the value
+   */
+  void AddValue (uint64_t value, uint64_t count = 1);
+  /**
+   * \brief Add the values of another histogram
+   *
+   * The two histograms must have the same precision.
+   *
+   * \param other the other histogram
+   */
+  void Merge (const LogLinearHistogram &other);
+  /**
+   * \brief Remove all the values
+   */
+  void Clear (void);
+
+  /**
+   * \return the precision of the histogram
+   */
+  uint8_t GetPrecision (void) const;
+  /**
+   * \return the number of values added
+   */
+  uint64_t GetCount (void) const;
+  /**
+   * \return the smallest value added, or 0 if the histogram is empty
+   */
+  uint64_t GetMin (void) const;
+  /**
+   * \return the largest value added, or 0 if the histogram is empty
+   */
+  uint64_t GetMax (void) const;
+  /**
+   * \return the mean of the values added, or 0 if the histogram is empty
+   */
+  double GetMean (void) const;
+  /**
+   * \brief Estimate a quantile of the values added
+   *
+   * The estimate is the middle point of the bucket holding the quantile,
+   * bounded by the smallest and the largest values added.
+   *
+   * \param quantile the quantile, between 0 and 1 (e.g., 0.99 for the 99th
+   *        percentile)
+   * \return the estimate, or 0 if the histogram is empty
+   */
+  uint64_t GetQuantile (double quantile) const;
+
+  /**
+   * \brief Write the histogram to a stream
+   *
+   * The histogram is written in a single line, with the precision, the
+   * statistics of the values, the number of non-empty buckets and
+   * the index and count of each non-empty bucket.
+   *
+   * \param os the output stream
+   */
+  void Serialize (std::ostream &os) const;
+  /**
+   * \brief Read a histogram written by Serialize
+   * \param is the input stream
+   * \return false if the stream does not contain a valid histogram
+   */
+  bool Deserialize (std::istream &is);
+
+private:
+  /**
+   * \param value a value
+   * \return the index of the bucket holding the value
+   */
+  uint32_t GetBucket (uint64_t value) const;
+  /**
+   * \param bucket the index of a bucket
+   * \return the smallest value held by the bucket
+   */
+  uint64_t GetBucketStart (uint32_t bucket) const;
+  /**
+   * \param bucket the index of a bucket
+   * \return the number of distinct values held by the bucket
+   */
+  uint64_t GetBucketWidth (uint32_t bucket) const;
+
+  uint8_t m_precision;             //!< bits of the values preserved by the buckets
+  std::vector<uint64_t> m_buckets; //!< number of values in each bucket
+  uint64_t m_count;                //!< number of values
+  uint64_t m_min;                  //!< smallest value
+  uint64_t m_max;                  //!< largest value
+  double m_sum;                    //!< sum of the values
+};
+
+} // namespace ns3
+
+#endif /* LOG_LINEAR_HISTOGRAM_H */
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "sweep-runner.h"
+#include "ns3/abort.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/warm-start.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <sys/wait.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SweepRunner");
+
+const std::string &
+SweepRunner::Point::Get (const std::string &name) const
+{
+  std::map<std::string, std::string>::const_iterator it = parameters.find (name);
+  NS_ABORT_MSG_IF (it == parameters.end (), "Unknown parameter " << name);
+  return it->second;
+}
+
+double
+SweepRunner::Point::GetDouble (const std::string &name) const
+{
+  const std::string &value = Get (name);
+  char *end;
+  double number = std::strtod (value.c_str (), &end);
+  NS_ABORT_MSG_IF (value.empty () || *end != '\0', "Parameter " << name << " is not a number: " << value);
+  return number;
+}
+
+SweepRunner::SweepRunner ()
+  : m_nRuns (1),
+    m_firstRun (1),
+    m_maxWorkers (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SweepRunner::AddParameter (const std::string &name, const std::vector<std::string> &values)
+{
+  NS_LOG_FUNCTION (this << name << values.size ());
+  NS_ABORT_MSG_IF (values.empty (), "No values for parameter " << name);
+  for (std::vector<Parameter>::const_iterator it = m_parameters.begin (); it != m_parameters.end (); ++it)
+    {
+      NS_ABORT_MSG_IF (it->name == name, "Parameter " << name << " added twice");
+    }
+  Parameter parameter;
+  parameter.name = name;
+  parameter.values = values;
+  m_parameters.push_back (parameter);
+}
+
+void
+SweepRunner::SetRuns (uint32_t nRuns, uint64_t firstRun)
+{
+  NS_LOG_FUNCTION (this << nRuns << firstRun);
+  NS_ABORT_MSG_IF (nRuns == 0, "At least one run is needed");
+  m_nRuns = nRuns;
+  m_firstRun = firstRun;
+}
+
+void
+SweepRunner::SetMaxWorkers (uint32_t maxWorkers)
+{
+  NS_LOG_FUNCTION (this << maxWorkers);
+  m_maxWorkers = maxWorkers;
+}
+
+uint32_t
+SweepRunner::GetNPoints (void) const
+{
+  uint32_t n = m_nRuns;
+  for (std::vector<Parameter>::const_iterator it = m_parameters.begin (); it != m_parameters.end (); ++it)
+    {
+      n *= it->values.size ();
+    }
+  return n;
+}
+
+SweepRunner::Point
+SweepRunner::GetPoint (uint32_t index) const
+{
+  NS_ABORT_MSG_IF (index >= GetNPoints (), "Point " << index << " out of range");
+  Point point;
+  point.index = index;
+  point.run = m_firstRun + index % m_nRuns;
+  uint32_t rest = index / m_nRuns;
+  for (std::vector<Parameter>::const_reverse_iterator it = m_parameters.rbegin (); it != m_parameters.rend (); ++it)
+    {
+      point.parameters[it->name] = it->values[rest % it->values.size ()];
+      rest /= it->values.size ();
+    }
+  return point;
+}
+
+uint32_t
+SweepRunner::Run (RunCallback callback, const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  int32_t index = WarmStart::Fork (GetNPoints (), m_maxWorkers);
+  if (index >= 0)
+    {
+      Point point = GetPoint (index);
+      for (std::map<std::string, std::string>::const_iterator it = point.parameters.begin ();
+           it != point.parameters.end (); ++it)
+        {
+          if (it->first.find ("::") != std::string::npos)
+            {
+              Config::SetDefault (it->first, StringValue (it->second));
+            }
+        }
+      WarmStart::SetRun (point.run);
+      Summary summary = callback (point);
+      std::ostringstream os;
+      for (Summary::const_iterator it = summary.begin (); it != summary.end (); ++it)
+        {
+          NS_ABORT_MSG_IF (it->first.find_first_of ("\t\n") != std::string::npos
+                           || it->second.find_first_of ("\t\n") != std::string::npos,
+                           "Tab or newline in the summary column " << it->first);
+          os << it->first << '\t' << it->second << '\n';
+        }
+      WarmStart::Report (os.str ());
+      WarmStart::Exit (0);
+    }
+
+  // columns of the summaries, in the order in which they first appear
+  std::vector<WarmStart::Result> results = WarmStart::GetResults ();
+  std::vector<std::string> columns;
+  std::vector<std::map<std::string, std::string> > summaries (results.size ());
+  std::vector<int> statuses (results.size ());
+  uint32_t failed = 0;
+  for (uint32_t i = 0; i < results.size (); i++)
+    {
+      // the status of a worker killed by a signal is reported as by the shells
+      int status = results[i].status;
+      statuses[i] = WIFEXITED (status) ? WEXITSTATUS (status) : 128 + WTERMSIG (status);
+      if (statuses[i] != 0)
+        {
+          NS_LOG_WARN ("Point " << i << " failed with status " << statuses[i]);
+          failed++;
+        }
+      std::istringstream is (results[i].output);
+      std::string line;
+      while (std::getline (is, line))
+        {
+          std::string::size_type tab = line.find ('\t');
+          if (tab == std::string::npos)
+            {
+              continue;
+            }
+          std::string name = line.substr (0, tab);
+          if (std::find (columns.begin (), columns.end (), name) == columns.end ())
+            {
+              columns.push_back (name);
+            }
+          summaries[i][name] = line.substr (tab + 1);
+        }
+    }
+
+  std::ofstream file (filename.c_str ());
+  NS_ABORT_MSG_IF (!file.is_open (), "Can't open " << filename);
+  file << "point\trun\tstatus";
+  for (std::vector<Parameter>::const_iterator it = m_parameters.begin (); it != m_parameters.end (); ++it)
+    {
+      file << '\t' << it->name;
+    }
+  for (std::vector<std::string>::const_iterator it = columns.begin (); it != columns.end (); ++it)
+    {
+      file << '\t' << *it;
+    }
+  file << std::endl;
+  for (uint32_t i = 0; i < results.size (); i++)
+    {
+      Point point = GetPoint (results[i].child);
+      file << point.index << '\t' << point.run << '\t' << statuses[i];
+      for (std::vector<Parameter>::const_iterator it = m_parameters.begin (); it != m_parameters.end (); ++it)
+        {
+          file << '\t' << point.parameters[it->name];
+        }
+      for (std::vector<std::string>::const_iterator it = columns.begin (); it != columns.end (); ++it)
+        {
+          std::map<std::string, std::string>::const_iterator value = summaries[i].find (*it);
+          file << '\t' << (value != summaries[i].end () ? value->second : "");
+        }
+      file << std::endl;
+    }
+  return failed;
+}
+
+} // namespace ns3
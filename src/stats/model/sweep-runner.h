@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SWEEP_RUNNER_H
+#define SWEEP_RUNNER_H
+
+#include "ns3/callback.h"
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Run the points of a parameter sweep in a pool of worker processes
+ *
+ * The sweep is the cartesian product of the values of its parameters,
+ * repeated for a number of runs of the random number generators. Each
+ * point is simulated in its own process, forked from the calling one with
+ * WarmStart::Fork, so that the program and its modules are loaded once for
+ * the whole sweep, and as many points as the online processors are
+ * simulated at the same time. If the calling process simulated part of the
+ * scenario before, every point continues from that state.
+ *
+ * In the worker process of a point, the parameters whose name contains
+ * "::", e.g., "ns3::MmWaveSidelinkMac::Mcs", are applied with
+ * Config::SetDefault, the run number is set with WarmStart::SetRun, and
+ * the run callback is invoked. The callback builds and simulates the
+ * scenario, reading the other parameters from the point, and returns a
+ * summary of the results, e.g., the throughput and delay computed by a
+ * BurstyAppStatsCalculator or by a FlowMonitor. The summaries are sent to
+ * the calling process through pipes, and written in a single
+ * tab-separated file, with one line per point:
+ *
+ * \verbatim
+   point  run  status  <parameters...>  <summary...>
+   \endverbatim
+ *
+ * where status is the exit status of the worker, 0 if it succeeded.
+ *
+ * The same run numbers are used for all the combinations of the
+ * parameters, so that they are compared with common random numbers.
+ */
+class SweepRunner
+{
+public:
+  /**
+   * Summary of the results of a point: names and values of the columns of
+   * the result file, which must not contain tabs or newlines
+   */
+  typedef std::vector<std::pair<std::string, std::string> > Summary;
+
+  /**
+   * A point of the sweep
+   */
+  struct Point
+  {
+    uint32_t index; //!< index of the point, in the order of the result file
+    uint64_t run;   //!< run number of the random number generators
+    std::map<std::string, std::string> parameters; //!< values of the parameters
+
+    /**
+     * \brief Get the value of a parameter
+     * \param name the name of the parameter
+     * \return the value of the parameter
+     */
+    const std::string & Get (const std::string &name) const;
+    /**
+     * \brief Get the value of a numeric parameter
+     * \param name the name of the parameter
+     * \return the value of the parameter, converted to a number
+     */
+    double GetDouble (const std::string &name) const;
+  };
+
+  /**
+   * Callback which simulates a point and returns the summary of its results
+   */
+  typedef Callback<Summary, const Point &> RunCallback;
+
+  SweepRunner ();
+
+  /**
+   * \brief Add a parameter to the sweep
+   * \param name the name of the parameter, or of the attribute default it sets
+   * \param values the values of the parameter
+   */
+  void AddParameter (const std::string &name, const std::vector<std::string> &values);
+  /**
+   * \brief Set the runs of each combination of the parameters
+   * \param nRuns the number of runs
+   * \param firstRun the run number of the first run
+   */
+  void SetRuns (uint32_t nRuns, uint64_t firstRun = 1);
+  /**
+   * \brief Set the maximum number of worker processes
+   * \param maxWorkers the maximum number of workers, or 0 for the number of
+   *        online processors
+   */
+  void SetMaxWorkers (uint32_t maxWorkers);
+
+  /**
+   * \return the number of points of the sweep
+   */
+  uint32_t GetNPoints (void) const;
+  /**
+   * \brief Get a point of the sweep
+   *
+   * The last parameter added varies fastest, and the run faster still.
+   *
+   * \param index the index of the point
+   * \return the point
+   */
+  Point GetPoint (uint32_t index) const;
+
+  /**
+   * \brief Simulate all the points and write the result file
+   *
+   * This returns in the calling process only, once all the workers exited.
+   *
+   * \param callback the callback which simulates a point
+   * \param filename the name of the result file
+   * \return the number of points whose worker failed
+   */
+  uint32_t Run (RunCallback callback, const std::string &filename);
+
+private:
+  /**
+   * Parameter of the sweep
+   */
+  struct Parameter
+  {
+    std::string name;                //!< name
+    std::vector<std::string> values; //!< values
+  };
+
+  std::vector<Parameter> m_parameters; //!< parameters, in the order they were added
+  uint32_t m_nRuns;                    //!< number of runs of each combination
+  uint64_t m_firstRun;                 //!< run number of the first run
+  uint32_t m_maxWorkers;               //!< maximum number of worker processes
+};
+
+} // namespace ns3
+
+#endif /* SWEEP_RUNNER_H */
@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/columnar-file-writer.h"
+#include "ns3/columnar-file-reader.h"
+#include "ns3/test.h"
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief Write a table with the columnar writer and read it back
+ */
+class ColumnarFileTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param nRows number of rows to write
+   * \param rowGroupSize rows per row group
+   * \param nIds number of distinct values of the dictionary column
+   */
+  ColumnarFileTestCase (uint32_t nRows, uint32_t rowGroupSize, uint32_t nIds);
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nRows;         //!< number of rows to write
+  uint32_t m_rowGroupSize;  //!< rows per row group
+  uint32_t m_nIds;          //!< number of distinct values of the dictionary column
+};
+
+ColumnarFileTestCase::ColumnarFileTestCase (uint32_t nRows, uint32_t rowGroupSize, uint32_t nIds)
+  : TestCase ("Columnar file with " + std::to_string (nRows) + " rows, row groups of "
+              + std::to_string (rowGroupSize) + " rows and " + std::to_string (nIds) + " IDs"),
+    m_nRows (nRows),
+    m_rowGroupSize (rowGroupSize),
+    m_nIds (nIds)
+{
+}
+
+void
+ColumnarFileTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("columnar-file-test.col");
+
+  std::vector<int64_t> ints;
+  std::vector<uint64_t> uints;
+  std::vector<uint64_t> ids;
+  std::vector<double> doubles;
+  for (uint32_t i = 0; i < m_nRows; ++i)
+    {
+      ints.push_back (static_cast<int64_t> (i) - m_nRows / 2);
+      uints.push_back (uint64_t (i) * 1000003);
+      ids.push_back (1000000000ULL + (i * 7) % m_nIds);
+      doubles.push_back (i * 0.25 - 3.5);
+    }
+
+  {
+    Ptr<ColumnarFileWriter> writer = Create<ColumnarFileWriter> ();
+    uint32_t intCol = writer->AddColumn ("int", ColumnarFile::INT64);
+    uint32_t uintCol = writer->AddColumn ("uint", ColumnarFile::UINT64);
+    uint32_t idCol = writer->AddColumn ("id", ColumnarFile::DICTIONARY);
+    uint32_t doubleCol = writer->AddColumn ("double", ColumnarFile::DOUBLE);
+    uint32_t unsetCol = writer->AddColumn ("unset", ColumnarFile::DOUBLE);
+    writer->SetRowGroupSize (m_rowGroupSize);
+    NS_TEST_ASSERT_MSG_EQ (writer->Open (filename), true, "Can't create " << filename);
+
+    for (uint32_t i = 0; i < m_nRows; ++i)
+      {
+        // set the columns in an order different from the declaration
+        writer->SetDouble (doubleCol, doubles[i]);
+        writer->SetUint (idCol, ids[i]);
+        writer->SetInt (intCol, ints[i]);
+        writer->SetUint (uintCol, uints[i]);
+        writer->EndRow ();
+      }
+    NS_TEST_ASSERT_MSG_EQ (writer->GetNRows (), m_nRows, "Wrong number of rows written");
+    NS_TEST_ASSERT_MSG_EQ (unsetCol, 4, "Wrong column index");
+    // the file is closed when the writer is destroyed
+  }
+
+  ColumnarFileReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (filename), true, "Can't read " << filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNColumns (), 5, "Wrong number of columns");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNRows (), m_nRows, "Wrong number of rows");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNRowGroups (), (m_nRows + m_rowGroupSize - 1) / m_rowGroupSize,
+                         "Wrong number of row groups");
+
+  uint32_t col;
+  NS_TEST_ASSERT_MSG_EQ (reader.FindColumn ("id", col), true, "Column not found");
+  NS_TEST_ASSERT_MSG_EQ (col, 2, "Wrong column index");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetColumnType (col), ColumnarFile::DICTIONARY, "Wrong column type");
+  NS_TEST_ASSERT_MSG_EQ (reader.FindColumn ("missing", col), false, "Unexpected column");
+
+  std::vector<int64_t> readInts;
+  NS_TEST_ASSERT_MSG_EQ (reader.ReadColumn (0, readInts), true, "Can't read column");
+  NS_TEST_ASSERT_MSG_EQ ((readInts == ints), true, "Wrong INT64 values");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetMin (0), ints.front (), "Wrong INT64 minimum");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetMax (0), ints.back (), "Wrong INT64 maximum");
+
+  std::vector<uint64_t> readUints;
+  NS_TEST_ASSERT_MSG_EQ (reader.ReadColumn (1, readUints), true, "Can't read column");
+  NS_TEST_ASSERT_MSG_EQ ((readUints == uints), true, "Wrong UINT64 values");
+  NS_TEST_ASSERT_MSG_EQ (reader.ReadColumn (0, readUints), false, "Type mismatch not detected");
+
+  std::vector<uint64_t> readIds;
+  NS_TEST_ASSERT_MSG_EQ (reader.ReadColumn (2, readIds), true, "Can't read column");
+  NS_TEST_ASSERT_MSG_EQ ((readIds == ids), true, "Wrong DICTIONARY values");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetDictionary (2).size (), std::min (m_nIds, m_nRows),
+                         "Wrong dictionary size");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetMin (2), 1000000000ULL, "Wrong DICTIONARY minimum");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetMax (2), 1000000000ULL + std::min (m_nIds, m_nRows) - 1,
+                         "Wrong DICTIONARY maximum");
+
+  std::vector<double> readDoubles;
+  NS_TEST_ASSERT_MSG_EQ (reader.ReadColumn (3, readDoubles), true, "Can't read column");
+  NS_TEST_ASSERT_MSG_EQ ((readDoubles == doubles), true, "Wrong DOUBLE values");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetMin (3), doubles.front (), "Wrong DOUBLE minimum");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetMax (3), doubles.back (), "Wrong DOUBLE maximum");
+
+  NS_TEST_ASSERT_MSG_EQ (reader.ReadColumn (4, readDoubles), true, "Can't read column");
+  NS_TEST_ASSERT_MSG_EQ ((readDoubles == std::vector<double> (m_nRows, 0.0)), true,
+                         "Unset values are not zero");
+
+  // any column can be read as double
+  NS_TEST_ASSERT_MSG_EQ (reader.ReadColumn (2, readDoubles), true, "Can't read column");
+  NS_TEST_ASSERT_MSG_EQ (readDoubles.back (), ids.back (), "Wrong conversion to double");
+
+  std::remove (filename.c_str ());
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief A file without footer must be rejected
+ */
+class ColumnarFileTruncatedTestCase : public TestCase
+{
+public:
+  ColumnarFileTruncatedTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ColumnarFileTruncatedTestCase::ColumnarFileTruncatedTestCase ()
+  : TestCase ("Truncated columnar file")
+{
+}
+
+void
+ColumnarFileTruncatedTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("columnar-file-truncated.col");
+
+  ColumnarFileWriter writer;
+  uint32_t col = writer.AddColumn ("value", ColumnarFile::UINT64);
+  writer.SetRowGroupSize (10);
+  NS_TEST_ASSERT_MSG_EQ (writer.Open (filename), true, "Can't create " << filename);
+  for (uint32_t i = 0; i < 25; ++i)
+    {
+      writer.SetUint (col, i);
+      writer.EndRow ();
+    }
+
+  // two row groups have been written, but not the footer
+  ColumnarFileReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (filename), false, "Truncated file accepted");
+
+  writer.Close ();
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (filename), true, "Can't read " << filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNRowGroups (), 3, "Wrong number of row groups");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetMax (col), 24, "Wrong maximum");
+
+  std::remove (filename.c_str ());
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief Columnar file TestSuite
+ */
+class ColumnarFileTestSuite : public TestSuite
+{
+public:
+  ColumnarFileTestSuite ();
+};
+
+ColumnarFileTestSuite::ColumnarFileTestSuite ()
+  : TestSuite ("columnar-file", UNIT)
+{
+  AddTestCase (new ColumnarFileTestCase (1, 100, 1), TestCase::QUICK);
+  AddTestCase (new ColumnarFileTestCase (1000, 1000, 10), TestCase::QUICK);
+  AddTestCase (new ColumnarFileTestCase (1000, 64, 300), TestCase::QUICK);
+  AddTestCase (new ColumnarFileTestCase (100000, 30000, 70001), TestCase::QUICK);
+  AddTestCase (new ColumnarFileTruncatedTestCase, TestCase::QUICK);
+}
+
+static ColumnarFileTestSuite columnarFileTestSuite; //!< Static variable for test initialization
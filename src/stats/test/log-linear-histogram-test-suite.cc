@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/log-linear-histogram.h"
+#include "ns3/test.h"
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief Compare the quantiles of a LogLinearHistogram with the exact ones
+ */
+class LogLinearHistogramQuantileTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param precision precision of the histogram
+   * \param step distance between consecutive values
+   */
+  LogLinearHistogramQuantileTestCase (uint8_t precision, uint64_t step);
+
+private:
+  virtual void DoRun (void);
+
+  uint8_t m_precision;  //!< precision of the histogram
+  uint64_t m_step;      //!< distance between consecutive values
+};
+
+LogLinearHistogramQuantileTestCase::LogLinearHistogramQuantileTestCase (uint8_t precision, uint64_t step)
+  : TestCase ("Quantiles with precision " + std::to_string (precision) + " and values spaced by "
+              + std::to_string (step)),
+    m_precision (precision),
+    m_step (step)
+{
+}
+
+void
+LogLinearHistogramQuantileTestCase::DoRun (void)
+{
+  const uint64_t nValues = 100000;
+  LogLinearHistogram histogram (m_precision);
+  // add the values in a scrambled order
+  for (uint64_t i = 0; i < nValues; ++i)
+    {
+      histogram.AddValue (((i * 7919) % nValues + 1) * m_step);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (), nValues, "Wrong count");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetMin (), m_step, "Wrong minimum");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetMax (), nValues * m_step, "Wrong maximum");
+  NS_TEST_ASSERT_MSG_EQ_TOL (histogram.GetMean (), (nValues + 1) / 2.0 * m_step, 1e-9 * nValues * m_step,
+                             "Wrong mean");
+
+  double maxError = std::ldexp (1.0, -m_precision);
+  const double quantiles[] = { 0.001, 0.1, 0.5, 0.9, 0.95, 0.99, 0.999 };
+  for (double q : quantiles)
+    {
+      // the values are 1..nValues times the step
+      double exact = std::ceil (q * nValues) * m_step;
+      double estimate = histogram.GetQuantile (q);
+      NS_TEST_ASSERT_MSG_EQ_TOL (estimate, exact, exact * maxError,
+                                 "Quantile " << q << " out of the error bound");
+    }
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0), m_step, "Quantile 0 is not the minimum");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (1), nValues * m_step, "Quantile 1 is not the maximum");
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief Check that LogLinearHistogram is exact for small values
+ */
+class LogLinearHistogramSmallValuesTestCase : public TestCase
+{
+public:
+  LogLinearHistogramSmallValuesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LogLinearHistogramSmallValuesTestCase::LogLinearHistogramSmallValuesTestCase ()
+  : TestCase ("Exact quantiles of small values")
+{
+}
+
+void
+LogLinearHistogramSmallValuesTestCase::DoRun (void)
+{
+  LogLinearHistogram histogram (4);
+  LogLinearHistogram empty (4);
+  NS_TEST_ASSERT_MSG_EQ (empty.GetQuantile (0.5), 0, "Quantile of an empty histogram");
+
+  // values up to 2^(precision + 1) have a bucket each
+  for (uint64_t value = 0; value < 32; ++value)
+    {
+      histogram.AddValue (value, 10);
+    }
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (), 320, "Wrong count");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.5), 15, "Wrong median");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.9), 28, "Wrong 90th percentile");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.99), 31, "Wrong 99th percentile");
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief Merge and serialization of LogLinearHistogram
+ */
+class LogLinearHistogramMergeTestCase : public TestCase
+{
+public:
+  LogLinearHistogramMergeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LogLinearHistogramMergeTestCase::LogLinearHistogramMergeTestCase ()
+  : TestCase ("Merge and serialization")
+{
+}
+
+void
+LogLinearHistogramMergeTestCase::DoRun (void)
+{
+  LogLinearHistogram whole;
+  LogLinearHistogram first;
+  LogLinearHistogram second;
+  for (uint64_t i = 1; i <= 50000; ++i)
+    {
+      uint64_t value = i * i;
+      whole.AddValue (value);
+      (i % 3 == 0 ? first : second).AddValue (value);
+    }
+
+  // merge after a round trip through a text stream, as done across runs
+  std::stringstream ss;
+  second.Serialize (ss);
+  LogLinearHistogram restored;
+  NS_TEST_ASSERT_MSG_EQ (restored.Deserialize (ss), true, "Can't deserialize " << ss.str ());
+  first.Merge (restored);
+
+  NS_TEST_ASSERT_MSG_EQ (first.GetCount (), whole.GetCount (), "Wrong count after merge");
+  NS_TEST_ASSERT_MSG_EQ (first.GetMin (), whole.GetMin (), "Wrong minimum after merge");
+  NS_TEST_ASSERT_MSG_EQ (first.GetMax (), whole.GetMax (), "Wrong maximum after merge");
+  NS_TEST_ASSERT_MSG_EQ_TOL (first.GetMean (), whole.GetMean (), 1e-6 * whole.GetMean (),
+                             "Wrong mean after merge");
+  const double quantiles[] = { 0.5, 0.95, 0.99, 0.999 };
+  for (double q : quantiles)
+    {
+      NS_TEST_ASSERT_MSG_EQ (first.GetQuantile (q), whole.GetQuantile (q),
+                             "Quantile " << q << " differs after merge");
+    }
+
+  std::stringstream bad ("7 10 1 2 3.0 1 5 9");
+  NS_TEST_ASSERT_MSG_EQ (restored.Deserialize (bad), false, "Inconsistent histogram accepted");
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief LogLinearHistogram TestSuite
+ */
+class LogLinearHistogramTestSuite : public TestSuite
+{
+public:
+  LogLinearHistogramTestSuite ();
+};
+
+LogLinearHistogramTestSuite::LogLinearHistogramTestSuite ()
+  : TestSuite ("log-linear-histogram", UNIT)
+{
+  AddTestCase (new LogLinearHistogramQuantileTestCase (7, 1), TestCase::QUICK);
+  AddTestCase (new LogLinearHistogramQuantileTestCase (7, 1000), TestCase::QUICK);
+  AddTestCase (new LogLinearHistogramQuantileTestCase (3, 1000000), TestCase::QUICK);
+  AddTestCase (new LogLinearHistogramSmallValuesTestCase, TestCase::QUICK);
+  AddTestCase (new LogLinearHistogramMergeTestCase, TestCase::QUICK);
+}
+
+static LogLinearHistogramTestSuite logLinearHistogramTestSuite; //!< Static variable for test initialization
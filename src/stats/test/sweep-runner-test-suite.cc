@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/sweep-runner.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/warm-start.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief Run a sweep in worker processes and check the result file
+ */
+class SweepRunnerTestCase : public TestCase
+{
+public:
+  SweepRunnerTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Simulate a point of the sweep
+   * \param point the point
+   * \return the summary of the point
+   */
+  SweepRunner::Summary RunPoint (const SweepRunner::Point &point);
+  /// Count an event
+  void Count (void);
+
+  uint32_t m_count; //!< number of events executed
+};
+
+SweepRunnerTestCase::SweepRunnerTestCase ()
+  : TestCase ("Run a sweep in worker processes and check the result file"),
+    m_count (0)
+{
+}
+
+void
+SweepRunnerTestCase::Count (void)
+{
+  m_count++;
+}
+
+SweepRunner::Summary
+SweepRunnerTestCase::RunPoint (const SweepRunner::Point &point)
+{
+  if (point.Get ("fail") == "yes")
+    {
+      WarmStart::Exit (3);
+    }
+  uint32_t events = point.GetDouble ("events");
+  for (uint32_t i = 0; i < events; i++)
+    {
+      Simulator::Schedule (Seconds (i), &SweepRunnerTestCase::Count, this);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // the maximum is set as a default by the runner
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  SweepRunner::Summary summary;
+  std::ostringstream os;
+  os << m_count;
+  summary.push_back (std::make_pair ("count", os.str ()));
+  os.str ("");
+  os << rv->GetInteger (0, 1000000) << " " << rv->GetMax ();
+  summary.push_back (std::make_pair ("random", os.str ()));
+  return summary;
+}
+
+void
+SweepRunnerTestCase::DoRun (void)
+{
+  uint64_t run = RngSeedManager::GetRun ();
+  std::string filename = CreateTempDirFilename ("sweep-runner.tsv");
+
+  SweepRunner sweep;
+  sweep.AddParameter ("events", {"1", "4"});
+  sweep.AddParameter ("ns3::UniformRandomVariable::Max", {"7", "9"});
+  sweep.AddParameter ("fail", {"no", "yes"});
+  sweep.SetRuns (2, 5);
+  sweep.SetMaxWorkers (3);
+  NS_TEST_ASSERT_MSG_EQ (sweep.GetNPoints (), 16, "Wrong number of points");
+  SweepRunner::Point point = sweep.GetPoint (13);
+  NS_TEST_ASSERT_MSG_EQ (point.run, 6, "Wrong run of the point");
+  NS_TEST_ASSERT_MSG_EQ (point.Get ("events"), "4", "Wrong value of the point");
+  NS_TEST_ASSERT_MSG_EQ (point.Get ("ns3::UniformRandomVariable::Max"), "9", "Wrong value of the point");
+  NS_TEST_ASSERT_MSG_EQ (point.Get ("fail"), "no", "Wrong value of the point");
+
+  uint32_t failed = sweep.Run (MakeCallback (&SweepRunnerTestCase::RunPoint, this), filename);
+  NS_TEST_ASSERT_MSG_EQ (WarmStart::IsChild (), false, "The runner returned in a worker");
+  NS_TEST_ASSERT_MSG_EQ (failed, 8, "Wrong number of failed points");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 0, "The points were simulated in the calling process");
+
+  std::ifstream file (filename.c_str ());
+  std::string line;
+  std::getline (file, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "point\trun\tstatus\tevents\tns3::UniformRandomVariable::Max\tfail\tcount\trandom",
+                         "Wrong header");
+  std::string random[2];
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (bool (std::getline (file, line)), true, "Missing point " << i);
+      std::istringstream is (line);
+      uint32_t index;
+      uint64_t pointRun;
+      int status;
+      std::string events, max, fail;
+      is >> index >> pointRun >> status >> events >> max >> fail;
+      point = sweep.GetPoint (i);
+      NS_TEST_ASSERT_MSG_EQ (index, i, "Wrong index");
+      NS_TEST_ASSERT_MSG_EQ (pointRun, point.run, "Wrong run");
+      NS_TEST_ASSERT_MSG_EQ (events, point.Get ("events"), "Wrong parameter");
+      NS_TEST_ASSERT_MSG_EQ (max, point.Get ("ns3::UniformRandomVariable::Max"), "Wrong parameter");
+      NS_TEST_ASSERT_MSG_EQ (fail, point.Get ("fail"), "Wrong parameter");
+      if (fail == "yes")
+        {
+          NS_TEST_ASSERT_MSG_EQ (status, 3, "Wrong status of a failed point");
+          continue;
+        }
+      NS_TEST_ASSERT_MSG_EQ (status, 0, "Wrong status");
+      uint32_t count;
+      uint32_t number;
+      double maximum;
+      is >> count >> number >> maximum;
+      NS_TEST_ASSERT_MSG_EQ (count, point.GetDouble ("events"), "Wrong summary");
+      NS_TEST_ASSERT_MSG_EQ (maximum, point.GetDouble ("ns3::UniformRandomVariable::Max"), "Default not set");
+      // the same runs of different points draw the same numbers
+      std::ostringstream os;
+      os << number;
+      std::string &expected = random[point.run - 5];
+      if (expected.empty ())
+        {
+          expected = os.str ();
+        }
+      NS_TEST_ASSERT_MSG_EQ (os.str (), expected, "Different numbers in the same run");
+    }
+  NS_TEST_ASSERT_MSG_NE (random[0], random[1], "Same numbers in different runs");
+  file.close ();
+  std::remove (filename.c_str ());
+
+  RngSeedManager::SetRun (run);
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief SweepRunner test suite
+ */
+class SweepRunnerTestSuite : public TestSuite
+{
+public:
+  SweepRunnerTestSuite ();
+};
+
+SweepRunnerTestSuite::SweepRunnerTestSuite ()
+  : TestSuite ("sweep-runner", UNIT)
+{
+  AddTestCase (new SweepRunnerTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static SweepRunnerTestSuite sweepRunnerTestSuite;
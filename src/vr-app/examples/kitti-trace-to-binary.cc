@@ -0,0 +1,53 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2021 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/burst-trace-registry.h"
+
+/**
+ * Converts a KITTI CSV trace into the binary format read by
+ * KittiTraceBurstGenerator. The binary file is memory mapped when loaded,
+ * so that simulations using it do not need to parse the trace.
+ *
+ * ./waf --run "kitti-trace-to-binary --input=kitti.csv --output=kitti.bin"
+ */
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("KittiTraceToBinary");
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("input", "KITTI CSV trace file", input);
+  cmd.AddValue ("output", "Binary trace file to write", output);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (input.empty () || output.empty (), "Both --input and --output are required");
+
+  Ptr<const KittiTrace> trace = BurstTraceRegistry::GetKittiTrace (input);
+  NS_ABORT_MSG_IF (!trace->WriteBinary (output), "Can't write " << output);
+
+  return 0;
+}
@@ -21,6 +21,7 @@
 #include "ns3/string.h"
 #include "ns3/nstime.h"
 #include <ns3/boolean.h>
+#include <ns3/enum.h>
 #include <ns3/log.h>
 #include <vector>
 #include <algorithm>
@@ -38,7 +39,10 @@ NS_OBJECT_ENSURE_REGISTERED (BurstyAppStatsCalculator);
 BurstyAppStatsCalculator::BurstyAppStatsCalculator ()
   : m_firstWrite (true),
     m_pendingOutput (false),
-    m_aggregatedStats (true)
+    m_aggregatedStats (true),
+    m_delayQuantiles (false),
+    m_firstHistogramWrite (true),
+    m_outputFormat (TEXT)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -88,7 +92,28 @@ BurstyAppStatsCalculator::GetTypeId (void)
                          "with external classes",
                          BooleanValue (false),
                          MakeBooleanAccessor (&BurstyAppStatsCalculator::m_writeToFile),
-                         MakeBooleanChecker ());
+                         MakeBooleanChecker ())
+          .AddAttribute ("OutputFormat",
+                         "Format of the output file. Columnar files are written with "
+                         "ColumnarFileWriter and can be read with ColumnarFileReader.",
+                         EnumValue (BurstyAppStatsCalculator::TEXT),
+                         MakeEnumAccessor (&BurstyAppStatsCalculator::m_outputFormat),
+                         MakeEnumChecker (BurstyAppStatsCalculator::TEXT, "Text",
+                                          BurstyAppStatsCalculator::COLUMNAR, "Columnar"))
+          .AddAttribute ("DelayQuantiles",
+                         "Choice to add the 50th, 95th, 99th and 99.9th percentiles of the "
+                         "burst delay to the output file. The percentiles are estimated with a "
+                         "log-linear histogram, with a relative error below 1%.",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&BurstyAppStatsCalculator::m_delayQuantiles),
+                         MakeBooleanChecker ())
+          .AddAttribute ("DelayHistogramFilename",
+                         "Name of the file where the burst delay histograms of each epoch are "
+                         "saved, so that they can be merged across runs. If empty, the "
+                         "histograms are not saved.",
+                         StringValue (""),
+                         MakeStringAccessor (&BurstyAppStatsCalculator::m_delayHistogramFilename),
+                         MakeStringChecker ());
   return tid;
 }
 
@@ -96,6 +121,12 @@ void
 BurstyAppStatsCalculator::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  if (m_columnarWriter)
+    {
+      // write the footer, without it the file can not be read
+      m_columnarWriter->Close ();
+      m_columnarWriter = 0;
+    }
 }
 
 void
@@ -189,6 +220,7 @@ BurstyAppStatsCalculator::RxBurst (uint32_t nodeId, Ptr<const Packet> burst, con
           
           uint64_t delay =  Simulator::Now().GetNanoSeconds() -  header.GetTs ().GetNanoSeconds();
           m_delay[nodeId]->Update (delay);
+          m_delayHistogram[nodeId].AddValue (delay);
         }
       m_pendingOutput = true;
     }
@@ -240,6 +272,10 @@ BurstyAppStatsCalculator::ReadResults (void)
           item.delayStdev = 0.0;
           item.delayMin = 0.0;
           item.delayMax = 0.0;
+          item.delayP50 = 0.0;
+          item.delayP95 = 0.0;
+          item.delayP99 = 0.0;
+          item.delayP999 = 0.0;
         }
       else
         {
@@ -247,6 +283,10 @@ BurstyAppStatsCalculator::ReadResults (void)
           item.delayStdev = m_delay[nodeId]->getStddev ();
           item.delayMin = m_delay[nodeId]->getMin ();
           item.delayMax = m_delay[nodeId]->getMax ();
+          item.delayP50 = m_delayHistogram[nodeId].GetQuantile (0.5);
+          item.delayP95 = m_delayHistogram[nodeId].GetQuantile (0.95);
+          item.delayP99 = m_delayHistogram[nodeId].GetQuantile (0.99);
+          item.delayP999 = m_delayHistogram[nodeId].GetQuantile (0.999);
         }
       results.insert (std::make_pair (item.imsi, item));
     }
@@ -261,6 +301,18 @@ BurstyAppStatsCalculator::ReadResults (void)
 void
 BurstyAppStatsCalculator::ShowResults (void)
 {
+  if (!m_delayHistogramFilename.empty ())
+    {
+      WriteDelayHistograms ();
+    }
+
+  if (m_outputFormat == COLUMNAR)
+    {
+      WriteColumnarResults ();
+      m_pendingOutput = false;
+      return;
+    }
+
   std::ofstream outFile;
 
   if (m_firstWrite == true)
@@ -274,6 +326,10 @@ BurstyAppStatsCalculator::ShowResults (void)
 
       m_firstWrite = false;
       outFile << "start\tend\tNodeId\tnTxBursts\tTxBytes\tnRxBursts\tRxBytes\tdelay\tstdDev\tmin\tmax\t";
+      if (m_delayQuantiles)
+        {
+          outFile << "p50\tp95\tp99\tp999\t";
+        }
       outFile << std::endl;
     }
   else
@@ -348,6 +404,13 @@ BurstyAppStatsCalculator::WriteResults (std::ofstream &outFile)
           outFile << 0.0 << "\t";
           outFile << 0.0 << "\t";
           outFile << 0.0 << "\t";
+          if (m_delayQuantiles)
+            {
+              outFile << 0.0 << "\t";
+              outFile << 0.0 << "\t";
+              outFile << 0.0 << "\t";
+              outFile << 0.0 << "\t";
+            }
         }
       else
         {
@@ -355,6 +418,13 @@ BurstyAppStatsCalculator::WriteResults (std::ofstream &outFile)
           outFile << m_delay[nodeId]->getStddev () << "\t";
           outFile << m_delay[nodeId]->getMin () << "\t";
           outFile << m_delay[nodeId]->getMax () << "\t";
+          if (m_delayQuantiles)
+            {
+              outFile << m_delayHistogram[nodeId].GetQuantile (0.5) << "\t";
+              outFile << m_delayHistogram[nodeId].GetQuantile (0.95) << "\t";
+              outFile << m_delayHistogram[nodeId].GetQuantile (0.99) << "\t";
+              outFile << m_delayHistogram[nodeId].GetQuantile (0.999) << "\t";
+            }
         }
 
 
@@ -364,6 +434,133 @@ BurstyAppStatsCalculator::WriteResults (std::ofstream &outFile)
   outFile.close ();
 }
 
+void
+BurstyAppStatsCalculator::WriteColumnarResults (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // same columns as the text output
+  enum
+  {
+    START, END, NODE_ID, TX_BURSTS, TX_BYTES, RX_BURSTS, RX_BYTES,
+    DELAY, DELAY_STD_DEV, DELAY_MIN, DELAY_MAX,
+    DELAY_P50, DELAY_P95, DELAY_P99, DELAY_P999
+  };
+
+  if (!m_columnarWriter)
+    {
+      m_columnarWriter = Create<ColumnarFileWriter> ();
+      m_columnarWriter->AddColumn ("start", ColumnarFile::DOUBLE);
+      m_columnarWriter->AddColumn ("end", ColumnarFile::DOUBLE);
+      m_columnarWriter->AddColumn ("NodeId", ColumnarFile::DICTIONARY);
+      m_columnarWriter->AddColumn ("nTxBursts", ColumnarFile::UINT64);
+      m_columnarWriter->AddColumn ("TxBytes", ColumnarFile::UINT64);
+      m_columnarWriter->AddColumn ("nRxBursts", ColumnarFile::UINT64);
+      m_columnarWriter->AddColumn ("RxBytes", ColumnarFile::UINT64);
+      m_columnarWriter->AddColumn ("delay", ColumnarFile::DOUBLE);
+      m_columnarWriter->AddColumn ("stdDev", ColumnarFile::DOUBLE);
+      m_columnarWriter->AddColumn ("min", ColumnarFile::DOUBLE);
+      m_columnarWriter->AddColumn ("max", ColumnarFile::DOUBLE);
+      if (m_delayQuantiles)
+        {
+          m_columnarWriter->AddColumn ("p50", ColumnarFile::UINT64);
+          m_columnarWriter->AddColumn ("p95", ColumnarFile::UINT64);
+          m_columnarWriter->AddColumn ("p99", ColumnarFile::UINT64);
+          m_columnarWriter->AddColumn ("p999", ColumnarFile::UINT64);
+        }
+      if (!m_columnarWriter->Open (GetOutputFilename ()))
+        {
+          NS_LOG_ERROR ("Can't open file " << GetOutputFilename ().c_str ());
+          m_columnarWriter = 0;
+          return;
+        }
+    }
+
+  // Get the list of node IDs
+  std::vector<uint32_t> nodeIdsVector;
+  for (auto it = m_txBursts.begin (); it != m_txBursts.end (); ++it)
+    {
+      nodeIdsVector.push_back ((*it).first);
+    }
+  for (auto it = m_rxBursts.begin (); it != m_rxBursts.end (); ++it)
+    {
+      if (m_txBursts.find ((*it).first) == m_txBursts.end ())
+        {
+          nodeIdsVector.push_back ((*it).first);
+        }
+    }
+
+  Time endTime = m_manualUpdate ? Simulator::Now () : m_startTime + m_epochDuration;
+  for (auto it = nodeIdsVector.begin (); it != nodeIdsVector.end (); ++it)
+    {
+      uint32_t nodeId = *it;
+      m_columnarWriter->SetDouble (START, m_startTime.GetNanoSeconds () / 1.0e9);
+      m_columnarWriter->SetDouble (END, endTime.GetNanoSeconds () / 1.0e9);
+      m_columnarWriter->SetUint (NODE_ID, nodeId);
+      m_columnarWriter->SetUint (TX_BURSTS, m_txBursts[nodeId]);
+      m_columnarWriter->SetUint (TX_BYTES, m_txData[nodeId]);
+      m_columnarWriter->SetUint (RX_BURSTS, m_rxBursts[nodeId]);
+      m_columnarWriter->SetUint (RX_BYTES, m_rxData[nodeId]);
+
+      // if no delay info have been recorded yet, leave it to zero
+      auto iter = m_delay.find (nodeId);
+      if (iter != m_delay.end ())
+        {
+          m_columnarWriter->SetDouble (DELAY, iter->second->getMean ());
+          m_columnarWriter->SetDouble (DELAY_STD_DEV, iter->second->getStddev ());
+          m_columnarWriter->SetDouble (DELAY_MIN, iter->second->getMin ());
+          m_columnarWriter->SetDouble (DELAY_MAX, iter->second->getMax ());
+          if (m_delayQuantiles)
+            {
+              const LogLinearHistogram &histogram = m_delayHistogram[nodeId];
+              m_columnarWriter->SetUint (DELAY_P50, histogram.GetQuantile (0.5));
+              m_columnarWriter->SetUint (DELAY_P95, histogram.GetQuantile (0.95));
+              m_columnarWriter->SetUint (DELAY_P99, histogram.GetQuantile (0.99));
+              m_columnarWriter->SetUint (DELAY_P999, histogram.GetQuantile (0.999));
+            }
+        }
+      m_columnarWriter->EndRow ();
+    }
+}
+
+void
+BurstyAppStatsCalculator::WriteDelayHistograms (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::ofstream outFile;
+  if (m_firstHistogramWrite)
+    {
+      outFile.open (m_delayHistogramFilename.c_str ());
+      if (!outFile.is_open ())
+        {
+          NS_LOG_ERROR ("Can't open file " << m_delayHistogramFilename);
+          return;
+        }
+      m_firstHistogramWrite = false;
+      outFile << "start\tend\tNodeId\thistogram\n";
+    }
+  else
+    {
+      outFile.open (m_delayHistogramFilename.c_str (), std::ios_base::app);
+      if (!outFile.is_open ())
+        {
+          NS_LOG_ERROR ("Can't open file " << m_delayHistogramFilename);
+          return;
+        }
+    }
+
+  Time endTime = m_manualUpdate ? Simulator::Now () : m_startTime + m_epochDuration;
+  for (auto it = m_delayHistogram.begin (); it != m_delayHistogram.end (); ++it)
+    {
+      outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
+      outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
+      outFile << it->first << "\t";
+      it->second.Serialize (outFile);
+      outFile << "\n";
+    }
+}
+
 void
 BurstyAppStatsCalculator::ResetResults (void)
 {
@@ -376,6 +573,7 @@ BurstyAppStatsCalculator::ResetResults (void)
   m_rxData.erase (m_rxData.begin (), m_rxData.end ());
 
   m_delay.erase (m_delay.begin (), m_delay.end ());
+  m_delayHistogram.clear ();
 }
 
 void
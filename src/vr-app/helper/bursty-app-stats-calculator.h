@@ -23,6 +23,8 @@
 #include "ns3/uinteger.h"
 #include "ns3/object.h"
 #include "ns3/basic-data-calculators.h"
+#include "ns3/columnar-file-writer.h"
+#include "ns3/log-linear-histogram.h"
 #include <string>
 #include <map>
 #include <fstream>
@@ -44,6 +46,10 @@ struct AppResults
     double delayStdev;
     double delayMin;
     double delayMax;
+    double delayP50;
+    double delayP95;
+    double delayP99;
+    double delayP999;
   };
 
 /**
@@ -53,6 +59,15 @@ struct AppResults
 class BurstyAppStatsCalculator: public Object
 {
 public:
+  /**
+   * Format of the output file
+   */
+  enum OutputFormat
+  {
+    TEXT = 0,    //!< tab-separated text, one line per node and epoch
+    COLUMNAR = 1 //!< columnar binary file, see ColumnarFileWriter
+  };
+
   /**
    * Class constructor
    */
@@ -158,6 +173,21 @@ public:
    */
   void WriteResults (std::ofstream &outFile);
 
+  /**
+   * Writes collected statistics to the columnar output file, which is
+   * created during the first call and closed when the calculator is disposed.
+   */
+  void WriteColumnarResults (void);
+
+  /**
+   * Appends the delay histograms of the current epoch to the delay
+   * histogram file, one line per node. Each line holds the start and end of
+   * the epoch, the node ID and the histogram written by
+   * LogLinearHistogram::Serialize, so that the histograms of several runs
+   * can be merged.
+   */
+  void WriteDelayHistograms (void);
+
   /**
    * Erases collected statistics
    */
@@ -201,8 +231,14 @@ private:
   std::map<uint32_t, uint64_t> m_rxData; //!< number of bytes received in a specific epoch per node ID
 
   std::map<uint32_t, Ptr<MinMaxAvgTotalCalculator<uint64_t>>> m_delay; //!< delay statistics calculator for a specific epoch, per node ID
+  std::map<uint32_t, LogLinearHistogram> m_delayHistogram; //!< delay histogram [ns] for a specific epoch, per node ID
+  bool m_delayQuantiles; //!< true if the delay quantiles are written to the output file
+  std::string m_delayHistogramFilename; //!< name of the delay histogram file, empty if disabled
+  bool m_firstHistogramWrite; //!< true if the delay histogram file has not been opened yet
 
   std::string m_outputFilename; //!< name of the output file
+  OutputFormat m_outputFormat; //!< format of the output file
+  Ptr<ColumnarFileWriter> m_columnarWriter; //!< writer of the columnar output file
 
 };
 
@@ -247,9 +247,8 @@ BurstSink::FragmentReceived (BurstHandler &burstHandler, const Ptr<Packet> &f, c
 
   NS_LOG_DEBUG ("Get BurstHandler for from="
                 << from << " with m_currentBurstSeq=" << burstHandler.m_currentBurstSeq
-                << ", m_fragmentsMerged=" << burstHandler.m_fragmentsMerged
-                << ", m_unorderedFragments.size ()=" << burstHandler.m_unorderedFragments.size ()
-                << ", m_burstBuffer.GetSize ()=" << burstHandler.m_burstBuffer->GetSize ()
+                << ", m_fragmentsReceived=" << burstHandler.m_fragmentsReceived
+                << ", m_bytesReceived=" << burstHandler.m_bytesReceived
                 << ", for fragment with header: " << header);
 
   if (header.GetSeq () < burstHandler.m_currentBurstSeq)
@@ -260,75 +259,50 @@ BurstSink::FragmentReceived (BurstHandler &burstHandler, const Ptr<Packet> &f, c
       return;
     }
 
-  if (header.GetSeq () > burstHandler.m_currentBurstSeq)
+  if (header.GetSeq () > burstHandler.m_currentBurstSeq || burstHandler.m_receivedFragments.empty ())
     {
       // fragment of new burst: discard previous burst if incomplete
-      NS_LOG_LOGIC ("Start mering new burst seq "
+      NS_LOG_LOGIC ("Start receiving new burst seq "
                     << header.GetSeq () << " (previous=" << burstHandler.m_currentBurstSeq << ")");
 
       burstHandler.m_currentBurstSeq = header.GetSeq ();
-      burstHandler.m_fragmentsMerged = 0;
-      burstHandler.m_unorderedFragments.clear ();
-      burstHandler.m_burstBuffer = Create<Packet> (0);
+      burstHandler.m_fragmentsReceived = 0;
+      burstHandler.m_bytesReceived = 0;
+      burstHandler.m_receivedFragments.assign (header.GetFrags (), false);
     }
 
-  if (header.GetSeq () == burstHandler.m_currentBurstSeq)
+  // fragment of current burst
+  NS_ASSERT_MSG (header.GetFragSeq () < burstHandler.m_receivedFragments.size (),
+                 header.GetFragSeq () << " < " << burstHandler.m_receivedFragments.size ());
+  if (burstHandler.m_receivedFragments[header.GetFragSeq ()])
     {
-      // fragment of current burst
-      NS_ASSERT_MSG (header.GetFragSeq () >= burstHandler.m_fragmentsMerged,
-                     header.GetFragSeq () << " >= " << burstHandler.m_fragmentsMerged);
-
-      NS_LOG_DEBUG ("fragment sequence=" << header.GetFragSeq () << ", fragments merged="
-                                         << burstHandler.m_fragmentsMerged);
-      if (header.GetFragSeq () == burstHandler.m_fragmentsMerged)
-        {
-          // following packet: merge it
-          f->RemoveHeader (header);
-          burstHandler.m_burstBuffer->AddAtEnd (f);
-          burstHandler.m_fragmentsMerged++;
-          NS_LOG_LOGIC ("Fragments merged " << burstHandler.m_fragmentsMerged << "/"
-                                            << header.GetFrags () << " for burst "
-                                            << header.GetSeq ());
-
-          // if present, merge following unordered fragments
-          auto nextFragmentIt = burstHandler.m_unorderedFragments.begin ();
-          while (nextFragmentIt !=
-                     burstHandler.m_unorderedFragments.end () && // there are unordered packets
-                 nextFragmentIt->first ==
-                     burstHandler.m_fragmentsMerged) // the following fragment was already received
-            {
-              Ptr<Packet> storedFragment = nextFragmentIt->second;
-              storedFragment->RemoveHeader (header);
-              burstHandler.m_burstBuffer->AddAtEnd (storedFragment);
-              burstHandler.m_fragmentsMerged++;
-              NS_LOG_LOGIC ("Unordered fragments merged " << burstHandler.m_fragmentsMerged << "/"
-                                                          << header.GetFrags () << " for burst "
-                                                          << header.GetSeq ());
-
-              nextFragmentIt = burstHandler.m_unorderedFragments.erase (nextFragmentIt);
-            }
-        }
-      else
-        {
-          // add to unordered fragments buffer
-          NS_LOG_LOGIC ("Add unordered fragment " << header.GetFragSeq () << " of burst "
-                                                  << header.GetSeq () << " to buffer ");
-          burstHandler.m_unorderedFragments.insert (
-              std::pair<uint16_t, const Ptr<Packet>> (header.GetFragSeq (), f));
-        }
+      NS_LOG_LOGIC ("Ignoring duplicated fragment " << header.GetFragSeq () << " of burst "
+                                                    << header.GetSeq ());
+      return;
     }
 
+  burstHandler.m_receivedFragments[header.GetFragSeq ()] = true;
+  burstHandler.m_fragmentsReceived++;
+  burstHandler.m_bytesReceived += f->GetSize () - header.GetSerializedSize ();
+  NS_LOG_LOGIC ("Fragments received " << burstHandler.m_fragmentsReceived << "/"
+                                      << header.GetFrags () << " for burst "
+                                      << header.GetSeq ());
+
   // check if burst is complete
-  if (burstHandler.m_fragmentsMerged == header.GetFrags ())
+  if (burstHandler.m_fragmentsReceived == header.GetFrags ())
     {
-      // all fragments have been merged
-      NS_ASSERT_MSG (burstHandler.m_burstBuffer->GetSize () == header.GetSize (),
-                     burstHandler.m_burstBuffer->GetSize () << " == " << header.GetSize ());
+      // all fragments have been received
+      NS_ASSERT_MSG (burstHandler.m_bytesReceived == header.GetSize (),
+                     burstHandler.m_bytesReceived << " == " << header.GetSize ());
 
       NS_LOG_LOGIC ("Burst received: " << header.GetFrags () << " fragments for a total of "
                                        << header.GetSize () << " B");
       m_totRxBursts++;
 
+      // The payload is zero-filled: the packet does not allocate its bytes
+      // unless a trace sink reads them
+      Ptr<Packet> burst = Create<Packet> (header.GetSize ());
+
       // schedule next burst
       
       if (m_decodingDelay)
@@ -361,11 +335,11 @@ BurstSink::FragmentReceived (BurstHandler &burstHandler, const Ptr<Packet> &f, c
         NS_LOG_DEBUG ("Decoding delay " << delay.As (Time::S));
 
         Simulator::Schedule (delay, &BurstSink::HandleCorrectReception, this,
-                            burstHandler.m_burstBuffer, from, localAddress, header);
+                            burst, from, localAddress, header);
       }
       else
       {
-        m_rxBurstTrace (burstHandler.m_burstBuffer, from, localAddress, header);
+        m_rxBurstTrace (burst, from, localAddress, header);
       }
     }
 }
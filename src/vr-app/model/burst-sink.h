@@ -30,6 +30,7 @@
 #include "ns3/seq-ts-size-frag-header.h"
 #include "kitti-trace-burst-generator.h"
 #include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 
@@ -60,7 +61,8 @@ class Packet;
  * received packets should have.
  * It then makes the following assumptions:
  * - Being based on a UDP socket, packets might arrive out-of-order. Within a
- * burst, BurstSink will reorder the received packets.
+ * burst, BurstSink keeps track of the received fragments regardless of their
+ * order, and ignores duplicated fragments.
  * - While receiving burst n, if a fragment from burst k<n is received, the
  * fragment is discarded
  * - While receiving burst n, if a fragment from burst k>n is received,
@@ -69,7 +71,11 @@ class Packet;
  * received.
  * 
  * Traces are sent when a fragment is received and when a whole burst is
- * successfully received.
+ * successfully received. Fragments are not merged: the packet passed to the
+ * burst trace has the size of the burst payload, but its bytes are only
+ * allocated if a trace sink actually reads them. Since BurstyApplication
+ * sends zero-filled payloads, its content is the same as the one of the
+ * merged fragments.
  * 
  */
 class BurstSink : public Application
@@ -168,13 +174,17 @@ private:
   /**
    * \brief Simple burst handler
    * Contains information regarding the current burst sequence number
+   *
+   * Fragments are not buffered: the handler only keeps track of which
+   * fragments of the current burst were received, and how many payload
+   * bytes they carried.
    */
   struct BurstHandler
   {
     uint64_t m_currentBurstSeq{0}; //!< Current burst sequence number
-    uint16_t m_fragmentsMerged{0}; //!< Number of ordered fragments received and merged for the current burst
-    std::map<uint16_t, const Ptr<Packet>> m_unorderedFragments; //!< The fragments received out-of-order, still to be merged
-    Ptr<Packet> m_burstBuffer{Create<Packet> (0)}; //!< The buffer containing the ordered received fragments
+    uint16_t m_fragmentsReceived{0}; //!< Number of distinct fragments received for the current burst
+    uint64_t m_bytesReceived{0}; //!< Payload bytes received for the current burst
+    std::vector<bool> m_receivedFragments; //!< Bitmap of the received fragments of the current burst
   };
 
   /**
@@ -0,0 +1,397 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// Copyright (c) 2021 SIGNET Lab, Department of Information Engineering,
+// University of Padova
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/csv-reader.h"
+#include "burst-trace-registry.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BurstTraceRegistry");
+
+BurstTrace::BurstTrace (const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+
+  CsvReader csv (filename);
+
+  uint32_t burstSize;
+  double period;
+  while (csv.FetchNextRow ())
+    {
+      // Ignore blank lines
+      if (csv.IsBlankRow ())
+        {
+          continue;
+        }
+
+      // Expecting burst size and period to next burst
+      bool ok = csv.GetValue (0, burstSize);
+      ok |= csv.GetValue (1, period);
+      NS_ABORT_MSG_IF (!ok, "Something went wrong on line " << csv.RowNumber () << " of file "
+                                                            << filename);
+      NS_ABORT_MSG_IF (period < 0, "Period to next burst should be non-negative, instead found: "
+                                       << period << " on line " << csv.RowNumber ());
+
+      m_bursts.push_back (std::make_pair (burstSize, period));
+    } // while FetchNextRow
+
+  NS_LOG_INFO ("Parsed " << m_bursts.size () << " bursts from file " << filename);
+}
+
+uint32_t
+BurstTrace::GetNBursts (void) const
+{
+  return m_bursts.size ();
+}
+
+uint32_t
+BurstTrace::GetBurstSize (uint32_t index) const
+{
+  return m_bursts.at (index).first;
+}
+
+double
+BurstTrace::GetPeriod (uint32_t index) const
+{
+  return m_bursts.at (index).second;
+}
+
+uint32_t
+BurstTrace::GetFirstBurst (double startTime) const
+{
+  // periods are non-negative, hence the bursts generated after startTime
+  // are a suffix of the trace
+  double cumulativeStartTime = 0;
+  uint32_t index = 0;
+  while (index < m_bursts.size () && cumulativeStartTime < startTime)
+    {
+      cumulativeStartTime += m_bursts[index].second;
+      index++;
+    }
+  return index;
+}
+
+const char KittiTrace::MAGIC[8] = { 'N', 'S', '3', 'K', 'I', 'T', 'T', 'I' };
+
+namespace {
+
+/// Version of the binary trace format
+const uint32_t KITTI_BINARY_VERSION = 1;
+
+} // unnamed namespace
+
+KittiTrace::KittiTrace (const std::string &filename)
+  : m_frames (nullptr),
+    m_map (nullptr),
+    m_mapSize (0)
+{
+  NS_LOG_FUNCTION (this << filename);
+  static_assert (sizeof (Frame) == 8, "Unexpected padding in KittiTrace::Frame");
+  static_assert (sizeof (Entry) == 24, "Unexpected padding in KittiTrace::Entry");
+
+  if (!MapBinary (filename))
+    {
+      ParseCsv (filename);
+    }
+}
+
+KittiTrace::~KittiTrace ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_map != nullptr)
+    {
+      munmap (m_map, m_mapSize);
+    }
+}
+
+KittiTrace::Sequence
+KittiTrace::GetSequence (int scene, uint32_t model) const
+{
+  Sequence sequence;
+  sequence.m_frames = m_frames;
+  sequence.m_nFrames = 0;
+  sequence.m_nSceneFrames = 0;
+
+  std::vector<Entry>::const_iterator it =
+    std::lower_bound (m_entries.begin (), m_entries.end (), std::make_pair (scene, model),
+                      [] (const Entry &e, const std::pair<int, uint32_t> &key)
+                      { return std::make_pair (int (e.m_scene), e.m_model) < key; });
+
+  if (it != m_entries.end () && it->m_scene == scene && it->m_model == model)
+    {
+      sequence.m_frames = m_frames + it->m_offset;
+      sequence.m_nFrames = it->m_nFrames;
+      sequence.m_nSceneFrames = it->m_nSceneFrames;
+    }
+  else if (it != m_entries.end () && it->m_scene == scene)
+    {
+      sequence.m_nSceneFrames = it->m_nSceneFrames;
+    }
+  else if (it != m_entries.begin () && (it - 1)->m_scene == scene)
+    {
+      sequence.m_nSceneFrames = (it - 1)->m_nSceneFrames;
+    }
+  return sequence;
+}
+
+bool
+KittiTrace::WriteBinary (const std::string &filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ofstream file (filename.c_str (), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!file.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename);
+      return false;
+    }
+
+  uint64_t nFrames = 0;
+  for (std::vector<Entry>::const_iterator it = m_entries.begin (); it != m_entries.end (); ++it)
+    {
+      nFrames = std::max (nFrames, it->m_offset + it->m_nFrames);
+    }
+
+  uint32_t nEntries = m_entries.size ();
+  file.write (MAGIC, sizeof (MAGIC));
+  file.write (reinterpret_cast<const char*> (&KITTI_BINARY_VERSION), sizeof (uint32_t));
+  file.write (reinterpret_cast<const char*> (&nEntries), sizeof (uint32_t));
+  file.write (reinterpret_cast<const char*> (m_entries.data ()), nEntries * sizeof (Entry));
+  file.write (reinterpret_cast<const char*> (m_frames), nFrames * sizeof (Frame));
+  return !file.fail ();
+}
+
+void
+KittiTrace::ParseCsv (const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+
+  // Frames of each scene, in the order in which they appear in the trace. As
+  // in the original reader, a frame is stored when the first row of the next
+  // frame of the same scene is found, hence the last frame of each scene is
+  // never used.
+  struct Scene
+  {
+    int m_frame{0};
+    std::map<uint16_t, Frame> m_info;
+    std::vector<std::map<uint16_t, Frame> > m_frames;
+  };
+  std::map<int, Scene> scenes;
+
+  char delimiter = ';';
+  CsvReader csv (filename, delimiter);
+
+  std::string name;
+  uint16_t model;
+  uint32_t burstSize;
+  uint16_t encodingTime;
+  uint16_t decodingTime;
+
+  while (csv.FetchNextRow ())
+    {
+      // Ignore blank lines and first line
+      if (csv.IsBlankRow () || csv.RowNumber () == 1)
+        {
+          continue;
+        }
+
+      bool ok = csv.GetValue (0, name);
+      ok |= csv.GetValue (1, model);
+      ok |= csv.GetValue (2, burstSize);
+      ok |= csv.GetValue (3, encodingTime);
+      ok |= csv.GetValue (4, decodingTime);
+      NS_ABORT_MSG_IF (!ok, "Something went wrong on line " << csv.RowNumber () << " of file " << filename);
+
+      // The name is formatted as <scene>/<frame>.<extension>
+      const char *begin = name.c_str ();
+      char *end;
+      int scene = std::strtol (begin, &end, 10);
+      NS_ABORT_MSG_IF (end == begin, "Invalid frame name on line " << csv.RowNumber () << " of file " << filename);
+      int newFrame = (*end == '/') ? std::strtol (end + 1, nullptr, 10) : scene;
+
+      Frame frameInfo;
+      frameInfo.m_burstSize = burstSize;
+      frameInfo.m_encodingTime = encodingTime;
+      frameInfo.m_decodingTime = decodingTime;
+
+      Scene &s = scenes[scene];
+      if (s.m_frame != newFrame)
+        {
+          // each row of m_frames is associated to a specific frame
+          // once each traffic model is added, we can move to the next frame
+          s.m_frames.push_back (s.m_info);
+          s.m_info.clear ();
+          s.m_frame = newFrame;
+        }
+      s.m_info.insert (std::make_pair (model, frameInfo));
+    } // while FetchNextRow
+
+  // Store the frames of each (scene, model) sequence contiguously
+  for (std::map<int, Scene>::const_iterator sc = scenes.begin (); sc != scenes.end (); ++sc)
+    {
+      const std::vector<std::map<uint16_t, Frame> > &frames = sc->second.m_frames;
+      std::set<uint16_t> models;
+      for (std::vector<std::map<uint16_t, Frame> >::const_iterator f = frames.begin (); f != frames.end (); ++f)
+        {
+          for (std::map<uint16_t, Frame>::const_iterator m = f->begin (); m != f->end (); ++m)
+            {
+              models.insert (m->first);
+            }
+        }
+      if (models.empty ())
+        {
+          // keep track of the number of frames of the scene anyway
+          models.insert (0);
+        }
+
+      for (std::set<uint16_t>::const_iterator m = models.begin (); m != models.end (); ++m)
+        {
+          Entry entry;
+          entry.m_scene = sc->first;
+          entry.m_model = *m;
+          entry.m_nFrames = 0;
+          entry.m_nSceneFrames = frames.size ();
+          entry.m_offset = m_storage.size ();
+          for (std::vector<std::map<uint16_t, Frame> >::const_iterator f = frames.begin (); f != frames.end (); ++f)
+            {
+              std::map<uint16_t, Frame>::const_iterator info = f->find (*m);
+              if (info == f->end ())
+                {
+                  break;
+                }
+              m_storage.push_back (info->second);
+              entry.m_nFrames++;
+            }
+          m_entries.push_back (entry);
+        }
+    }
+
+  m_frames = m_storage.data ();
+  NS_LOG_INFO ("Parsed " << scenes.size () << " scenes and " << m_entries.size ()
+                         << " sequences from file " << filename);
+}
+
+bool
+KittiTrace::MapBinary (const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+
+  int fd = open (filename.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Can't open file " << filename);
+
+  struct stat st;
+  const std::size_t headerSize = sizeof (MAGIC) + 2 * sizeof (uint32_t);
+  if (fstat (fd, &st) != 0 || st.st_size < static_cast<off_t> (headerSize))
+    {
+      close (fd);
+      return false;
+    }
+
+  char magic[sizeof (MAGIC)];
+  if (read (fd, magic, sizeof (MAGIC)) != sizeof (MAGIC)
+      || std::memcmp (magic, MAGIC, sizeof (MAGIC)) != 0)
+    {
+      close (fd);
+      return false;
+    }
+
+  m_mapSize = st.st_size;
+  m_map = mmap (nullptr, m_mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  NS_ABORT_MSG_IF (m_map == MAP_FAILED, "Can't map file " << filename);
+
+  const char *base = static_cast<const char*> (m_map);
+  uint32_t version;
+  uint32_t nEntries;
+  std::memcpy (&version, base + sizeof (MAGIC), sizeof (uint32_t));
+  std::memcpy (&nEntries, base + sizeof (MAGIC) + sizeof (uint32_t), sizeof (uint32_t));
+  NS_ABORT_MSG_IF (version != KITTI_BINARY_VERSION, "Unsupported version " << version << " of file " << filename);
+  NS_ABORT_MSG_IF (headerSize + uint64_t (nEntries) * sizeof (Entry) > m_mapSize, "Truncated file " << filename);
+
+  m_entries.resize (nEntries);
+  std::memcpy (m_entries.data (), base + headerSize, nEntries * sizeof (Entry));
+
+  const std::size_t framesOffset = headerSize + nEntries * sizeof (Entry);
+  uint64_t nFrames = (m_mapSize - framesOffset) / sizeof (Frame);
+  for (std::vector<Entry>::const_iterator it = m_entries.begin (); it != m_entries.end (); ++it)
+    {
+      NS_ABORT_MSG_IF (it->m_offset + it->m_nFrames > nFrames, "Truncated file " << filename);
+    }
+  m_frames = reinterpret_cast<const Frame*> (base + framesOffset);
+
+  NS_LOG_INFO ("Mapped " << m_entries.size () << " sequences from file " << filename);
+  return true;
+}
+
+Ptr<const BurstTrace>
+BurstTraceRegistry::GetBurstTrace (const std::string &filename)
+{
+  std::map<std::string, Ptr<const BurstTrace> > &traces = GetBurstTraces ();
+  std::map<std::string, Ptr<const BurstTrace> >::iterator it = traces.find (filename);
+  if (it == traces.end ())
+    {
+      it = traces.insert (std::make_pair (filename, Create<BurstTrace> (filename))).first;
+    }
+  return it->second;
+}
+
+Ptr<const KittiTrace>
+BurstTraceRegistry::GetKittiTrace (const std::string &filename)
+{
+  std::map<std::string, Ptr<const KittiTrace> > &traces = GetKittiTraces ();
+  std::map<std::string, Ptr<const KittiTrace> >::iterator it = traces.find (filename);
+  if (it == traces.end ())
+    {
+      it = traces.insert (std::make_pair (filename, Create<KittiTrace> (filename))).first;
+    }
+  return it->second;
+}
+
+void
+BurstTraceRegistry::Clear (void)
+{
+  GetBurstTraces ().clear ();
+  GetKittiTraces ().clear ();
+}
+
+std::map<std::string, Ptr<const BurstTrace> > &
+BurstTraceRegistry::GetBurstTraces (void)
+{
+  static std::map<std::string, Ptr<const BurstTrace> > traces;
+  return traces;
+}
+
+std::map<std::string, Ptr<const KittiTrace> > &
+BurstTraceRegistry::GetKittiTraces (void)
+{
+  static std::map<std::string, Ptr<const KittiTrace> > traces;
+  return traces;
+}
+
+} // Namespace ns3
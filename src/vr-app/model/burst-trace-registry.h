@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2021 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BURST_TRACE_REGISTRY_H
+#define BURST_TRACE_REGISTRY_H
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/ptr.h>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup applications
+ *
+ * \brief Bursts read from a trace file, as used by TraceFileBurstGenerator
+ *
+ * Each burst is described by its size and by the period to the next burst.
+ * The object is immutable once parsed, and is shared by all the generators
+ * using the same trace file.
+ */
+class BurstTrace : public SimpleRefCount<BurstTrace>
+{
+public:
+  /**
+   * \brief Parse a trace file
+   *
+   * Each non-blank row of the file contains the burst size [B] and the
+   * period to the next burst [s]. The simulation is aborted if the file is
+   * malformed.
+   *
+   * \param filename the name of the trace file
+   */
+  BurstTrace (const std::string &filename);
+
+  /**
+   * \return the number of bursts in the trace
+   */
+  uint32_t GetNBursts (void) const;
+  /**
+   * \param index the index of the burst
+   * \return the size of the burst [B]
+   */
+  uint32_t GetBurstSize (uint32_t index) const;
+  /**
+   * \param index the index of the burst
+   * \return the period to the next burst [s]
+   */
+  double GetPeriod (uint32_t index) const;
+  /**
+   * \brief Find the first burst generated at or after a given time
+   * \param startTime the time offset from the beginning of the trace [s]
+   * \return the index of the first burst, or GetNBursts () if none
+   */
+  uint32_t GetFirstBurst (double startTime) const;
+
+private:
+  std::vector<std::pair<uint32_t, double> > m_bursts; //!< burst size and period to the next burst
+};
+
+/**
+ * \ingroup applications
+ *
+ * \brief Frames of a KITTI trace file, as used by KittiTraceBurstGenerator
+ *
+ * The frames are indexed by (scene, traffic model): the frames of one
+ * sequence are stored in a contiguous array, so that a generator only keeps
+ * a pointer to it. The object is immutable once created, and is shared by all
+ * the generators using the same trace file.
+ *
+ * The trace can be created either from the CSV file of the KITTI dataset or
+ * from a binary file obtained with WriteBinary. Binary files are memory
+ * mapped and used in place, so that no parsing is needed at all. Binary
+ * files are stored in the byte order of the host that wrote them.
+ */
+class KittiTrace : public SimpleRefCount<KittiTrace>
+{
+public:
+  /**
+   * One frame of a (scene, model) sequence
+   */
+  struct Frame
+  {
+    uint32_t m_burstSize;     //!< size of the burst [B]
+    uint16_t m_encodingTime;  //!< encoding time
+    uint16_t m_decodingTime;  //!< decoding time
+  };
+
+  /**
+   * The frames of a (scene, model) sequence
+   *
+   * The traffic model may be missing for some of the frames of the scene:
+   * in that case, m_frames only holds the frames preceding the first frame
+   * without the model, while m_nSceneFrames is the number of frames of the
+   * scene.
+   */
+  struct Sequence
+  {
+    const Frame *m_frames;    //!< the frames with the requested model
+    uint32_t m_nFrames;       //!< the number of elements of m_frames
+    uint32_t m_nSceneFrames;  //!< the number of frames of the scene
+  };
+
+  /**
+   * \brief Load a trace file
+   *
+   * Binary files are recognized by their magic string, any other file is
+   * parsed as a KITTI CSV file. The simulation is aborted if the file is
+   * malformed.
+   *
+   * \param filename the name of the trace file
+   */
+  KittiTrace (const std::string &filename);
+  ~KittiTrace ();
+
+  /**
+   * \param scene the scene
+   * \param model the traffic model
+   * \return the frames of the scene with the given traffic model
+   */
+  Sequence GetSequence (int scene, uint32_t model) const;
+  /**
+   * \brief Write the trace in the binary format
+   * \param filename the name of the binary file
+   * \return false if the file could not be written
+   */
+  bool WriteBinary (const std::string &filename) const;
+
+private:
+  /**
+   * Position of a (scene, model) sequence in the frame array
+   */
+  struct Entry
+  {
+    int32_t m_scene;          //!< scene
+    uint32_t m_model;         //!< traffic model
+    uint32_t m_nFrames;       //!< number of frames with the model
+    uint32_t m_nSceneFrames;  //!< number of frames of the scene
+    uint64_t m_offset;        //!< index of the first frame in the frame array
+  };
+
+  /**
+   * \brief Parse a KITTI CSV file
+   * \param filename the name of the file
+   */
+  void ParseCsv (const std::string &filename);
+  /**
+   * \brief Map a binary file
+   * \param filename the name of the file
+   * \return false if the file is not a binary trace file
+   */
+  bool MapBinary (const std::string &filename);
+
+  static const char MAGIC[8]; //!< magic string of the binary files
+
+  std::vector<Entry> m_entries;  //!< sequences, sorted by scene and model
+  std::vector<Frame> m_storage;  //!< frames parsed from a CSV file
+  const Frame *m_frames;         //!< frame array, either m_storage or the mapped file
+  void *m_map;                   //!< mapped binary file, if any
+  std::size_t m_mapSize;         //!< size of the mapped region
+};
+
+/**
+ * \ingroup applications
+ *
+ * \brief Process-wide cache of the trace files used by the burst generators
+ *
+ * Each trace file is read once, the first time it is requested, and the
+ * resulting immutable object is shared by all the generators using the same
+ * file, including the generators of later simulations run by the same
+ * process.
+ */
+class BurstTraceRegistry
+{
+public:
+  /**
+   * \param filename the name of the trace file
+   * \return the bursts of the trace file
+   */
+  static Ptr<const BurstTrace> GetBurstTrace (const std::string &filename);
+  /**
+   * \param filename the name of a KITTI CSV file or of a binary trace file
+   * \return the frames of the trace file
+   */
+  static Ptr<const KittiTrace> GetKittiTrace (const std::string &filename);
+  /**
+   * \brief Drop the cached traces
+   *
+   * Generators holding a trace keep using it until they release it.
+   */
+  static void Clear (void);
+
+private:
+  /**
+   * \return the cached burst traces
+   */
+  static std::map<std::string, Ptr<const BurstTrace> > & GetBurstTraces (void);
+  /**
+   * \return the cached KITTI traces
+   */
+  static std::map<std::string, Ptr<const KittiTrace> > & GetKittiTraces (void);
+};
+
+} // namespace ns3
+
+#endif // BURST_TRACE_REGISTRY_H
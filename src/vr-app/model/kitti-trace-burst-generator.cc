@@ -26,7 +26,6 @@
 #include "ns3/integer.h"
 #include "ns3/double.h"
 #include "ns3/nstime.h"
-#include "ns3/csv-reader.h"
 #include "kitti-trace-burst-generator.h"
 
 namespace ns3 {
@@ -89,6 +88,8 @@ KittiTraceBurstGenerator::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
 
+  m_trace = nullptr;
+
   // chain up
   BurstGenerator::DoDispose ();
 }
@@ -105,7 +106,7 @@ KittiTraceBurstGenerator::HasNextBurst (void)
       ImportTrace ();
     }
 
-  if (m_frameNumber < m_frameVector.size())
+  if (m_frameNumber < m_frames.m_nSceneFrames)
     {
       NS_LOG_DEBUG ("Prepare to read frame " << m_frameNumber << " ...");
       hasNext = true;
@@ -137,7 +138,10 @@ KittiTraceBurstGenerator::GenerateBurst ()
       ImportTrace ();
     }
 
-  uint32_t burstSize = m_frameVector[m_frameNumber].at(m_model).m_burstSize;
+  NS_ABORT_MSG_IF (m_frameNumber >= m_frames.m_nFrames,
+                   "Traffic model " << m_model << " is missing for frame " << m_frameNumber
+                                    << " of scene " << m_scene);
+  uint32_t burstSize = m_frames.m_frames[m_frameNumber].m_burstSize;
 
   std::pair<uint32_t, Time> burst (burstSize, m_framePeriod);
   
@@ -165,6 +169,10 @@ KittiTraceBurstGenerator::SetModel (uint32_t mdl)
                    mdl !=  1150 && mdl != 1450 && mdl != 1451 && mdl != 1452, 
                    "This traffic model is not supported.");
   m_model = mdl;
+  if (m_isFinalized)
+    {
+      m_frames = m_trace->GetSequence (m_scene, m_model);
+    }
 }
 
 uint32_t
@@ -190,69 +198,10 @@ KittiTraceBurstGenerator::ImportTrace (void)
 {
   NS_LOG_FUNCTION (this);
 
-  // extract trace from file
-  char delimiter = ';';
-  CsvReader csv (m_traceFile, delimiter);
-
-  std::string name;
-  uint16_t model;
-  uint32_t burstSize;
-  uint16_t encodingTime;
-  uint16_t decodingTime;
-  int frame = 0;
-
-  std::map<uint16_t, struct FrameInfo> info;
-
-  while (csv.FetchNextRow ())
-    {
-      // Ignore blank lines and first line
-      if (csv.IsBlankRow () || csv.RowNumber () == 1)
-        {
-          continue;
-        }
-
-      // Expecting burst size and period to next burst
-      bool ok = csv.GetValue (0, name);
-      ok |= csv.GetValue (1, model);
-      ok |= csv.GetValue (2, burstSize);
-      ok |= csv.GetValue (3, encodingTime);
-      ok |= csv.GetValue (4, decodingTime);
-
-      std::string delimiter = ".";
-      std::string sceneFrame = name.substr (0, name.find (delimiter));
-      
-      // Get the scene and frame index
-      delimiter = "/";
-      int scene = stoi( sceneFrame.substr (0, sceneFrame.find (delimiter)));
-      int newFrame = stoi( sceneFrame.substr (sceneFrame.find (delimiter) + 1));
-
-      if (scene != m_scene)
-      {
-        // consider only the scene that we are interested in
-        continue;
-      }
-
-      NS_LOG_DEBUG (scene << " " << frame << " " << model << " " << burstSize << " " << encodingTime << " " << decodingTime);
-
-      FrameInfo frameInfo (burstSize, encodingTime, decodingTime);
-
-      if (frame != newFrame)
-      {
-        // each row of m_frameVector is associated to a specific frame
-        // once each traffic model is added, we can move to the next frame 
-        m_frameVector.push_back(info);
-        info.clear();
-        info.insert ({model, frameInfo});
-        frame = newFrame;
-      }
-      else
-      {
-        info.insert({model, frameInfo});
-      }
-      
-      NS_ABORT_MSG_IF (!ok, "Something went wrong on line " << csv.RowNumber () << " of file " << m_traceFile);
-
-    } // while FetchNextRow
+  m_trace = BurstTraceRegistry::GetKittiTrace (m_traceFile);
+  m_frames = m_trace->GetSequence (m_scene, m_model);
+  NS_LOG_DEBUG ("Scene " << m_scene << " has " << m_frames.m_nSceneFrames << " frames, "
+                         << m_frames.m_nFrames << " of them with traffic model " << m_model);
 
   m_isFinalized = true;
 }
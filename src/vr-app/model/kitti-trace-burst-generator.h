@@ -34,7 +34,11 @@ class Time;
  * 
  * The generator reads a trace file obtained from the Kitti Dataset and generates bursts accordingly.
  * A trace file should be formatted following the guidelines given
- * by the documentation of ns3::CsvReader.
+ * by the documentation of ns3::CsvReader, or be a binary trace written by
+ * KittiTrace::WriteBinary.
+ *
+ * Trace files are loaded once per process by BurstTraceRegistry, and shared
+ * by all the generators using them.
  * 
  */
 class KittiTraceBurstGenerator : public TraceFileBurstGenerator
@@ -90,25 +94,13 @@ protected:
 
 private:
   
-    /**
-   * Import the trace file into the burst queue
+  /**
+   * Get the trace from the registry and look up the frames of the scene
    */
   void ImportTrace (void);
 
-  // Structure representing one row from the Kitti dataset
-  struct FrameInfo
-  {
-    FrameInfo (uint32_t bSize, uint16_t encoTime, uint16_t decoTime)
-        : m_burstSize (bSize), m_encodingTime (encoTime), m_decodingTime (decoTime)
-    {
-    }
-
-    uint32_t m_burstSize;
-    uint16_t m_encodingTime;
-    uint16_t m_decodingTime;
-  };
-
-  std::vector< std::map<uint16_t, struct FrameInfo> > m_frameVector;
+  Ptr<const KittiTrace> m_trace; //!< The trace shared by all the generators using the same file
+  KittiTrace::Sequence m_frames; //!< The frames of the scene with the selected traffic model
 
   std::string m_traceFile{""}; //!< The name of the trace file
   uint32_t m_frameNumber{0}; //!< The frame number associated to a specific scene
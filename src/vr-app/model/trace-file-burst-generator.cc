@@ -23,7 +23,6 @@
 #include "ns3/string.h"
 #include "ns3/double.h"
 #include "ns3/nstime.h"
-#include "ns3/csv-reader.h"
 #include "trace-file-burst-generator.h"
 
 namespace ns3 {
@@ -67,7 +66,7 @@ TraceFileBurstGenerator::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
 
-  ClearBurstQueue ();
+  m_trace = nullptr;
 
   // chain up
   BurstGenerator::DoDispose ();
@@ -82,7 +81,7 @@ TraceFileBurstGenerator::HasNextBurst (void)
       ImportTrace ();
     }
 
-  return !m_burstQueue.empty ();
+  return m_nextBurst < m_trace->GetNBursts ();
 }
 
 std::pair<uint32_t, Time>
@@ -94,63 +93,30 @@ TraceFileBurstGenerator::GenerateBurst ()
       ImportTrace ();
     }
 
-  NS_ABORT_MSG_IF (m_burstQueue.empty (), "All bursts from the trace have already been generated, "
-                                          "you should have checked if HasNextBurst");
+  NS_ABORT_MSG_IF (m_nextBurst >= m_trace->GetNBursts (), "All bursts from the trace have already been generated, "
+                                                          "you should have checked if HasNextBurst");
 
-  std::pair<uint32_t, Time> burst = m_burstQueue.front ();
-  m_burstQueue.pop ();
+  std::pair<uint32_t, Time> burst (m_trace->GetBurstSize (m_nextBurst),
+                                   Seconds (m_trace->GetPeriod (m_nextBurst)));
+  m_nextBurst++;
   NS_LOG_DEBUG ("Generated std::pair(" << burst.first << ", " << burst.second << "); "
-                                       << m_burstQueue.size ()
+                                       << m_trace->GetNBursts () - m_nextBurst
                                        << " more bursts excluding the current one");
   return burst;
 }
 
-void
-TraceFileBurstGenerator::ClearBurstQueue (void)
-{
-  NS_LOG_FUNCTION (this);
-  std::queue<std::pair<uint32_t, Time>> empty;
-  std::swap (m_burstQueue, empty);
-}
-
 void
 TraceFileBurstGenerator::ImportTrace (void)
 {
   NS_LOG_FUNCTION (this);
 
-  // extract trace from file
-  CsvReader csv (m_traceFile);
+  m_trace = BurstTraceRegistry::GetBurstTrace (m_traceFile);
 
-  ClearBurstQueue ();
-  double cumulativeStartTime = 0;
-  uint32_t burstSize;
-  double period;
-  while (csv.FetchNextRow ())
-    {
-      // Ignore blank lines
-      if (csv.IsBlankRow ())
-        {
-          continue;
-        }
-
-      // Expecting burst size and period to next burst
-      bool ok = csv.GetValue (0, burstSize);
-      ok |= csv.GetValue (1, period);
-      NS_ABORT_MSG_IF (!ok, "Something went wrong on line " << csv.RowNumber () << " of file "
-                                                            << m_traceFile);
-      NS_ABORT_MSG_IF (period < 0, "Period to next burst should be non-negative, instead found: "
-                                       << period << " on line " << csv.RowNumber ());
-
-      // Ignore bursts before m_startTime
-      if (cumulativeStartTime >= m_startTime)
-        {
-          m_burstQueue.push (std::make_pair (burstSize, Seconds (period)));
-        }
-      cumulativeStartTime += period;
-    } // while FetchNextRow
+  // Ignore bursts before m_startTime
+  m_nextBurst = m_trace->GetFirstBurst (m_startTime);
 
   m_isFinalized = true;
-  NS_LOG_INFO ("Parsed " << m_burstQueue.size () << " bursts from file " << m_traceFile);
+  NS_LOG_INFO ("Using " << m_trace->GetNBursts () - m_nextBurst << " bursts from file " << m_traceFile);
 }
 
 } // Namespace ns3
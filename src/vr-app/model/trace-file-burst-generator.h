@@ -21,7 +21,7 @@
 #define TRACE_FILE_BURST_GENERATOR_H
 
 #include <ns3/burst-generator.h>
-#include <queue>
+#include <ns3/burst-trace-registry.h>
 
 namespace ns3 {
 
@@ -40,6 +40,9 @@ class Time;
  * the generated bursts can be decoupled by assigning different
  * StartTimes to different users, if the trace is long enough with respect
  * to the simulation duration.
+ *
+ * Trace files are parsed once per process by BurstTraceRegistry, and shared
+ * by all the generators using them.
  * 
  */
 class TraceFileBurstGenerator : public BurstGenerator
@@ -64,19 +67,15 @@ protected:
 
 private:
   /**
-   * Clears the burst queue
-   */
-  void ClearBurstQueue (void);
-
-  /**
-   * Import the trace file into the burst queue
+   * Get the trace from the registry and skip the bursts before the start time
    */
   void ImportTrace (void);
 
   std::string m_traceFile{""}; //!< The name of the trace file
   double m_startTime{0.0}; //!< The trace will only generate traced traffic after a start time offset
   bool m_isFinalized{false}; //!< The generator is finalized only once ImportTrace ends with no errors
-  std::queue<std::pair<uint32_t, Time>> m_burstQueue; //!< The burst information read from the trace
+  Ptr<const BurstTrace> m_trace; //!< The burst information read from the trace
+  uint32_t m_nextBurst{0}; //!< The index of the next burst to generate
 };
 
 } // namespace ns3